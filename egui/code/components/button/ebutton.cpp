@@ -93,7 +93,7 @@ void eButton::setupclass()
     addpropertyl(cls, ECOMP_SETVALUE, ecomp_setvalue, OS_TRUE, "set value", EPRO_METADATA);
     addpropertys(cls, ECOMP_TARGET, ecomp_target, "target", EPRO_METADATA);
 
-    propertysetdone(cls);
+    propertysetdone(cls, EPSET_DENSE);
     os_unlock();
 }
 
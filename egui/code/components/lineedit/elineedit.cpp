@@ -90,7 +90,7 @@ void eLineEdit::setupclass()
     os_lock();
     eclasslist_add(cls, (eNewObjFunc)newobj, "eLineEdit", EGUICLASSID_COMPONENT);
     setupproperties(cls, ECOMP_VALUE_PROPERITES|ECOMP_EXTRA_UI_PROPERITES);
-    propertysetdone(cls);
+    propertysetdone(cls, EPSET_DENSE);
     os_unlock();
 }
 
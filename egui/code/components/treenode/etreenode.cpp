@@ -116,7 +116,7 @@ void eTreeNode::setupclass()
     addpropertys(cls, ECOMP_IPATH, ecomp_ipath, "ipath");
     addpropertyb(cls, ECOMP_ALL, ecomp_all, "show all");
 
-    propertysetdone(cls);
+    propertysetdone(cls, EPSET_DENSE);
     os_unlock();
 }
 
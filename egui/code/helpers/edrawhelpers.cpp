@@ -36,6 +36,7 @@ void edraw_value(
     os_int dflags)
 {
     const os_char *text;
+    os_char nbuf[EVARIABLE_NBUF_SZ];
     ImVec2 pos, pos_max;
     ImU32 check_col;
     ImDrawList *draw_list;
@@ -108,7 +109,7 @@ void edraw_value(
 
         default:
             enice_value_for_ui(value, compo, &attr);
-            text = value->gets();
+            text = value->gets_buf(nbuf, sizeof(nbuf));
             align = attr.alignment();
 
             if (attr.buttontype() & E_OPEN_BUTTON)
@@ -42,17 +42,18 @@ extern const os_char ebindp_state[];
 #define EBIND_METADATA      0x0001
 #define EBIND_CLIENTINIT    0x0002
 #define EBIND_NOFLOWCLT     0x0004
-/* #define EBIND_RESERVED      0x0008 */
+#define EBIND_BATCH         0x0008
 
 #define EBIND_CLIENT        0x0010  /* do not give as argument */
 #define EBIND_TEMPORARY     0x0020
 #define EBIND_BIND_ROWSET   0x0040  /* This is eRowSetBinding. do not give as argument */
+#define EBIND_LATEST        0x0080
 
 #define EBIND_CHANGED       0x0400  /* do not give as argument */
 #define EBIND_INTERTHREAD   0x0800  /* do not give as argument */
 
 #define EBIND_TYPE_MASK     EBIND_BIND_ROWSET
-#define EBIND_SER_MASK     (EBIND_TYPE_MASK|EBIND_CLIENTINIT|EBIND_NOFLOWCLT|EBIND_METADATA)
+#define EBIND_SER_MASK     (EBIND_TYPE_MASK|EBIND_CLIENTINIT|EBIND_NOFLOWCLT|EBIND_METADATA|EBIND_BATCH|EBIND_LATEST)
 
 /* Binding states.
  */
@@ -64,6 +65,28 @@ extern const os_char ebindp_state[];
  */
 #define EBIND_MAX_ACK_COUNT 3
 
+/* Rate limit and deadband options for property binding, given as argument to bind().
+   Zero disables the option.
+ */
+typedef struct eBindParams
+{
+    /* Minimum time between forwarded values, milliseconds. Changes meanwhile are
+       coalesced, latest value is forwarded when the interval has elapsed.
+     */
+    os_int min_interval_ms;
+
+    /* Maximum time between forwarded values (heartbeat), milliseconds.
+     */
+    os_int max_interval_ms;
+
+    /* Numeric value is forwarded only if it differs from last forwarded value more
+       than absolute deadband or more than deadband_pct percent of last forwarded value.
+     */
+    os_double deadband;
+    os_double deadband_pct;
+}
+eBindParams;
+
 
 
 /**
@@ -206,7 +229,7 @@ protected:
     {
         return (m_bflags & EBIND_CHANGED) &&
                 m_state == E_BINDING_OK &&
-                (m_ackcount < EBIND_MAX_ACK_COUNT ||
+                (m_ackcount < ((m_bflags & EBIND_LATEST) ? 1 : EBIND_MAX_ACK_COUNT) ||
                  (m_bflags & EBIND_NOFLOWCLT) ||
                  (m_bflags & EBIND_INTERTHREAD) == 0);
     }
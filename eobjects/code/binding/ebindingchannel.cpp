@@ -0,0 +1,347 @@
+/**
+
+  @file    ebindingchannel.cpp
+  @brief   Batched property binding updates between two threads.
+  @author  Pekka Lehtikoski
+  @version 1.0
+  @date    18.10.2026
+
+  Property bindings with EBIND_BATCH flag do not send own ECMD_FWRD message for each change.
+  Changed values are collected to binding channel, one per remote thread, which sends values
+  of all bindings as one ECMD_FWRD_BATCH message when the thread has processed it's messages,
+  or when flush timer hits if the thread is kept busy by incoming messages. The remote thread
+  acknowledges the whole batch with one ECMD_ACK.
+
+  ECMD_FWRD_BATCH message content is eContainer holding pairs of eVariables: Object index
+  string of remote binding, like "@12_3", followed by the value.
+
+  Copyright 2020 Pekka Lehtikoski. This file is part of the eobjects project and shall only be used,
+  modified, and distributed under the terms of the project licensing. By continuing to use, modify,
+  or distribute this file you indicate that you have read the license and understand and accept
+  it fully.
+
+****************************************************************************************************
+*/
+#include "eobjects.h"
+
+/* Binding channel property names.
+ */
+const os_char
+    ebchp_nbatches[] = "nbatches",
+    ebchp_nvalues[] = "nvalues",
+    ebchp_ncoalesced[] = "ncoalesced",
+    ebchp_latency[] = "latency";
+
+
+/**
+****************************************************************************************************
+  Constructor.
+****************************************************************************************************
+*/
+eBindingChannel::eBindingChannel(
+    eObject *parent,
+    e_oid id,
+    os_int flags)
+    : eObject(parent, id, flags)
+{
+    m_path = new eVariable(this);
+    m_batch = new eContainer(this);
+    m_batch->ns_create();
+    m_ackcount = 0;
+    m_timer_ms = 0;
+    m_nbatches = m_nvalues = m_ncoalesced = 0;
+    m_nacks = m_latency_sum = 0;
+}
+
+
+/**
+****************************************************************************************************
+  Virtual destructor.
+****************************************************************************************************
+*/
+eBindingChannel::~eBindingChannel()
+{
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Add eBindingChannel to class list and class'es properties to it's property set.
+
+  The eBindingChannel::setupclass function adds eBindingChannel to class list and class'es
+  properties to it's property set. Properties are statistics, which can be compared to
+  number of ECMD_FWRD messages sent by unbatched bindings.
+
+****************************************************************************************************
+*/
+void eBindingChannel::setupclass()
+{
+    const os_int cls = ECLASSID_BINDING_CHANNEL;
+    eVariable *p;
+
+    /* Synchronize, add the class to class list and properties to property set.
+     */
+    os_lock();
+    eclasslist_add(cls, (eNewObjFunc)OS_NULL, "eBindingChannel");
+    addpropertyl(cls, EBCHP_NBATCHES, ebchp_nbatches, "batches sent",
+        EPRO_SIMPLE|EPRO_RDONLY);
+    addpropertyl(cls, EBCHP_NVALUES, ebchp_nvalues, "values sent",
+        EPRO_SIMPLE|EPRO_RDONLY);
+    addpropertyl(cls, EBCHP_NCOALESCED, ebchp_ncoalesced, "values coalesced",
+        EPRO_SIMPLE|EPRO_RDONLY);
+    p = addpropertyl(cls, EBCHP_LATENCY, ebchp_latency, "average round trip",
+        EPRO_SIMPLE|EPRO_RDONLY);
+    p->setpropertys(EVARP_UNIT, "us");
+    propertysetdone(cls);
+    os_unlock();
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Process incoming messages.
+
+  The eBindingChannel::onmessage function handles acknowledgements from remote thread. When
+  batch is acknowledged, values collected meanwhile can be sent. If remote thread has gone,
+  flow control is reset so that values are sent again when bindings reconnect. Timer
+  sends values which have been waiting for EBINDINGCHANNEL_FLUSH_MS.
+
+  @param   envelope Message envelope. Contains command, target and source paths and
+           message content, etc.
+  @return  None.
+
+****************************************************************************************************
+*/
+void eBindingChannel::onmessage(
+    eEnvelope *envelope)
+{
+    os_int i;
+
+    if (*envelope->target() == '\0')
+    {
+        switch (envelope->command())
+        {
+            case ECMD_ACK:
+                if (m_ackcount <= 0) return;
+                m_latency_sum += etime() - m_sent_ts[0];
+                m_nacks++;
+                for (i = 1; i < m_ackcount; i++) {
+                    m_sent_ts[i - 1] = m_sent_ts[i];
+                }
+                m_ackcount--;
+                flush();
+                return;
+
+            case ECMD_NO_TARGET:
+                m_ackcount = 0;
+                return;
+
+            case ECMD_TIMER:
+                flush();
+                return;
+        }
+    }
+
+    eObject::onmessage(envelope);
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Get value of simple property (override).
+
+  The simpleproperty() function stores current value of simple property into variable x.
+
+  @param   propertynr Property number to get.
+  @param   x Variable into which to store the property value.
+  @return  If property with property number was stored in x, the function returns
+           ESTATUS_SUCCESS (0). Nonzero return values indicate that property with
+           given number was not among simple properties.
+
+****************************************************************************************************
+*/
+eStatus eBindingChannel::simpleproperty(
+    os_int propertynr,
+    eVariable *x)
+{
+    switch (propertynr)
+    {
+        case EBCHP_NBATCHES:
+            x->setl(m_nbatches);
+            break;
+
+        case EBCHP_NVALUES:
+            x->setl(m_nvalues);
+            break;
+
+        case EBCHP_NCOALESCED:
+            x->setl(m_ncoalesced);
+            break;
+
+        case EBCHP_LATENCY:
+            x->setl(m_nacks ? m_latency_sum / m_nacks : 0);
+            break;
+
+        default:
+            return eObject::simpleproperty(propertynr, x);
+    }
+    return ESTATUS_SUCCESS;
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Add changed value to batch.
+
+  The eBindingChannel::put() function stores value to be sent to remote binding. If there is
+  earlier value to the same binding which has not been sent yet, it is replaced. Values are
+  sent by flush(), which eThread calls when it has processed received messages.
+
+  @param   bindpath Path to remote binding. Only the last object index part, like "@12_3",
+           is used, route to remote thread is channel's path.
+  @param   x Value to send.
+  @param   delete_x OS_TRUE to adopt x (it will be deleted), OS_FALSE to copy it.
+  @return  None.
+
+****************************************************************************************************
+*/
+void eBindingChannel::put(
+    const os_char *bindpath,
+    eVariable *x,
+    os_boolean delete_x)
+{
+    eVariable *v;
+    const os_char *p;
+
+    for (p = bindpath; *bindpath; bindpath++) {
+        if (*bindpath == '/') p = bindpath + 1;
+    }
+
+    v = eVariable::cast(m_batch->byname(p));
+    if (v) {
+        m_ncoalesced++;
+    }
+    else {
+        v = new eVariable(m_batch);
+        v->addname(p);
+    }
+    v->setv(x, delete_x);
+
+    /* If the thread doesn't get to process all messages soon, the timer sends batch.
+     */
+    if (m_timer_ms == 0)
+    {
+        m_timer_ms = EBINDINGCHANNEL_FLUSH_MS;
+        timer(m_timer_ms);
+    }
+
+    if (delete_x) {
+        delete x;
+    }
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Send collected values.
+
+  The eBindingChannel::flush() function sends all collected values as one ECMD_FWRD_BATCH
+  message to remote thread, unless too many batches are waiting for acknowledgement. In that
+  case values stay in batch and newer values replace them, and are sent when acknowledgement
+  is received. Flush timer is stopped when there is nothing to send or sending waits for
+  acknowledgement.
+
+  @return  None.
+
+****************************************************************************************************
+*/
+void eBindingChannel::flush()
+{
+    eContainer *content;
+    eVariable *v, *next_v, *p;
+    eName *name;
+
+    if (m_batch->first() && m_ackcount < EBIND_MAX_ACK_COUNT)
+    {
+        content = new eContainer;
+        for (v = m_batch->firstv(); v; v = next_v)
+        {
+            next_v = v->nextv();
+            name = v->firstn();
+            if (name)
+            {
+                p = new eVariable(content);
+                p->setv(name);
+                p = new eVariable(content);
+                p->setv(v, OS_TRUE);
+                m_nvalues++;
+            }
+            delete v;
+        }
+
+        message(ECMD_FWRD_BATCH, m_path->gets(), OS_NULL, content, EMSG_DEL_CONTENT);
+        m_sent_ts[m_ackcount++] = etime();
+        m_nbatches++;
+    }
+
+    if (m_timer_ms)
+    {
+        m_timer_ms = 0;
+        timer(0);
+    }
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Set values received in ECMD_FWRD_BATCH message to bindings.
+
+  The eBindingChannel::receive() function is called by eThread, which received the batch.
+  Each value is given to the binding identified by object index, which handles it like value
+  received in ECMD_FWRD message. Bindings which have been deleted meanwhile are skipped.
+  The whole batch is acknowledged with one ECMD_ACK.
+
+  @param   thread Thread which received the message.
+  @param   envelope ECMD_FWRD_BATCH message envelope.
+  @return  None.
+
+****************************************************************************************************
+*/
+void eBindingChannel::receive(
+    eObject *thread,
+    eEnvelope *envelope)
+{
+    eContainer *content;
+    eVariable *p, *x;
+    eHandle *handle, *thread_handle;
+    e_oix oix;
+    os_int ucnt;
+
+    content = eContainer::cast(envelope->content());
+    thread_handle = thread->handle();
+    if (content && thread_handle)
+    {
+        for (p = content->firstv(); p; p = x->nextv())
+        {
+            x = p->nextv();
+            if (x == OS_NULL) break;
+
+            if (thread->oixparse(p->gets(), &oix, &ucnt) == 0) continue;
+            handle = eget_handle(oix);
+            if (handle == OS_NULL) continue;
+            if (handle->m_ucnt != ucnt || handle->m_root != thread_handle->m_root) continue;
+            if (handle->m_object->classid() != ECLASSID_PROPERTY_BINDING) continue;
+
+            ePropertyBinding::cast(handle->m_object)->batch_update(x);
+        }
+    }
+
+    thread->message(ECMD_ACK, envelope->source(), OS_NULL, OS_NULL,
+        EMSG_NO_REPLIES|EMSG_NO_ERRORS);
+}
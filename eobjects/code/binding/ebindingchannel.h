@@ -0,0 +1,174 @@
+/**
+
+  @file    ebindingchannel.h
+  @brief   Batched property binding updates between two threads.
+  @author  Pekka Lehtikoski
+  @version 1.0
+  @date    18.10.2026
+
+  Property bindings with EBIND_BATCH flag do not send own ECMD_FWRD message for each change.
+  Changed values are collected to binding channel, one per remote thread, which sends values
+  of all bindings as one ECMD_FWRD_BATCH message when the thread has processed it's messages.
+  The remote thread acknowledges the whole batch with one ECMD_ACK.
+
+  Copyright 2020 Pekka Lehtikoski. This file is part of the eobjects project and shall only be used,
+  modified, and distributed under the terms of the project licensing. By continuing to use, modify,
+  or distribute this file you indicate that you have read the license and understand and accept
+  it fully.
+
+****************************************************************************************************
+*/
+#pragma once
+#ifndef EBINDINGCHANNEL_H_
+#define EBINDINGCHANNEL_H_
+#include "eobjects.h"
+
+
+/**
+****************************************************************************************************
+  Defines
+****************************************************************************************************
+*/
+
+/* Maximum time collected values wait for thread's message queue to become empty, ms.
+ */
+#ifndef EBINDINGCHANNEL_FLUSH_MS
+#define EBINDINGCHANNEL_FLUSH_MS 40
+#endif
+
+/* Enumeration of binding channel properties.
+ */
+#define EBCHP_NBATCHES 2
+#define EBCHP_NVALUES 3
+#define EBCHP_NCOALESCED 4
+#define EBCHP_LATENCY 5
+
+/* Binding channel property names.
+ */
+extern const os_char
+    ebchp_nbatches[],
+    ebchp_nvalues[],
+    ebchp_ncoalesced[],
+    ebchp_latency[];
+
+
+/**
+****************************************************************************************************
+
+  @brief Binding channel class.
+
+  The eBindingChannel collects changed property values of batched bindings, which are bound
+  to the same remote thread, and sends them as one message. Channels are created by eThread
+  as needed and named by path to remote thread.
+
+****************************************************************************************************
+*/
+class eBindingChannel : public eObject
+{
+public:
+    /* Constructor.
+     */
+    eBindingChannel(
+        eObject *parent = OS_NULL,
+        e_oid id = EOID_ITEM,
+        os_int flags = EOBJ_DEFAULT);
+
+    /* Virtual destructor.
+     */
+    virtual ~eBindingChannel();
+
+    /* Casting eObject pointer to eBindingChannel pointer.
+     */
+    inline static eBindingChannel *cast(
+        eObject *o)
+    {
+        e_assert_type(o, ECLASSID_BINDING_CHANNEL)
+        return (eBindingChannel*)o;
+    }
+
+    /* Get class identifier.
+     */
+    virtual os_int classid() {return ECLASSID_BINDING_CHANNEL; }
+
+    /* Static function to add class to propertysets and class list.
+     */
+    static void setupclass();
+
+    /* Process received messages (acknowledgements).
+     */
+    virtual void onmessage(
+        eEnvelope *envelope);
+
+    /* Get value of simple property.
+     */
+    virtual eStatus simpleproperty(
+        os_int propertynr,
+        eVariable *x);
+
+    /* Set path to remote thread.
+     */
+    inline void set_path(
+        const os_char *path)
+        {m_path->sets(path); }
+
+    /* Add changed value to batch.
+     */
+    void put(
+        const os_char *bindpath,
+        eVariable *x,
+        os_boolean delete_x);
+
+    /* Send collected values, if flow control allows.
+     */
+    void flush();
+
+    /* Check if values have been sent and not acknowledged, or are waiting to be sent.
+     */
+    inline os_boolean busy()
+        {return (os_boolean)(m_ackcount > 0 || m_batch->first() != OS_NULL); }
+
+    /* Set values received in ECMD_FWRD_BATCH message to bindings and acknowledge.
+     */
+    static void receive(
+        eObject *thread,
+        eEnvelope *envelope);
+
+protected:
+
+    /**
+    ************************************************************************************************
+      Member variables.
+    ************************************************************************************************
+    */
+
+    /** Path to remote thread.
+     */
+    eVariable *m_path;
+
+    /** Changed values waiting to be sent, named by remote binding's object index.
+     */
+    eContainer *m_batch;
+
+    /** Send time stamps of unacknowledged batches, microseconds. Oldest first.
+     */
+    os_long m_sent_ts[EBIND_MAX_ACK_COUNT];
+
+    /** Number of ECMD_FWRD_BATCH messages sent but have not been acknowledged.
+     */
+    os_int m_ackcount;
+
+    /** Flush timer period, ms. Zero if timer is not running.
+     */
+    os_int m_timer_ms;
+
+    /** Statistics: Batches sent, values sent, values superseded before sending, number of
+        acknowledged batches and their total round trip time in microseconds.
+     */
+    os_long m_nbatches;
+    os_long m_nvalues;
+    os_long m_ncoalesced;
+    os_long m_nacks;
+    os_long m_latency_sum;
+};
+
+#endif
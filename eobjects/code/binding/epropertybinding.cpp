@@ -36,6 +36,8 @@ ePropertyBinding::ePropertyBinding(
      */
     m_propertyname = OS_NULL;
     m_propertynamesz = 0;
+    m_channel = OS_NULL;
+    m_limits = OS_NULL;
 }
 
 
@@ -52,6 +54,7 @@ ePropertyBinding::ePropertyBinding(
 ePropertyBinding::~ePropertyBinding()
 {
     set_propertyname(OS_NULL);
+    set_limits(OS_NULL);
 }
 
 
@@ -61,7 +64,8 @@ ePropertyBinding::~ePropertyBinding()
   @brief Clone object
 
   The ePropertyBinding::clone function clones and object including object's children.
-  Names will be left detached in clone.
+  Names will be left detached in clone. Rate limit and deadband options are copied, the
+  clone starts with fresh limit state.
 
   @param  parent Parent for the clone.
   @param  id Object identifier for the clone.
@@ -75,11 +79,13 @@ eObject *ePropertyBinding::clone(
     e_oid id,
     os_int aflags)
 {
-    eObject
-        *clonedobj,
-        *child;
+    ePropertyBinding *clonedobj;
+    eObject *child;
 
     clonedobj = new ePropertyBinding(parent, id == EOID_CHILD ? oid() : id, flags());
+    if (m_limits) {
+        clonedobj->set_limits(&m_limits->prm);
+    }
 
     for (child = first(EOID_ALL); child; child = child->next(EOID_ALL))
     {
@@ -141,7 +147,7 @@ eStatus ePropertyBinding::writer(
     /* Version number. Increment if new serialized items are added to the object,
        and check for new version's items in read() function.
      */
-    const os_int version = 0;
+    const os_int version = 1;
     eObject *child;
 
     /* Begin the object and write version number.
@@ -159,6 +165,17 @@ eStatus ePropertyBinding::writer(
         child->write(stream, flags);
     }
 
+    /* Version 1: Rate limit and deadband options, preceded by flag if these are set.
+     */
+    if (*stream << (os_int)(m_limits != OS_NULL)) goto failed;
+    if (m_limits)
+    {
+        if (*stream << m_limits->prm.min_interval_ms) goto failed;
+        if (*stream << m_limits->prm.max_interval_ms) goto failed;
+        if (*stream << m_limits->prm.deadband) goto failed;
+        if (*stream << m_limits->prm.deadband_pct) goto failed;
+    }
+
     /* End the object.
      */
     if (stream->write_end_block()) goto failed;
@@ -198,8 +215,9 @@ eStatus ePropertyBinding::reader(
 {
     /* Version number. Used to check which versions item's are in serialized data.
      */
-    os_int version;
+    os_int version, has_limits;
     os_long count;
+    eBindParams bparams;
 
     /* Read object start mark and version number.
      */
@@ -216,6 +234,22 @@ eStatus ePropertyBinding::reader(
         read(stream, flags);
     }
 
+    /* Version 1: Rate limit and deadband options.
+     */
+    if (version >= 1)
+    {
+        if (*stream >> has_limits) goto failed;
+        if (has_limits)
+        {
+            os_memclear(&bparams, sizeof(bparams));
+            if (*stream >> bparams.min_interval_ms) goto failed;
+            if (*stream >> bparams.max_interval_ms) goto failed;
+            if (*stream >> bparams.deadband) goto failed;
+            if (*stream >> bparams.deadband_pct) goto failed;
+            set_limits(&bparams);
+        }
+    }
+
     /* End the object.
      */
     if (stream->read_end_block()) goto failed;
@@ -285,6 +319,15 @@ void ePropertyBinding::onmessage(
             case ECMD_REBIND:
                 bind2(OS_NULL);
                 return;
+
+            case ECMD_TIMER:
+                if (m_limits) {
+                    limits_ontimer();
+                }
+                else {
+                    timer(0);
+                }
+                return;
         }
     }
 
@@ -320,6 +363,11 @@ void ePropertyBinding::onmessage(
           - EBIND_METADATA: If meta data, like text, unit, attributes, etc exists, it is
             also transferred from remote object to local object.
           - EBIND_METADATA: Bind also attributes (subproperties like "x.min").
+          - EBIND_BATCH: Changes are sent trough binding channel with changes of other
+            batched bindings to the same remote thread, see eBindingChannel.
+          - EBIND_LATEST: Keep at most one forwarded value waiting for acknowledge.
+  @param  bparams Rate limit and deadband options, OS_NULL if none. These are passed to
+          server end of binding, so both ends filter values they forward.
   @return None.
 
 ****************************************************************************************************
@@ -328,11 +376,13 @@ void ePropertyBinding::bind(
     os_int localpropertynr,
     const os_char *remotepath,
     const os_char *remoteproperty,
-    os_int bflags)
+    os_int bflags,
+    const eBindParams *bparams)
 {
     /* Save bind parameters and flags.
      */
     set_propertyname(remoteproperty);
+    set_limits(bparams);
     m_localpropertynr = localpropertynr;
     m_bflags = bflags | EBIND_CLIENT;
 
@@ -353,6 +403,25 @@ void ePropertyBinding::bind2(
     parameters->setl(EPR_BINDING_FLAGS, m_bflags & EBIND_SER_MASK);
     parameters->sets(EPR_BINDING_PROPERTYNAME, m_propertyname);
 
+    /* If batched, tell server end where to send batches.
+     */
+    m_channel = OS_NULL;
+    if (m_bflags & EBIND_BATCH)
+    {
+        get_threadpath(&x);
+        parameters->setv(EPR_BINDING_CHANNEL, &x);
+    }
+
+    /* Pass rate limit and deadband options to server end.
+     */
+    if (m_limits)
+    {
+        parameters->setl(EPR_BINDING_MIN_INTERVAL, m_limits->prm.min_interval_ms);
+        parameters->setl(EPR_BINDING_MAX_INTERVAL, m_limits->prm.max_interval_ms);
+        parameters->setd(EPR_BINDING_DEADBAND, m_limits->prm.deadband);
+        parameters->setd(EPR_BINDING_DEADBAND_PCT, m_limits->prm.deadband_pct);
+    }
+
     /* If this client is master, get property value.
      */
     if (m_bflags & EBIND_CLIENTINIT)
@@ -401,6 +470,7 @@ void ePropertyBinding::srvbind(
 {
     eSet *parameters, *reply;
     eVariable v, propertyname;
+    eBindParams bparams;
     const os_char *propertyname_str;
 
     parameters = eSet::cast(envelope->content());
@@ -448,6 +518,28 @@ void ePropertyBinding::srvbind(
      */
     reply = new eSet(this);
 
+    /* If batched binding, select channel to client thread and tell client where to send
+       it's batches.
+     */
+    if (m_bflags & EBIND_BATCH)
+    {
+        parameters->getv(EPR_BINDING_CHANNEL, &v);
+        set_channel(envelope, &v);
+        if (m_channel)
+        {
+            get_threadpath(&v);
+            reply->setv(EPR_BINDING_CHANNEL, &v);
+        }
+    }
+
+    /* Rate limit and deadband options from client end.
+     */
+    bparams.min_interval_ms = (os_int)parameters->getl(EPR_BINDING_MIN_INTERVAL);
+    bparams.max_interval_ms = (os_int)parameters->getl(EPR_BINDING_MAX_INTERVAL);
+    bparams.deadband = parameters->getd(EPR_BINDING_DEADBAND);
+    bparams.deadband_pct = parameters->getd(EPR_BINDING_DEADBAND_PCT);
+    set_limits(&bparams);
+
     /* If this client is nor master at initialization, get property value.
      */
     if ((m_bflags & EBIND_CLIENTINIT) == 0)
@@ -472,6 +564,11 @@ void ePropertyBinding::srvbind(
     /* Complete the server end of binding and return.
      */
     srvbind_base(envelope, reply);
+    if (m_limits)
+    {
+        limits_forwarded(OS_NULL);
+        limits_set_timer(m_limits->prm.max_interval_ms);
+    }
     return;
 
 notarget:
@@ -525,11 +622,25 @@ void ePropertyBinding::cbindok(
         binding_setproperty(&v);
     }
 
+    /* If batched binding, select channel to server thread. Server which doesn't support
+       batching doesn't reply with thread path, then this works as unbatched binding.
+     */
+    if (m_bflags & EBIND_BATCH)
+    {
+        reply->getv(EPR_BINDING_CHANNEL, &v);
+        set_channel(envelope, &v);
+    }
+
 notarget:
 
     /* Call base class to complete the binding.
      */
     cbindok_base(envelope);
+    if (m_limits && m_state == E_BINDING_OK)
+    {
+        limits_forwarded(OS_NULL);
+        limits_set_timer(m_limits->prm.max_interval_ms);
+    }
 }
 
 
@@ -559,6 +670,16 @@ void ePropertyBinding::changed(
      */
     if (propertynr != m_localpropertynr) return;
 
+    /* If change is within deadband, it is not forwarded.
+     */
+    if (m_limits) if (!limits_pass(x))
+    {
+        if (delete_x) {
+            delete x;
+        }
+        return;
+    }
+
     /* Mark property value, etc changed. Forward immediately, if binding if flow
        control does not block it.
      */
@@ -586,6 +707,47 @@ void ePropertyBinding::forward(
 {
     eVariable *tmp;
 
+    /* If minimum interval since last forward has not elapsed, value stays marked changed
+       and is forwarded by timer.
+     */
+    if (m_limits) if (!limits_allow_forward())
+    {
+        if (delete_x && x) {
+            delete x;
+        }
+        return;
+    }
+
+    /* Batched binding: Value is passed to binding channel, which sends values of all
+       batched bindings to the same remote thread together. Flow control is done by channel.
+     */
+    if (m_channel)
+    {
+        if ((m_bflags & EBIND_CHANGED) && m_state == E_BINDING_OK)
+        {
+            if (x == OS_NULL)
+            {
+                tmp = new eVariable;
+                binding_getproperty(tmp);
+                if (m_limits) limits_forwarded(tmp);
+                m_channel->put(m_bindpath, tmp, OS_TRUE);
+            }
+            else
+            {
+                if (m_limits) limits_forwarded(x);
+                m_channel->put(m_bindpath, x, delete_x);
+                x = OS_NULL;
+            }
+            m_bflags &= ~EBIND_CHANGED;
+        }
+
+        if (delete_x && x)
+        {
+            delete x;
+        }
+        return;
+    }
+
     if (forwardnow())
     {
 
@@ -593,6 +755,7 @@ void ePropertyBinding::forward(
         {
             tmp = new eVariable;
             binding_getproperty(tmp);
+            if (m_limits) limits_forwarded(tmp);
 
             message(ECMD_FWRD, m_bindpath, OS_NULL, tmp,
                 EMSG_DEL_CONTENT /* EMSG_NO_ERROR_MSGS */);
@@ -601,6 +764,7 @@ void ePropertyBinding::forward(
         {
             /* Send data as ECMD_FWRD message.
              */
+            if (m_limits) limits_forwarded(x);
             message(ECMD_FWRD, m_bindpath, OS_NULL, x,
                 delete_x ? EMSG_DEL_CONTENT : EMSG_DEFAULT  /* EMSG_NO_ERROR_MSGS */);
             x = OS_NULL;
@@ -639,6 +803,38 @@ void ePropertyBinding::update(
 }
 
 
+/**
+****************************************************************************************************
+
+  @brief Property value has been received trough binding channel.
+
+  The ePropertyBinding::batch_update function is batched binding's counterpart of update().
+  Binding channel acknowledges the whole batch, so no ECMD_ACK is sent here. Otherwise value
+  is handled as in sendack(): If this is server end and it's own values to client are still
+  waiting to be sent or acknowledged, value is marked changed and forwarded again. This way
+  client ends up with the same value as server when both change it at the same time.
+
+  @param  x Received property value.
+  @return None.
+
+****************************************************************************************************
+*/
+void ePropertyBinding::batch_update(
+    eVariable *x)
+{
+    binding_setproperty(x);
+
+    if ((m_bflags & EBIND_CLIENT) == 0 && m_channel)
+    {
+        if (m_channel->busy())
+        {
+            setchanged();
+            forward();
+        }
+    }
+}
+
+
 /**
 ****************************************************************************************************
 
@@ -716,6 +912,305 @@ void ePropertyBinding::set_propertyname(
 }
 
 
+/**
+****************************************************************************************************
+
+  @brief Select binding channel for batched binding.
+
+  The ePropertyBinding::set_channel() function gets binding channel to remote thread from this
+  thread. Route to remote thread is the same as route to remote binding (source path of the
+  envelope), except that binding's object index is replaced by remote thread's object index.
+  Bindings within same thread are not batched.
+
+  @param  envelope ECMD_BIND or ECMD_BIND_REPLY message envelope from remote binding.
+  @param  threadpath Object index of remote thread, as given by remote binding. Empty if
+          remote end doesn't support batching.
+  @return None.
+
+****************************************************************************************************
+*/
+void ePropertyBinding::set_channel(
+    eEnvelope *envelope,
+    eVariable *threadpath)
+{
+    eThread *t;
+    eVariable path;
+    const os_char *source, *p, *e;
+
+    m_channel = OS_NULL;
+    if (threadpath->isempty()) return;
+    if ((envelope->mflags() & EMSG_INTERTHREAD) == 0) return;
+    t = thread();
+    if (t == OS_NULL) return;
+
+    source = envelope->source();
+    for (p = e = source; *p; p++) {
+        if (*p == '/') e = p + 1;
+    }
+    path.sets(source, e - source);
+    path.appendv(threadpath);
+
+    m_channel = t->bindingchannel(path.gets());
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Get path to this thread for remote end of batched binding.
+
+  The ePropertyBinding::get_threadpath() function stores object index string of the thread
+  running this binding into x. Remote end sends batches to this path.
+
+  @param  x Variable where to store the path. Set empty if binding is not within thread.
+  @return None.
+
+****************************************************************************************************
+*/
+void ePropertyBinding::get_threadpath(
+    eVariable *x)
+{
+    eThread *t;
+    os_char buf[E_OIXSTR_BUF_SZ];
+
+    t = thread();
+    if (t == OS_NULL)
+    {
+        x->clear();
+        return;
+    }
+    t->oixstr(buf, sizeof(buf));
+    x->sets(buf);
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Set or clear rate limit and deadband options.
+
+  The ePropertyBinding::set_limits() function stores options given to bind(). Memory for
+  options and state is allocated only if some option is set, so bindings without options
+  stay small.
+
+  @param  bparams Options to set, OS_NULL or all zeros to clear.
+  @return None.
+
+****************************************************************************************************
+*/
+void ePropertyBinding::set_limits(
+    const eBindParams *bparams)
+{
+    if (bparams) if (bparams->min_interval_ms <= 0 && bparams->max_interval_ms <= 0 &&
+        bparams->deadband <= 0.0 && bparams->deadband_pct <= 0.0)
+    {
+        bparams = OS_NULL;
+    }
+
+    if (bparams == OS_NULL)
+    {
+        if (m_limits)
+        {
+            os_free(m_limits, sizeof(ePropertyBindingLimits));
+            m_limits = OS_NULL;
+        }
+        return;
+    }
+
+    if (m_limits == OS_NULL)
+    {
+        m_limits = (ePropertyBindingLimits*)os_malloc(sizeof(ePropertyBindingLimits), OS_NULL);
+        os_memclear(m_limits, sizeof(ePropertyBindingLimits));
+    }
+    os_memcpy(&m_limits->prm, bparams, sizeof(eBindParams));
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Check if changed value should be forwarded.
+
+  The ePropertyBinding::limits_pass() function compares numeric value to last forwarded
+  value. Change is ignored if it is within deadband, unless state bits have changed or
+  heartbeat is due. Non numeric values always pass. No memory is allocated when x is given.
+
+  @param  x Changed property value, OS_NULL to get it from bound object.
+  @return OS_TRUE if value should be forwarded, OS_FALSE if change is within deadband.
+
+****************************************************************************************************
+*/
+os_boolean ePropertyBinding::limits_pass(
+    eVariable *x)
+{
+    ePropertyBindingLimits *l;
+    eVariable tmp;
+    eValueX *ex;
+    osalTypeId type;
+    os_double d, band, pband;
+
+    l = m_limits;
+    if (!l->has_last_value) return OS_TRUE;
+    if (l->prm.deadband <= 0.0 && l->prm.deadband_pct <= 0.0) return OS_TRUE;
+    if (l->prm.max_interval_ms > 0) {
+        if (os_has_elapsed(&l->last_fwrd, l->prm.max_interval_ms)) return OS_TRUE;
+    }
+
+    if (x == OS_NULL)
+    {
+        binding_getproperty(&tmp);
+        x = &tmp;
+    }
+
+    ex = x->getx();
+    type = ex ? ex->type() : x->type();
+    if (type != OS_LONG && type != OS_DOUBLE) return OS_TRUE;
+    if (x->sbits() != l->last_sbits) return OS_TRUE;
+
+    d = x->getd() - l->last_value;
+    if (d < 0.0) d = -d;
+
+    band = l->prm.deadband;
+    pband = l->last_value * l->prm.deadband_pct * 0.01;
+    if (pband < 0.0) pband = -pband;
+    if (pband > band) band = pband;
+
+    return (os_boolean)(d > band);
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Check if minimum interval allows forwarding now.
+
+  If minimum interval since last forwarded value has not elapsed, the
+  ePropertyBinding::limits_allow_forward() function starts timer to forward the value later.
+  Changes meanwhile are coalesced, the value is read when it is forwarded.
+
+  @return OS_TRUE if value can be forwarded now.
+
+****************************************************************************************************
+*/
+os_boolean ePropertyBinding::limits_allow_forward()
+{
+    os_int min_ms;
+
+    min_ms = m_limits->prm.min_interval_ms;
+    if (min_ms <= 0 || (m_bflags & EBIND_CHANGED) == 0 || m_state != E_BINDING_OK) {
+        return OS_TRUE;
+    }
+    if (os_has_elapsed(&m_limits->last_fwrd, min_ms)) return OS_TRUE;
+
+    limits_set_timer(min_ms);
+    return OS_FALSE;
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Record forwarded value.
+
+  The ePropertyBinding::limits_forwarded() function saves time stamp, and for numeric value
+  also the value and state bits, for deadband and interval checks.
+
+  @param  x Forwarded value, OS_NULL to get current value from bound object (used when
+          binding is established).
+  @return None.
+
+****************************************************************************************************
+*/
+void ePropertyBinding::limits_forwarded(
+    eVariable *x)
+{
+    ePropertyBindingLimits *l;
+    eVariable tmp;
+    eValueX *ex;
+    osalTypeId type;
+
+    l = m_limits;
+    os_get_timer(&l->last_fwrd);
+
+    if (x == OS_NULL)
+    {
+        binding_getproperty(&tmp);
+        x = &tmp;
+    }
+
+    ex = x->getx();
+    type = ex ? ex->type() : x->type();
+    l->has_last_value = (os_boolean)(type == OS_LONG || type == OS_DOUBLE);
+    if (l->has_last_value)
+    {
+        l->last_value = x->getd();
+        l->last_sbits = x->sbits();
+    }
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Start, change or stop rate limit timer.
+
+  Call this function instead of calling timer() directly to avoid repeated set or clear
+  of the timer period.
+
+  @param  timer_ms Timer period in milliseconds, 0 to stop the timer.
+  @return None.
+
+****************************************************************************************************
+*/
+void ePropertyBinding::limits_set_timer(
+    os_int timer_ms)
+{
+    if (timer_ms < 0) timer_ms = 0;
+    if (timer_ms != m_limits->timer_ms)
+    {
+        m_limits->timer_ms = timer_ms;
+        timer(timer_ms);
+    }
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Forward held or heartbeat value when timer hits.
+
+  The ePropertyBinding::limits_ontimer() function forwards value which was held back by
+  minimum interval, or current value if nothing has been forwarded within maximum interval.
+  When nothing is waiting, timer is slowed down to heartbeat period, or stopped if there
+  is no heartbeat.
+
+  @return None.
+
+****************************************************************************************************
+*/
+void ePropertyBinding::limits_ontimer()
+{
+    os_int max_ms;
+
+    if (m_state != E_BINDING_OK)
+    {
+        limits_set_timer(0);
+        return;
+    }
+
+    max_ms = m_limits->prm.max_interval_ms;
+    if (max_ms > 0) if (os_has_elapsed(&m_limits->last_fwrd, max_ms)) {
+        setchanged();
+    }
+
+    forward();
+
+    if ((m_bflags & EBIND_CHANGED) == 0) {
+        limits_set_timer(max_ms);
+    }
+}
+
+
 /**
 ****************************************************************************************************
 
@@ -25,11 +25,40 @@ typedef enum ePrBindingParamEnum {
     EPR_BINDING_PROPERTYNAME,
     EPR_BINDING_VALUE,
     EPR_BINDING_META_PR_NAMES,
+    EPR_BINDING_CHANNEL,
+    EPR_BINDING_MIN_INTERVAL,
+    EPR_BINDING_MAX_INTERVAL,
+    EPR_BINDING_DEADBAND,
+    EPR_BINDING_DEADBAND_PCT,
 
     EPR_BINDING_META_PR_VALUES /* must be last */
 }
 ePrBindingParamEnum;
 
+/* Rate limit and deadband state of property binding, allocated only if binding has options.
+ */
+typedef struct ePropertyBindingLimits
+{
+    /* Options given to bind().
+     */
+    eBindParams prm;
+
+    /* Time when value was last forwarded.
+     */
+    os_timer last_fwrd;
+
+    /* Last forwarded numeric value and state bits, valid if has_last_value is set.
+     */
+    os_double last_value;
+    os_int last_sbits;
+    os_boolean has_last_value;
+
+    /* Current timer period, 0 if timer is not running.
+     */
+    os_int timer_ms;
+}
+ePropertyBindingLimits;
+
 /**
 ****************************************************************************************************
 
@@ -113,7 +142,7 @@ public:
 
     /* Get property nr.
      */
-    /* inline os_int bound_propertynr() {return m_localpropertynr;} */
+    inline os_int bound_propertynr() {return m_localpropertynr;}
 
 
 
@@ -134,7 +163,8 @@ public:
         os_int localpropertynr,
         const os_char *remotepath,
         const os_char *remoteproperty,
-        os_int bflags);
+        os_int bflags,
+        const eBindParams *bparams = OS_NULL);
 
     void bind2(
         const os_char *remotepath);
@@ -152,6 +182,11 @@ public:
         eVariable *x,
         os_boolean delete_x);
 
+    /* Update to property value has been received trough binding channel.
+     */
+    void batch_update(
+        eVariable *x);
+
 protected:
 
     /* Finish the client end of binding.
@@ -209,6 +244,45 @@ protected:
     void set_propertyname(
         const os_char *propertyname);
 
+    /* Select binding channel for batched binding.
+     */
+    void set_channel(
+        eEnvelope *envelope,
+        eVariable *threadpath);
+
+    /* Get path to this thread for remote end of batched binding.
+     */
+    void get_threadpath(
+        eVariable *x);
+
+    /* Set or clear rate limit and deadband options.
+     */
+    void set_limits(
+        const eBindParams *bparams);
+
+    /* Check if change is outside deadband or heartbeat is due.
+     */
+    os_boolean limits_pass(
+        eVariable *x);
+
+    /* Check if minimum interval allows forwarding now.
+     */
+    os_boolean limits_allow_forward();
+
+    /* Record forwarded value for deadband and interval checks.
+     */
+    void limits_forwarded(
+        eVariable *x);
+
+    /* Start, change or stop rate limit timer.
+     */
+    void limits_set_timer(
+        os_int timer_ms);
+
+    /* Forward held or heartbeat value when timer hits.
+     */
+    void limits_ontimer();
+
 
     /**
     ************************************************************************************************
@@ -233,6 +307,14 @@ protected:
     /** Which property of local object is bound.
      */
     os_int m_localpropertynr;
+
+    /** Binding channel to remote thread, OS_NULL if this binding is not batched.
+     */
+    eBindingChannel *m_channel;
+
+    /** Rate limit and deadband options and state, OS_NULL if binding has no options.
+     */
+    ePropertyBindingLimits *m_limits;
 };
 
 #endif
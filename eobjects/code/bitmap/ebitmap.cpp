@@ -48,6 +48,7 @@ eBitmap::eBitmap(
     m_timestamp = 0;
     m_buf = OS_NULL;
     m_buf_sz = m_buf_alloc_sz = 0;
+    m_pool_buf = OS_NULL;
     m_jpeg = OS_NULL;
     m_jpeg_sz = m_jpeg_alloc_sz = 0;
     m_alpha = OS_NULL;
@@ -160,7 +161,15 @@ eObject *eBitmap::clone(
     clonedobj->m_row_nbytes = m_row_nbytes;
     clonedobj->m_bflags = m_bflags;
 
-    if (m_buf) {
+    /* Pooled frame buffer is shared with the clone, no copy.
+     */
+    if (m_pool_buf) {
+        eBitmapPool::attach(m_pool_buf);
+        clonedobj->m_pool_buf = m_pool_buf;
+        clonedobj->m_buf = m_buf;
+        clonedobj->m_buf_sz = m_buf_sz;
+    }
+    else if (m_buf) {
         clonedobj->m_buf = (os_uchar*)os_malloc(m_buf_sz, &(clonedobj->m_buf_alloc_sz));
         if (clonedobj->m_buf) {
             os_memcpy(clonedobj->m_buf, m_buf, m_buf_sz);
@@ -648,15 +657,26 @@ void eBitmap::resize(
     tmp_flags = (bflags & EBITMAP_TMP_FLAGS_MASK);
     bflags &= ~EBITMAP_TMP_FLAGS_MASK;
 
-    /* If nothing has changed.
+    /* If nothing has changed. Pooled frame buffer may be shared with clones: It is released
+       instead of clearing it, or copied if content is to be kept, since caller is about
+       to write to it.
      */
     if (m_format == format && m_bflags == bflags && m_height == height && m_width == width)
     {
-        if (m_buf && (tmp_flags & EBITMAP_KEEP_CONTENT) == 0) {
-            os_memclear(m_buf, m_buf_sz);
-            clear_compress();
+        if (tmp_flags & EBITMAP_KEEP_CONTENT) {
+            if (unshare_buf() == ESTATUS_SUCCESS) return;
+            release_buf();
+        }
+        else if (m_pool_buf == OS_NULL) {
+            if (m_buf) {
+                os_memclear(m_buf, m_buf_sz);
+                clear_compress();
+            }
+            return;
+        }
+        else {
+            release_buf();
         }
-        return;
     }
 
     pixel_nbytes = OSAL_BITMAP_BYTES_PER_PIX(format);
@@ -713,11 +733,7 @@ void eBitmap::resize(
 void eBitmap::clear()
 {
     clear_compress();
-    if (m_buf) {
-        os_free(m_buf, m_buf_alloc_sz);
-        m_buf = OS_NULL;
-        m_buf_alloc_sz = 0;
-    }
+    release_buf();
     m_width = m_height = 0;
     m_pixel_nbytes = 0;
     m_row_nbytes = 0;
@@ -731,11 +747,33 @@ void eBitmap::clear()
 
   @brief Get pointer to uncompressed bitmap.
 
-  If there is compressed bitmap, but not uncompressed one, it is decompressed.
+  If there is compressed bitmap, but not uncompressed one, it is decompressed. Caller may
+  modify the data, so pooled frame buffer shared with clones is copied first.
 
 ****************************************************************************************************
 */
 os_uchar *eBitmap::ptr()
+{
+    if (m_pool_buf) {
+        return unshare_buf() == ESTATUS_SUCCESS ? m_buf : OS_NULL;
+    }
+    if (m_buf) return m_buf;
+    uncompress();
+    return m_buf;
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Get pointer to uncompressed bitmap for reading.
+
+  Like ptr(), but for internal functions which only read pixel data, like scale() and crop().
+  Pooled frame buffer is used as is, even if shared with clones.
+
+****************************************************************************************************
+*/
+const os_uchar *eBitmap::readptr()
 {
     if (m_buf) return m_buf;
     uncompress();
@@ -876,12 +914,108 @@ void eBitmap::set_jpeg_data(
 
     os_memcpy(m_jpeg, data, data_sz);
     m_jpeg_sz = data_sz;
+    release_buf();
+}
 
-    if (m_buf) {
+
+/**
+****************************************************************************************************
+
+  @brief Use pooled frame buffer as bitmap data.
+
+  The eBitmap::adopt_pool_buf function sets bitmap to use data in pooled buffer without
+  copying it, for example camera frame received directly into the buffer. Call allocate()
+  with EBITMAP_NO_NEW_MEMORY_ALLOCATION flag first to set format and size. Rows must be
+  aligned as eBitmap::row_nbytes() expects.
+
+  The pooled buffer is shared by clones of this bitmap and it is recycled when the last
+  bitmap referring to it is deleted. ptr() and resize() with EBITMAP_KEEP_CONTENT copy
+  the data to bitmap's own buffer while it is shared, so writes never reach the clones.
+
+  @param   pool_buf Pooled buffer, the bitmap takes over caller's reference to it.
+  @param   offset Position of pixel data within the pooled buffer, bytes.
+
+****************************************************************************************************
+*/
+void eBitmap::adopt_pool_buf(
+    eBitmapPoolBuf *pool_buf,
+    os_memsz offset)
+{
+    clear_compress();
+    release_buf();
+    osal_debug_assert(offset + m_buf_sz <= pool_buf->alloc_sz);
+    m_pool_buf = pool_buf;
+    m_buf = pool_buf->buf + offset;
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Free or release uncompressed bitmap buffer.
+
+  If the buffer was allocated by this bitmap, it is freed. If it is pooled frame buffer,
+  reference to it is released.
+
+****************************************************************************************************
+*/
+void eBitmap::release_buf()
+{
+    if (m_pool_buf) {
+        eBitmapPool::detach(m_pool_buf);
+        m_pool_buf = OS_NULL;
+    }
+    else if (m_buf) {
         os_free(m_buf, m_buf_alloc_sz);
-        m_buf = OS_NULL;
-        m_buf_alloc_sz = 0;
     }
+    m_buf = OS_NULL;
+    m_buf_alloc_sz = 0;
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Make private copy of shared pooled frame buffer.
+
+  The eBitmap::unshare_buf function is called before pixel data may be modified. If the bitmap
+  uses pooled frame buffer which is also referred by clones, the data is copied to a buffer
+  allocated by this bitmap and reference to the pooled buffer is released. Pooled buffer not
+  shared with anyone is used as is.
+
+  @return  ESTATUS_SUCCESS if bitmap data can be modified. ESTATUS_FAILED if memory
+           allocation failed, bitmap still uses the shared buffer.
+
+****************************************************************************************************
+*/
+eStatus eBitmap::unshare_buf()
+{
+    os_uchar *buf;
+    os_memsz alloc_sz;
+    os_boolean shared;
+
+    if (m_pool_buf == OS_NULL) {
+        return ESTATUS_SUCCESS;
+    }
+
+    os_lock();
+    shared = (os_boolean)(m_pool_buf->nrefs > 1);
+    os_unlock();
+    if (!shared) {
+        return ESTATUS_SUCCESS;
+    }
+
+    buf = (os_uchar*)os_malloc(m_buf_sz, &alloc_sz);
+    if (buf == OS_NULL) {
+        return ESTATUS_FAILED;
+    }
+    os_memcpy(buf, m_buf, m_buf_sz);
+
+    eBitmapPool::detach(m_pool_buf);
+    m_pool_buf = OS_NULL;
+    m_buf = buf;
+    m_buf_alloc_sz = alloc_sz;
+    return ESTATUS_SUCCESS;
 }
 
 
@@ -66,6 +66,13 @@ eBitmapCompression;
 #define EBITMAP_NO_NEW_MEMORY_ALLOCATION 2
 #define EBITMAP_TMP_FLAGS_MASK (EBITMAP_KEEP_CONTENT|EBITMAP_NO_NEW_MEMORY_ALLOCATION)
 
+/* eBitmap::scale argument sflags: Default selects box filter to shrink and bilinear
+   interpolation to enlarge.
+ */
+#define EBITMAP_SCALE_DEFAULT 0
+#define EBITMAP_SCALE_BOX 1
+#define EBITMAP_SCALE_BILINEAR 2
+
 /**
 ****************************************************************************************************
   Bitmap class.
@@ -241,6 +248,52 @@ public:
      */
     eStatus uncompress();
 
+    /* Use pooled frame buffer as bitmap data without copying. Pixel data is shared by
+       clones, ptr() and resize() make a private copy before it can be modified.
+     */
+    void adopt_pool_buf(
+        eBitmapPoolBuf *pool_buf,
+        os_memsz offset);
+
+
+    /**
+    ************************************************************************************************
+
+      @name Scaling and region of interest, ebitmap_scale.cpp.
+
+    ************************************************************************************************
+    */
+    /* Scale bitmap to given size, result is stored in dst.
+     */
+    eStatus scale(
+        eBitmap *dst,
+        os_int width,
+        os_int height,
+        os_int sflags = EBITMAP_SCALE_DEFAULT);
+
+    /* Scale bitmap to fit within max_width x max_height, keeping the aspect ratio.
+     */
+    eStatus scale_to_fit(
+        eBitmap *dst,
+        os_int max_width,
+        os_int max_height,
+        os_int sflags = EBITMAP_SCALE_DEFAULT);
+
+    /* Generate multi-resolution pyramid, each level half size of the previous one.
+     */
+    os_int pyramid(
+        eContainer *levels,
+        os_int min_size);
+
+    /* Copy rectangle of this bitmap into dst.
+     */
+    eStatus crop(
+        eBitmap *dst,
+        os_int x,
+        os_int y,
+        os_int width,
+        os_int height);
+
 
 protected:
     /**
@@ -257,6 +310,18 @@ protected:
         os_int height,
         os_short bflags);
 
+    /* Free or release uncompressed bitmap buffer.
+     */
+    void release_buf();
+
+    /* Copy pooled frame buffer shared with clones into buffer of this bitmap's own.
+     */
+    eStatus unshare_buf();
+
+    /* Get pointer to uncompressed bitmap for reading, shared data is not copied.
+     */
+    const os_uchar *readptr();
+
     /* Collect information about this bitmap for tree browser, etc.
      */
     virtual void object_info(
@@ -329,6 +394,11 @@ protected:
      */
     os_memsz m_buf_sz;
 
+    /** Pooled frame buffer, if m_buf points into one. OS_NULL if m_buf is allocated
+        by this bitmap.
+     */
+    eBitmapPoolBuf *m_pool_buf;
+
     /** JPEG compressed image, OS_NULL if none.
      */
     os_uchar *m_jpeg;
@@ -0,0 +1,269 @@
+/**
+
+  @file    ebitmap_pool.cpp
+  @brief   Pool of recycled bitmap frame buffers.
+  @author  Pekka Lehtikoski
+  @version 1.0
+  @date    18.10.2026
+
+  Camera and similar sources produce a stream of same size frames. Instead of allocating new
+  memory for each frame and copying pixel data, the frame buffers are taken from a pool and
+  returned to it once the last eBitmap referring to the buffer is deleted.
+
+  Reference counts and free list are protected by os_lock(), since bitmap clones sharing a
+  buffer may be deleted by different threads.
+
+  Copyright 2020 Pekka Lehtikoski. This file is part of the eobjects project and shall only be used,
+  modified, and distributed under the terms of the project licensing. By continuing to use, modify,
+  or distribute this file you indicate that you have read the license and understand and accept
+  it fully.
+
+****************************************************************************************************
+*/
+#include "eobjects.h"
+
+
+/**
+****************************************************************************************************
+  Constructor.
+****************************************************************************************************
+*/
+eBitmapPool::eBitmapPool(
+    os_int max_free)
+{
+    m_free = OS_NULL;
+    m_nfree = 0;
+    m_max_free = max_free;
+    m_nused = 0;
+    m_released = OS_FALSE;
+}
+
+
+/**
+****************************************************************************************************
+  Destructor, frees buffers in free list.
+****************************************************************************************************
+*/
+eBitmapPool::~eBitmapPool()
+{
+    eBitmapPoolBuf *pb;
+
+    while ((pb = m_free)) {
+        m_free = pb->next;
+        os_free(pb->buf, pb->alloc_sz);
+        os_free(pb, sizeof(eBitmapPoolBuf));
+    }
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Release the pool.
+
+  The eBitmapPool::release function is called by pool owner when it no longer needs the pool.
+  The pool and it's free buffers are deleted when the last buffer in use is released.
+  Buffers released after this are not recycled.
+
+****************************************************************************************************
+*/
+void eBitmapPool::release()
+{
+    os_lock();
+    m_released = OS_TRUE;
+    m_max_free = 0;
+    delete_if_unused();
+    os_unlock();
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Get buffer from pool.
+
+  The eBitmapPool::alloc function returns a free buffer which is large enough, or allocates
+  a new one.
+
+  @param   sz Minimum buffer size in bytes.
+  @return  Pooled buffer with reference count 1, or OS_NULL if memory allocation failed.
+
+****************************************************************************************************
+*/
+eBitmapPoolBuf *eBitmapPool::alloc(
+    os_memsz sz)
+{
+    eBitmapPoolBuf *pb, *prev;
+    os_uchar *buf;
+    os_memsz alloc_sz;
+
+    os_lock();
+    prev = OS_NULL;
+    for (pb = m_free; pb; pb = pb->next) {
+        if (pb->alloc_sz >= sz) {
+            if (prev) prev->next = pb->next;
+            else m_free = pb->next;
+            m_nfree--;
+            m_nused++;
+            pb->nrefs = 1;
+            pb->next = OS_NULL;
+            os_unlock();
+            return pb;
+        }
+        prev = pb;
+    }
+    os_unlock();
+
+    buf = (os_uchar*)os_malloc(sz, &alloc_sz);
+    if (buf == OS_NULL) return OS_NULL;
+    pb = adopt(buf, alloc_sz);
+    if (pb == OS_NULL) os_free(buf, alloc_sz);
+    return pb;
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Adopt buffer into pool.
+
+  The eBitmapPool::adopt function takes ownership of buffer allocated by os_malloc(), so
+  that data received into the buffer can be used by eBitmap without copying. The buffer
+  will be recycled by the pool.
+
+  @param   buf Pointer to buffer.
+  @param   alloc_sz Allocated buffer size in bytes.
+  @return  Pooled buffer with reference count 1, or OS_NULL if memory allocation failed.
+           In this case the caller still owns buf.
+
+****************************************************************************************************
+*/
+eBitmapPoolBuf *eBitmapPool::adopt(
+    os_uchar *buf,
+    os_memsz alloc_sz)
+{
+    eBitmapPoolBuf *pb;
+
+    pb = (eBitmapPoolBuf*)os_malloc(sizeof(eBitmapPoolBuf), OS_NULL);
+    if (pb == OS_NULL) return OS_NULL;
+    pb->pool = this;
+    pb->buf = buf;
+    pb->alloc_sz = alloc_sz;
+    pb->nrefs = 1;
+    pb->next = OS_NULL;
+
+    os_lock();
+    m_nused++;
+    os_unlock();
+    return pb;
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Take a free buffer out of pool.
+
+  The eBitmapPool::take function is used to give a recycled buffer back to code which
+  receives data into buffers allocated by os_malloc(), like iocom brick buffer.
+
+  @param   alloc_sz Pointer where to store allocated size of the returned buffer.
+  @return  Pointer to buffer, caller becomes owner. OS_NULL if the pool has no free buffers.
+
+****************************************************************************************************
+*/
+os_uchar *eBitmapPool::take(
+    os_memsz *alloc_sz)
+{
+    eBitmapPoolBuf *pb;
+    os_uchar *buf;
+
+    os_lock();
+    pb = m_free;
+    if (pb == OS_NULL) {
+        os_unlock();
+        *alloc_sz = 0;
+        return OS_NULL;
+    }
+    m_free = pb->next;
+    m_nfree--;
+    os_unlock();
+
+    buf = pb->buf;
+    *alloc_sz = pb->alloc_sz;
+    os_free(pb, sizeof(eBitmapPoolBuf));
+    return buf;
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Add reference to pooled buffer.
+
+  Called when eBitmap is cloned, the clone shares the buffer.
+
+****************************************************************************************************
+*/
+void eBitmapPool::attach(
+    eBitmapPoolBuf *pb)
+{
+    os_lock();
+    pb->nrefs++;
+    os_unlock();
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Release reference to pooled buffer.
+
+  When the last reference is released, the buffer is moved to free list of the pool. If
+  the free list is full or the pool has been released, the buffer is freed.
+
+****************************************************************************************************
+*/
+void eBitmapPool::detach(
+    eBitmapPoolBuf *pb)
+{
+    eBitmapPool *pool;
+
+    os_lock();
+    if (--pb->nrefs > 0) {
+        os_unlock();
+        return;
+    }
+
+    pool = pb->pool;
+    pool->m_nused--;
+    if (pool->m_nfree < pool->m_max_free) {
+        pb->next = pool->m_free;
+        pool->m_free = pb;
+        pool->m_nfree++;
+    }
+    else {
+        os_free(pb->buf, pb->alloc_sz);
+        os_free(pb, sizeof(eBitmapPoolBuf));
+    }
+    pool->delete_if_unused();
+    os_unlock();
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Delete the pool if it is no longer needed.
+
+  The pool is deleted once the owner has released it and no buffers are in use.
+  Lock must be on.
+
+****************************************************************************************************
+*/
+void eBitmapPool::delete_if_unused()
+{
+    if (m_released && m_nused == 0) {
+        delete this;
+    }
+}
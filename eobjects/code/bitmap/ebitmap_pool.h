@@ -0,0 +1,112 @@
+/**
+
+  @file    ebitmap_pool.h
+  @brief   Pool of recycled bitmap frame buffers.
+  @author  Pekka Lehtikoski
+  @version 1.0
+  @date    18.10.2026
+
+  Copyright 2020 Pekka Lehtikoski. This file is part of the eobjects project and shall only be used,
+  modified, and distributed under the terms of the project licensing. By continuing to use, modify,
+  or distribute this file you indicate that you have read the license and understand and accept
+  it fully.
+
+****************************************************************************************************
+*/
+#pragma once
+#ifndef EBITMAP_POOL_H_
+#define EBITMAP_POOL_H_
+#include "eobjects.h"
+
+class eBitmapPool;
+
+/* Default maximum number of free buffers kept in pool.
+ */
+#define EBITMAP_POOL_DEFAULT_MAX_FREE 4
+
+/* Frame buffer allocated from pool. The buffer is shared by eBitmap and it's clones,
+   and returned to the pool when the last reference is released.
+ */
+typedef struct eBitmapPoolBuf
+{
+    eBitmapPool *pool;              /* Pool which owns the buffer. */
+    os_uchar *buf;                  /* Buffer allocated by os_malloc(). */
+    os_memsz alloc_sz;              /* Allocated buffer size in bytes. */
+    os_int nrefs;                   /* Number of references, 0 when in free list. */
+    struct eBitmapPoolBuf *next;    /* Next buffer in free list. */
+}
+eBitmapPoolBuf;
+
+
+/**
+****************************************************************************************************
+  eBitmapPool recycles large frame buffers, like camera images, to avoid allocating and
+  copying memory for every frame.
+****************************************************************************************************
+*/
+class eBitmapPool
+{
+public:
+    /* Constructor.
+     */
+    eBitmapPool(
+        os_int max_free = EBITMAP_POOL_DEFAULT_MAX_FREE);
+
+    /* Release pool. Pool is deleted when all buffers have been released.
+     */
+    void release();
+
+    /* Get buffer of at least sz bytes, reference count 1.
+     */
+    eBitmapPoolBuf *alloc(
+        os_memsz sz);
+
+    /* Adopt buffer allocated by os_malloc() into pool, reference count 1.
+     */
+    eBitmapPoolBuf *adopt(
+        os_uchar *buf,
+        os_memsz alloc_sz);
+
+    /* Take a free buffer out of pool, caller becomes owner of it.
+     */
+    os_uchar *take(
+        os_memsz *alloc_sz);
+
+    /* Add reference to pooled buffer.
+     */
+    static void attach(
+        eBitmapPoolBuf *pb);
+
+    /* Release reference to pooled buffer, recycle when no references are left.
+     */
+    static void detach(
+        eBitmapPoolBuf *pb);
+
+protected:
+    /* Destructor, use release() to delete the pool.
+     */
+    ~eBitmapPool();
+
+    /* Delete the pool if it is released and no buffers are in use. Lock must be on.
+     */
+    void delete_if_unused();
+
+    /** Free buffers, most recently released first.
+     */
+    eBitmapPoolBuf *m_free;
+
+    /** Number of buffers in free list, and maximum number to keep.
+     */
+    os_int m_nfree;
+    os_int m_max_free;
+
+    /** Number of buffers in use (reference count > 0).
+     */
+    os_int m_nused;
+
+    /** Set by release() when the pool owner no longer needs the pool.
+     */
+    os_boolean m_released;
+};
+
+#endif
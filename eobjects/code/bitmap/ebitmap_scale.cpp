@@ -0,0 +1,430 @@
+/**
+
+  @file    ebitmap_scale.cpp
+  @brief   Bitmap scaling and region of interest.
+  @author  Pekka Lehtikoski
+  @version 1.0
+  @date    18.10.2026
+
+  Thumbnails and previews of camera images are scaled on CPU, so that reduced resolution images
+  can be sent to remote viewers instead of full frames.
+
+  All bitmap formats are handled as rows of samples: 8 bit formats have one byte per color
+  channel (alpha and padding bytes are scaled as any other channel), OSAL_GRAYSCALE16 has one
+  16 bit sample per pixel. Source rows are loaded into os_uint arrays, so that the filter loops
+  are simple loops over arrays which the compiler can vectorize, and the same code serves all
+  formats.
+
+  Shrinking uses box filter: Each destination pixel is the average of source pixels it covers.
+  Enlarging uses bilinear interpolation with 8 bit fixed point weights.
+
+  Copyright 2020 Pekka Lehtikoski. This file is part of the eobjects project and shall only be used,
+  modified, and distributed under the terms of the project licensing. By continuing to use, modify,
+  or distribute this file you indicate that you have read the license and understand and accept
+  it fully.
+
+****************************************************************************************************
+*/
+#include "eobjects.h"
+
+/* Forward referred static functions.
+ */
+static void ebitmap_load_row(
+    const os_uchar *src,
+    os_uint *dst,
+    os_int n,
+    os_boolean is16);
+
+static void ebitmap_store_row(
+    const os_uint *src,
+    os_uchar *dst,
+    os_int n,
+    os_boolean is16);
+
+
+/**
+****************************************************************************************************
+
+  @brief Scale bitmap.
+
+  The eBitmap::scale() function scales this bitmap to given size and stores result in dst
+  bitmap. Format, time stamp, state bits and compression setting are copied, pixel size
+  in micrometers is scaled.
+
+  @param  dst Destination bitmap, must not be this bitmap.
+  @param  width Destination width in pixels.
+  @param  height Destination height in pixels.
+  @param  sflags Filter selection:
+          - EBITMAP_SCALE_DEFAULT (0): Box filter to shrink, bilinear to enlarge. Selected
+            separately for each direction.
+          - EBITMAP_SCALE_BOX: Box filter, nearest pixel when enlarging.
+          - EBITMAP_SCALE_BILINEAR: Bilinear interpolation.
+  @return ESTATUS_SUCCESS if all is fine. ESTATUS_FAILED if this bitmap is empty or
+          memory allocation failed.
+
+****************************************************************************************************
+*/
+eStatus eBitmap::scale(
+    eBitmap *dst,
+    os_int width,
+    os_int height,
+    os_int sflags)
+{
+    const os_uchar *src_buf;
+    os_uchar *drow;
+    os_uint *row, *out, v;
+    os_long *acc, div;
+    os_int *xpos, *xw;
+    os_int sw, sh, nch, sn, dn, dx, dy, c, i, x, y, y0, y1, iy, yf, w, n;
+    os_memsz sz;
+    os_boolean is16, box_x, box_y;
+
+    src_buf = readptr();
+    sw = m_width;
+    sh = m_height;
+    if (src_buf == OS_NULL || sw <= 0 || sh <= 0 || width <= 0 || height <= 0 || dst == this) {
+        return ESTATUS_FAILED;
+    }
+
+    dst->allocate(m_format, width, height, EBITMAP_KEEP_CONTENT);
+    if (dst->m_buf == OS_NULL) return ESTATUS_FAILED;
+    dst->m_timestamp = m_timestamp;
+    dst->m_state_bits = m_state_bits;
+    dst->m_compression = m_compression;
+    if (m_pixel_width_um != 0.0 || m_pixel_height_um != 0.0) {
+        dst->setpropertyd(EBITMAPP_PIXEL_WIDTH_UM, m_pixel_width_um * sw / width);
+        dst->setpropertyd(EBITMAPP_PIXEL_HEIGHT_UM, m_pixel_height_um * sh / height);
+    }
+
+    is16 = (os_boolean)(m_format == OSAL_GRAYSCALE16);
+    nch = is16 ? 1 : m_pixel_nbytes;
+    sn = sw * nch;
+    dn = width * nch;
+
+    box_x = (os_boolean)((sflags & EBITMAP_SCALE_BOX) ||
+        ((sflags & EBITMAP_SCALE_BILINEAR) == 0 && width <= sw));
+    box_y = (os_boolean)((sflags & EBITMAP_SCALE_BOX) ||
+        ((sflags & EBITMAP_SCALE_BILINEAR) == 0 && height <= sh));
+
+    /* Work arrays: Accumulator, loaded source row, horizontally filtered row, and
+       horizontal position and weight for each destination pixel.
+     */
+    sz = (os_memsz)dn * sizeof(os_long) + (os_memsz)(sn + dn) * sizeof(os_uint)
+        + 2 * (os_memsz)width * sizeof(os_int);
+    acc = (os_long*)os_malloc(sz, &sz);
+    if (acc == OS_NULL) return ESTATUS_FAILED;
+    row = (os_uint*)(acc + dn);
+    out = row + sn;
+    xpos = (os_int*)(out + dn);
+    xw = xpos + width;
+
+    /* Horizontal positions. Box: First source pixel and number of pixels. Bilinear: Left
+       source pixel and 8 bit weight of the right one.
+     */
+    for (dx = 0; dx < width; dx++) {
+        if (box_x) {
+            xpos[dx] = (os_int)((os_long)dx * sw / width);
+            n = (os_int)((os_long)(dx + 1) * sw / width) - xpos[dx];
+            xw[dx] = n > 0 ? n : 1;
+        }
+        else {
+            x = (os_int)(((2 * (os_long)dx + 1) * sw * 256) / (2 * (os_long)width)) - 128;
+            if (x < 0) x = 0;
+            xpos[dx] = x >> 8;
+            xw[dx] = x & 255;
+            if (xpos[dx] >= sw - 1) {
+                xpos[dx] = sw - 1;
+                xw[dx] = 0;
+            }
+        }
+    }
+
+    drow = dst->m_buf;
+    for (dy = 0; dy < height; dy++)
+    {
+        /* Source rows for this destination row: Box filter averages rows [y0, y1),
+           bilinear interpolates between rows y0 and y0 + 1.
+         */
+        if (box_y) {
+            y0 = (os_int)((os_long)dy * sh / height);
+            y1 = (os_int)((os_long)(dy + 1) * sh / height);
+            if (y1 <= y0) y1 = y0 + 1;
+            yf = 0;
+        }
+        else {
+            y = (os_int)(((2 * (os_long)dy + 1) * sh * 256) / (2 * (os_long)height)) - 128;
+            if (y < 0) y = 0;
+            y0 = y >> 8;
+            yf = y & 255;
+            if (y0 >= sh - 1) {
+                y0 = sh - 1;
+                yf = 0;
+            }
+            y1 = y0 + 2;
+        }
+
+        os_memclear(acc, dn * sizeof(os_long));
+        for (iy = y0; iy < y1; iy++)
+        {
+            w = box_y ? 1 : (iy == y0 ? 256 - yf : yf);
+            if (w == 0) continue;
+            ebitmap_load_row(src_buf + (os_memsz)iy * m_row_nbytes, row, sn, is16);
+
+            /* Horizontal pass.
+             */
+            if (box_x) {
+                for (dx = 0; dx < width; dx++) {
+                    i = xpos[dx] * nch;
+                    n = xw[dx];
+                    for (c = 0; c < nch; c++) {
+                        v = 0;
+                        for (x = 0; x < n; x++) {
+                            v += row[i + x * nch + c];
+                        }
+                        out[dx * nch + c] = v;
+                    }
+                }
+            }
+            else {
+                for (dx = 0; dx < width; dx++) {
+                    i = xpos[dx] * nch;
+                    n = xw[dx] ? nch : 0;
+                    for (c = 0; c < nch; c++) {
+                        out[dx * nch + c] = (row[i + c] * (256 - xw[dx])
+                            + row[i + n + c] * xw[dx] + 128) >> 8;
+                    }
+                }
+            }
+
+            for (i = 0; i < dn; i++) {
+                acc[i] += (os_long)out[i] * w;
+            }
+        }
+
+        /* Divide accumulated sums and store destination row.
+         */
+        for (dx = 0; dx < width; dx++) {
+            div = box_y ? y1 - y0 : 256;
+            if (box_x) div *= xw[dx];
+            for (c = 0; c < nch; c++) {
+                i = dx * nch + c;
+                out[i] = (os_uint)((acc[i] + div / 2) / div);
+            }
+        }
+        ebitmap_store_row(out, drow, dn, is16);
+        drow += dst->m_row_nbytes;
+    }
+
+    os_free(acc, sz);
+    return ESTATUS_SUCCESS;
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Scale bitmap to fit within given size.
+
+  The eBitmap::scale_to_fit() function scales the bitmap so that it fits within max_width
+  and max_height, keeping the aspect ratio. Bitmap which already fits is copied as is.
+
+  @param  dst Destination bitmap.
+  @param  max_width Maximum width in pixels, 0 = no limit.
+  @param  max_height Maximum height in pixels, 0 = no limit.
+  @param  sflags Filter selection, see eBitmap::scale().
+  @return ESTATUS_SUCCESS if all is fine, other values indicate an error.
+
+****************************************************************************************************
+*/
+eStatus eBitmap::scale_to_fit(
+    eBitmap *dst,
+    os_int max_width,
+    os_int max_height,
+    os_int sflags)
+{
+    os_int w, h;
+
+    w = width();
+    h = height();
+    if (w <= 0 || h <= 0) return ESTATUS_FAILED;
+
+    if (max_width > 0 && w > max_width) {
+        h = (os_int)(((os_long)h * max_width + w / 2) / w);
+        w = max_width;
+    }
+    if (max_height > 0 && h > max_height) {
+        w = (os_int)(((os_long)w * max_height + h / 2) / h);
+        h = max_height;
+    }
+    if (w < 1) w = 1;
+    if (h < 1) h = 1;
+
+    return scale(dst, w, h, sflags);
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Generate multi-resolution pyramid.
+
+  The eBitmap::pyramid() function generates reduced resolution versions of this bitmap. Each
+  level is half width and height of the previous one, and is generated from the previous
+  level by box filter, so the cost of whole pyramid is about third of scaling the full bitmap
+  once. Levels are added as eBitmap children of levels container, largest first.
+
+  @param  levels Container into which to add the levels.
+  @param  min_size Stop when longer side of the next level would be smaller than this,
+          pixels.
+  @return Number of levels generated.
+
+****************************************************************************************************
+*/
+os_int eBitmap::pyramid(
+    eContainer *levels,
+    os_int min_size)
+{
+    eBitmap *src, *level;
+    os_int w, h, nlevels;
+
+    if (min_size < 1) min_size = 1;
+    src = this;
+    nlevels = 0;
+    while (OS_TRUE)
+    {
+        w = src->m_width / 2;
+        h = src->m_height / 2;
+        if (w < 1 || h < 1 || (w > h ? w : h) < min_size) break;
+
+        level = new eBitmap(levels);
+        if (src->scale(level, w, h, EBITMAP_SCALE_BOX)) {
+            delete level;
+            break;
+        }
+        src = level;
+        nlevels++;
+    }
+    return nlevels;
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Copy region of interest into an another bitmap.
+
+  The eBitmap::crop() function copies rectangle of this bitmap into dst bitmap. The rectangle
+  is clipped to this bitmap.
+
+  @param  dst Destination bitmap, must not be this bitmap.
+  @param  x Left edge of region, pixels.
+  @param  y Top edge of region, pixels.
+  @param  width Region width in pixels.
+  @param  height Region height in pixels.
+  @return ESTATUS_SUCCESS if all is fine. ESTATUS_FAILED if the region is empty after
+          clipping, or memory allocation failed.
+
+****************************************************************************************************
+*/
+eStatus eBitmap::crop(
+    eBitmap *dst,
+    os_int x,
+    os_int y,
+    os_int width,
+    os_int height)
+{
+    const os_uchar *src;
+    os_uchar *d;
+    os_int row_bytes;
+
+    src = readptr();
+    if (src == OS_NULL || dst == this) return ESTATUS_FAILED;
+
+    if (x < 0) { width += x; x = 0; }
+    if (y < 0) { height += y; y = 0; }
+    if (x + width > m_width) width = m_width - x;
+    if (y + height > m_height) height = m_height - y;
+    if (width <= 0 || height <= 0) return ESTATUS_FAILED;
+
+    dst->allocate(m_format, width, height, EBITMAP_KEEP_CONTENT);
+    d = dst->m_buf;
+    if (d == OS_NULL) return ESTATUS_FAILED;
+    dst->m_timestamp = m_timestamp;
+    dst->m_state_bits = m_state_bits;
+    dst->m_compression = m_compression;
+    if (m_pixel_width_um != 0.0 || m_pixel_height_um != 0.0) {
+        dst->setpropertyd(EBITMAPP_PIXEL_WIDTH_UM, m_pixel_width_um);
+        dst->setpropertyd(EBITMAPP_PIXEL_HEIGHT_UM, m_pixel_height_um);
+    }
+
+    src += (os_memsz)y * m_row_nbytes + (os_memsz)x * m_pixel_nbytes;
+    row_bytes = width * m_pixel_nbytes;
+    while (height--) {
+        os_memcpy(d, src, row_bytes);
+        d += dst->m_row_nbytes;
+        src += m_row_nbytes;
+    }
+    return ESTATUS_SUCCESS;
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Load row of samples into os_uint array.
+
+  @param  src Pointer to first sample.
+  @param  dst Array where to store samples.
+  @param  n Number of samples.
+  @param  is16 OS_TRUE for 16 bit samples, OS_FALSE for 8 bit.
+
+****************************************************************************************************
+*/
+static void ebitmap_load_row(
+    const os_uchar *src,
+    os_uint *dst,
+    os_int n,
+    os_boolean is16)
+{
+    const os_ushort *src16;
+    os_int i;
+
+    if (is16) {
+        src16 = (const os_ushort*)src;
+        for (i = 0; i < n; i++) dst[i] = src16[i];
+    }
+    else {
+        for (i = 0; i < n; i++) dst[i] = src[i];
+    }
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Store os_uint array as row of samples.
+
+  @param  src Array of samples.
+  @param  dst Pointer to first sample in bitmap.
+  @param  n Number of samples.
+  @param  is16 OS_TRUE for 16 bit samples, OS_FALSE for 8 bit.
+
+****************************************************************************************************
+*/
+static void ebitmap_store_row(
+    const os_uint *src,
+    os_uchar *dst,
+    os_int n,
+    os_boolean is16)
+{
+    os_ushort *dst16;
+    os_int i;
+
+    if (is16) {
+        dst16 = (os_ushort*)dst;
+        for (i = 0; i < n; i++) dst16[i] = (os_ushort)src[i];
+    }
+    else {
+        for (i = 0; i < n; i++) dst[i] = (os_uchar)src[i];
+    }
+}
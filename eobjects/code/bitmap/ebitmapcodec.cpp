@@ -0,0 +1,671 @@
+/**
+
+  @file    ebitmapcodec.cpp
+  @brief   JPEG compression and decompression of bitmaps in worker threads.
+  @author  Pekka Lehtikoski
+  @version 1.0
+  @date    18.10.2026
+
+  Compressing or decompressing a full camera frame takes long enough to stall the thread doing
+  it. The eBitmapCodec service thread, typically named "//codec", takes bitmaps with
+  ECMD_BITMAP_COMPRESS or ECMD_BITMAP_UNCOMPRESS message and passes them to a pool of
+  eBitmapCodecWorker threads. The processed bitmap is sent back to the requester with
+  ECMD_BITMAP_CODEC_REPLY. Reply content is eContainer holding the bitmap (EOID_CONTENT),
+  the request command (EOID_FLAGS) and latency from queueing to reply in microseconds
+  (EOID_PARAMETER). The context of the request is returned as context of the reply.
+
+  A bitmap which has been compressed by the codec is serialized without compressing it again,
+  so connection threads do not stall either.
+
+  Copyright 2020 Pekka Lehtikoski. This file is part of the eobjects project and shall only be used,
+  modified, and distributed under the terms of the project licensing. By continuing to use, modify,
+  or distribute this file you indicate that you have read the license and understand and accept
+  it fully.
+
+****************************************************************************************************
+*/
+#include "eobjects.h"
+
+/* Bitmap codec property names.
+ */
+const os_char
+    ebcodecp_pool_size[] = "poolsize",
+    ebcodecp_max_queue[] = "maxqueue",
+    ebcodecp_nqueued[] = "nqueued",
+    ebcodecp_nframes[] = "nframes",
+    ebcodecp_ndropped[] = "ndropped",
+    ebcodecp_latency[] = "latency",
+    ebcodecp_max_latency[] = "maxlatency",
+    ebcodecp_codec_time[] = "codectime";
+
+
+/**
+****************************************************************************************************
+  Constructor.
+****************************************************************************************************
+*/
+eBitmapCodec::eBitmapCodec(
+    eObject *parent,
+    e_oid id,
+    os_int flags)
+    : eThread(parent, id, flags)
+{
+    m_pool_size = EBITMAP_CODEC_DEFAULT_POOL_SIZE;
+    m_pool_started = 0;
+    m_queue = new eContainer(this);
+    m_max_queue = EBITMAP_CODEC_DEFAULT_MAX_QUEUE;
+    m_nqueued = 0;
+    m_nframes = m_ndropped = 0;
+    m_latency_sum = m_max_latency = m_codec_time_sum = 0;
+    initproperties();
+}
+
+
+/**
+****************************************************************************************************
+  Virtual destructor.
+****************************************************************************************************
+*/
+eBitmapCodec::~eBitmapCodec()
+{
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Add eBitmapCodec to class list and class'es properties to it's property set.
+
+  The eBitmapCodec::setupclass function adds eBitmapCodec to class list and class'es
+  properties to it's property set. The class list enables creating new objects dynamically
+  by class identifier, which is used for serialization reader functions. The property set
+  stores static list of class'es properties and metadata for those.
+
+****************************************************************************************************
+*/
+void eBitmapCodec::setupclass()
+{
+    const os_int cls = ECLASSID_BITMAP_CODEC;
+    eVariable *p;
+
+    /* Synchronize, add the class to class list and properties to property set.
+     */
+    os_lock();
+    eclasslist_add(cls, (eNewObjFunc)newobj, "eBitmapCodec", ECLASSID_THREAD);
+    addpropertyl(cls, EBCODECP_POOL_SIZE, ebcodecp_pool_size, EBITMAP_CODEC_DEFAULT_POOL_SIZE,
+        "worker threads", EPRO_SIMPLE);
+    addpropertyl(cls, EBCODECP_MAX_QUEUE, ebcodecp_max_queue, EBITMAP_CODEC_DEFAULT_MAX_QUEUE,
+        "max queued bitmaps", EPRO_SIMPLE);
+    addpropertyl(cls, EBCODECP_NQUEUED, ebcodecp_nqueued, "bitmaps queued",
+        EPRO_SIMPLE|EPRO_RDONLY);
+    addpropertyl(cls, EBCODECP_NFRAMES, ebcodecp_nframes, "bitmaps processed",
+        EPRO_SIMPLE|EPRO_RDONLY);
+    addpropertyl(cls, EBCODECP_NDROPPED, ebcodecp_ndropped, "bitmaps dropped",
+        EPRO_SIMPLE|EPRO_RDONLY);
+    p = addpropertyl(cls, EBCODECP_LATENCY, ebcodecp_latency, "average latency",
+        EPRO_SIMPLE|EPRO_RDONLY);
+    p->setpropertys(EVARP_UNIT, "us");
+    p = addpropertyl(cls, EBCODECP_MAX_LATENCY, ebcodecp_max_latency, "max latency",
+        EPRO_SIMPLE|EPRO_RDONLY);
+    p->setpropertys(EVARP_UNIT, "us");
+    p = addpropertyl(cls, EBCODECP_CODEC_TIME, ebcodecp_codec_time, "average codec time",
+        EPRO_SIMPLE|EPRO_RDONLY);
+    p->setpropertys(EVARP_UNIT, "us");
+    propertysetdone(cls);
+    os_unlock();
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Codec thread main loop.
+
+  The eBitmapCodec::run() function processes messages until thread is requested to exit.
+  Then worker threads are stopped.
+
+****************************************************************************************************
+*/
+void eBitmapCodec::run()
+{
+    eThread::run();
+    stop_pool();
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Process incoming messages.
+
+  The eBitmapCodec::onmessage function handles compress and uncompress requests, and
+  ECMD_BITMAP_CODEC_DONE messages from workers. Other messages are passed to eThread
+  base class.
+
+  @param   envelope Message envelope. Contains command, target and source paths and
+           message content, etc.
+  @return  None.
+
+****************************************************************************************************
+*/
+void eBitmapCodec::onmessage(
+    eEnvelope *envelope)
+{
+    if (*envelope->target() == '\0')
+    {
+        switch (envelope->command())
+        {
+            case ECMD_BITMAP_COMPRESS:
+            case ECMD_BITMAP_UNCOMPRESS:
+                queue_bitmap(envelope);
+                return;
+
+            case ECMD_BITMAP_CODEC_DONE:
+                job_done(envelope);
+                return;
+        }
+    }
+
+    eThread::onmessage(envelope);
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Called to inform the class about property value change (override).
+
+  The onpropertychange() function is called when class'es property changes, unless the
+  property is flagged with EPRO_NOONPRCH.
+
+  @param   propertynr Property number of changed property.
+  @param   x Variable containing the new value.
+  @param   flags
+  @return  If successfull, the function returns ESTATUS_SUCCESS (0). Nonzero return values do
+           indicate that there was no property with given property number.
+
+****************************************************************************************************
+*/
+eStatus eBitmapCodec::onpropertychange(
+    os_int propertynr,
+    eVariable *x,
+    os_int flags)
+{
+    switch (propertynr)
+    {
+        case EBCODECP_POOL_SIZE: /* Effective only until first bitmap is queued */
+            m_pool_size = x->geti();
+            if (m_pool_size < 0) m_pool_size = 0;
+            if (m_pool_size > EBITMAP_CODEC_MAX_POOL_SIZE) {
+                m_pool_size = EBITMAP_CODEC_MAX_POOL_SIZE;
+            }
+            break;
+
+        case EBCODECP_MAX_QUEUE:
+            m_max_queue = x->geti();
+            if (m_max_queue < 0) m_max_queue = 0;
+            break;
+
+        default:
+            return eThread::onpropertychange(propertynr, x, flags);
+    }
+
+    return ESTATUS_SUCCESS;
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Get value of simple property (override).
+
+  The simpleproperty() function stores current value of simple property into variable x.
+
+  @param   propertynr Property number to get.
+  @param   x Variable into which to store the property value.
+  @return  If property with property number was stored in x, the function returns
+           ESTATUS_SUCCESS (0). Nonzero return values indicate that property with
+           given number was not among simple properties.
+
+****************************************************************************************************
+*/
+eStatus eBitmapCodec::simpleproperty(
+    os_int propertynr,
+    eVariable *x)
+{
+    switch (propertynr)
+    {
+        case EBCODECP_POOL_SIZE:
+            x->setl(m_pool_size);
+            break;
+
+        case EBCODECP_MAX_QUEUE:
+            x->setl(m_max_queue);
+            break;
+
+        case EBCODECP_NQUEUED:
+            x->setl(m_nqueued);
+            break;
+
+        case EBCODECP_NFRAMES:
+            x->setl(m_nframes);
+            break;
+
+        case EBCODECP_NDROPPED:
+            x->setl(m_ndropped);
+            break;
+
+        case EBCODECP_LATENCY:
+            x->setl(m_nframes ? m_latency_sum / m_nframes : 0);
+            break;
+
+        case EBCODECP_MAX_LATENCY:
+            x->setl(m_max_latency);
+            break;
+
+        case EBCODECP_CODEC_TIME:
+            x->setl(m_nframes ? m_codec_time_sum / m_nframes : 0);
+            break;
+
+        default:
+            return eThread::simpleproperty(propertynr, x);
+    }
+    return ESTATUS_SUCCESS;
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Queue bitmap for codec worker.
+
+  The eBitmapCodec::queue_bitmap() function moves bitmap from request message to queue,
+  together with the request command, reply path, context and queueing time. If the queue
+  is longer than "maxqueue", the oldest waiting bitmaps are dropped without reply: For
+  live images it is better to skip frames than to fall behind.
+
+  If "poolsize" is zero, the bitmap is processed immediately within the codec thread.
+
+  @param envelope ECMD_BITMAP_COMPRESS or ECMD_BITMAP_UNCOMPRESS message. Content is adopted.
+
+****************************************************************************************************
+*/
+void eBitmapCodec::queue_bitmap(
+    eEnvelope *envelope)
+{
+    eObject *bitmap, *job;
+    eVariable *v;
+    os_long latency, codec_us;
+
+    bitmap = envelope->content();
+    if (bitmap == OS_NULL) return;
+    if (bitmap->classid() != ECLASSID_BITMAP) {
+        osal_debug_error("eBitmapCodec: message content is not eBitmap");
+        return;
+    }
+
+    if (!m_pool_started && m_pool_size > 0) {
+        start_pool();
+    }
+
+    job = new eContainer(m_queue);
+    bitmap->adopt(job, EOID_CONTENT, EOBJ_NO_MAP);
+    v = new eVariable(job, EOID_FLAGS);
+    v->setl(envelope->command());
+    if ((envelope->mflags() & EMSG_NO_REPLIES) == 0) {
+        v = new eVariable(job, EOID_PATH);
+        v->sets(envelope->source());
+    }
+    if (envelope->context()) {
+        envelope->context()->clone(job, EOID_CONTEXT, EOBJ_NO_MAP);
+    }
+    v = new eVariable(job, EOID_PARAMETER);
+    v->setl(etime());
+
+    /* No worker threads, process now.
+     */
+    if (m_pool_started == 0) {
+        latency = eBitmapCodecWorker::process_job(job, this, &codec_us);
+        m_latency_sum += latency;
+        if (latency > m_max_latency) m_max_latency = latency;
+        m_codec_time_sum += codec_us;
+        m_nframes++;
+        delete job;
+        return;
+    }
+
+    if (++m_nqueued > m_max_queue && m_max_queue > 0) {
+        delete m_queue->first();
+        m_nqueued--;
+        m_ndropped++;
+    }
+
+    dispatch();
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Pass queued bitmaps to idle workers.
+
+  The eBitmapCodec::dispatch() function sends the oldest queued bitmaps to workers which
+  are not processing a bitmap. Only one bitmap at a time is given to a worker, so that
+  bitmaps waiting in queue can still be dropped if they become too old.
+
+****************************************************************************************************
+*/
+void eBitmapCodec::dispatch()
+{
+    eObject *job;
+    os_int nr;
+
+    for (nr = 0; nr < m_pool_started; nr++)
+    {
+        if (m_pool_busy[nr]) continue;
+        job = m_queue->first();
+        if (job == OS_NULL) return;
+
+        m_pool_busy[nr] = OS_TRUE;
+        m_nqueued--;
+        message(ECMD_BITMAP_CODEC_JOB, m_pool[nr]->uniquename(), OS_NULL, job,
+            EMSG_DEL_CONTENT);
+    }
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Worker has processed a bitmap.
+
+  The eBitmapCodec::job_done() function processes ECMD_BITMAP_CODEC_DONE from worker:
+  Updates latency statistics and passes next queued bitmap to the worker.
+
+  @param envelope ECMD_BITMAP_CODEC_DONE message. Content holds worker index
+         (EOID_PARAMETER), codec time (EOID_CONTENT) and latency from queueing to reply
+         (EOID_FLAGS), both in microseconds.
+
+****************************************************************************************************
+*/
+void eBitmapCodec::job_done(
+    eEnvelope *envelope)
+{
+    eObject *c;
+    eVariable *v;
+    os_long latency;
+    os_int nr;
+
+    c = envelope->content();
+    if (c == OS_NULL) return;
+    v = eVariable::cast(c->first(EOID_PARAMETER));
+    if (v == OS_NULL) return;
+    nr = v->geti();
+    if (nr < 0 || nr >= m_pool_started) return;
+
+    v = eVariable::cast(c->first(EOID_CONTENT));
+    if (v) {
+        m_codec_time_sum += v->getl();
+        m_nframes++;
+    }
+    v = eVariable::cast(c->first(EOID_FLAGS));
+    if (v) {
+        latency = v->getl();
+        m_latency_sum += latency;
+        if (latency > m_max_latency) m_max_latency = latency;
+    }
+
+    m_pool_busy[nr] = OS_FALSE;
+    dispatch();
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Start codec worker threads.
+
+  The eBitmapCodec::start_pool() function starts "poolsize" worker threads when the first
+  bitmap is queued.
+
+****************************************************************************************************
+*/
+void eBitmapCodec::start_pool()
+{
+    eBitmapCodecWorker *w;
+    os_int nr;
+
+    for (nr = 0; nr < m_pool_size; nr++)
+    {
+        m_pool[nr] = new eThreadHandle(this);
+        m_pool_busy[nr] = OS_FALSE;
+
+        w = new eBitmapCodecWorker();
+        w->set_worker_nr(nr);
+        w->start(m_pool[nr]); /* After this w pointer is useless */
+    }
+    m_pool_started = m_pool_size;
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Terminate codec worker threads.
+
+  The eBitmapCodec::stop_pool() function requests worker threads to exit and waits for them.
+  Bitmaps still waiting in queue are dropped.
+
+****************************************************************************************************
+*/
+void eBitmapCodec::stop_pool()
+{
+    eObject *job;
+    os_int nr;
+
+    for (nr = 0; nr < m_pool_started; nr++) {
+        m_pool[nr]->terminate();
+    }
+    for (nr = 0; nr < m_pool_started; nr++) {
+        m_pool[nr]->join();
+        delete m_pool[nr];
+    }
+
+    while ((job = m_queue->first())) {
+        delete job;
+    }
+
+    m_pool_started = 0;
+    m_nqueued = 0;
+}
+
+
+/**
+****************************************************************************************************
+  Worker constructor.
+****************************************************************************************************
+*/
+eBitmapCodecWorker::eBitmapCodecWorker(
+    eObject *parent,
+    e_oid id,
+    os_int flags)
+    : eThread(parent, id, flags)
+{
+    m_worker_nr = 0;
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Add eBitmapCodecWorker to class list.
+
+****************************************************************************************************
+*/
+void eBitmapCodecWorker::setupclass()
+{
+    const os_int cls = ECLASSID_BITMAP_CODEC_WORKER;
+
+    os_lock();
+    eclasslist_add(cls, (eNewObjFunc)OS_NULL, "eBitmapCodecWorker", ECLASSID_THREAD);
+    propertysetdone(cls);
+    os_unlock();
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Process incoming messages.
+
+  The eBitmapCodecWorker::onmessage function handles ECMD_BITMAP_CODEC_JOB messages from
+  codec thread. Other messages are passed to eThread base class.
+
+  @param   envelope Message envelope. Contains command, target and source paths and
+           message content, etc.
+  @return  None.
+
+****************************************************************************************************
+*/
+void eBitmapCodecWorker::onmessage(
+    eEnvelope *envelope)
+{
+    if (*envelope->target() == '\0' &&
+        envelope->command() == ECMD_BITMAP_CODEC_JOB)
+    {
+        codec_job(envelope);
+        return;
+    }
+
+    eThread::onmessage(envelope);
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Compress or uncompress bitmap and send it to requester.
+
+  The eBitmapCodecWorker::process_job() function compresses or uncompresses the bitmap in
+  job and sends it to requester with ECMD_BITMAP_CODEC_REPLY. The function doesn't use any
+  worker member, so it can be called by worker threads and codec thread.
+
+  @param   job Queued job: Bitmap (EOID_CONTENT), request command (EOID_FLAGS), reply path
+           (EOID_PATH), request context (EOID_CONTEXT) and queueing time (EOID_PARAMETER).
+           The bitmap is moved to reply.
+  @param   sender Object to send the reply from.
+  @param   codec_us Pointer where to store time taken by compression or decompression,
+           microseconds.
+  @return  Latency from queueing to reply, microseconds.
+
+****************************************************************************************************
+*/
+os_long eBitmapCodecWorker::process_job(
+    eObject *job,
+    eObject *sender,
+    os_long *codec_us)
+{
+    eBitmap *bitmap;
+    eObject *o;
+    eContainer *reply;
+    eVariable *command, *path, *queued, *v;
+    os_long start_us, end_us, latency;
+
+    o = job->first(EOID_CONTENT);
+    command = eVariable::cast(job->first(EOID_FLAGS));
+    path = eVariable::cast(job->first(EOID_PATH));
+    queued = eVariable::cast(job->first(EOID_PARAMETER));
+
+    start_us = etime();
+    if (o && command) {
+        bitmap = eBitmap::cast(o);
+        if (command->geti() == ECMD_BITMAP_COMPRESS) {
+            bitmap->compress();
+        }
+        else if (bitmap->uncompress()) {
+            osal_debug_error("eBitmapCodec: uncompress failed");
+        }
+    }
+    end_us = etime();
+    *codec_us = end_us - start_us;
+    latency = queued ? end_us - queued->getl() : *codec_us;
+
+    if (path && o)
+    {
+        reply = new eContainer(sender, EOID_TEMPORARY);
+        o->adopt(reply, EOID_CONTENT, EOBJ_NO_MAP);
+        v = new eVariable(reply, EOID_FLAGS);
+        v->setl(command ? command->getl() : 0);
+        v = new eVariable(reply, EOID_PARAMETER);
+        v->setl(latency);
+        sender->message(ECMD_BITMAP_CODEC_REPLY, path->gets(), OS_NULL, reply,
+            EMSG_DEL_CONTENT|EMSG_NO_REPLIES, job->first(EOID_CONTEXT));
+    }
+
+    return latency;
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Process job and report to codec thread.
+
+  The eBitmapCodecWorker::codec_job() function processes one ECMD_BITMAP_CODEC_JOB and
+  then sends ECMD_BITMAP_CODEC_DONE with worker index (EOID_PARAMETER), codec time
+  (EOID_CONTENT) and latency (EOID_FLAGS) to codec thread, so it can pass next bitmap.
+
+  @param   envelope ECMD_BITMAP_CODEC_JOB message from codec thread.
+  @return  None.
+
+****************************************************************************************************
+*/
+void eBitmapCodecWorker::codec_job(
+    eEnvelope *envelope)
+{
+    eObject *job;
+    eContainer *done;
+    eVariable *v;
+    os_long latency, codec_us;
+
+    latency = codec_us = 0;
+    job = envelope->content();
+    if (job) {
+        latency = process_job(job, this, &codec_us);
+    }
+
+    done = new eContainer(this, EOID_TEMPORARY);
+    v = new eVariable(done, EOID_PARAMETER);
+    v->setl(m_worker_nr);
+    v = new eVariable(done, EOID_CONTENT);
+    v->setl(codec_us);
+    v = new eVariable(done, EOID_FLAGS);
+    v->setl(latency);
+    message(ECMD_BITMAP_CODEC_DONE, envelope->source(), OS_NULL, done,
+        EMSG_DEL_CONTENT|EMSG_NO_REPLIES|EMSG_NO_ERRORS);
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Start bitmap codec service thread.
+
+  @param codec_name Name for the eBitmapCodec object, typically "//codec".
+  @param pool_size Number of worker threads, 0 to process bitmaps in codec thread.
+  @param codec_thread_handle Handle of thread running the codec is set here.
+
+****************************************************************************************************
+*/
+void ebitmap_start_codec(
+    const os_char *codec_name,
+    os_int pool_size,
+    eThreadHandle *codec_thread_handle)
+{
+    eBitmapCodec *codec;
+
+    codec = new eBitmapCodec();
+    codec->addname(codec_name);
+    codec->setpropertyl(EBCODECP_POOL_SIZE, pool_size);
+    codec->start(codec_thread_handle);
+}
@@ -0,0 +1,267 @@
+/**
+
+  @file    ebitmapcodec.h
+  @brief   JPEG compression and decompression of bitmaps in worker threads.
+  @author  Pekka Lehtikoski
+  @version 1.0
+  @date    18.10.2026
+
+  Copyright 2020 Pekka Lehtikoski. This file is part of the eobjects project and shall only be used,
+  modified, and distributed under the terms of the project licensing. By continuing to use, modify,
+  or distribute this file you indicate that you have read the license and understand and accept
+  it fully.
+
+****************************************************************************************************
+*/
+#pragma once
+#ifndef EBITMAPCODEC_H_
+#define EBITMAPCODEC_H_
+#include "eobjects.h"
+
+
+/**
+****************************************************************************************************
+  Defines
+****************************************************************************************************
+*/
+
+/* Bitmap codec property numbers.
+ */
+#define EBCODECP_POOL_SIZE 12
+#define EBCODECP_MAX_QUEUE 13
+#define EBCODECP_NQUEUED 14
+#define EBCODECP_NFRAMES 15
+#define EBCODECP_NDROPPED 16
+#define EBCODECP_LATENCY 17
+#define EBCODECP_MAX_LATENCY 18
+#define EBCODECP_CODEC_TIME 19
+
+/* Bitmap codec property names.
+ */
+extern const os_char
+    ebcodecp_pool_size[],
+    ebcodecp_max_queue[],
+    ebcodecp_nqueued[],
+    ebcodecp_nframes[],
+    ebcodecp_ndropped[],
+    ebcodecp_latency[],
+    ebcodecp_max_latency[],
+    ebcodecp_codec_time[];
+
+/* Maximum and default number of codec worker threads.
+ */
+#define EBITMAP_CODEC_MAX_POOL_SIZE 16
+#define EBITMAP_CODEC_DEFAULT_POOL_SIZE 2
+
+/* Default maximum number of bitmaps waiting in queue. When the queue is full, the oldest
+   waiting bitmap is dropped. 0 = no limit.
+ */
+#define EBITMAP_CODEC_DEFAULT_MAX_QUEUE 8
+
+
+/**
+****************************************************************************************************
+
+  @brief Bitmap codec service.
+
+  The eBitmapCodec thread receives ECMD_BITMAP_COMPRESS and ECMD_BITMAP_UNCOMPRESS messages
+  with eBitmap as content, and passes the bitmaps to a pool of eBitmapCodecWorker threads.
+  The worker replies to the original sender with ECMD_BITMAP_CODEC_REPLY.
+
+****************************************************************************************************
+*/
+class eBitmapCodec : public eThread
+{
+public:
+    /* Constructor.
+     */
+    eBitmapCodec(
+        eObject *parent = OS_NULL,
+        e_oid id = EOID_ITEM,
+        os_int flags = EOBJ_DEFAULT);
+
+    /* Virtual destructor.
+     */
+    virtual ~eBitmapCodec();
+
+    /* Casting eObject pointer to eBitmapCodec pointer.
+     */
+    inline static eBitmapCodec *cast(
+        eObject *o)
+    {
+        e_assert_type(o, ECLASSID_BITMAP_CODEC)
+        return (eBitmapCodec*)o;
+    }
+
+    /* Get class identifier.
+     */
+    virtual os_int classid() {return ECLASSID_BITMAP_CODEC; }
+
+    /* Static function to add class to propertysets and class list.
+     */
+    static void setupclass();
+
+    /* Static constructor function.
+    */
+    static eBitmapCodec *newobj(
+        eObject *parent,
+        e_oid id = EOID_ITEM,
+        os_int flags = EOBJ_DEFAULT)
+    {
+        return new eBitmapCodec(parent, id, flags);
+    }
+
+    /* Codec thread main loop.
+     */
+    virtual void run();
+
+    /* Function to process messages to this object.
+     */
+    virtual void onmessage(
+        eEnvelope *envelope);
+
+    /* Called when property value changes.
+     */
+    virtual eStatus onpropertychange(
+        os_int propertynr,
+        eVariable *x,
+        os_int flags);
+
+    /* Get value of simple property.
+     */
+    virtual eStatus simpleproperty(
+        os_int propertynr,
+        eVariable *x);
+
+protected:
+    /**
+    ************************************************************************************************
+      Protected member functions.
+    ************************************************************************************************
+    */
+
+    /* Queue bitmap for codec worker.
+     */
+    void queue_bitmap(
+        eEnvelope *envelope);
+
+    /* Pass queued bitmaps to idle workers.
+     */
+    void dispatch();
+
+    /* Worker has processed a bitmap.
+     */
+    void job_done(
+        eEnvelope *envelope);
+
+    /* Start and stop worker threads.
+     */
+    void start_pool();
+    void stop_pool();
+
+
+    /**
+    ************************************************************************************************
+      Member variables.
+    ************************************************************************************************
+    */
+
+    /** Number of worker threads to use, and number of threads started.
+     */
+    os_int m_pool_size;
+    os_int m_pool_started;
+
+    /** Worker thread handles.
+     */
+    eThreadHandle *m_pool[EBITMAP_CODEC_MAX_POOL_SIZE];
+
+    /** Worker is processing a bitmap.
+     */
+    os_boolean m_pool_busy[EBITMAP_CODEC_MAX_POOL_SIZE];
+
+    /** Bitmaps waiting for a worker, oldest first.
+     */
+    eContainer *m_queue;
+
+    /** Maximum and current number of bitmaps in queue.
+     */
+    os_int m_max_queue;
+    os_int m_nqueued;
+
+    /** Statistics: Bitmaps processed and dropped, sum and maximum of latency from queueing
+        to reply, and sum of codec time. Times in microseconds.
+     */
+    os_long m_nframes;
+    os_long m_ndropped;
+    os_long m_latency_sum;
+    os_long m_max_latency;
+    os_long m_codec_time_sum;
+};
+
+
+/**
+****************************************************************************************************
+
+  @brief Bitmap codec worker thread.
+
+  The eBitmapCodecWorker receives one ECMD_BITMAP_CODEC_JOB at a time from eBitmapCodec,
+  compresses or uncompresses the bitmap, sends it to requester and replies with
+  ECMD_BITMAP_CODEC_DONE.
+
+****************************************************************************************************
+*/
+class eBitmapCodecWorker : public eThread
+{
+public:
+    /* Constructor.
+     */
+    eBitmapCodecWorker(
+        eObject *parent = OS_NULL,
+        e_oid id = EOID_ITEM,
+        os_int flags = EOBJ_DEFAULT);
+
+    /* Get class identifier.
+     */
+    virtual os_int classid() {return ECLASSID_BITMAP_CODEC_WORKER; }
+
+    /* Static function to add class to propertysets and class list.
+     */
+    static void setupclass();
+
+    /* Function to process messages to this object.
+     */
+    virtual void onmessage(
+        eEnvelope *envelope);
+
+    /* Set worker index, reported back to codec with each processed bitmap.
+     */
+    inline void set_worker_nr(
+        os_int worker_nr)
+        {m_worker_nr = worker_nr; }
+
+    /* Compress or uncompress queued bitmap and send it to requester.
+     */
+    static os_long process_job(
+        eObject *job,
+        eObject *sender,
+        os_long *codec_us);
+
+protected:
+    /* Compress or uncompress bitmap and reply.
+     */
+    void codec_job(
+        eEnvelope *envelope);
+
+    /** Worker index within codec's pool.
+     */
+    os_int m_worker_nr;
+};
+
+/* Start bitmap codec service thread.
+ */
+void ebitmap_start_codec(
+    const os_char *codec_name,
+    os_int pool_size,
+    eThreadHandle *codec_thread_handle);
+
+#endif
@@ -33,7 +33,15 @@ const os_char
     econnp_ipaddr[] = "ipaddr",
     econnp_network_name[] = "netname",
     econnp_isopen[] = "isopen",
-    econnp_enable[] = "enable";
+    econnp_enable[] = "enable",
+    econnp_flush_delay[] = "flushdelay",
+    econnp_flush_bytes[] = "flushbytes",
+    econnp_envelopes_per_flush[] = "envperflush",
+    econnp_bytes_per_write[] = "bytesperwrite",
+    econnp_coalesced[] = "coalesced",
+    econnp_compression[] = "compression",
+    econnp_compression_ratio[] = "zratio",
+    econnp_compression_cpu[] = "zcpu";
 
 
 /**
@@ -57,6 +65,15 @@ eConnection::eConnection(
     m_network_name = new eVariable(this);
     m_stream = OS_NULL;
     m_initbuffer = new eContainer(this);
+    m_batch = new eContainer(this);
+    m_batch->ns_create();
+    m_batch_bytes = 0;
+    m_batch_start = 0;
+    m_flush_delay = ECONNECTION_DEFAULT_FLUSH_DELAY;
+    m_flush_bytes = ECONNECTION_DEFAULT_FLUSH_BYTES;
+    m_nenvelopes = 0;
+    m_nflushes = 0;
+    m_ncoalesced = 0;
     m_initialized = OS_FALSE;
     m_connected = OS_FALSE;
     m_connection_failed_once = OS_FALSE;
@@ -71,6 +88,11 @@ eConnection::eConnection(
     m_authentication_message_received = OS_FALSE;
     m_auth_send_buf = OS_NULL;
     m_auth_recv_buf = OS_NULL;
+    m_codec = ECONNECTION_DEFAULT_CODEC;
+    m_hello_sent = OS_FALSE;
+    m_hello_received = OS_FALSE;
+    m_pathdict = OS_NULL;
+    m_pathdict_out = OS_FALSE;
     m_client_bindings = new eContainer(this);
     m_client_bindings->ns_create();
     m_server_bindings = new eContainer(this);
@@ -134,6 +156,25 @@ void eConnection::setupclass()
     p = addpropertyb(cls, ECONNP_ISOPEN, econnp_isopen, OS_FALSE, "is open", EPRO_SIMPLE);
     p->setpropertys(EVARP_ATTR, "rdonly");
     addpropertyb(cls, ECONNP_ENABLE, econnp_enable, OS_TRUE, "enable", EPRO_DEFAULT);
+    p = addpropertyl(cls, ECONNP_FLUSH_DELAY, econnp_flush_delay, ECONNECTION_DEFAULT_FLUSH_DELAY,
+        "flush delay", EPRO_PERSISTENT|EPRO_SIMPLE);
+    p->setpropertys(EVARP_UNIT, "us");
+    addpropertyl(cls, ECONNP_FLUSH_BYTES, econnp_flush_bytes, ECONNECTION_DEFAULT_FLUSH_BYTES,
+        "flush bytes", EPRO_PERSISTENT|EPRO_SIMPLE);
+    addpropertyd(cls, ECONNP_ENVELOPES_PER_FLUSH, econnp_envelopes_per_flush,
+        "envelopes/flush", 1, EPRO_SIMPLE|EPRO_RDONLY);
+    addpropertyd(cls, ECONNP_BYTES_PER_WRITE, econnp_bytes_per_write,
+        "bytes/write", 1, EPRO_SIMPLE|EPRO_RDONLY);
+    addpropertyl(cls, ECONNP_COALESCED, econnp_coalesced,
+        "coalesced updates", EPRO_SIMPLE|EPRO_RDONLY);
+    p = addpropertyl(cls, ECONNP_COMPRESSION, econnp_compression, ECONNECTION_DEFAULT_CODEC,
+        "compression", EPRO_PERSISTENT|EPRO_SIMPLE);
+    p->setpropertys(EVARP_ATTR, "enum=\"0.none,1.lz\"");
+    addpropertyd(cls, ECONNP_COMPRESSION_RATIO, econnp_compression_ratio,
+        "compression ratio", 2, EPRO_SIMPLE|EPRO_RDONLY);
+    p = addpropertyd(cls, ECONNP_COMPRESSION_CPU, econnp_compression_cpu,
+        "compression CPU", 1, EPRO_SIMPLE|EPRO_RDONLY);
+    p->setpropertys(EVARP_UNIT, "ms");
     propertysetdone(cls);
     os_unlock();
 }
@@ -193,6 +234,26 @@ eStatus eConnection::onpropertychange(
             }
             break;
 
+        case ECONNP_FLUSH_DELAY:
+            m_flush_delay = x->getl();
+            if (m_flush_delay < 0) m_flush_delay = 0;
+            break;
+
+        case ECONNP_FLUSH_BYTES:
+            m_flush_bytes = x->getl();
+            break;
+
+        case ECONNP_COMPRESSION:
+            m_codec = x->geti();
+            break;
+
+        case ECONNP_ENVELOPES_PER_FLUSH:
+        case ECONNP_BYTES_PER_WRITE:
+        case ECONNP_COALESCED:
+        case ECONNP_COMPRESSION_RATIO:
+        case ECONNP_COMPRESSION_CPU:
+            break;
+
         default:
             return eThread::onpropertychange(propertynr, x, flags);
     }
@@ -220,6 +281,8 @@ eStatus eConnection::simpleproperty(
     os_int propertynr,
     eVariable *x)
 {
+    os_long nbytes, ncalls, raw_bytes, coded_bytes, cpu_us;
+
     switch (propertynr)
     {
         case ECONNP_ISOPEN:
@@ -234,6 +297,50 @@ eStatus eConnection::simpleproperty(
             x->setv(m_network_name);
             break;
 
+        case ECONNP_FLUSH_DELAY:
+            x->setl(m_flush_delay);
+            break;
+
+        case ECONNP_FLUSH_BYTES:
+            x->setl(m_flush_bytes);
+            break;
+
+        case ECONNP_ENVELOPES_PER_FLUSH:
+            x->setd(m_nflushes ? (os_double)m_nenvelopes / (os_double)m_nflushes : 0.0);
+            break;
+
+        case ECONNP_BYTES_PER_WRITE:
+            if (m_stream) {
+                m_stream->outstats(&nbytes, &ncalls);
+                x->setd(ncalls ? (os_double)nbytes / (os_double)ncalls : 0.0);
+            }
+            else {
+                x->setd(0.0);
+            }
+            break;
+
+        case ECONNP_COALESCED:
+            x->setl(m_ncoalesced);
+            break;
+
+        case ECONNP_COMPRESSION:
+            x->setl(m_codec);
+            break;
+
+        case ECONNP_COMPRESSION_RATIO:
+        case ECONNP_COMPRESSION_CPU:
+            raw_bytes = coded_bytes = cpu_us = 0;
+            if (m_stream) {
+                m_stream->codecstats(&raw_bytes, &coded_bytes, &cpu_us);
+            }
+            if (propertynr == ECONNP_COMPRESSION_CPU) {
+                x->setd(0.001 * (os_double)cpu_us);
+            }
+            else {
+                x->setd(coded_bytes ? (os_double)raw_bytes / (os_double)coded_bytes : 1.0);
+            }
+            break;
+
         default:
             return eThread::simpleproperty(propertynr, x);
     }
@@ -453,18 +560,42 @@ void eConnection::run()
         if (m_stream)
         {
             auth_s = handshake_and_authentication();
-            /* If we are still authenticating, do not start the real communication.
+            /* If we are still authenticating, do not start the real communication. Wait
+               until socket has data or thread is triggered, then continue the handshake.
+               Received data is left in socket for the handshake to read.
              */
             if (auth_s == ESTATUS_PENDING) {
-                osal_sleep(50);
+                if (m_stream->select(&m_stream, 1, trigger(), ECONNECTION_HANDSHAKE_WAIT_MS,
+                    ESTREAM_SELECT_WAIT_ONLY))
+                {
+                    close();
+                }
                 continue;
             }
+
+            /* Handshake or authentication failed: Do not retry immediately, let the
+               reconnect timer reopen the socket. Server side connection thread exits.
+             */
             if (ESTATUS_IS_ERROR(auth_s)) {
                 close();
-                osal_sleep(50);
+                if (!m_is_server) {
+                    timer(try_again_ms);
+                    m_fast_timer_enabled = 1;
+                    alive(EALIVE_WAIT_FOR_EVENT);
+                }
                 continue;
             }
 
+            /* Handshake just completed: Write buffered messages without waiting for
+               the first socket event.
+             */
+            if (!m_connected) {
+                if (connected()) {
+                    close();
+                    continue;
+                }
+            }
+
             /* Set slow timer for keepalive messages. About 1 per 30 seconds.
                This allows socket library to detect dead socket, and keeps
                sockets which are connected trough system which disconnects
@@ -477,18 +608,15 @@ void eConnection::run()
             }
 
             /* Wait for socket or thread event. The function will return error if
-               socket is disconnected.
+               socket is disconnected. If writes are being batched, wake up in time
+               to flush these.
              */
-            s = m_stream->select(&m_stream, 1, trigger(), OSAL_INFINITE, OSAL_STREAM_DEFAULT);
+            s = m_stream->select(&m_stream, 1, trigger(), flush_timeout_ms(), OSAL_STREAM_DEFAULT);
             if (s) {
                 close();
                 continue;
             }
 
-            if (!m_connected) {
-                connected();
-            }
-
             /* Call alive() to process messages. If stream gets closed, step out here.
              */
             alive(EALIVE_RETURN_IMMEDIATELY);
@@ -496,30 +624,10 @@ void eConnection::run()
                 continue;
             }
 
-            /* If message queue for incoming messages is empty, flush writes.
-             */
-            if (/* m_message_queue->first() == OS_NULL && */ m_new_writes)
-            {
-                if (m_stream->writechar(E_STREAM_FLUSH)) {
-                    close();
-                    continue;
-                }
-                if (m_stream->flush()) {
-                    close();
-                    continue;
-                }
-                os_get_timer(&m_last_send);
-                m_new_writes = OS_FALSE;
-            }
-
-            /* Read objects, as long we have whole objects to read.
+            /* Flush writes and read received objects.
              */
-            while (m_stream->flushcount() > 0)
-            {
-                if (read()) {
-                    close();
-                    break;
-                }
+            if (transfer()) {
+                close();
             }
         }
 
@@ -563,6 +671,10 @@ void eConnection::run()
   - Socket handshake for switchbox cloud network selection + trusted certificate copy
   - Send/receive an authentication message.
 
+  These are written directly to the underlying stream. Flushing uses ESTREAM_FLUSH_KEEP_BUFFERED,
+  so that hello queued by open() or accepted() stays in output buffer until handshake and
+  authentication are done.
+
   @return  - ESTATUS_SUCCESS All done, handshake ready, certificate copied if it was needed,
              authentication message has been received and processed.
            - ESTATUS_PENDING All data not yet transferred, but no error thus far. Keep on
@@ -602,7 +714,7 @@ os_boolean cert_match = OS_TRUE;
 
         if (ss) {
             if (ss == OSAL_PENDING) {
-                m_stream->flush();
+                m_stream->flush(ESTREAM_FLUSH_KEEP_BUFFERED);
             }
             return ESTATUS_FROM_OSAL_STATUS(ss);
         }
@@ -681,7 +793,7 @@ os_boolean cert_match = OS_TRUE;
             os_free(m_auth_send_buf, sizeof(iocSwitchboxAuthenticationFrameBuffer));
             m_auth_send_buf = OS_NULL;
             m_authentication_message_sent = OS_TRUE;
-            m_stream->flush();
+            m_stream->flush(ESTREAM_FLUSH_KEEP_BUFFERED);
         }
         else if (ss != OSAL_PENDING) {
             osal_debug_error("eConnection: Failed to send authentication message");
@@ -692,38 +804,240 @@ os_boolean cert_match = OS_TRUE;
     if (!m_authentication_message_sent ||
         !m_authentication_message_received)
     {
-        os_timeslice();
-        m_stream->flush();
+        m_stream->flush(ESTREAM_FLUSH_KEEP_BUFFERED);
         return ESTATUS_PENDING;
     }
     return ESTATUS_SUCCESS;
 }
 
 
+/**
+****************************************************************************************************
+
+  @brief Queue hello with codec selection and path dictionary support.
+
+  The eConnection::send_hello() function is called by open() and accepted() as soon as the
+  stream exists, so hello is the first thing in stream's output buffer: Keep alive control
+  character with E_STREAM_KEEPALIVE_HELLO bit, path dictionary support bit and this end's
+  codec selection in count field. Handshake and authentication write directly to the
+  underlying stream and flush it with ESTREAM_FLUSH_KEEP_BUFFERED, so hello goes out right
+  after these, before any envelope or keep alive. Older versions ignore it like any keep
+  alive. The function doesn't wait for the other end's hello, so the connection works as
+  before with older versions.
+
+  @return  ESTATUS_SUCCESS if all fine, other return values indicate an error.
+
+****************************************************************************************************
+*/
+eStatus eConnection::send_hello()
+{
+    eStatus s;
+
+    if (m_hello_sent) {
+        return ESTATUS_SUCCESS;
+    }
+
+    s = m_stream->writechar(E_STREAM_KEEPALIVE + (E_STREAM_KEEPALIVE_HELLO |
+        ECONNECTION_CODEC_PATH_DICT | (m_codec & ECONNECTION_CODEC_MASK)));
+    if (s) return s;
+    m_hello_sent = OS_TRUE;
+    return ESTATUS_SUCCESS;
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Act on hello received from the other end.
+
+  The eConnection::check_hello() function checks if the stream has received hello from the
+  other end. Hello is the first thing the other end sends, so this is known before any
+  envelope from it is read. If the other end selected the same codec as this end, output
+  compression is started, input decompression starts when the stream finds the other end's
+  codec switch mark.
+
+  If the other end supports path dictionary, dictionary is set up for reading and support
+  is echoed back. The other end writes dictionary coded paths only after it receives the
+  echo. This end does the same: Dictionary is used for writing only once the other end's
+  echo confirms that it received our hello, see check_echo(). Until then paths are written
+  as strings, so a peer which missed our hello never receives a path it cannot decode.
+
+  @return  ESTATUS_SUCCESS if all fine, other return values indicate an error.
+
+****************************************************************************************************
+*/
+eStatus eConnection::check_hello()
+{
+    os_int caps;
+    eStatus s;
+
+    caps = m_stream->peercaps();
+    if (caps == 0) return ESTATUS_SUCCESS;
+    m_hello_received = OS_TRUE;
+
+    if ((caps & ECONNECTION_CODEC_PATH_DICT) && m_pathdict == OS_NULL)
+    {
+        os_char buf[E_OIXSTR_BUF_SZ+3];
+        oixstr(buf, sizeof(buf));
+        os_strncat(buf, "/_r", sizeof(buf));
+        m_pathdict = (ePathDict*)os_malloc(sizeof(ePathDict), OS_NULL);
+        epathdict_init(m_pathdict, buf);
+
+        s = m_stream->writechar(E_STREAM_KEEPALIVE + E_STREAM_KEEPALIVE_ECHO);
+        if (s) return s;
+        s = m_stream->flush();
+        if (s) return s;
+    }
+
+    if (m_codec != ECOMPRESS_CODEC_NONE && (caps & ECONNECTION_CODEC_MASK) == m_codec) {
+        m_stream->setcodec(m_codec);
+    }
+    return ESTATUS_SUCCESS;
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Start writing dictionary coded paths once the other end has echoed support.
+
+  The eConnection::check_echo() function enables path dictionary for writing when the stream
+  has received echo of path dictionary support. The echo is sent by the other end after it
+  has received our hello and set up it's dictionary for reading.
+
+****************************************************************************************************
+*/
+void eConnection::check_echo()
+{
+    if (m_pathdict && (m_stream->peerecho() & E_STREAM_KEEPALIVE_ECHO)) {
+        m_pathdict_out = OS_TRUE;
+    }
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Process connection after worker thread's select (connection pool).
+
+  The eConnection::pooled_run() function is used instead of run() when the connection is
+  not running as own thread, but multiplexed by eConnectionWorker together with other
+  connections. The worker thread calls select() for all connections' streams and processes
+  messages, and then this function for each connection. This continues handshake, moves
+  received data to input buffer, flushes writes and reads received envelopes. None of
+  these waits.
+
+  @return OS_TRUE to keep the connection. OS_FALSE if connection has been closed and
+          connection object should be deleted (accepted connection).
+
+****************************************************************************************************
+*/
+os_boolean eConnection::pooled_run()
+{
+    eStatus s;
+
+    if (m_stream == OS_NULL) {
+        return !m_is_server;
+    }
+
+    s = handshake_and_authentication();
+    if (s == ESTATUS_PENDING) {
+        return OS_TRUE;
+    }
+
+    if (!s && !m_connected) {
+        s = connected();
+    }
+    if (!s) {
+        s = m_stream->receive();
+    }
+    if (!s) {
+        s = transfer();
+    }
+
+    if (s) {
+        close();
+        return !m_is_server;
+    }
+    return OS_TRUE;
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Close connection with broken stream (connection pool).
+
+  The eConnection::pooled_close() function is called by eConnectionWorker when select
+  reports an error for this connection's stream.
+
+  @return OS_TRUE to keep the connection object (client connection reconnects by timer).
+          OS_FALSE if connection object should be deleted (accepted connection).
+
+****************************************************************************************************
+*/
+os_boolean eConnection::pooled_close()
+{
+    close();
+    return !m_is_server;
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Get maximum time worker thread may wait in select (connection pool).
+
+  The eConnection::pooled_timeout_ms() function returns how long eConnectionWorker may wait
+  in select before pooled_run() needs to be called for this connection.
+
+  @return Timeout in milliseconds, OSAL_INFINITE if no timeout is needed.
+
+****************************************************************************************************
+*/
+os_int eConnection::pooled_timeout_ms()
+{
+    if (m_stream == OS_NULL) {
+        return OSAL_INFINITE;
+    }
+
+    if (!m_handshake_ready ||
+        !m_authentication_message_sent ||
+        !m_authentication_message_received)
+    {
+        return ECONNECTION_HANDSHAKE_WAIT_MS;
+    }
+
+    return flush_timeout_ms();
+}
+
+
 /**
 ****************************************************************************************************
 
   @brief Incoming connection has been accepted.
 
-  The eConnection::accepted() function adopts connected incoming stream and starts communicating
-  through it.
+  The eConnection::accepted() function adopts connected incoming stream and queues hello as
+  the first thing to send through it. The connection is not marked connected here: As for
+  client side, run() or pooled_run() calls connected() once handshake and authentication
+  are done, so no envelope or keep alive can be written before hello.
 
-  @return  None.
+  @return  If successfull, the function returns ESTATUS_SUCCESS. Other return values
+           indicate an error.
 
 ****************************************************************************************************
 */
 eStatus eConnection::accepted(
     eStream *stream)
 {
-    eStatus s;
-
     delete m_stream;
     m_stream = stream;
     stream->adopt(this);
 
-    s = connected();
     m_is_server = OS_TRUE;
-    return s;
+    m_hello_sent = OS_FALSE;
+    m_hello_received = OS_FALSE;
+    return send_hello();
 }
 
 
@@ -777,6 +1091,8 @@ void eConnection::open()
     m_handshake_ready = OS_FALSE;
     m_authentication_message_sent = OS_FALSE;
     m_authentication_message_received = OS_FALSE;
+    m_hello_sent = OS_FALSE;
+    m_hello_received = OS_FALSE;
     if (m_auth_send_buf) {
         os_free(m_auth_send_buf, sizeof(iocSwitchboxAuthenticationFrameBuffer));
         m_auth_send_buf = OS_NULL;
@@ -785,6 +1101,13 @@ void eConnection::open()
         os_free(m_auth_recv_buf, sizeof(iocSwitchboxAuthenticationFrameBuffer));
         m_auth_recv_buf = OS_NULL;
     }
+
+    /* Hello is the first thing in output buffer, before anything can be flushed.
+     */
+    if (send_hello()) {
+        osal_debug_error("eConnection: failed to queue hello");
+        close();
+    }
 }
 
 
@@ -826,6 +1149,16 @@ void eConnection::close()
         delete m_stream;
         m_stream = OS_NULL;
     }
+
+    /* Path dictionary is valid for one socket connection only.
+     */
+    if (m_pathdict)
+    {
+        epathdict_release(m_pathdict);
+        os_free(m_pathdict, sizeof(ePathDict));
+        m_pathdict = OS_NULL;
+    }
+    m_pathdict_out = OS_FALSE;
 }
 
 
@@ -877,17 +1210,7 @@ eStatus eConnection::connected()
 
     /* If we have something to write, flush it now.
      */
-    if (m_new_writes)
-    {
-        s = m_stream->writechar(E_STREAM_FLUSH);
-        if (s) return s;
-        s = m_stream->flush();
-        if (s) return s;
-        os_get_timer(&m_last_send);
-        m_new_writes = OS_FALSE;
-    }
-
-    return ESTATUS_SUCCESS;
+    return flush_writes(OS_TRUE);
 }
 
 
@@ -942,6 +1265,12 @@ void eConnection::disconnected()
     setpropertyl(ECONNP_ISOPEN, OS_FALSE);
     m_connection_failed_once = OS_TRUE;
     m_initbuffer->clear();
+
+    /* Drop batched writes, these cannot be sent any more.
+     */
+    m_batch->clear();
+    m_batch_bytes = 0;
+    m_batch_start = 0;
 }
 
 
@@ -1032,12 +1361,251 @@ eStatus eConnection::write(
 
     if (m_stream == OS_NULL) return ESTATUS_FAILED;
 
-    s = envelope->writer(m_stream, EOBJ_SERIALIZE_DEFAULT);
-    if (!s) m_new_writes = OS_TRUE;
+    /* Property value updates are held in batch when flush delay is set, so that an update
+       superseded by a newer one to the same target is never sent. With flush delay 0 there
+       is nothing to coalesce, and update is written without copying it to batch.
+     */
+    if (envelope->command() == ECMD_FWRD && m_flush_delay > 0)
+    {
+        batch_forward(envelope);
+        return ESTATUS_SUCCESS;
+    }
+
+    /* Any other message: Write batched updates first to preserve message order. Batch
+       may hold updates also after flush delay has been set to 0.
+     */
+    if (m_batch->first())
+    {
+        s = write_batch();
+        if (s) return s;
+    }
+    return write_envelope(envelope);
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Serialize an envelope to the stream.
+
+  The eConnection::write_envelope() function serializes an envelope to socket, etc. stream.
+  Data is not flushed, it stays in stream's output buffer until flush_writes() is called.
+
+  @param  envelope Envelope to write.
+  @return If successfull, the function returns ESTATUS_SUCCESS. Other return values indicate
+          an error and stream is to be closed.
+
+****************************************************************************************************
+*/
+eStatus eConnection::write_envelope(
+    eEnvelope *envelope)
+{
+    eStatus s;
+
+    s = envelope->dictwriter(m_stream, EOBJ_SERIALIZE_DEFAULT,
+        m_pathdict_out ? m_pathdict : OS_NULL);
+    if (!s)
+    {
+        m_new_writes = OS_TRUE;
+        m_nenvelopes++;
+        if (m_batch_start == 0) m_batch_start = etime();
+    }
     return s;
 }
 
 
+/**
+****************************************************************************************************
+
+  @brief Hold property value update in batch.
+
+  The eConnection::batch_forward() function stores a copy of ECMD_FWRD envelope in m_batch
+  container, named by target path. If there is an earlier update to the same target in batch,
+  which has not been written yet, it is dropped. The sender of the dropped update waits for
+  an acknowledgement, so an ECMD_ACK is sent back to it on behalf of the remote end.
+
+  Message order: Any other message written to the connection writes the batch first, so
+  batched updates are never moved relative to unbatched messages. Within the batch, the
+  newest update to a target is placed last: Updates are written in order of their last
+  change, for example "A=1, B=1, A=2" is written as "B=1, A=2".
+
+  @param  envelope Property value update envelope. The envelope is not modified, the caller
+          keeps ownership of it.
+
+****************************************************************************************************
+*/
+void eConnection::batch_forward(
+    eEnvelope *envelope)
+{
+    eEnvelope *prev, *e;
+    os_char *target, *source;
+
+    target = envelope->target();
+    prev = eEnvelope::cast(m_batch->byname(target));
+    if (prev)
+    {
+        if ((prev->mflags() & EMSG_NO_REPLIES) == 0)
+        {
+            message(ECMD_ACK, prev->source(), OS_NULL, OS_NULL,
+                EMSG_NO_REPLIES|EMSG_NO_ERRORS);
+        }
+        m_batch_bytes -= ECONNECTION_BATCH_ENVELOPE_SZ(prev->target(), prev->source());
+        delete prev;
+        m_ncoalesced++;
+    }
+
+    e = eEnvelope::cast(envelope->clone(m_batch, EOID_ITEM, EOBJ_NO_MAP));
+    e->addname(target);
+
+    source = envelope->source();
+    m_batch_bytes += ECONNECTION_BATCH_ENVELOPE_SZ(target, source);
+    if (m_batch_start == 0) m_batch_start = etime();
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Write all property value updates held in batch.
+
+  The eConnection::write_batch() function serializes envelopes in m_batch container to stream,
+  in order they were added, and empties the batch.
+
+  @return If successfull, the function returns ESTATUS_SUCCESS. Other return values indicate
+          an error and stream is to be closed.
+
+****************************************************************************************************
+*/
+eStatus eConnection::write_batch()
+{
+    eObject *o;
+    eStatus s = ESTATUS_SUCCESS;
+
+    while ((o = m_batch->first()))
+    {
+        if (!s) s = write_envelope(eEnvelope::cast(o));
+        delete o;
+    }
+    m_batch_bytes = 0;
+    return s;
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Flush written data to stream.
+
+  The eConnection::flush_writes() function decides if writes should be flushed now, and if
+  so, writes batched envelopes and flushes the stream. Flush is held back while the oldest
+  unflushed write is younger than "flushdelay" microseconds and amount of data waiting is
+  less than "flushbytes". Flush delay 0 disables holding back (flush at every loop).
+
+  @param  force OS_TRUE to flush regardless of batching policy.
+  @return If successfull, the function returns ESTATUS_SUCCESS. Other return values indicate
+          an error and stream is to be closed.
+
+****************************************************************************************************
+*/
+eStatus eConnection::flush_writes(
+    os_boolean force)
+{
+    os_long elapsed;
+    eStatus s;
+
+    if (m_batch_start == 0) return ESTATUS_SUCCESS;
+
+    if (!force && m_flush_delay > 0)
+    {
+        elapsed = etime() - m_batch_start;
+        if (elapsed >= 0 && elapsed < m_flush_delay &&
+            (os_long)(m_stream->outbytes() + m_batch_bytes) < m_flush_bytes)
+        {
+            return ESTATUS_SUCCESS;
+        }
+    }
+
+    s = write_batch();
+    if (s) return s;
+
+    if (m_new_writes)
+    {
+        s = m_stream->writechar(E_STREAM_FLUSH);
+        if (s) return s;
+        s = m_stream->flush();
+        if (s) return s;
+        os_get_timer(&m_last_send);
+        m_new_writes = OS_FALSE;
+        m_nflushes++;
+    }
+
+    m_batch_start = 0;
+    return ESTATUS_SUCCESS;
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Get select timeout needed to flush batched writes in time.
+
+  The eConnection::flush_timeout_ms() function calculates how long run() loop may wait in
+  select before flush_writes() needs to be called.
+
+  @return Timeout in milliseconds, OSAL_INFINITE if there is nothing waiting to be flushed.
+
+****************************************************************************************************
+*/
+os_int eConnection::flush_timeout_ms()
+{
+    os_long remaining;
+
+    if (m_batch_start == 0) return OSAL_INFINITE;
+
+    remaining = m_flush_delay - (etime() - m_batch_start);
+    if (remaining <= 1000) return 1;
+    return (os_int)((remaining + 999) / 1000);
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Flush writes and read received envelopes.
+
+  The eConnection::transfer() function flushes writes, unless batching policy tells to wait
+  for more, and reads received envelopes as long as there are whole envelopes in input buffer.
+
+  @return If successfull, the function returns ESTATUS_SUCCESS. Other return values indicate
+          an error and stream is to be closed.
+
+****************************************************************************************************
+*/
+eStatus eConnection::transfer()
+{
+    eStatus s;
+
+    if (!m_hello_received) {
+        s = check_hello();
+        if (s) return s;
+    }
+    if (!m_pathdict_out) {
+        check_echo();
+    }
+
+    s = flush_writes(OS_FALSE);
+    if (s) return s;
+
+    while (m_stream->flushcount() > 0)
+    {
+        s = read();
+        if (s) return s;
+    }
+
+    return ESTATUS_SUCCESS;
+}
+
+
 /**
 ****************************************************************************************************
 
@@ -1061,7 +1629,7 @@ eStatus eConnection::read()
         m_envelope = new eEnvelope(this);
     }
 
-    s = m_envelope->reader(m_stream, EOBJ_SERIALIZE_DEFAULT);
+    s = m_envelope->dictreader(m_stream, EOBJ_SERIALIZE_DEFAULT, m_pathdict);
     if (s == ESTATUS_NO_WHOLE_MESSAGES_TO_READ) {
         return ESTATUS_SUCCESS;
     }
@@ -1071,14 +1639,19 @@ eStatus eConnection::read()
         return s;
     }
 
-    m_envelope->prependtarget(*m_envelope->target() == '\0' ? "//" : "/");
-
-    if ((m_envelope->mflags() & EMSG_NO_REPLIES) == 0)
+    /* With path dictionary, prefixes have been added by dictreader().
+     */
+    if (m_pathdict == OS_NULL)
     {
-        os_char buf[E_OIXSTR_BUF_SZ+3];
-        oixstr(buf, sizeof(buf));
-        os_strncat(buf, "/_r", sizeof(buf));
-        m_envelope->prependsource(buf);
+        m_envelope->prependtarget(*m_envelope->target() == '\0' ? "//" : "/");
+
+        if ((m_envelope->mflags() & EMSG_NO_REPLIES) == 0)
+        {
+            os_char buf[E_OIXSTR_BUF_SZ+3];
+            oixstr(buf, sizeof(buf));
+            os_strncat(buf, "/_r", sizeof(buf));
+            m_envelope->prependsource(buf);
+        }
     }
     m_envelope->addmflags(EMSG_NO_NEW_SOURCE_OIX);
     message(m_envelope);
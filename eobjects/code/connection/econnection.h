@@ -35,6 +35,14 @@ struct iocSwitchboxAuthenticationFrameBuffer;
 #define ECONNP_NETWORK_NAME 12
 #define ECONNP_ISOPEN 15
 #define ECONNP_ENABLE 20
+#define ECONNP_FLUSH_DELAY 22
+#define ECONNP_FLUSH_BYTES 23
+#define ECONNP_ENVELOPES_PER_FLUSH 30
+#define ECONNP_BYTES_PER_WRITE 31
+#define ECONNP_COALESCED 32
+#define ECONNP_COMPRESSION 33
+#define ECONNP_COMPRESSION_RATIO 34
+#define ECONNP_COMPRESSION_CPU 35
 
 /* Connection property names.
  */
@@ -42,7 +50,52 @@ extern const os_char
     econnp_ipaddr[],
     econnp_network_name[],
     econnp_isopen[],
-    econnp_enable[];
+    econnp_enable[],
+    econnp_flush_delay[],
+    econnp_flush_bytes[],
+    econnp_envelopes_per_flush[],
+    econnp_bytes_per_write[],
+    econnp_coalesced[],
+    econnp_compression[],
+    econnp_compression_ratio[],
+    econnp_compression_cpu[];
+
+/* Default write batching: Maximum time to hold back a flush in microseconds (0 = flush
+   every time thread wakes up) and number of buffered bytes which forces a flush.
+ */
+#ifndef ECONNECTION_DEFAULT_FLUSH_DELAY
+#define ECONNECTION_DEFAULT_FLUSH_DELAY 0
+#endif
+#ifndef ECONNECTION_DEFAULT_FLUSH_BYTES
+#define ECONNECTION_DEFAULT_FLUSH_BYTES 16000
+#endif
+
+/* Default compression codec, ECOMPRESS_CODEC_NONE or ECOMPRESS_CODEC_LZ. Compression is
+   used only if both ends of the connection select the same codec.
+ */
+#ifndef ECONNECTION_DEFAULT_CODEC
+#define ECONNECTION_DEFAULT_CODEC ECOMPRESS_CODEC_NONE
+#endif
+
+/* Capability bits in hello sent after authentication, see E_STREAM_KEEPALIVE_HELLO: Bit 3
+   tells that path dictionary is supported and bits 0 - 2 are the selected codec. Older
+   versions do not send hello, and ignore it as keep alive. Path dictionary support is
+   echoed back with E_STREAM_KEEPALIVE_ECHO when hello from the other end is received.
+ */
+#define ECONNECTION_CODEC_PATH_DICT 0x08
+#define ECONNECTION_CODEC_MASK E_STREAM_KEEPALIVE_CODEC_MASK
+
+/* Maximum time to wait for socket or thread event during handshake and authentication, ms.
+   Normally select returns as soon as data is received, this is just upper limit.
+ */
+#ifndef ECONNECTION_HANDSHAKE_WAIT_MS
+#define ECONNECTION_HANDSHAKE_WAIT_MS 100
+#endif
+
+/* Estimated serialized size of batched property value update, used for "flushbytes" limit.
+ */
+#define ECONNECTION_BATCH_ENVELOPE_SZ(target, source) \
+    ((os_memsz)(os_strlen(target) + os_strlen(source) + 24))
 
 
 /**
@@ -131,6 +184,23 @@ public:
     virtual eStatus accepted(
         eStream *stream);
 
+    /* Connection pool: Stream to include in worker thread's select, OS_NULL if none.
+     */
+    inline eStream *stream()
+        {return m_stream; }
+
+    /* Connection pool: Process connection after worker thread's select.
+     */
+    os_boolean pooled_run();
+
+    /* Connection pool: Maximum time worker thread may wait in select for this connection.
+     */
+    os_int pooled_timeout_ms();
+
+    /* Connection pool: Close connection with broken stream.
+     */
+    os_boolean pooled_close();
+
     /* Send authentication message to the socket.
      */
     void send_authentication_message();
@@ -148,6 +218,19 @@ protected:
      */
     eStatus handshake_and_authentication();
 
+    /* Queue hello with codec selection and path dictionary support, called by open()
+       and accepted().
+     */
+    eStatus send_hello();
+
+    /* Act on hello received from the other end.
+     */
+    eStatus check_hello();
+
+    /* Start writing dictionary coded paths once the other end has echoed support.
+     */
+    void check_echo();
+
     /* Open the connection (connect)
      */
     void open();
@@ -179,6 +262,33 @@ protected:
     eStatus write(
         eEnvelope *envelope);
 
+    /* Serialize an envelope to the stream.
+     */
+    eStatus write_envelope(
+        eEnvelope *envelope);
+
+    /* Hold property value update in batch, drop older update to same target.
+     */
+    void batch_forward(
+        eEnvelope *envelope);
+
+    /* Write all property value updates held in batch.
+     */
+    eStatus write_batch();
+
+    /* Flush written data to stream if batching policy allows.
+     */
+    eStatus flush_writes(
+        os_boolean force);
+
+    /* Select timeout needed to flush batched writes in time.
+     */
+    os_int flush_timeout_ms();
+
+    /* Flush writes and read received envelopes.
+     */
+    eStatus transfer();
+
     /* Read an envelope from connection.
      */
     eStatus read();
@@ -222,6 +332,33 @@ protected:
      */
     eContainer *m_initbuffer;
 
+    /** ECMD_FWRD envelopes held back until next flush, named by target path.
+     */
+    eContainer *m_batch;
+
+    /** Estimated size of envelopes in m_batch, bytes.
+     */
+    os_memsz m_batch_bytes;
+
+    /** Time stamp when first unflushed write or batched envelope was added, microseconds.
+        0 if nothing is waiting for flush.
+     */
+    os_long m_batch_start;
+
+    /** Maximum time to hold back flush, microseconds. 0 = flush every time.
+     */
+    os_long m_flush_delay;
+
+    /** Flush when this many bytes are waiting.
+     */
+    os_long m_flush_bytes;
+
+    /** Statistics: Envelopes written, flushes done and superseded ECMD_FWRD envelopes dropped.
+     */
+    os_long m_nenvelopes;
+    os_long m_nflushes;
+    os_long m_ncoalesced;
+
     /** Connection initailized flag.
      */
     os_boolean m_initialized;
@@ -275,6 +412,27 @@ protected:
     /** Buffer for sending authentication message. OS_NULL if the buffer is not allocated.
      */
     struct iocSwitchboxAuthenticationFrameBuffer *m_auth_recv_buf;
+
+    /** Compression codec selected by "compression" property.
+     */
+    os_int m_codec;
+
+    /** Flags indicating that hello has been sent and received. Hello is never received
+        from older version.
+     */
+    os_boolean m_hello_sent;
+    os_boolean m_hello_received;
+
+    /** Path dictionary for envelope targets and sources, OS_NULL if not used. Allocated
+        when hello from the other end tells that it is supported, released when connection
+        is closed.
+     */
+    ePathDict *m_pathdict;
+
+    /** Path dictionary is used also for writing: The other end has echoed path dictionary
+        support, so it has received our hello and set up it's dictionary for reading.
+     */
+    os_boolean m_pathdict_out;
 };
 
 #endif
@@ -0,0 +1,380 @@
+/**
+
+  @file    econnectionworker.cpp
+  @brief   Connection pool worker thread.
+  @author  Pekka Lehtikoski
+  @version 1.0
+  @date    18.10.2026
+
+  The eConnectionWorker is a thread which runs multiple eConnection objects, instead of
+  each connection running as own thread. A server with thousands of connections can so
+  run few threads instead of one thread per connection.
+
+  Copyright 2020 Pekka Lehtikoski. This file is part of the eobjects project and shall only be used,
+  modified, and distributed under the terms of the project licensing. By continuing to use, modify,
+  or distribute this file you indicate that you have read the license and understand and accept
+  it fully.
+
+****************************************************************************************************
+*/
+#include "eobjects.h"
+
+/* Connection worker property names.
+ */
+const os_char
+    econnwp_nconnections[] = "nconnections";
+
+
+/**
+****************************************************************************************************
+  Constructor.
+****************************************************************************************************
+*/
+eConnectionWorker::eConnectionWorker(
+    eObject *parent,
+    e_oid id,
+    os_int flags)
+    : eThread(parent, id, flags)
+{
+    m_endpoint_path = new eVariable(this);
+    m_worker_nr = 0;
+    m_nconnections = 0;
+}
+
+
+/**
+****************************************************************************************************
+  Virtual destructor.
+****************************************************************************************************
+*/
+eConnectionWorker::~eConnectionWorker()
+{
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Add eConnectionWorker to class list and class'es properties to it's property set.
+
+  The eConnectionWorker::setupclass function adds eConnectionWorker to class list and class'es
+  properties to it's property set. The class list enables creating new objects dynamically
+  by class identifier, which is used for serialization reader functions. The property set
+  stores static list of class'es properties and metadata for those.
+
+****************************************************************************************************
+*/
+void eConnectionWorker::setupclass()
+{
+    const os_int cls = ECLASSID_CONNECTION_WORKER;
+
+    /* Synchronize, add the class to class list and properties to property set.
+     */
+    os_lock();
+    eclasslist_add(cls, (eNewObjFunc)newobj, "eConnectionWorker", ECLASSID_THREAD);
+    addpropertyl(cls, ECONNWP_NCONNECTIONS, econnwp_nconnections, "connections",
+        EPRO_SIMPLE|EPRO_RDONLY);
+    propertysetdone(cls);
+    os_unlock();
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Process incoming messages.
+
+  The eConnectionWorker::onmessage function handles ECMD_POOL_ADD_CONNECTION messages from
+  end point. Messages to connections run by the worker are passed trough the eThread
+  base class.
+
+  @param   envelope Message envelope. Contains command, target and source paths and
+           message content, etc.
+  @return  None.
+
+****************************************************************************************************
+*/
+void eConnectionWorker::onmessage(
+    eEnvelope *envelope)
+{
+    if (*envelope->target() == '\0' &&
+        envelope->command() == ECMD_POOL_ADD_CONNECTION)
+    {
+        add_connection(envelope);
+        return;
+    }
+
+    eThread::onmessage(envelope);
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Get value of simple property (override).
+
+  The simpleproperty() function stores current value of simple property into variable x.
+
+  @param   propertynr Property number to get.
+  @param   x Variable into which to store the property value.
+  @return  If property with property number was stored in x, the function returns
+           ESTATUS_SUCCESS (0). Nonzero return values indicate that property with
+           given number was not among simple properties.
+
+****************************************************************************************************
+*/
+eStatus eConnectionWorker::simpleproperty(
+    os_int propertynr,
+    eVariable *x)
+{
+    switch (propertynr)
+    {
+        case ECONNWP_NCONNECTIONS:
+            x->setl(m_nconnections);
+            break;
+
+        default:
+            return eThread::simpleproperty(propertynr, x);
+    }
+    return ESTATUS_SUCCESS;
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Initialize the object.
+
+  The initialize() function is called when new object is fully constructed. It initializes
+  client connections which have been created as children of the worker before it was
+  started. Connections above ECONNECTIONWORKER_MAX_CONNECTIONS are reported as error,
+  those would never be selected.
+
+  @param   params Parameters for the new thread. Not used.
+
+****************************************************************************************************
+*/
+void eConnectionWorker::initialize(
+    eContainer *params)
+{
+    eObject *o;
+
+    for (o = first(); o; o = o->next())
+    {
+        if (o->classid() == ECLASSID_CONNECTION)
+        {
+            eConnection::cast(o)->initialize();
+            m_nconnections++;
+        }
+    }
+
+    if (m_nconnections > ECONNECTIONWORKER_MAX_CONNECTIONS) {
+        osal_debug_error_int("eConnectionWorker: too many connections, not selected: ",
+            m_nconnections - ECONNECTIONWORKER_MAX_CONNECTIONS);
+    }
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Worker main loop.
+
+  The eConnectionWorker::run() function waits in one select call for sockets of all
+  connections and thread events. Received data is left in sockets by select, each
+  connection moves it's own data to input buffer in eConnection::pooled_run().
+
+  If select reports an error, connections are not processed as if they had events. Instead
+  select_failed() finds and closes the broken connections, or backs off if none is found.
+
+****************************************************************************************************
+*/
+void eConnectionWorker::run()
+{
+    eStream *streams[ECONNECTIONWORKER_MAX_CONNECTIONS];
+    eObject *o, *next_o;
+    eConnection *c;
+    os_int nstreams, timeout_ms, t;
+    eStatus s;
+
+    while (!exitnow())
+    {
+        /* Collect streams to select and shortest timeout needed.
+         */
+        nstreams = 0;
+        timeout_ms = OSAL_INFINITE;
+        for (o = first(); o; o = o->next())
+        {
+            if (o->classid() != ECLASSID_CONNECTION) continue;
+            c = eConnection::cast(o);
+
+            if (c->stream() && nstreams < ECONNECTIONWORKER_MAX_CONNECTIONS) {
+                streams[nstreams++] = c->stream();
+            }
+
+            t = c->pooled_timeout_ms();
+            if (t != OSAL_INFINITE && (timeout_ms == OSAL_INFINITE || t < timeout_ms)) {
+                timeout_ms = t;
+            }
+        }
+
+        /* Wait for socket or thread event and process messages. If there are no sockets,
+           wait only for thread events (timer will reopen client connections).
+         */
+        if (nstreams) {
+            s = streams[0]->select(streams, nstreams, trigger(), timeout_ms,
+                ESTREAM_SELECT_WAIT_ONLY);
+            if (s) {
+                select_failed(s);
+                continue;
+            }
+            alive(EALIVE_RETURN_IMMEDIATELY);
+        }
+        else {
+            alive(EALIVE_WAIT_FOR_EVENT);
+        }
+
+        /* Process connections, delete closed accepted connections.
+         */
+        for (o = first(); o; o = next_o)
+        {
+            next_o = o->next();
+            if (o->classid() != ECLASSID_CONNECTION) continue;
+            c = eConnection::cast(o);
+
+            if (!c->pooled_run()) {
+                remove_connection(c);
+            }
+        }
+    }
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Handle error from select.
+
+  The eConnectionWorker::select_failed() function is called when select for all connections'
+  streams fails. Select doesn't tell which stream caused the error, so each stream is
+  selected alone with short timeout and connections whose stream fails are closed. If no
+  broken stream is found (transient error), the worker backs off for a moment, so that
+  a persistent error doesn't turn the worker loop into a busy loop. Thread messages are
+  processed in both cases.
+
+  @param   s Status returned by select.
+  @return  None.
+
+****************************************************************************************************
+*/
+void eConnectionWorker::select_failed(
+    eStatus s)
+{
+    eObject *o, *next_o;
+    eConnection *c;
+    eStream *stream;
+    os_int nbroken = 0;
+
+    osal_debug_error_int("eConnectionWorker: select failed: ", s);
+
+    for (o = first(); o; o = next_o)
+    {
+        next_o = o->next();
+        if (o->classid() != ECLASSID_CONNECTION) continue;
+        c = eConnection::cast(o);
+
+        stream = c->stream();
+        if (stream == OS_NULL) continue;
+        if (stream->select(&stream, 1, OS_NULL, ECONNECTIONWORKER_CHECK_SELECT_MS,
+            ESTREAM_SELECT_WAIT_ONLY))
+        {
+            nbroken++;
+            if (!c->pooled_close()) {
+                remove_connection(c);
+            }
+        }
+    }
+
+    if (nbroken == 0) {
+        osal_event_wait(trigger(), ECONNECTIONWORKER_SELECT_ERROR_WAIT_MS);
+    }
+    alive(EALIVE_RETURN_IMMEDIATELY);
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Adopt accepted stream as new connection.
+
+  The eConnectionWorker::add_connection() function creates new eConnection as child of the
+  worker and sets it to use the accepted stream from message content. Connection name
+  is in message context.
+
+  @param   envelope ECMD_POOL_ADD_CONNECTION message from end point.
+  @return  None.
+
+****************************************************************************************************
+*/
+void eConnectionWorker::add_connection(
+    eEnvelope *envelope)
+{
+    eObject *content, *context;
+    eConnection *c;
+
+    content = envelope->content();
+    if (content == OS_NULL) return;
+
+    m_endpoint_path->sets(envelope->source());
+
+    c = new eConnection(this);
+    m_nconnections++;
+    if (c->accepted(eStream::cast(content)))
+    {
+        osal_debug_error("eConnectionWorker: accepted() failed");
+        remove_connection(c);
+        return;
+    }
+
+    context = envelope->context();
+    if (context) {
+        c->addname(eVariable::cast(context)->gets());
+    }
+    c->initialize();
+
+    /* Slow timer for keepalive messages, as in eConnection::run().
+     */
+    c->timer(osal_rand(30000, 31000));
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Delete closed connection and inform end point.
+
+  The eConnectionWorker::remove_connection() function deletes connection object and sends
+  ECMD_POOL_CONNECTION_CLOSED to end point, so end point can keep count of connections
+  per worker.
+
+  @param   c Pointer to connection to delete.
+  @return  None.
+
+****************************************************************************************************
+*/
+void eConnectionWorker::remove_connection(
+    eConnection *c)
+{
+    eVariable nr;
+
+    c->timer(0);
+    delete c;
+    m_nconnections--;
+
+    if (!m_endpoint_path->isempty())
+    {
+        nr = m_worker_nr;
+        message(ECMD_POOL_CONNECTION_CLOSED, m_endpoint_path->gets(), OS_NULL, &nr,
+            EMSG_NO_REPLIES|EMSG_NO_ERRORS);
+    }
+}
@@ -0,0 +1,182 @@
+/**
+
+  @file    econnectionworker.h
+  @brief   Connection pool worker thread.
+  @author  Pekka Lehtikoski
+  @version 1.0
+  @date    18.10.2026
+
+  The eConnectionWorker is a thread which runs multiple eConnection objects, instead of
+  each connection running as own thread.
+
+  Copyright 2020 Pekka Lehtikoski. This file is part of the eobjects project and shall only be used,
+  modified, and distributed under the terms of the project licensing. By continuing to use, modify,
+  or distribute this file you indicate that you have read the license and understand and accept
+  it fully.
+
+****************************************************************************************************
+*/
+#pragma once
+#ifndef ECONNECTIONWORKER_H_
+#define ECONNECTIONWORKER_H_
+#include "eobjects.h"
+
+
+/**
+****************************************************************************************************
+  Defines
+****************************************************************************************************
+*/
+
+/* Enumeration of connection worker properties.
+ */
+#define ECONNWP_NCONNECTIONS 2
+
+/* Connection worker property names.
+ */
+extern const os_char
+    econnwp_nconnections[];
+
+/* Maximum number of connections one worker thread can run. Can be set smaller at build
+   time, but not above OSAL_SOCKET_SELECT_MAX which limits select.
+ */
+#ifndef ECONNECTIONWORKER_MAX_CONNECTIONS
+#define ECONNECTIONWORKER_MAX_CONNECTIONS OSAL_SOCKET_SELECT_MAX
+#endif
+#if ECONNECTIONWORKER_MAX_CONNECTIONS > OSAL_SOCKET_SELECT_MAX
+#error ECONNECTIONWORKER_MAX_CONNECTIONS must not exceed OSAL_SOCKET_SELECT_MAX
+#endif
+
+/* Back off time after select error when no broken stream was found, ms.
+ */
+#define ECONNECTIONWORKER_SELECT_ERROR_WAIT_MS 200
+
+/* Timeout when selecting streams one by one to find the broken one, ms.
+ */
+#define ECONNECTIONWORKER_CHECK_SELECT_MS 1
+
+
+/**
+****************************************************************************************************
+
+  @brief Connection worker class.
+
+  The eConnectionWorker runs eConnection objects as it's children. Worker waits in one select
+  call for all connections' sockets and thread events, and then calls eConnection::pooled_run()
+  for each connection. Accepted connections are passed to worker by eEndPoint with
+  ECMD_POOL_ADD_CONNECTION message, client connections can be created as children of
+  worker before the worker thread is started.
+
+****************************************************************************************************
+*/
+class eConnectionWorker : public eThread
+{
+public:
+    /* Constructor.
+     */
+    eConnectionWorker(
+        eObject *parent = OS_NULL,
+        e_oid id = EOID_ITEM,
+        os_int flags = EOBJ_DEFAULT);
+
+    /* Virtual destructor.
+     */
+    virtual ~eConnectionWorker();
+
+    /* Casting eObject pointer to eConnectionWorker pointer.
+     */
+    inline static eConnectionWorker *cast(
+        eObject *o)
+    {
+        e_assert_type(o, ECLASSID_CONNECTION_WORKER)
+        return (eConnectionWorker*)o;
+    }
+
+    /* Get class identifier.
+     */
+    virtual os_int classid() {return ECLASSID_CONNECTION_WORKER; }
+
+    /* Static function to add class to propertysets and class list.
+     */
+    static void setupclass();
+
+    /* Static constructor function.
+    */
+    static eConnectionWorker *newobj(
+        eObject *parent,
+        e_oid id = EOID_ITEM,
+        os_int flags = EOBJ_DEFAULT)
+    {
+        return new eConnectionWorker(parent, id, flags);
+    }
+
+    /* Function to process messages to this object.
+     */
+    virtual void onmessage(
+        eEnvelope *envelope);
+
+    /* Get value of simple property.
+     */
+    virtual eStatus simpleproperty(
+        os_int propertynr,
+        eVariable *x);
+
+    /* Initialize the object.
+     */
+    virtual void initialize(
+        eContainer *params = OS_NULL);
+
+    /* Run the worker: select for all connections, process messages and connections.
+     */
+    virtual void run();
+
+    /* Set worker index, reported back to end point when connection is closed.
+     */
+    inline void set_worker_nr(
+        os_int worker_nr)
+        {m_worker_nr = worker_nr; }
+
+protected:
+
+    /**
+    ************************************************************************************************
+      Protected member functions.
+    ************************************************************************************************
+    */
+
+    /* Handle error from select: close broken connections or back off.
+     */
+    void select_failed(
+        eStatus s);
+
+    /* Adopt accepted stream as new connection.
+     */
+    void add_connection(
+        eEnvelope *envelope);
+
+    /* Delete closed connection and inform end point.
+     */
+    void remove_connection(
+        eConnection *c);
+
+
+    /**
+    ************************************************************************************************
+      Member variables.
+    ************************************************************************************************
+    */
+
+    /** Path to end point which passes accepted connections to this worker.
+     */
+    eVariable *m_endpoint_path;
+
+    /** Worker index within end point's pool.
+     */
+    os_int m_worker_nr;
+
+    /** Number of connections run by this worker.
+     */
+    os_int m_nconnections;
+};
+
+#endif
@@ -22,7 +22,11 @@
 const os_char
     eendpp_ipaddr[] = "ipaddr",
     eendpp_cloud_name[] = "cloudname",
-    eendpp_isopen[] = "isopen";
+    eendpp_isopen[] = "isopen",
+    eendpp_pool_size[] = "poolsize",
+    eendpp_pool_workers[] = "poolworkers",
+    eendpp_pool_max_load[] = "poolmaxload",
+    eendpp_pool_overflow[] = "pooloverflow";
 
 
 /**
@@ -46,6 +50,10 @@ eEndPoint::eEndPoint(
     m_cloud_name[0] = '\0';
     m_accept_count = 0;
     m_open_timer = 0;
+    m_pool_size = 0;
+    m_pool_started = 0;
+    m_pool_max_load = 0;
+    m_pool_overflow = 0;
 }
 
 
@@ -85,6 +93,14 @@ void eEndPoint::setupclass()
     addproperty(cls, EENDPP_CLOUD_NAME, eendpp_cloud_name, "cloud name", EPRO_PERSISTENT|EPRO_SIMPLE);
     p = addpropertyb(cls, EENDPP_ISOPEN, eendpp_isopen, OS_FALSE, "is open", EPRO_SIMPLE);
     p->setpropertys(EVARP_ATTR, "rdonly");
+    addpropertyl(cls, EENDPP_POOL_SIZE, eendpp_pool_size, 0, "connection threads",
+        EPRO_PERSISTENT|EPRO_SIMPLE);
+    addpropertyl(cls, EENDPP_POOL_WORKERS, eendpp_pool_workers, 0, "pool workers",
+        EPRO_RDONLY);
+    addpropertyl(cls, EENDPP_POOL_MAX_LOAD, eendpp_pool_max_load, 0, "connections/worker",
+        EPRO_RDONLY);
+    addpropertyl(cls, EENDPP_POOL_OVERFLOW, eendpp_pool_overflow, 0, "pool overflow",
+        EPRO_RDONLY);
     propertysetdone(cls);
     os_unlock();
 }
@@ -137,6 +153,17 @@ eStatus eEndPoint::onpropertychange(
             }
             break;
 
+        case EENDPP_POOL_SIZE:
+            m_pool_size = x->geti();
+            if (m_pool_size < 0) m_pool_size = 0;
+            if (m_pool_size > EENDPOINT_MAX_POOL_SIZE) m_pool_size = EENDPOINT_MAX_POOL_SIZE;
+            break;
+
+        case EENDPP_POOL_WORKERS:
+        case EENDPP_POOL_MAX_LOAD:
+        case EENDPP_POOL_OVERFLOW:
+            break;
+
         default:
             return eThread::onpropertychange(propertynr, x, flags);
     }
@@ -178,6 +205,10 @@ eStatus eEndPoint::simpleproperty(
             x->sets(m_cloud_name);
             break;
 
+        case EENDPP_POOL_SIZE:
+            x->setl(m_pool_size);
+            break;
+
         default:
             return eThread::simpleproperty(propertynr, x);
     }
@@ -227,10 +258,6 @@ void eEndPoint::initialize(
 void eEndPoint::run()
 {
     eStream *newstream;
-    eConnection *c;
-    eVariable *name;
-    eName *n;
-    os_char *p;
     eStatus s;
 
     while (!exitnow())
@@ -255,32 +282,7 @@ void eEndPoint::run()
             newstream = m_stream->accept(OSAL_STREAM_DEFAULT, &s, this, EOID_ITEM);
             if (newstream)
             {
-                c = new eConnection();
-                // c->addname("//connection");
-
-                s = c->accepted(newstream);
-                if (s) {
-                    delete c;
-                    osal_debug_error_int("accepted() failed: ", s);
-                }
-                else {
-                    name = new eVariable(ETEMPORARY);
-                    name->sets("//ecom");
-                    n = primaryname();
-                    if (n) {
-                        p = n->gets();
-                        p = os_strchr(p, '_');
-                        if (p) name->appends(p);
-                    }
-                    name->appends("_accepted");
-                    name->appendl(++m_accept_count);
-                    c->addname(name->gets());
-                    delete name;
-
-                    c->start(); /* After this c pointer is useless */
-
-                    osal_trace3("stream accepted");
-                }
+                accepted(newstream);
             }
             else if (s != ESTATUS_NO_NEW_CONNECTION)
             {
@@ -315,6 +317,215 @@ void eEndPoint::run()
             }
         }
     }
+
+    stop_pool();
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Process incoming messages.
+
+  The eEndPoint::onmessage function keeps count of connections per connection worker:
+  Worker sends ECMD_POOL_CONNECTION_CLOSED when a connection passed to it is closed.
+
+  @param   envelope Message envelope. Contains command, target and source paths and
+           message content, etc.
+  @return  None.
+
+****************************************************************************************************
+*/
+void eEndPoint::onmessage(
+    eEnvelope *envelope)
+{
+    eObject *content;
+    os_int nr;
+
+    if (*envelope->target() == '\0' &&
+        envelope->command() == ECMD_POOL_CONNECTION_CLOSED)
+    {
+        content = envelope->content();
+        if (content)
+        {
+            nr = eVariable::cast(content)->geti();
+            if (nr >= 0 && nr < m_pool_started && m_pool_load[nr] > 0) {
+                m_pool_load[nr]--;
+            }
+        }
+        return;
+    }
+
+    eThread::onmessage(envelope);
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Incoming connection has been accepted.
+
+  The eEndPoint::accepted() function names the new connection. If "poolsize" property is
+  zero, it creates an eConnection object, sets it to use the accepted stream and starts it
+  as it's own thread. Otherwise the stream is passed to least loaded connection worker
+  thread, which runs it together with other connections. If all workers already run
+  ECONNECTIONWORKER_MAX_CONNECTIONS connections, the connection is run as own thread and
+  counted in "pooloverflow" property. Connection pool use is reported by "poolworkers",
+  "poolmaxload" and "pooloverflow" properties.
+
+  @param   newstream Accepted stream, child of end point.
+  @return  None.
+
+****************************************************************************************************
+*/
+void eEndPoint::accepted(
+    eStream *newstream)
+{
+    eConnection *c;
+    eVariable *name;
+    eName *n;
+    os_char *p;
+    os_int nr;
+    eStatus s;
+
+    name = new eVariable(ETEMPORARY);
+    name->sets("//ecom");
+    n = primaryname();
+    if (n) {
+        p = n->gets();
+        p = os_strchr(p, '_');
+        if (p) name->appends(p);
+    }
+    name->appends("_accepted");
+    name->appendl(++m_accept_count);
+
+    /* Connection pool in use: Pass stream to worker thread, name as context.
+     */
+    nr = select_worker();
+    if (nr >= 0)
+    {
+        if (++m_pool_load[nr] > m_pool_max_load) m_pool_max_load = m_pool_load[nr];
+        message(ECMD_POOL_ADD_CONNECTION, m_pool[nr]->uniquename(), OS_NULL,
+            newstream, EMSG_DEL_CONTENT, name);
+        delete name;
+        pool_stats();
+        osal_trace3("stream passed to connection worker");
+        return;
+    }
+
+    /* Connection pool in use, but all workers are full: Run connection as own thread,
+       report first time this happens.
+     */
+    if (m_pool_size > 0)
+    {
+        if (m_pool_overflow++ == 0) {
+            osal_debug_error_int("connection pool full, connection run as own thread, "
+                "workers=", m_pool_started);
+        }
+        pool_stats();
+    }
+
+    c = new eConnection();
+    s = c->accepted(newstream);
+    if (s) {
+        delete c;
+        osal_debug_error_int("accepted() failed: ", s);
+    }
+    else {
+        c->addname(name->gets());
+        c->start(); /* After this c pointer is useless */
+        osal_trace3("stream accepted");
+    }
+    delete name;
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Select least loaded connection worker.
+
+  The eEndPoint::select_worker() function selects connection worker with fewest connections.
+  New worker thread is started when all running workers have connections and "poolsize"
+  allows more workers.
+
+  @return Worker index, or -1 if connection pool is not used or all workers are full.
+          In later case the connection is run as own thread.
+
+****************************************************************************************************
+*/
+os_int eEndPoint::select_worker()
+{
+    eConnectionWorker *w;
+    os_int i, nr = -1;
+
+    if (m_pool_size <= 0) return -1;
+
+    for (i = 0; i < m_pool_started; i++)
+    {
+        if (m_pool_load[i] < ECONNECTIONWORKER_MAX_CONNECTIONS &&
+            (nr < 0 || m_pool_load[i] < m_pool_load[nr]))
+        {
+            nr = i;
+        }
+    }
+
+    if ((nr < 0 || m_pool_load[nr] > 0) && m_pool_started < m_pool_size)
+    {
+        nr = m_pool_started++;
+        m_pool[nr] = new eThreadHandle(this);
+        m_pool_load[nr] = 0;
+
+        w = new eConnectionWorker();
+        w->set_worker_nr(nr);
+        w->start(m_pool[nr]); /* After this w pointer is useless */
+    }
+
+    return nr;
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Update connection pool statistics properties.
+
+  The eEndPoint::pool_stats() function sets "poolworkers", "poolmaxload" and "pooloverflow"
+  properties from member variables. Properties are not simple, so that changes are
+  forwarded to bindings. Unchanged values are not forwarded again.
+
+****************************************************************************************************
+*/
+void eEndPoint::pool_stats()
+{
+    setpropertyl(EENDPP_POOL_WORKERS, m_pool_started);
+    setpropertyl(EENDPP_POOL_MAX_LOAD, m_pool_max_load);
+    setpropertyl(EENDPP_POOL_OVERFLOW, m_pool_overflow);
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Terminate connection worker threads.
+
+  The eEndPoint::stop_pool() function requests all connection worker threads to exit and
+  waits for them. Connections run by workers are closed.
+
+****************************************************************************************************
+*/
+void eEndPoint::stop_pool()
+{
+    os_int i;
+
+    for (i = 0; i < m_pool_started; i++) {
+        m_pool[i]->terminate();
+    }
+    for (i = 0; i < m_pool_started; i++) {
+        m_pool[i]->join();
+        delete m_pool[i];
+    }
+    m_pool_started = 0;
 }
 
 
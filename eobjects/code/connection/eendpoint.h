@@ -32,13 +32,29 @@
 #define EENDPP_IPADDR  4
 #define EENDPP_CLOUD_NAME 5
 #define EENDPP_ISOPEN  6
+#define EENDPP_POOL_SIZE 7
+#define EENDPP_POOL_WORKERS 8
+#define EENDPP_POOL_MAX_LOAD 9
+#define EENDPP_POOL_OVERFLOW 10
 
 /* End point property names.
  */
 extern const os_char
     eendpp_ipaddr[],
     eendpp_cloud_name[],
-    eendpp_isopen[];
+    eendpp_isopen[],
+    eendpp_pool_size[],
+    eendpp_pool_workers[],
+    eendpp_pool_max_load[],
+    eendpp_pool_overflow[];
+
+/* Maximum number of connection worker threads per end point. One worker runs up to
+   ECONNECTIONWORKER_MAX_CONNECTIONS connections, when all workers are full accepted
+   connections are run as own threads and counted in "pooloverflow" property.
+ */
+#ifndef EENDPOINT_MAX_POOL_SIZE
+#define EENDPOINT_MAX_POOL_SIZE 64
+#endif
 
 
 /**
@@ -109,6 +125,11 @@ public:
     virtual void initialize(
         eContainer *params = OS_NULL);
 
+    /* Function to process messages to this object.
+     */
+    virtual void onmessage(
+        eEnvelope *envelope);
+
     /* Run the end point: main loop to process thread events and accept connections.
      */
     virtual void run();
@@ -129,6 +150,23 @@ protected:
      */
     void close();
 
+    /* Start accepted connection as own thread or pass it to connection worker.
+     */
+    void accepted(
+        eStream *newstream);
+
+    /* Select least loaded connection worker, start workers when needed.
+     */
+    os_int select_worker();
+
+    /* Terminate connection worker threads.
+     */
+    void stop_pool();
+
+    /* Update connection pool statistics properties.
+     */
+    void pool_stats();
+
 
     /**
     ************************************************************************************************
@@ -169,6 +207,30 @@ protected:
     /** We tried to open socket port and failed.
      */
     os_boolean m_connection_failed;
+
+    /** Number of connection worker threads to use, 0 to run each connection as own thread.
+     */
+    os_int m_pool_size;
+
+    /** Number of connection worker threads started.
+     */
+    os_int m_pool_started;
+
+    /** Thread handles of connection worker threads.
+     */
+    eThreadHandle *m_pool[EENDPOINT_MAX_POOL_SIZE];
+
+    /** Number of connections passed to each worker and not yet closed.
+     */
+    os_int m_pool_load[EENDPOINT_MAX_POOL_SIZE];
+
+    /** Largest number of connections run by one worker at a time.
+     */
+    os_int m_pool_max_load;
+
+    /** Number of accepted connections run as own thread because all workers were full.
+     */
+    os_long m_pool_overflow;
 };
 
 #endif
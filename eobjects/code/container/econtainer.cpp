@@ -289,12 +289,50 @@ eStatus eContainer::json_writer(
         if (json_indent(stream, indent, EJSON_NEW_LINE_BEFORE)) goto failed;
         if (json_puts(stream, "]")) goto failed;
     }
+    else {
+        if (json_puts(stream, "[]")) goto failed;
+    }
 
     return ESTATUS_SUCCESS;
 
 failed:
     return ESTATUS_FAILED;
 }
+
+
+/**
+****************************************************************************************************
+
+  @brief Read container specific content from JSON.
+
+  The eContainer::json_reader() function reads array of children, as written by
+  json_writer(). Each child is created as soon as it's first token is read.
+
+  @param  reader JSON tokenizer.
+  @param  token First token of the content, '['.
+  @param  sflags Serialization flags. Typically EOBJ_SERIALIZE_DEFAULT.
+
+  @return If successfull the function returns ESTATUS_SUCCESS (0). Other return values
+          indicate an error.
+
+****************************************************************************************************
+*/
+eStatus eContainer::json_reader(
+    eJsonReader *reader,
+    os_int token,
+    os_int sflags)
+{
+    if (token != EJSON_TOKEN_BEGIN_ARRAY) return ESTATUS_FAILED;
+
+    while ((token = reader->next()) != EJSON_TOKEN_END_ARRAY)
+    {
+        if (json_read_value(reader, token, OS_NULL, sflags) == OS_NULL) {
+            return ESTATUS_FAILED;
+        }
+    }
+
+    return ESTATUS_SUCCESS;
+}
 #endif
 
 
@@ -114,6 +114,13 @@ public:
         eStream *stream,
         os_int sflags,
         os_int indent);
+
+    /* Read container specific content from JSON.
+     */
+    virtual eStatus json_reader(
+        eJsonReader *reader,
+        os_int token,
+        os_int sflags);
 #endif
 
     /* Empty the container.
@@ -31,7 +31,8 @@ const os_char
     eperp_relative_path[] = "rel_path",
     eperp_file[] = "file_name",
     eperp_save_time_ms[] = "time_ms",
-    eperp_save_latest_time_ms[] = "latest_ms";
+    eperp_save_latest_time_ms[] = "latest_ms",
+    eperp_journal_max[] = "journal_max";
 
 /**
 ****************************************************************************************************
@@ -50,6 +51,15 @@ ePersistent::ePersistent(
     m_save_latest_time = 2001;
     m_timer_ms = 0;
 
+    m_journal = new eContainer(ETEMPORARY);
+    m_journal_seq = 0;
+    m_journal_items = 0;
+    m_journal_max = 10000;
+    m_snapshot_needed = OS_TRUE;
+    m_journal_truncate = OS_FALSE;
+    m_loading = OS_FALSE;
+    m_matrix_slot = 1;
+
     initproperties();
 }
 
@@ -121,6 +131,8 @@ void ePersistent::setupclass()
     p = addpropertyl(cls, EPERP_SAVE_LATEST_TIME_MS, eperp_save_latest_time_ms, 2000,
         "save latest", EPRO_DEFAULT);
     p->setpropertys(EVARP_UNIT, "ms");
+    addpropertyl(cls, EPERP_JOURNAL_MAX, eperp_journal_max, 10000,
+        "journal max", EPRO_DEFAULT);
     propertysetdone(cls);
     os_unlock();
 }
@@ -195,6 +207,10 @@ eStatus ePersistent::onpropertychange(
             m_save_latest_time = x->geti();
             break;
 
+        case EPERP_JOURNAL_MAX:
+            m_journal_max = x->geti();
+            break;
+
         default:
             goto call_parent;
     }
@@ -211,7 +227,8 @@ call_parent:
 
   @brief Process a callback from a child object.
 
-  The ePersistent::oncallback function
+  The ePersistent::oncallback function records change to journal and starts save timer.
+  Changes made while loading are ignored.
 
 ****************************************************************************************************
 */
@@ -224,7 +241,11 @@ eStatus ePersistent::oncallback(
     {
         case ECALLBACK_VARIABLE_VALUE_CHANGED:
         case ECALLBACK_TABLE_CONTENT_CHANGED:
-            touch();
+            if (!m_loading)
+            {
+                journal_add(event, obj, appendix);
+                touch();
+            }
             break;
 
         default:
@@ -266,7 +287,10 @@ void ePersistent::touch()
 
   @brief Check if enugh time has passed since last change to save the peristent data.
 
-  The ePersistent::check_save_timer function...
+  The ePersistent::check_save_timer function saves changes when enough time has passed. If
+  all changes since last save are in journal, only the journal records are appended to
+  journal file. Otherwise (or when journal has grown over limit) the whole object is saved
+  as a new snapshot.
 
 ****************************************************************************************************
 */
@@ -280,7 +304,12 @@ void ePersistent::check_save_timer()
         if (os_has_elapsed_since(&m_latest_touch, &now_t, m_save_time) ||
             os_has_elapsed_since(&m_oldest_touch, &now_t, m_save_latest_time))
         {
-            save_as_message();
+            if (m_snapshot_needed) {
+                save_as_message();
+            }
+            else {
+                journal_save_as_message();
+            }
             m_latest_touch = 0;
             m_oldest_touch = 0;
             set_timer(0);
@@ -294,27 +323,37 @@ void ePersistent::check_save_timer()
 
   @brief Save persistent object by sending it as message to file system.
 
-  The ePersistent::save_as_message function...
+  The ePersistent::save_as_message function clones the whole persistent object and sends it
+  to file system as snapshot. Journal sequence number is incremented for each snapshot and
+  saved with the snapshot as EOID_PARAMETER variable. Journal records not yet written are
+  included in the snapshot, so they are dropped, and next journal batch starts a new journal
+  file. Rows of large matrices are sent before the snapshot as separate memory image files.
 
 ****************************************************************************************************
 */
 void ePersistent::save_as_message()
 {
-    eVariable target, *relative_path, tmp;
+    eVariable target, *relative_path, *seq;
     eContainer *content;
+    eObject *snapshot;
     const os_char *p;
 
     content = new eContainer(ETEMPORARY);
     relative_path = new eVariable(content, EOID_PATH);
-    clone(content, EOID_CONTENT);
+    snapshot = clone(content, EOID_CONTENT);
+    seq = new eVariable(snapshot, EOID_PARAMETER);
+    seq->setl(++m_journal_seq);
+    save_matrix_snapshots(snapshot);
 
 // content->print_json();
 
     propertyv(EPERP_ROOT_PATH, &target);
-    get_relative_path(relative_path);
-    propertyv(EPERP_FILE, &tmp);
-    relative_path->appends("/");
-    relative_path->appendv(&tmp);
+    get_file_path(relative_path);
+
+    m_journal->clear();
+    m_journal_items = 0;
+    m_snapshot_needed = (os_boolean)(m_journal_max <= 0);
+    m_journal_truncate = OS_TRUE;
 
     target.appends("/");
     target.appendv(relative_path);
@@ -331,7 +370,8 @@ void ePersistent::save_as_message()
 
   @brief Load persistent object from local file system.
 
-  The ePersistent::load_file function...
+  The ePersistent::load_file function loads the snapshot and memory image files of large
+  matrices, and replays changes from journal file, which were written after the snapshot.
 
 ****************************************************************************************************
 */
@@ -340,6 +380,9 @@ void ePersistent::load_file(
 {
     eVariable path, tmp;
     eObject *content;
+    eVariable *seq;
+    os_long snapshot_seq = 0;
+    eStatus matrix_s = ESTATUS_SUCCESS;
 
     if (file_name) {
         setpropertys(EPERP_FILE, file_name);
@@ -347,22 +390,446 @@ void ePersistent::load_file(
 
     path.sets(eglobal->root_path);
     path.appends("/");
-    get_relative_path(&tmp);
-    path.appendv(&tmp);
-    path.appends("/");
-    propertyv(EPERP_FILE, &tmp);
+    get_file_path(&tmp);
     path.appendv(&tmp);
 
+    m_loading = OS_TRUE;
     content = load(path.gets());
     if (content) {
         content->adopt(this, EOID_TEMPORARY, EOBJ_NO_MAP|EOBJ_IS_ATTACHMENT);
+        seq = eVariable::cast(content->first(EOID_PARAMETER));
+        if (seq) {
+            snapshot_seq = seq->getl();
+        }
+        matrix_s = load_matrix_snapshots(content, path.gets(), snapshot_seq);
         use_loded_content(ePersistent::cast(content));
         delete content;
-        set_timer(0);
+        m_snapshot_needed = (os_boolean)(m_journal_max <= 0);
+    }
+    m_journal_seq = snapshot_seq;
+
+    /* If there was journal, write fresh snapshot at next save and start the journal clean.
+       Otherwise new batches would be appended after partially written batch, if any, and
+       never read back.
+     */
+    if (!m_snapshot_needed)
+    {
+        path.appends(EPER_JOURNAL_EXT);
+        if (journal_load(path.gets(), snapshot_seq))
+        {
+            m_snapshot_needed = OS_TRUE;
+            m_journal_truncate = OS_TRUE;
+        }
+    }
+
+    /* If rows of a large matrix could not be loaded, don't journal changes on top of the
+       incomplete content: Next save writes a new snapshot.
+     */
+    if (matrix_s) {
+        m_snapshot_needed = OS_TRUE;
+    }
+    m_loading = OS_FALSE;
+    set_timer(0);
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Add change to journal.
+
+  The ePersistent::journal_add function stores a journal record for value change of a named
+  child variable, or for table change record given by eMatrix as appendix. If the change
+  cannot be journaled or journal has grown too big, only flag for full save is set.
+
+  @param  event ECALLBACK_VARIABLE_VALUE_CHANGED or ECALLBACK_TABLE_CONTENT_CHANGED.
+  @param  obj Child object which changed.
+  @param  appendix Table change record, see EMTX_JOURNAL_INSERT.
+
+****************************************************************************************************
+*/
+void ePersistent::journal_add(
+    eCallbackEvent event,
+    eObject *obj,
+    eObject *appendix)
+{
+    eContainer *record, *rows;
+    eVariable *v;
+    eName *name;
+
+    if (m_snapshot_needed) return;
+    if (obj == OS_NULL) goto snapshot;
+    if (obj->parent() != this) goto snapshot;
+
+    name = obj->primaryname(ENAME_PARENT_NS);
+    if (name == OS_NULL) name = obj->primaryname();
+    if (name == OS_NULL) goto snapshot;
+
+    if (event == ECALLBACK_VARIABLE_VALUE_CHANGED)
+    {
+        if (obj->classid() != ECLASSID_VARIABLE) goto snapshot;
+        record = new eContainer(m_journal);
+        v = new eVariable(record, EOID_PARAMETER);
+        v->setl(EPER_JOURNAL_SET_VALUE);
+        v = new eVariable(record, EOID_CONTENT);
+        v->setv(eVariable::cast(obj));
+        m_journal_items++;
+    }
+    else
+    {
+        if (obj->classid() != ECLASSID_MATRIX || appendix == OS_NULL) goto snapshot;
+        if (appendix->classid() != ECLASSID_CONTAINER) goto snapshot;
+        record = eContainer::cast(appendix->clone(m_journal, EOID_ITEM));
+        rows = record->firstc(EOID_CONTENT);
+        m_journal_items += (rows && rows->firstc()) ? rows->childcount() : 1;
+    }
+
+    v = new eVariable(record, EOID_PATH);
+    v->sets(name->gets());
+
+    if (m_journal_items <= m_journal_max) return;
+
+snapshot:
+    m_snapshot_needed = OS_TRUE;
+    m_journal->clear();
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Send journal records to file system.
+
+  The ePersistent::journal_save_as_message function moves journal records collected since
+  last save into one batch, which is appended to journal file with ECMD_APPEND_FILE. Batches
+  are numbered, the first batch after snapshot overwrites old journal file. Batching changes
+  by save timer limits how often the journal file is written and flushed.
+
+****************************************************************************************************
+*/
+void ePersistent::journal_save_as_message()
+{
+    eVariable target, *relative_path, *seq;
+    eContainer *content, *batch;
+    eObject *record, *next_record;
+
+    if (m_journal->first() == OS_NULL) return;
+
+    content = new eContainer(ETEMPORARY);
+    relative_path = new eVariable(content, EOID_PATH);
+    batch = new eContainer(content, EOID_CONTENT);
+    seq = new eVariable(batch, EOID_PARAMETER);
+    seq->setl(++m_journal_seq);
+
+    for (record = m_journal->first(); record; record = next_record)
+    {
+        next_record = record->next();
+        record->adopt(batch);
+    }
+
+    propertyv(EPERP_ROOT_PATH, &target);
+    get_file_path(relative_path);
+    relative_path->appends(EPER_JOURNAL_EXT);
+    target.appends("/");
+    target.appendv(relative_path);
+
+    message(m_journal_truncate ? ECMD_SAVE_FILE : ECMD_APPEND_FILE,
+        target.gets(), OS_NULL, content, EMSG_DEL_CONTENT);
+    m_journal_truncate = OS_FALSE;
+
+    docallback(ECALLBACK_PERSISTENT_CHANGED);
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Load journal file and replay changes.
+
+  The ePersistent::journal_load function reads journal batches one by one and applies
+  records of batches which are newer than the snapshot. Reading stops at end of file, or at
+  partially written batch if the process was terminated while writing. Clean end of file
+  cannot be told apart from partially written batch, so any journal file found is reported.
+
+  @param  path OS path to journal file.
+  @param  snapshot_seq Journal sequence number saved with the snapshot.
+  @return OS_TRUE if journal file was found, OS_FALSE if there is no journal.
+
+****************************************************************************************************
+*/
+os_boolean ePersistent::journal_load(
+    const os_char *path,
+    os_long snapshot_seq)
+{
+    eVariable tmp, *seq;
+    eOsStream *stream;
+    eObject *batch;
+    eContainer *record;
+    os_long batch_seq;
+    os_boolean found = OS_FALSE;
+
+    stream = new eOsStream(ETEMPORARY);
+    tmp.sets("file:");
+    tmp.appends(path);
+    if (stream->open(tmp.gets(), OS_NULL, OSAL_STREAM_READ) == ESTATUS_SUCCESS)
+    {
+        found = OS_TRUE;
+        while ((batch = read(stream, OSAL_STREAM_DEFAULT)))
+        {
+            batch->adopt(this, EOID_TEMPORARY, EOBJ_NO_MAP|EOBJ_IS_ATTACHMENT);
+            seq = eVariable::cast(batch->first(EOID_PARAMETER));
+            batch_seq = seq ? seq->getl() : 0;
+            if (batch_seq > snapshot_seq)
+            {
+                for (record = batch->firstc(); record; record = record->nextc()) {
+                    journal_replay(record);
+                }
+                m_journal_seq = batch_seq;
+            }
+            delete batch;
+        }
+        stream->close();
+    }
+    delete stream;
+    return found;
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Apply one journal record.
+
+  @param  record Journal record, see journal_add().
+
+****************************************************************************************************
+*/
+void ePersistent::journal_replay(
+    eContainer *record)
+{
+    eVariable *path, *v;
+    eObject *obj;
+    eName *name;
+    eMatrix *m;
+    os_int op, tflags;
+
+    path = eVariable::cast(record->first(EOID_PATH));
+    v = eVariable::cast(record->first(EOID_PARAMETER));
+    if (path == OS_NULL || v == OS_NULL) return;
+    op = v->geti();
+
+    /* Find child object by name, names may be mapped to parent's name space.
+     */
+    for (obj = first(); obj; obj = obj->next())
+    {
+        name = obj->primaryname(ENAME_PARENT_NS);
+        if (name == OS_NULL) name = obj->primaryname();
+        if (name) if (!os_strcmp(name->gets(), path->gets())) break;
+    }
+    if (obj == OS_NULL) return;
+
+    if (op == EPER_JOURNAL_SET_VALUE)
+    {
+        v = eVariable::cast(record->first(EOID_CONTENT));
+        if (v && obj->classid() == ECLASSID_VARIABLE) {
+            if (!((eVariable*)obj)->is_nosave()) {
+                ((eVariable*)obj)->setv(v);
+            }
+        }
+        return;
+    }
+
+    if (obj->classid() != ECLASSID_MATRIX) return;
+    m = (eMatrix*)obj;
+    v = eVariable::cast(record->first(EOID_FLAGS));
+    tflags = v ? v->geti() : 0;
+    v = eVariable::cast(record->first(EOID_TABLE_WHERE));
+
+    switch (op)
+    {
+        case EMTX_JOURNAL_INSERT:
+            m->insert(record->firstc(EOID_CONTENT), 0);
+            break;
+
+        case EMTX_JOURNAL_UPDATE:
+            if (v) m->update(v->gets(), record->firstc(EOID_CONTENT), tflags);
+            break;
+
+        case EMTX_JOURNAL_REMOVE:
+            if (v) m->remove(v->gets());
+            break;
     }
 }
 
 
+/**
+****************************************************************************************************
+
+  @brief Save large matrices of snapshot as memory image snapshot files.
+
+  The ePersistent::save_matrix_snapshots function moves rows of large matrices in snapshot
+  clone into separate messages, which eFileSystem saves as memory image snapshot files. The
+  matrices are left in snapshot without rows, so column configuration is saved as before.
+  Names of these matrices are listed in snapshot's EOID_APPENDIX container, so that loading
+  can tell them from matrices which are empty. Files are written to the slot not used by
+  previous snapshot, and are sent before the snapshot itself, so files of previous snapshot
+  stay valid until the new snapshot is saved.
+
+  @param  snapshot Clone of this persistent object to be saved.
+
+****************************************************************************************************
+*/
+void ePersistent::save_matrix_snapshots(
+    eObject *snapshot)
+{
+    eVariable root, target, *relative_path, *seq, *item;
+    eContainer *content, *saved_list = OS_NULL;
+    eMatrix *m, *data;
+    eObject *obj;
+    eName *name;
+    os_int slot;
+    os_boolean saved = OS_FALSE;
+
+    slot = m_matrix_slot ^ 1;
+    propertyv(EPERP_ROOT_PATH, &root);
+
+    for (obj = snapshot->first(); obj; obj = obj->next())
+    {
+        if (obj->classid() != ECLASSID_MATRIX) continue;
+        m = (eMatrix*)obj;
+        if (m->nrows() < EPER_MATRIX_SNAPSHOT_MIN_ROWS) continue;
+        if (!m->snapshot_supported()) continue;
+        name = obj->primaryname(ENAME_PARENT_NS);
+        if (name == OS_NULL) name = obj->primaryname();
+        if (name == OS_NULL) continue;
+
+        content = new eContainer(ETEMPORARY);
+        relative_path = new eVariable(content, EOID_PATH);
+        get_file_path(relative_path);
+        append_matrix_snapshot_name(relative_path, name->gets(), slot);
+        seq = new eVariable(content, EOID_PARAMETER);
+        seq->setl(m_journal_seq);
+        data = new eMatrix(content, EOID_CONTENT);
+        data->adopt_data(m);
+
+        target.setv(&root);
+        target.appends("/");
+        target.appendv(relative_path);
+        message(ECMD_SAVE_MATRIX_SNAPSHOT, target.gets(), OS_NULL, content, EMSG_DEL_CONTENT);
+        saved = OS_TRUE;
+
+        if (saved_list == OS_NULL) {
+            saved_list = new eContainer(snapshot, EOID_APPENDIX);
+        }
+        item = new eVariable(saved_list);
+        item->sets(name->gets());
+    }
+
+    if (saved) {
+        m_matrix_slot = slot;
+    }
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Load memory image snapshot files of matrices.
+
+  The ePersistent::load_matrix_snapshots function loads rows of matrices, which were saved
+  without rows, from memory image snapshot files. Only file with same sequence number as
+  loaded snapshot is accepted. If neither slot has valid file for a matrix listed in
+  snapshot's EOID_APPENDIX container, the matrix is left empty and error is reported.
+  Snapshots saved by older versions have no list, then missing files are not reported.
+
+  @param  content Loaded snapshot.
+  @param  path OS path to persistent object's file.
+  @param  seq Journal sequence number of loaded snapshot.
+  @return ESTATUS_SUCCESS if all matrices were loaded. ESTATUS_FAILED if rows of some matrix
+          could not be loaded from either slot.
+
+****************************************************************************************************
+*/
+eStatus ePersistent::load_matrix_snapshots(
+    eObject *content,
+    const os_char *path,
+    os_long seq)
+{
+    eVariable mpath, *v;
+    eContainer *saved_list;
+    eMatrix *m;
+    eObject *obj;
+    eName *name;
+    os_int slot;
+    eStatus s = ESTATUS_SUCCESS;
+
+    saved_list = eContainer::cast(content->first(EOID_APPENDIX));
+
+    for (obj = content->first(); obj; obj = obj->next())
+    {
+        if (obj->classid() != ECLASSID_MATRIX) continue;
+        m = (eMatrix*)obj;
+        if (m->nrows()) continue;
+        name = obj->primaryname(ENAME_PARENT_NS);
+        if (name == OS_NULL) name = obj->primaryname();
+        if (name == OS_NULL) continue;
+
+        for (slot = 0; slot < 2; slot++)
+        {
+            mpath.sets(path);
+            append_matrix_snapshot_name(&mpath, name->gets(), slot);
+            if (m->load_snapshot(mpath.gets(), seq) == ESTATUS_SUCCESS) {
+                m_matrix_slot = slot;
+                break;
+            }
+        }
+
+        if (slot >= 2 && saved_list)
+        {
+            for (v = saved_list->firstv(); v; v = v->nextv()) {
+                if (!os_strcmp(v->gets(), name->gets())) break;
+            }
+            if (v == OS_NULL) continue;
+
+            osal_debug_error_str("load_matrix_snapshots: No valid snapshot file for ",
+                mpath.gets());
+            s = ESTATUS_FAILED;
+        }
+    }
+
+    return s;
+}
+
+
+/* Append matrix snapshot file name to persistent file path, like ".rows.0.mtx".
+ */
+void ePersistent::append_matrix_snapshot_name(
+    eVariable *path,
+    const os_char *matrix_name,
+    os_int slot)
+{
+    path->appends(".");
+    path->appends(matrix_name);
+    path->appends(".");
+    path->appendl(slot);
+    path->appends(EMTX_SNAPSHOT_EXT);
+}
+
+
+/* Get path to persistent file relative to file system root, like "data/grumpy10/x.eo"
+ */
+void ePersistent::get_file_path(
+    eVariable *file_path)
+{
+    eVariable tmp;
+
+    get_relative_path(file_path);
+    propertyv(EPERP_FILE, &tmp);
+    file_path->appends("/");
+    file_path->appendv(&tmp);
+}
+
+
 /* Get relative path, like "data/grumpy10"
  */
 void ePersistent::get_relative_path(
@@ -457,6 +924,7 @@ void ePersistent::copy_loaded_matrix(
     eVariable *v, *tmp, *dcol;
     os_int max_src_cols, i, dst_i, *column_ix_tab;
     os_int nro_src_rows, row;
+    os_boolean same;
 
     /* Get column list of both source and destination matrices.
      */
@@ -473,6 +941,28 @@ void ePersistent::copy_loaded_matrix(
         return;
     }
 
+    /* If loaded matrix has same columns, take it's data blocks into use as such. Rows
+       in destination matrix are replaced.
+     */
+    same = (os_boolean)(srcm->datatype() == dstm->datatype() &&
+        srcm->ncolumns() == dstm->ncolumns() &&
+        src_cols->childcount() == dst_cols->childcount());
+    for (v = src_cols->firstv(); v && same; v = v->nextv())
+    {
+        n = v->primaryname();
+        dcol = n ? eVariable::cast(dst_cols->byname(n->gets())) : OS_NULL;
+        if (dcol == OS_NULL) {
+            same = OS_FALSE;
+        }
+        else if (dcol->is_nosave() || dcol->oid() != v->oid()) {
+            same = OS_FALSE;
+        }
+    }
+    if (same) {
+        dstm->adopt_data(srcm);
+        return;
+    }
+
     /* Generate column_ix_tab to convert source column index to destination column index.
      */
     max_src_cols = src_cols->childcount();
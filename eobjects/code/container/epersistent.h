@@ -33,6 +33,7 @@
 #define EPERP_FILE 30
 #define EPERP_SAVE_TIME_MS 40
 #define EPERP_SAVE_LATEST_TIME_MS 50
+#define EPERP_JOURNAL_MAX 60
 
 /* Persistent object property names.
  */
@@ -42,7 +43,22 @@ extern const os_char
     eperp_relative_path[],
     eperp_file[],
     eperp_save_time_ms[],
-    eperp_save_latest_time_ms[];
+    eperp_save_latest_time_ms[],
+    eperp_journal_max[];
+
+/* Journal record operation for variable value change. Table changes use EMTX_JOURNAL_INSERT,
+   EMTX_JOURNAL_UPDATE and EMTX_JOURNAL_REMOVE.
+ */
+#define EPER_JOURNAL_SET_VALUE 10
+
+/* Journal file name extension.
+ */
+#define EPER_JOURNAL_EXT ".jnl"
+
+/* Matrices with at least this many rows are saved as memory image snapshot file, like
+   "x.eo.rows.0.mtx", instead of serializing the rows within persistent object's file.
+ */
+#define EPER_MATRIX_SNAPSHOT_MIN_ROWS 1000
 
 /**
 ****************************************************************************************************
@@ -121,6 +137,11 @@ public:
     void load_file(
         const os_char *file_name);
 
+    /* Check if changes are journaled: Child matrix needs to generate change records only then.
+     */
+    inline os_boolean journaling()
+        {return (os_boolean)(m_journal_max > 0 && !m_snapshot_needed && !m_loading); }
+
 protected:
     /**
     ************************************************************************************************
@@ -140,6 +161,52 @@ protected:
      */
     void save_as_message();
 
+    /* Add change to journal, or mark that full save is needed.
+     */
+    void journal_add(
+        eCallbackEvent event,
+        eObject *obj,
+        eObject *appendix);
+
+    /* Send journal records collected since last save to file system.
+     */
+    void journal_save_as_message();
+
+    /* Load journal file and replay changes made after the snapshot.
+     */
+    os_boolean journal_load(
+        const os_char *path,
+        os_long snapshot_seq);
+
+    /* Apply one journal record.
+     */
+    void journal_replay(
+        eContainer *record);
+
+    /* Save large matrices of snapshot as memory image snapshot files.
+     */
+    void save_matrix_snapshots(
+        eObject *snapshot);
+
+    /* Load memory image snapshot files of matrices saved without rows.
+     */
+    eStatus load_matrix_snapshots(
+        eObject *content,
+        const os_char *path,
+        os_long seq);
+
+    /* Append matrix snapshot file name to persistent file path, like ".rows.0.mtx".
+     */
+    void append_matrix_snapshot_name(
+        eVariable *path,
+        const os_char *matrix_name,
+        os_int slot);
+
+    /* Get path to persistent file relative to file system root, like "data/grumpy10/x.eo".
+     */
+    void get_file_path(
+        eVariable *file_path);
+
     /* Get relative path, like "data/grumpy10"
      */
     void get_relative_path(
@@ -185,6 +252,40 @@ protected:
     /** Current periodic of timer messages.
      */
     os_int m_timer_ms;
+
+    /** Journal records not yet sent to file system, temporary attachment.
+     */
+    eContainer *m_journal;
+
+    /** Sequence number of latest journal batch. Snapshot stores this, so that batches
+        already included in snapshot are skipped on load.
+     */
+    os_long m_journal_seq;
+
+    /** Number of journaled values and rows since last snapshot, and limit which triggers
+        compaction to new snapshot. Limit 0 disables journal.
+     */
+    os_int m_journal_items;
+    os_int m_journal_max;
+
+    /** Full save is needed: Change which cannot be journaled, journal is full, or there
+        is no snapshot yet.
+     */
+    os_boolean m_snapshot_needed;
+
+    /** Next journal batch overwrites the journal file (first batch after snapshot).
+     */
+    os_boolean m_journal_truncate;
+
+    /** Set while loading, changes are not journaled.
+     */
+    os_boolean m_loading;
+
+    /** Matrix snapshot files are written alternately to slot 0 and 1, so that files of
+        previous snapshot are intact until new persistent object file has been saved. This
+        is the slot of latest snapshot.
+     */
+    os_int m_matrix_slot;
 };
 
 #endif
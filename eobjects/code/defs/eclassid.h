@@ -63,6 +63,8 @@
 #define ECLASSID_BINDING 31
 #define ECLASSID_SYNCHRONIZED 32
 #define ECLASSID_SYNC_CONNECTOR 33
+#define ECLASSID_CONNECTION_WORKER 34
+#define ECLASSID_BINDING_CHANNEL 35
 
 #define ECLASSID_STREAM 65
 #define ECLASSID_BUFFERED_STREAM 66
@@ -93,6 +95,9 @@
 #define ECLASSID_NETSERVICE 101
 #define ECLASSID_LIGHT_HOUSE_CLIENT 102
 #define ECLASSID_NET_MAINTAIN_CLIENT 103
+#define ECLASSID_FILE_WRITER 104
+#define ECLASSID_BITMAP_CODEC 105
+#define ECLASSID_BITMAP_CODEC_WORKER 106
 
 
 /* egui property numbers start from 128 */
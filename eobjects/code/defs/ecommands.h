@@ -64,6 +64,7 @@
 #define ECMD_REBIND -25
 #define ECMD_FWRD -26
 #define ECMD_ACK -27
+#define ECMD_FWRD_BATCH -28
 #define ECMD_RSET_SELECT -30
 
 /* Tables.
@@ -93,6 +94,29 @@
 /* File system related.
  */
 #define ECMD_SAVE_FILE -65
+#define ECMD_APPEND_FILE -66
+#define ECMD_SAVE_MATRIX_SNAPSHOT -67
+
+/* File system writer pool: Pass file to write to writer thread, writer informs that
+   file has been written.
+ */
+#define ECMD_FSYS_WRITE_JOB -68
+#define ECMD_FSYS_JOB_DONE -69
+
+/* Connection pool: Pass accepted connection to worker thread, worker informs that
+   connection has been closed.
+ */
+#define ECMD_POOL_ADD_CONNECTION -70
+#define ECMD_POOL_CONNECTION_CLOSED -71
+
+/* Bitmap codec: Request to compress or uncompress bitmap, reply with processed bitmap.
+   Codec passes bitmap to worker thread, worker informs that bitmap has been processed.
+ */
+#define ECMD_BITMAP_COMPRESS -72
+#define ECMD_BITMAP_UNCOMPRESS -73
+#define ECMD_BITMAP_CODEC_REPLY -74
+#define ECMD_BITMAP_CODEC_JOB -75
+#define ECMD_BITMAP_CODEC_DONE -76
 
 /* Thread control, exit thread.
  */
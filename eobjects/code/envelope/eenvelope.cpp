@@ -29,6 +29,26 @@ const os_char
 
 #define EENVELOPE_EXTRA_ALLOC 4
 
+/* Forward referred static functions.
+ */
+static eStatus eenvelope_write_path(
+    eStream *stream,
+    eEnvelopePath *path,
+    ePathDict *dict,
+    ePathDictTable *t);
+
+static eStatus eenvelope_read_path(
+    eStream *stream,
+    eEnvelopePath *path,
+    ePathDictTable *t,
+    const os_char *prefix,
+    const os_char *empty_prefix);
+
+static void eenvelope_read_str(
+    eStream *stream,
+    eEnvelopePath *path,
+    os_memsz n);
+
 /* Place name in front of the path.
  */
 void eenvelope_prepend_name(
@@ -374,12 +394,39 @@ eStatus eEnvelope::simpleproperty(
 eStatus eEnvelope::writer(
     eStream *stream,
     os_int flags)
+{
+    return dictwriter(stream, flags, OS_NULL);
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Write envelope to connection using path dictionary.
+
+  The eEnvelope::dictwriter() function serializes envelope like writer(), but target and
+  source paths found in connection's path dictionary are written as ids only. Path not yet
+  in dictionary is added to it and written with it's id.
+
+  @param  stream The stream to write to.
+  @param  flags Serialization flags.
+  @param  dict Connection's path dictionary, OS_NULL to write paths as strings.
+
+  @return If successfull the function returns ESTATUS_SUCCESS (0). If writing object to stream
+          fails, value ESTATUS_WRITING_OBJ_FAILED is returned. Assume that all nonzero values
+          indicate an error.
+
+****************************************************************************************************
+*/
+eStatus eEnvelope::dictwriter(
+    eStream *stream,
+    os_int flags,
+    ePathDict *dict)
 {
     /* Version number. Increment if new serialized items are to the object,
        and check for new version's items in read() function.
      */
     const os_int version = 0;
-    os_int n;
     os_short mflags;
     eObject *ctnt, *ctxt;
 
@@ -402,23 +449,15 @@ eStatus eEnvelope::writer(
 
     /* Write target.
      */
-    n = (os_int)(m_target.str_alloc - m_target.str_pos) - 1;
-    if (n <  0 || m_target.str == OS_NULL) n = 0;
-    if (stream->putl(n)) goto failed;
-    if (n > 0) {
-        stream->write(m_target.str + m_target.str_pos, n);
-    }
+    if (eenvelope_write_path(stream, &m_target, dict,
+        dict ? &dict->out_target : OS_NULL)) goto failed;
 
     /* Write source, unless EMSG_NO_REPLIES is given.
      */
     if ((m_mflags & EMSG_NO_REPLIES) == 0)
     {
-        n = (os_int)(m_source.str_alloc - m_source.str_pos) - 1;
-        if (n <  0 || m_source.str == OS_NULL) n = 0;
-        if (stream->putl(n)) goto failed;
-        if (n > 0) {
-            stream->write(m_source.str + m_source.str_pos, n);
-        }
+        if (eenvelope_write_path(stream, &m_source, dict,
+            dict ? &dict->out_source : OS_NULL)) goto failed;
     }
 
     /* Write content.
@@ -471,12 +510,42 @@ failed:
 eStatus eEnvelope::reader(
     eStream *stream,
     os_int flags)
+{
+    return dictreader(stream, flags, OS_NULL);
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Read envelope from connection using path dictionary.
+
+  The eEnvelope::dictreader() function reads envelope written by dictwriter(). If path
+  dictionary is given, connection's prefixes are added to target and source path: "/" to
+  target, or "//" if target is empty, and dictionary's source prefix to source path. Paths
+  found in dictionary are stored there with prefixes, so these do not need to be formatted
+  again for every envelope.
+
+  @param  stream The stream to read from.
+  @param  flags Serialization flags.
+  @param  dict Connection's path dictionary, OS_NULL to read paths as strings without
+          adding prefixes.
+
+  @return If successfull the function returns ESTATUS_SUCCESS (0). If writing object to stream
+          fails, value ESTATUS_READING_OBJ_FAILED is returned. Assume that all nonzero values
+          indicate an error.
+
+****************************************************************************************************
+*/
+eStatus eEnvelope::dictreader(
+    eStream *stream,
+    os_int flags,
+    ePathDict *dict)
 {
     /* Version number. Used to check which versions item's are in serialized data.
      */
     // os_int version;
     os_long l, mflags;
-    os_memsz sz;
     os_int c;
 
     /* Read object start mark and version number.
@@ -510,29 +579,16 @@ eStatus eEnvelope::reader(
 
     /* Read target.
      */
-    if (stream->getl(&l)) goto failed;
-    if (l > 0)
-    {
-        m_target.str = os_malloc(l + 1 + EENVELOPE_EXTRA_ALLOC, &sz);
-        m_target.str_alloc = (os_short)sz;
-        m_target.str_pos = (os_short)(sz - l - 1);
-        stream->read(m_target.str + m_target.str_pos, l);
-        m_target.str[m_target.str_pos + l] = '\0';
-    }
+    if (eenvelope_read_path(stream, &m_target, dict ? &dict->in_target : OS_NULL,
+        "/", "//")) goto failed;
 
     /* Read source, unless EMSG_NO_REPLIES is given.
      */
     if ((m_mflags & EMSG_NO_REPLIES) == 0)
     {
-        if (stream->getl(&l)) goto failed;
-        if (l > 0)
-        {
-            m_source.str = os_malloc(l + 1 + EENVELOPE_EXTRA_ALLOC, &sz);
-            m_source.str_alloc = (os_short)sz;
-            m_source.str_pos = (os_short)(sz - l - 1);
-            stream->read(m_source.str + m_source.str_pos, l);
-            m_source.str[m_source.str_pos + l] = '\0';
-        }
+        if (eenvelope_read_path(stream, &m_source, dict ? &dict->in_source : OS_NULL,
+            dict ? dict->source_prefix : OS_NULL,
+            dict ? dict->source_prefix : OS_NULL)) goto failed;
     }
 
     /* Read content.
@@ -720,3 +776,150 @@ void eEnvelope::prependsourceoix(
 }
 
 
+/**
+****************************************************************************************************
+
+  @brief Write target or source path.
+
+  The eenvelope_write_path() function writes path as string, or if path dictionary is used,
+  as dictionary id (with the string if path was just added to dictionary).
+
+  @param  stream The stream to write to.
+  @param  path Path to write.
+  @param  dict Path dictionary for statistics, OS_NULL if not used.
+  @param  t Sending side dictionary table, OS_NULL if not used.
+  @return ESTATUS_SUCCESS if successfull, other values indicate an error.
+
+****************************************************************************************************
+*/
+static eStatus eenvelope_write_path(
+    eStream *stream,
+    eEnvelopePath *path,
+    ePathDict *dict,
+    ePathDictTable *t)
+{
+    const os_char *str;
+    os_boolean define;
+    os_int n, id;
+
+    n = (os_int)(path->str_alloc - path->str_pos) - 1;
+    if (n <  0 || path->str == OS_NULL) n = 0;
+    str = path->str + path->str_pos;
+
+    if (t)
+    {
+        id = epathdict_lookup(t, str, n, &define);
+        if (id >= 0)
+        {
+            if (!define) {
+                dict->nhits++;
+                return stream->putl(EPATHDICT_REF(id));
+            }
+            if (stream->putl(EPATHDICT_DEF(id))) return ESTATUS_FAILED;
+        }
+        dict->nmisses++;
+    }
+
+    if (stream->putl(n)) return ESTATUS_FAILED;
+    if (n > 0) {
+        stream->write(str, n);
+    }
+    return ESTATUS_SUCCESS;
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Read target or source path.
+
+  The eenvelope_read_path() function reads path written by eenvelope_write_path(). If
+  dictionary table is given, prefix is added to path and paths defined by sender are stored
+  in dictionary with the prefix.
+
+  @param  stream The stream to read from.
+  @param  path Path to set, must be empty.
+  @param  t Receiving side dictionary table, OS_NULL if not used.
+  @param  prefix Prefix to add to path, if dictionary is used.
+  @param  empty_prefix Prefix to use if path is empty.
+  @return ESTATUS_SUCCESS if successfull, other values indicate an error.
+
+****************************************************************************************************
+*/
+static eStatus eenvelope_read_path(
+    eStream *stream,
+    eEnvelopePath *path,
+    ePathDictTable *t,
+    const os_char *prefix,
+    const os_char *empty_prefix)
+{
+    ePathDictEntry *e;
+    os_memsz sz;
+    os_long l;
+    os_boolean define;
+    os_int id;
+
+    if (stream->getl(&l)) return ESTATUS_FAILED;
+    if (l >= 0)
+    {
+        eenvelope_read_str(stream, path, l);
+        if (t) {
+            eenvelope_prepend_name(path, l > 0 ? prefix : empty_prefix);
+        }
+        return ESTATUS_SUCCESS;
+    }
+    if (t == OS_NULL) return ESTATUS_FAILED;
+
+    id = EPATHDICT_ID(l);
+    define = EPATHDICT_IS_DEF(l);
+
+    /* New path: Read the string, add prefix and store in dictionary.
+     */
+    if (define)
+    {
+        if (stream->getl(&l)) return ESTATUS_FAILED;
+        if (l <= 0 || l > EPATHDICT_MAX_PATH) return ESTATUS_FAILED;
+        eenvelope_read_str(stream, path, l);
+        eenvelope_prepend_name(path, prefix);
+        return epathdict_define(t, id, path->str + path->str_pos,
+            (os_int)os_strlen(path->str + path->str_pos));
+    }
+
+    /* Known path, copy it from dictionary.
+     */
+    e = epathdict_get(t, id);
+    if (e == OS_NULL) return ESTATUS_FAILED;
+    path->str = os_malloc(e->len + 1 + EENVELOPE_EXTRA_ALLOC, &sz);
+    path->str_alloc = (os_short)sz;
+    path->str_pos = (os_short)(sz - e->len - 1);
+    os_memcpy(path->str + path->str_pos, e->str, e->len + 1);
+    return ESTATUS_SUCCESS;
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Read path string.
+
+  @param  stream The stream to read from.
+  @param  path Path to set, must be empty.
+  @param  n String length in bytes.
+  @return None.
+
+****************************************************************************************************
+*/
+static void eenvelope_read_str(
+    eStream *stream,
+    eEnvelopePath *path,
+    os_memsz n)
+{
+    os_memsz sz;
+
+    if (n <= 0) return;
+    path->str = os_malloc(n + 1 + EENVELOPE_EXTRA_ALLOC, &sz);
+    path->str_alloc = (os_short)sz;
+    path->str_pos = (os_short)(sz - n - 1);
+    stream->read(path->str + path->str_pos, n);
+    path->str[path->str_pos + n] = '\0';
+}
@@ -144,6 +144,20 @@ public:
         eStream *stream,
         os_int flags);
 
+    /* Write envelope to connection using path dictionary.
+     */
+    eStatus dictwriter(
+        eStream *stream,
+        os_int flags,
+        ePathDict *dict);
+
+    /* Read envelope from connection using path dictionary.
+     */
+    eStatus dictreader(
+        eStream *stream,
+        os_int flags,
+        ePathDict *dict);
+
 
     /**
     ************************************************************************************************
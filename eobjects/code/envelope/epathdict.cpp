@@ -0,0 +1,183 @@
+/**
+
+  @file    epathdict.cpp
+  @brief   Session path dictionary for envelopes passed over connection.
+  @author  Pekka Lehtikoski
+  @version 1.0
+  @date    18.10.2026
+
+  Both ends of connection keep own dictionaries for paths sent and received. Ids are given
+  in order starting from 0, so receiving end can check that definitions arrive in the same
+  order. Dictionaries live as long as the socket connection, and are cleared on reconnect.
+
+  Copyright 2020 Pekka Lehtikoski. This file is part of the eobjects project and shall only be used,
+  modified, and distributed under the terms of the project licensing. By continuing to use, modify,
+  or distribute this file you indicate that you have read the license and understand and accept
+  it fully.
+
+****************************************************************************************************
+*/
+#include "eobjects.h"
+
+/* Forward referred static functions.
+ */
+static void epathdict_release_table(
+    ePathDictTable *t);
+
+
+/**
+****************************************************************************************************
+
+  @brief Clear path dictionary.
+
+  The epathdict_init() function clears the dictionary and stores prefix which is added to
+  received source paths.
+
+  @param   dict Path dictionary to set up.
+  @param   source_prefix Prefix to add to received source paths.
+  @return  None.
+
+****************************************************************************************************
+*/
+void epathdict_init(
+    ePathDict *dict,
+    const os_char *source_prefix)
+{
+    os_memclear(dict, sizeof(ePathDict));
+    os_strncpy(dict->source_prefix, source_prefix, sizeof(dict->source_prefix));
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Release memory allocated for path strings.
+
+  @param   dict Path dictionary.
+  @return  None.
+
+****************************************************************************************************
+*/
+void epathdict_release(
+    ePathDict *dict)
+{
+    epathdict_release_table(&dict->out_target);
+    epathdict_release_table(&dict->out_source);
+    epathdict_release_table(&dict->in_target);
+    epathdict_release_table(&dict->in_source);
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Find or add path to send.
+
+  The epathdict_lookup() function finds path from sending side dictionary. If path is not
+  there, it is added and *define is set to tell caller that path string needs to be sent
+  together with the id.
+
+  @param   t Sending side dictionary table.
+  @param   path Path string, need not be '\0' terminated.
+  @param   len Path length in bytes.
+  @param   define Set to OS_TRUE if path was added to dictionary.
+  @return  Path id, or -1 if path is not in dictionary and cannot be added (dictionary is
+           full or path is too long).
+
+****************************************************************************************************
+*/
+os_int epathdict_lookup(
+    ePathDictTable *t,
+    const os_char *path,
+    os_int len,
+    os_boolean *define)
+{
+    ePathDictEntry *e;
+    os_uint hash, h;
+    os_int i, id;
+
+    *define = OS_FALSE;
+    if (len <= 0 || len > EPATHDICT_MAX_PATH) return -1;
+
+    /* FNV-1a hash.
+     */
+    hash = 2166136261U;
+    for (i = 0; i < len; i++) {
+        hash = (hash ^ (os_uchar)path[i]) * 16777619U;
+    }
+
+    for (h = hash & (EPATHDICT_HASH_SZ - 1); t->htab[h]; h = (h + 1) & (EPATHDICT_HASH_SZ - 1))
+    {
+        e = t->e + t->htab[h] - 1;
+        if (e->hash == hash && e->len == len && !os_memcmp(e->str, path, len)) {
+            return t->htab[h] - 1;
+        }
+    }
+
+    if (t->n >= EPATHDICT_SZ) return -1;
+
+    id = t->n++;
+    e = t->e + id;
+    e->str = os_malloc(len + 1, OS_NULL);
+    os_memcpy(e->str, path, len);
+    e->str[len] = '\0';
+    e->len = (os_short)len;
+    e->hash = hash;
+    t->htab[h] = (os_short)(id + 1);
+    *define = OS_TRUE;
+    return id;
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Store received path to receiving side dictionary.
+
+  @param   t Receiving side dictionary table.
+  @param   id Path id, must be next unused id.
+  @param   path Path string with prefix added.
+  @param   len Path length in bytes.
+  @return  ESTATUS_SUCCESS if successfull, ESTATUS_FAILED if id is not the expected one.
+
+****************************************************************************************************
+*/
+eStatus epathdict_define(
+    ePathDictTable *t,
+    os_int id,
+    const os_char *path,
+    os_int len)
+{
+    ePathDictEntry *e;
+
+    if (id != t->n || id >= EPATHDICT_SZ) return ESTATUS_FAILED;
+
+    e = t->e + t->n++;
+    e->str = os_malloc(len + 1, OS_NULL);
+    os_memcpy(e->str, path, len);
+    e->str[len] = '\0';
+    e->len = (os_short)len;
+    return ESTATUS_SUCCESS;
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Release path strings of one dictionary table.
+
+  @param   t Dictionary table.
+  @return  None.
+
+****************************************************************************************************
+*/
+static void epathdict_release_table(
+    ePathDictTable *t)
+{
+    os_int i;
+
+    for (i = 0; i < t->n; i++) {
+        os_free(t->e[i].str, t->e[i].len + 1);
+    }
+    os_memclear(t, sizeof(ePathDictTable));
+}
@@ -0,0 +1,143 @@
+/**
+
+  @file    epathdict.h
+  @brief   Session path dictionary for envelopes passed over connection.
+  @author  Pekka Lehtikoski
+  @version 1.0
+  @date    18.10.2026
+
+  Same target and source paths are repeated in most envelopes sent over a connection. The path
+  dictionary assigns an id to a path when it is sent for the first time, and after that only
+  the id is sent. Receiving end keeps decoded paths, with connection's prefixes already added.
+
+  Copyright 2020 Pekka Lehtikoski. This file is part of the eobjects project and shall only be used,
+  modified, and distributed under the terms of the project licensing. By continuing to use, modify,
+  or distribute this file you indicate that you have read the license and understand and accept
+  it fully.
+
+****************************************************************************************************
+*/
+#pragma once
+#ifndef EPATHDICT_H_
+#define EPATHDICT_H_
+#include "eobjects.h"
+
+/* Maximum number of paths in one direction's dictionary, paths are not replaced when full.
+ */
+#define EPATHDICT_SZ 256
+
+/* Hash table size for finding paths to send, must be power of two and larger than EPATHDICT_SZ.
+ */
+#define EPATHDICT_HASH_SZ 512
+
+/* Longer paths are always sent as strings.
+ */
+#define EPATHDICT_MAX_PATH 256
+
+/* Path length on the wire is written with putl(): Value >= 0 is string length and string
+   follows. Negative value is reference to dictionary, or definition of new dictionary
+   entry followed by string length and string.
+ */
+#define EPATHDICT_REF(id) (-1 - 2 * (os_long)(id))
+#define EPATHDICT_DEF(id) (-2 - 2 * (os_long)(id))
+#define EPATHDICT_ID(l) ((os_int)((-(l) - 1) >> 1))
+#define EPATHDICT_IS_DEF(l) (((-(l) - 1) & 1) != 0)
+
+/* One path in dictionary.
+ */
+typedef struct ePathDictEntry
+{
+    /* Path string, with prefix added on receiving side. '\0' terminated.
+     */
+    os_char *str;
+
+    /* String length, not including terminating '\0'.
+     */
+    os_short len;
+
+    /* Hash of path string (sending side only).
+     */
+    os_uint hash;
+}
+ePathDictEntry;
+
+/* Dictionary for one kind of paths (targets or sources) in one direction.
+ */
+typedef struct ePathDictTable
+{
+    ePathDictEntry e[EPATHDICT_SZ];
+
+    /* Sending side: Index to e + 1 by hash, 0 if unused.
+     */
+    os_short htab[EPATHDICT_HASH_SZ];
+
+    /* Number of used entries in e.
+     */
+    os_int n;
+}
+ePathDictTable;
+
+/* Path dictionary of a connection.
+ */
+typedef struct ePathDict
+{
+    /* Dictionaries for paths we send.
+     */
+    ePathDictTable out_target;
+    ePathDictTable out_source;
+
+    /* Dictionaries for paths received, prefixes added.
+     */
+    ePathDictTable in_target;
+    ePathDictTable in_source;
+
+    /* Prefix to add to received source paths, like "@17_3/_r".
+     */
+    os_char source_prefix[E_OIXSTR_BUF_SZ + 3];
+
+    /* Statistics: Number of paths sent as id only and number of paths sent as string.
+     */
+    os_long nhits;
+    os_long nmisses;
+}
+ePathDict;
+
+/* Clear path dictionary.
+ */
+void epathdict_init(
+    ePathDict *dict,
+    const os_char *source_prefix);
+
+/* Release memory allocated for path strings.
+ */
+void epathdict_release(
+    ePathDict *dict);
+
+/* Find or add path to send, returns id or -1 if path is not in dictionary and cannot
+   be added. *define is set if path was added.
+ */
+os_int epathdict_lookup(
+    ePathDictTable *t,
+    const os_char *path,
+    os_int len,
+    os_boolean *define);
+
+/* Store received path (prefix already added) to receiving side dictionary.
+ */
+eStatus epathdict_define(
+    ePathDictTable *t,
+    os_int id,
+    const os_char *path,
+    os_int len);
+
+/* Get received path by id, OS_NULL if id is not defined.
+ */
+inline ePathDictEntry *epathdict_get(
+    ePathDictTable *t,
+    os_int id)
+{
+    if (id < 0 || id >= t->n) return OS_NULL;
+    return t->e + id;
+}
+
+#endif
@@ -18,7 +18,11 @@
 /* File system property names.
  */
 const os_char
-    efsysp_path[] = "path";
+    efsysp_path[] = "path",
+    efsysp_pool_size[] = "poolsize",
+    efsysp_nqueued[] = "nqueued",
+    efsysp_ncoalesced[] = "ncoalesced",
+    efsysp_latency[] = "latency";
 
 /**
 ****************************************************************************************************
@@ -32,6 +36,12 @@ eFileSystem::eFileSystem(
     : eThread(parent, oid, flags)
 {
     m_path = new eVariable(this);
+    m_pool_size = EFSYS_DEFAULT_POOL_SIZE;
+    m_pool_started = 0;
+    m_nqueued = 0;
+    m_ncoalesced = m_nwritten = m_latency_sum = 0;
+    os_get_timer(&m_stats_timer);
+    m_stats_pending = OS_FALSE;
     initproperties();
 }
 
@@ -88,12 +98,22 @@ eObject *eFileSystem::clone(
 void eFileSystem::setupclass()
 {
     const os_int cls = ECLASSID_FILE_SYSTEM;
+    eVariable *p;
 
     /* Add the class to class list.
      */
     os_lock();
     eclasslist_add(cls, (eNewObjFunc)newobj, "eFileSystem", ECLASSID_THREAD);
     addpropertys(cls, EFSYSP_PATH, efsysp_path, "/coderoot/fsys", "path", EPRO_SIMPLE);
+    addpropertyl(cls, EFSYSP_POOL_SIZE, efsysp_pool_size, EFSYS_DEFAULT_POOL_SIZE,
+        "writer threads", EPRO_SIMPLE);
+    addpropertyl(cls, EFSYSP_NQUEUED, efsysp_nqueued, 0, "files queued",
+        EPRO_RDONLY);
+    addpropertyl(cls, EFSYSP_NCOALESCED, efsysp_ncoalesced, 0, "saves coalesced",
+        EPRO_RDONLY);
+    p = addpropertyl(cls, EFSYSP_LATENCY, efsysp_latency, 0, "average write time",
+        EPRO_RDONLY);
+    p->setpropertys(EVARP_UNIT, "us");
     propertysetdone(cls);
     os_unlock();
 }
@@ -104,6 +124,24 @@ void eFileSystem::initialize(
 }
 
 
+/**
+****************************************************************************************************
+
+  @brief File system thread main loop.
+
+  The eFileSystem::run() function processes messages until thread is requested to exit.
+  Then writer threads are stopped and files still waiting in queue are written, so that
+  no save is lost when the process exits.
+
+****************************************************************************************************
+*/
+void eFileSystem::run()
+{
+    eThread::run();
+    stop_pool();
+}
+
+
 /**
 ****************************************************************************************************
 
@@ -138,11 +176,28 @@ void eFileSystem::onmessage(
             return;
 
           case ECMD_SAVE_FILE:
+          case ECMD_APPEND_FILE:
+          case ECMD_SAVE_MATRIX_SNAPSHOT:
             save_file(envelope);
             return;
         }
     }
 
+    /* Writer thread has written a file, or time to update statistics */
+    else if (c == '\0')
+    {
+        switch (envelope->command())
+        {
+          case ECMD_FSYS_JOB_DONE:
+            job_done(envelope);
+            return;
+
+          case ECMD_TIMER:
+            fsys_stats(OS_TRUE);
+            return;
+        }
+    }
+
     eThread::onmessage(envelope);
 }
 
@@ -173,6 +228,17 @@ eStatus eFileSystem::onpropertychange(
         case EFSYSP_PATH: /* Read only for sandbox security */
             break;
 
+        case EFSYSP_POOL_SIZE: /* Effective only until first file is queued */
+            m_pool_size = x->geti();
+            if (m_pool_size < 0) m_pool_size = 0;
+            if (m_pool_size > EFSYS_MAX_POOL_SIZE) m_pool_size = EFSYS_MAX_POOL_SIZE;
+            break;
+
+        case EFSYSP_NQUEUED:
+        case EFSYSP_NCOALESCED:
+        case EFSYSP_LATENCY:
+            break;
+
         default:
             return eThread::onpropertychange(propertynr, x, flags);
     }
@@ -206,6 +272,10 @@ eStatus eFileSystem::simpleproperty(
             m_path->setv(m_path);
             break;
 
+        case EFSYSP_POOL_SIZE:
+            x->setl(m_pool_size);
+            break;
+
         default:
             return eThread::simpleproperty(propertynr, x);
     }
@@ -357,6 +427,13 @@ void eFileSystem::object_info(
 
   @brief Save envelope content as a file (binary serialization).
 
+  ECMD_SAVE_FILE overwrites the file. ECMD_APPEND_FILE adds the content to end of the file,
+  used by ePersistent to write journal. ECMD_SAVE_MATRIX_SNAPSHOT saves eMatrix content as
+  memory image snapshot, message content holds also sequence number (EOID_PARAMETER).
+
+  If "poolsize" property is nonzero, the file is queued to be written by writer thread.
+  Otherwise it is written here, within the file system thread.
+
   @param envelope Message envelope received by the eFileSystem object. This is eContainer
          which holds eVariable for path and eObject for content.
 
@@ -365,7 +442,7 @@ void eFileSystem::object_info(
 void eFileSystem::save_file(
     eEnvelope *envelope)
 {
-    eObject *c, *file_content;
+    eObject *c;
     eVariable file_path, *relative_path;
     const os_char *p;
     eStatus s = ESTATUS_FAILED;
@@ -386,10 +463,14 @@ void eFileSystem::save_file(
 
         if (relative_path) {
             file_path.appendv(relative_path);
-            file_content = c->first(EOID_CONTENT);
-            if (file_content) {
-                s = file_content->save(file_path.gets());
+
+            if (m_pool_size > 0 || m_pool_started) {
+                queue_file(envelope, &file_path);
+                return;
             }
+
+            s = eFileWriter::write_file(envelope->command(), file_path.gets(),
+                c->first(EOID_CONTENT), eVariable::cast(c->first(EOID_PARAMETER)));
         }
     }
 
@@ -408,6 +489,276 @@ void eFileSystem::save_file(
 }
 
 
+/**
+****************************************************************************************************
+
+  @brief Queue file save for writer thread.
+
+  The eFileSystem::queue_file() function moves save message content to queue of a writer
+  thread. The writer is selected by file name up to the first '.', so ".eo", ".jnl" and
+  ".mtx" files of one persistent object are always written by the same writer, in the
+  order in which they were received. Different objects are written concurrently.
+
+  If the same file is saved again before earlier save has been passed to writer, only the
+  newest content is kept. Only saves at the end of the queue are replaced this way, so
+  that order of different files of the object doesn't change. Appends are never replaced.
+  Reply paths of replaced saves are moved to the newest save, so every sender gets reply
+  when the file has been written.
+
+  @param envelope Save message. Content is adopted by the queue.
+  @param file_path Full OS path to the file.
+
+****************************************************************************************************
+*/
+void eFileSystem::queue_file(
+    eEnvelope *envelope,
+    eVariable *file_path)
+{
+    eObject *job, *o, *prev_o;
+    eContainer *queue;
+    eVariable *v, *next_v;
+    const os_char *p;
+    os_uint hash;
+    os_int command, nr;
+
+    if (!m_pool_started) {
+        start_pool();
+    }
+
+    /* Select writer by file name without extensions.
+     */
+    p = os_strechr(file_path->gets(), '/');
+    p = p ? p + 1 : file_path->gets();
+    while (*p == '.') p++;
+    for (hash = 0; *p != '\0' && *p != '.'; p++) {
+        hash = 31 * hash + (os_uchar)*p;
+    }
+    nr = (os_int)(hash % (os_uint)m_pool_started);
+    queue = m_pool_queue[nr];
+
+    /* Move message content to queue and add full path, command and reply path to it.
+     */
+    command = envelope->command();
+    job = envelope->content();
+    eVariable::cast(job->first(EOID_PATH))->setv(file_path);
+    v = new eVariable(job, EOID_FLAGS);
+    v->setl(command);
+    if ((envelope->mflags() & EMSG_NO_REPLIES) == 0) {
+        v = new eVariable(job, EOID_CONTEXT);
+        v->sets(envelope->source());
+    }
+
+    /* Drop earlier saves of the same file at end of queue, keep their reply paths.
+     */
+    if (command != ECMD_APPEND_FILE)
+    {
+        for (o = queue->last(); o; o = prev_o)
+        {
+            prev_o = o->prev();
+            v = eVariable::cast(o->first(EOID_FLAGS));
+            if (v->geti() == ECMD_APPEND_FILE) break;
+            if (eVariable::cast(o->first(EOID_PATH))->compare(file_path)) break;
+            for (v = eVariable::cast(o->first(EOID_CONTEXT)); v; v = next_v) {
+                next_v = eVariable::cast(v->next(EOID_CONTEXT));
+                v->adopt(job, EOID_CONTEXT);
+            }
+            delete o;
+            m_nqueued--;
+            m_ncoalesced++;
+        }
+    }
+
+    job->adopt(queue, EOID_ITEM, EOBJ_NO_MAP);
+    m_nqueued++;
+
+    dispatch(nr);
+    fsys_stats(OS_FALSE);
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Pass next queued file save to writer thread.
+
+  The eFileSystem::dispatch() function sends the oldest queued save to writer, unless the
+  writer is already writing a file. Only one job at a time is given to a writer, so that
+  saves waiting in queue can still be replaced by newer ones.
+
+  @param nr Writer index.
+
+****************************************************************************************************
+*/
+void eFileSystem::dispatch(
+    os_int nr)
+{
+    eObject *job;
+
+    if (m_pool_busy[nr]) return;
+    job = m_pool_queue[nr]->first();
+    if (job == OS_NULL) return;
+
+    m_pool_busy[nr] = OS_TRUE;
+    m_nqueued--;
+    message(ECMD_FSYS_WRITE_JOB, m_pool[nr]->uniquename(), OS_NULL, job, EMSG_DEL_CONTENT);
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Writer thread has written a file.
+
+  The eFileSystem::job_done() function processes ECMD_FSYS_JOB_DONE from writer: Updates
+  write time statistics and passes next queued save to the writer.
+
+  @param envelope ECMD_FSYS_JOB_DONE message. Content holds writer index (EOID_PARAMETER)
+         and write time in microseconds (EOID_CONTENT).
+
+****************************************************************************************************
+*/
+void eFileSystem::job_done(
+    eEnvelope *envelope)
+{
+    eObject *c;
+    eVariable *v;
+    os_int nr;
+
+    c = envelope->content();
+    if (c == OS_NULL) return;
+    v = eVariable::cast(c->first(EOID_PARAMETER));
+    if (v == OS_NULL) return;
+    nr = v->geti();
+    if (nr < 0 || nr >= m_pool_started) return;
+
+    v = eVariable::cast(c->first(EOID_CONTENT));
+    if (v) {
+        m_latency_sum += v->getl();
+        m_nwritten++;
+    }
+
+    m_pool_busy[nr] = OS_FALSE;
+    dispatch(nr);
+    fsys_stats(OS_FALSE);
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Start file writer threads.
+
+  The eFileSystem::start_pool() function starts "poolsize" writer threads when the first
+  file is queued. Number of writers doesn't change after this, since file to writer
+  mapping depends on it.
+
+****************************************************************************************************
+*/
+void eFileSystem::start_pool()
+{
+    eFileWriter *w;
+    os_int nr;
+
+    for (nr = 0; nr < m_pool_size; nr++)
+    {
+        m_pool[nr] = new eThreadHandle(this);
+        m_pool_queue[nr] = new eContainer(this);
+        m_pool_busy[nr] = OS_FALSE;
+
+        w = new eFileWriter();
+        w->set_worker_nr(nr);
+        w->start(m_pool[nr]); /* After this w pointer is useless */
+    }
+    m_pool_started = m_pool_size;
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Terminate file writer threads and write files still in queue.
+
+  The eFileSystem::stop_pool() function requests writer threads to exit and waits for them.
+  Writers finish the file being written before exiting. Saves still waiting in queues are
+  then written by the calling thread, in order.
+
+****************************************************************************************************
+*/
+void eFileSystem::stop_pool()
+{
+    eObject *job;
+    eVariable *path, *command;
+    os_int nr;
+    eStatus s;
+
+    for (nr = 0; nr < m_pool_started; nr++) {
+        m_pool[nr]->terminate();
+    }
+    for (nr = 0; nr < m_pool_started; nr++) {
+        m_pool[nr]->join();
+        delete m_pool[nr];
+    }
+
+    for (nr = 0; nr < m_pool_started; nr++)
+    {
+        while ((job = m_pool_queue[nr]->first()))
+        {
+            path = eVariable::cast(job->first(EOID_PATH));
+            command = eVariable::cast(job->first(EOID_FLAGS));
+            s = eFileWriter::write_file(command->geti(), path->gets(), job->first(EOID_CONTENT),
+                eVariable::cast(job->first(EOID_PARAMETER)));
+            if (s) {
+                osal_debug_error_str("eFileSystem: Saving failed: ", path->gets());
+            }
+            eFileWriter::reply_job(this, job, s);
+            delete job;
+        }
+        delete m_pool_queue[nr];
+    }
+
+    m_pool_started = 0;
+    m_nqueued = 0;
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Set statistics properties.
+
+  The eFileSystem::fsys_stats() function sets "nqueued", "ncoalesced" and "latency" properties
+  from member variables, so that changes are forwarded to bindings. Queue changes with every
+  save, so properties are set at most once per EFSYS_STATS_MS. If called sooner, timer is
+  started to set the properties when the interval has passed.
+
+  @param now OS_TRUE to set properties now (timer hit), OS_FALSE if statistics have changed.
+
+****************************************************************************************************
+*/
+void eFileSystem::fsys_stats(
+    os_boolean now)
+{
+    if (!now && !os_has_elapsed(&m_stats_timer, EFSYS_STATS_MS))
+    {
+        if (!m_stats_pending) {
+            m_stats_pending = OS_TRUE;
+            timer(EFSYS_STATS_MS);
+        }
+        return;
+    }
+
+    if (m_stats_pending) {
+        m_stats_pending = OS_FALSE;
+        timer(0);
+    }
+    os_get_timer(&m_stats_timer);
+
+    setpropertyl(EFSYSP_NQUEUED, m_nqueued);
+    setpropertyl(EFSYSP_NCOALESCED, m_ncoalesced);
+    setpropertyl(EFSYSP_LATENCY, m_nwritten ? m_latency_sum / m_nwritten : 0);
+}
+
+
 /**
 ****************************************************************************************************
 
@@ -28,11 +28,33 @@
 /* File system property numbers.
  */
 #define EFSYSP_PATH 10
+#define EFSYSP_POOL_SIZE 12
+#define EFSYSP_NQUEUED 13
+#define EFSYSP_NCOALESCED 14
+#define EFSYSP_LATENCY 15
 
 /* File system property names.
  */
 extern const os_char
-    efsysp_path[];
+    efsysp_path[],
+    efsysp_pool_size[],
+    efsysp_nqueued[],
+    efsysp_ncoalesced[],
+    efsysp_latency[];
+
+/* Maximum and default number of file writer threads. Pool size 0 writes files in file
+   system thread.
+ */
+#define EFSYS_MAX_POOL_SIZE 16
+#define EFSYS_DEFAULT_POOL_SIZE 2
+
+/* New file content is written to file with this extension appended, and then renamed.
+ */
+#define EFSYS_TMP_EXT ".tmp"
+
+/* Minimum interval between updates of "nqueued", "ncoalesced" and "latency" properties, ms.
+ */
+#define EFSYS_STATS_MS 200
 
 
 /**
@@ -91,6 +113,10 @@ public:
     virtual void initialize(
         eContainer *params = OS_NULL);
 
+    /* File system thread main loop.
+     */
+    virtual void run();
+
     /* Process an incoming message.
      */
     virtual void onmessage(
@@ -142,6 +168,35 @@ protected:
     void save_file(
         eEnvelope *envelope);
 
+    /* Queue file save for writer thread.
+     */
+    void queue_file(
+        eEnvelope *envelope,
+        eVariable *file_path);
+
+    /* Pass next queued file save to writer thread, if it is idle.
+     */
+    void dispatch(
+        os_int nr);
+
+    /* Writer thread has saved a file.
+     */
+    void job_done(
+        eEnvelope *envelope);
+
+    /* Start file writer threads.
+     */
+    void start_pool();
+
+    /* Terminate file writer threads and write files still in queue.
+     */
+    void stop_pool();
+
+    /* Set statistics properties, at most once per EFSYS_STATS_MS.
+     */
+    void fsys_stats(
+        os_boolean now);
+
     /**
     ************************************************************************************************
       Member variables
@@ -151,6 +206,37 @@ protected:
     /* OS path to root directory
      */
     eVariable *m_path;
+
+    /** Number of file writer threads to use, and number of threads started.
+     */
+    os_int m_pool_size;
+    os_int m_pool_started;
+
+    /** File writer thread handles.
+     */
+    eThreadHandle *m_pool[EFSYS_MAX_POOL_SIZE];
+
+    /** File saves waiting for each writer thread, oldest first.
+     */
+    eContainer *m_pool_queue[EFSYS_MAX_POOL_SIZE];
+
+    /** Writer thread is saving a file.
+     */
+    os_boolean m_pool_busy[EFSYS_MAX_POOL_SIZE];
+
+    /** Statistics: Queued saves, saves replaced by newer save of same file, number of
+        files written and total write time in microseconds.
+     */
+    os_int m_nqueued;
+    os_long m_ncoalesced;
+    os_long m_nwritten;
+    os_long m_latency_sum;
+
+    /** Time when statistics properties were last set, and flag indicating that timer is
+        running to set them later.
+     */
+    os_timer m_stats_timer;
+    os_boolean m_stats_pending;
 };
 
 /* Expose OS directory as object tree.
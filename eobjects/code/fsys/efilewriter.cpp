@@ -0,0 +1,286 @@
+/**
+
+  @file    efilewriter.cpp
+  @brief   File writer thread for eFileSystem.
+  @author  Pekka Lehtikoski
+  @version 1.0
+  @date    18.10.2026
+
+  The eFileWriter is a worker thread, which serializes and writes files for eFileSystem.
+  New file content is first written to temporary file, which is then renamed over the
+  old file. A reader never sees half written file, and if the process is stopped while
+  writing, the old file is still there.
+
+  Copyright 2020 Pekka Lehtikoski. This file is part of the eobjects project and shall only be used,
+  modified, and distributed under the terms of the project licensing. By continuing to use, modify,
+  or distribute this file you indicate that you have read the license and understand and accept
+  it fully.
+
+****************************************************************************************************
+*/
+#include "eobjects.h"
+
+/* File writer property names.
+ */
+const os_char
+    efwrp_nwritten[] = "nwritten";
+
+
+/**
+****************************************************************************************************
+  Constructor.
+****************************************************************************************************
+*/
+eFileWriter::eFileWriter(
+    eObject *parent,
+    e_oid id,
+    os_int flags)
+    : eThread(parent, id, flags)
+{
+    m_worker_nr = 0;
+    m_nwritten = 0;
+}
+
+
+/**
+****************************************************************************************************
+  Virtual destructor.
+****************************************************************************************************
+*/
+eFileWriter::~eFileWriter()
+{
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Add eFileWriter to class list and class'es properties to it's property set.
+
+  The eFileWriter::setupclass function adds eFileWriter to class list and class'es
+  properties to it's property set. The class list enables creating new objects dynamically
+  by class identifier, which is used for serialization reader functions. The property set
+  stores static list of class'es properties and metadata for those.
+
+****************************************************************************************************
+*/
+void eFileWriter::setupclass()
+{
+    const os_int cls = ECLASSID_FILE_WRITER;
+
+    /* Synchronize, add the class to class list and properties to property set.
+     */
+    os_lock();
+    eclasslist_add(cls, (eNewObjFunc)newobj, "eFileWriter", ECLASSID_THREAD);
+    addpropertyl(cls, EFWRP_NWRITTEN, efwrp_nwritten, "files written",
+        EPRO_SIMPLE|EPRO_RDONLY);
+    propertysetdone(cls);
+    os_unlock();
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Process incoming messages.
+
+  The eFileWriter::onmessage function handles ECMD_FSYS_WRITE_JOB messages from file
+  system. Other messages are passed to eThread base class.
+
+  @param   envelope Message envelope. Contains command, target and source paths and
+           message content, etc.
+  @return  None.
+
+****************************************************************************************************
+*/
+void eFileWriter::onmessage(
+    eEnvelope *envelope)
+{
+    if (*envelope->target() == '\0' &&
+        envelope->command() == ECMD_FSYS_WRITE_JOB)
+    {
+        write_job(envelope);
+        return;
+    }
+
+    eThread::onmessage(envelope);
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Get value of simple property (override).
+
+  The simpleproperty() function stores current value of simple property into variable x.
+
+  @param   propertynr Property number to get.
+  @param   x Variable into which to store the property value.
+  @return  If property with property number was stored in x, the function returns
+           ESTATUS_SUCCESS (0). Nonzero return values indicate that property with
+           given number was not among simple properties.
+
+****************************************************************************************************
+*/
+eStatus eFileWriter::simpleproperty(
+    os_int propertynr,
+    eVariable *x)
+{
+    switch (propertynr)
+    {
+        case EFWRP_NWRITTEN:
+            x->setl(m_nwritten);
+            break;
+
+        default:
+            return eThread::simpleproperty(propertynr, x);
+    }
+    return ESTATUS_SUCCESS;
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Write content to file.
+
+  The eFileWriter::write_file() function serializes content to file. ECMD_APPEND_FILE
+  appends to end of existing file (journal). ECMD_SAVE_FILE and ECMD_SAVE_MATRIX_SNAPSHOT
+  write to temporary file, path + EFSYS_TMP_EXT, which is then renamed to path.
+
+  The function doesn't use any eFileSystem member, so it can be called by writer threads
+  and file system thread.
+
+  @param   command ECMD_SAVE_FILE, ECMD_APPEND_FILE or ECMD_SAVE_MATRIX_SNAPSHOT.
+  @param   path Full OS path to the file.
+  @param   content Object to save. For ECMD_SAVE_MATRIX_SNAPSHOT this must be eMatrix.
+  @param   seq Snapshot sequence number, used only by ECMD_SAVE_MATRIX_SNAPSHOT.
+  @return  ESTATUS_SUCCESS if file was written, other values indicate an error.
+
+****************************************************************************************************
+*/
+eStatus eFileWriter::write_file(
+    os_int command,
+    const os_char *path,
+    eObject *content,
+    eVariable *seq)
+{
+    eVariable tmp_path;
+    eStatus s;
+
+    if (content == OS_NULL) return ESTATUS_FAILED;
+
+    if (command == ECMD_APPEND_FILE) {
+        return content->save(path, OS_TRUE);
+    }
+
+    tmp_path.sets(path);
+    tmp_path.appends(EFSYS_TMP_EXT);
+
+    if (command == ECMD_SAVE_MATRIX_SNAPSHOT) {
+        if (seq == OS_NULL || content->classid() != ECLASSID_MATRIX) return ESTATUS_FAILED;
+        s = eMatrix::cast(content)->save_snapshot(tmp_path.gets(), seq->getl());
+    }
+    else {
+        s = content->save(tmp_path.gets(), OS_FALSE);
+    }
+    if (s) return s;
+
+    if (osal_rename(tmp_path.gets(), path, OSAL_STREAM_DEFAULT)) {
+        osal_debug_error_str("eFileWriter: rename failed: ", tmp_path.gets());
+        return ESTATUS_FAILED;
+    }
+    return ESTATUS_SUCCESS;
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Write file and report to file system.
+
+  The eFileWriter::write_job() function writes the file described by ECMD_FSYS_WRITE_JOB
+  message content. If original save requests wanted a reply, it is sent as eFileSystem
+  would have sent it. Then ECMD_FSYS_JOB_DONE with worker index (EOID_PARAMETER) and write
+  time in microseconds (EOID_CONTENT) is sent to file system, so it can pass next job.
+
+  @param   envelope ECMD_FSYS_WRITE_JOB message from file system.
+  @return  None.
+
+****************************************************************************************************
+*/
+void eFileWriter::write_job(
+    eEnvelope *envelope)
+{
+    eObject *job;
+    eContainer *done;
+    eVariable *path, *command, *v;
+    os_long start_us;
+    eStatus s = ESTATUS_FAILED;
+
+    start_us = etime();
+    job = envelope->content();
+    if (job)
+    {
+        path = eVariable::cast(job->first(EOID_PATH));
+        command = eVariable::cast(job->first(EOID_FLAGS));
+
+        if (path && command) {
+            s = write_file(command->geti(), path->gets(), job->first(EOID_CONTENT),
+                eVariable::cast(job->first(EOID_PARAMETER)));
+        }
+        reply_job(this, job, s);
+    }
+
+    if (s == ESTATUS_SUCCESS) {
+        m_nwritten++;
+    }
+
+    done = new eContainer(this, EOID_TEMPORARY);
+    v = new eVariable(done, EOID_PARAMETER);
+    v->setl(m_worker_nr);
+    v = new eVariable(done, EOID_CONTENT);
+    v->setl(etime() - start_us);
+    message(ECMD_FSYS_JOB_DONE, envelope->source(), OS_NULL, done,
+        EMSG_DEL_CONTENT|EMSG_NO_REPLIES|EMSG_NO_ERRORS);
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Reply to senders of save messages.
+
+  The eFileWriter::reply_job() function replies to each path stored in job (EOID_CONTEXT),
+  as eObject::reply() does: Empty ECMD_NO_TARGET if file was written, or ECMD_NO_TARGET with
+  error text if writing failed. There is more than one path if saves were coalesced.
+
+  @param   obj Object sending the replies.
+  @param   job Write job, see ECMD_FSYS_WRITE_JOB.
+  @param   s Status from write_file().
+  @return  None.
+
+****************************************************************************************************
+*/
+void eFileWriter::reply_job(
+    eObject *obj,
+    eObject *job,
+    eStatus s)
+{
+    eVariable *source, *path, *v;
+
+    path = eVariable::cast(job->first(EOID_PATH));
+    for (source = eVariable::cast(job->first(EOID_CONTEXT));
+         source;
+         source = eVariable::cast(source->next(EOID_CONTEXT)))
+    {
+        v = OS_NULL;
+        if (s) {
+            v = new eVariable(obj, EOID_TEMPORARY);
+            v->sets("Saving \'");
+            if (path) v->appendv(path);
+            v->appends("\' failed.");
+        }
+        obj->message(ECMD_NO_TARGET, source->gets(), OS_NULL, v, EMSG_DEL_CONTENT);
+    }
+}
@@ -0,0 +1,156 @@
+/**
+
+  @file    efilewriter.h
+  @brief   File writer thread for eFileSystem.
+  @author  Pekka Lehtikoski
+  @version 1.0
+  @date    18.10.2026
+
+  The eFileWriter is a worker thread, which serializes and writes files for eFileSystem.
+  File system thread so stays responsive while large files are being written, and files
+  of different persistent objects can be written concurrently.
+
+  Copyright 2020 Pekka Lehtikoski. This file is part of the eobjects project and shall only be used,
+  modified, and distributed under the terms of the project licensing. By continuing to use, modify,
+  or distribute this file you indicate that you have read the license and understand and accept
+  it fully.
+
+****************************************************************************************************
+*/
+#pragma once
+#ifndef EFILEWRITER_H_
+#define EFILEWRITER_H_
+#include "eobjects.h"
+
+
+/**
+****************************************************************************************************
+  Defines
+****************************************************************************************************
+*/
+
+/* Enumeration of file writer properties.
+ */
+#define EFWRP_NWRITTEN 2
+
+/* File writer property names.
+ */
+extern const os_char
+    efwrp_nwritten[];
+
+
+/**
+****************************************************************************************************
+
+  @brief File writer class.
+
+  The eFileWriter receives one ECMD_FSYS_WRITE_JOB at a time from eFileSystem, writes the
+  file and replies with ECMD_FSYS_JOB_DONE. Job is the content of the original save message,
+  to which the file system has added full OS path (EOID_PATH), the save command (EOID_FLAGS)
+  and paths to reply to (EOID_CONTEXT, one for each save coalesced into this job).
+
+****************************************************************************************************
+*/
+class eFileWriter : public eThread
+{
+public:
+    /* Constructor.
+     */
+    eFileWriter(
+        eObject *parent = OS_NULL,
+        e_oid id = EOID_ITEM,
+        os_int flags = EOBJ_DEFAULT);
+
+    /* Virtual destructor.
+     */
+    virtual ~eFileWriter();
+
+    /* Casting eObject pointer to eFileWriter pointer.
+     */
+    inline static eFileWriter *cast(
+        eObject *o)
+    {
+        e_assert_type(o, ECLASSID_FILE_WRITER)
+        return (eFileWriter*)o;
+    }
+
+    /* Get class identifier.
+     */
+    virtual os_int classid() {return ECLASSID_FILE_WRITER; }
+
+    /* Static function to add class to propertysets and class list.
+     */
+    static void setupclass();
+
+    /* Static constructor function.
+    */
+    static eFileWriter *newobj(
+        eObject *parent,
+        e_oid id = EOID_ITEM,
+        os_int flags = EOBJ_DEFAULT)
+    {
+        return new eFileWriter(parent, id, flags);
+    }
+
+    /* Function to process messages to this object.
+     */
+    virtual void onmessage(
+        eEnvelope *envelope);
+
+    /* Get value of simple property.
+     */
+    virtual eStatus simpleproperty(
+        os_int propertynr,
+        eVariable *x);
+
+    /* Set worker index, reported back to file system with each finished job.
+     */
+    inline void set_worker_nr(
+        os_int worker_nr)
+        {m_worker_nr = worker_nr; }
+
+    /* Write content to file, used by both writer threads and file system thread.
+     */
+    static eStatus write_file(
+        os_int command,
+        const os_char *path,
+        eObject *content,
+        eVariable *seq);
+
+    /* Reply to senders of save messages handled by job.
+     */
+    static void reply_job(
+        eObject *obj,
+        eObject *job,
+        eStatus s);
+
+protected:
+
+    /**
+    ************************************************************************************************
+      Protected member functions.
+    ************************************************************************************************
+    */
+
+    /* Write file and report to file system.
+     */
+    void write_job(
+        eEnvelope *envelope);
+
+
+    /**
+    ************************************************************************************************
+      Member variables.
+    ************************************************************************************************
+    */
+
+    /** Worker index within file system's pool.
+     */
+    os_int m_worker_nr;
+
+    /** Number of files written by this worker.
+     */
+    os_long m_nwritten;
+};
+
+#endif
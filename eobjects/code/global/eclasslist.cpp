@@ -16,6 +16,51 @@
 ****************************************************************************************************
 */
 #include "eobjects.h"
+#if !defined(__GNUC__) && !defined(__clang__)
+#include <atomic>
+#endif
+
+/* Forward referred static functions.
+ */
+static ePropertyIndex *eclasslist_build_propertyindex(
+    os_int cid);
+
+static void eclasslist_retire_propertyindex(
+    os_int cid);
+
+static void eclasslist_free_propertyindex(
+    ePropertyIndex *ix);
+
+
+/* Read class'es property index pointer without lock. Acquire pairs with release in
+   eclasslist_set_ix(), so the index content is seen complete once the pointer is seen.
+ */
+static inline ePropertyIndex *eclasslist_get_ix(
+    os_int cid)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return __atomic_load_n(eglobal->propertyindex + cid, __ATOMIC_ACQUIRE);
+#else
+    ePropertyIndex *ix;
+    ix = *(ePropertyIndex * volatile *)(eglobal->propertyindex + cid);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return ix;
+#endif
+}
+
+/* Publish class'es property index pointer, os_lock() must be on.
+ */
+static inline void eclasslist_set_ix(
+    os_int cid,
+    ePropertyIndex *ix)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    __atomic_store_n(eglobal->propertyindex + cid, ix, __ATOMIC_RELEASE);
+#else
+    std::atomic_thread_fence(std::memory_order_release);
+    *(ePropertyIndex * volatile *)(eglobal->propertyindex + cid) = ix;
+#endif
+}
 
 
 
@@ -201,6 +246,43 @@ os_char *eclasslist_classname(
 }
 
 
+/**
+****************************************************************************************************
+
+  @brief Get class identifier by class name.
+
+  The eclasslist_classid function returns class id matching to class name, for example
+  when reading "class" item of JSON.
+
+  @param   classname Class name to look for, like "eVariable".
+  @return  Class identifier, or 0 if none found.
+
+****************************************************************************************************
+*/
+os_int eclasslist_classid(
+    const os_char *classname)
+{
+    eObject *pointer;
+    os_int cid = 0;
+
+    os_lock();
+    pointer = eglobal->classlist->byname(classname);
+    if (pointer)
+    {
+        cid = (os_int)pointer->oid();
+    }
+#if OSAL_DEBUG
+    else
+    {
+        osal_debug_error_str("eclasslist_classid: Class not found: ", classname);
+    }
+#endif
+
+    os_unlock();
+    return cid;
+}
+
+
 /**
 ****************************************************************************************************
 
@@ -219,6 +301,11 @@ void eclasslist_initialize()
     eglobal->propertysets = new eContainer(eglobal->root);
     eglobal->empty = new eVariable();
 
+    eglobal->propertyindex = (ePropertyIndex**)os_malloc(
+        ECLASSLIST_INDEX_SZ * sizeof(ePropertyIndex*), OS_NULL);
+    os_memclear(eglobal->propertyindex, ECLASSLIST_INDEX_SZ * sizeof(ePropertyIndex*));
+    eglobal->propertyindex_old = OS_NULL;
+
     /* eVariable should be first to add to class list followed by then eSet and eContainer.
        Reason is that these same classes are used to store description of classes, including
        themselves.
@@ -233,6 +320,7 @@ void eclasslist_initialize()
     ePointer::setupclass();
     eEnvelope::setupclass();
     eBinding::setupclass();
+    eBindingChannel::setupclass();
     ePropertyBinding::setupclass();
     eRowSetBinding::setupclass();
     eSynchronized::setupclass();
@@ -246,6 +334,7 @@ void eclasslist_initialize()
     eDBM::setupclass();
     eBitmap::setupclass();
     eConnection::setupclass();
+    eConnectionWorker::setupclass();
     eEndPoint::setupclass();
     eThread::setupclass();
     eProcess::setupclass();
@@ -253,6 +342,9 @@ void eclasslist_initialize()
     eStream::setupclass();
     eOsStream::setupclass();
     eFileSystem::setupclass();
+    eFileWriter::setupclass();
+    eBitmapCodec::setupclass();
+    eBitmapCodecWorker::setupclass();
 }
 
 
@@ -268,6 +360,230 @@ void eclasslist_initialize()
 */
 void eclasslist_release()
 {
+    ePropertyIndex *ix, *next_ix;
+    os_int cid;
+
+    if (eglobal->propertyindex)
+    {
+        for (cid = 0; cid < ECLASSLIST_INDEX_SZ; cid++) {
+            if (eglobal->propertyindex[cid]) {
+                eclasslist_free_propertyindex(eglobal->propertyindex[cid]);
+            }
+        }
+        os_free(eglobal->propertyindex, ECLASSLIST_INDEX_SZ * sizeof(ePropertyIndex*));
+        eglobal->propertyindex = OS_NULL;
+    }
+    for (ix = eglobal->propertyindex_old; ix; ix = next_ix) {
+        next_ix = ix->old;
+        eclasslist_free_propertyindex(ix);
+    }
+    eglobal->propertyindex_old = OS_NULL;
+
     delete eglobal->root;
     delete eglobal->empty;
 }
+
+
+/**
+****************************************************************************************************
+
+  @brief Get flat property index for class.
+
+  The eclasslist_propertyindex function returns class'es property index, which gives
+  eVariable describing a property by property number without searching or locking. The
+  index is built by eclasslist_propertysetdone() when class'es property set is complete, or
+  from class'es property set when first needed.
+
+  @param   cid Class identifier.
+  @return  Pointer to property index, OS_NULL if class ID or property numbers are too
+           large for index. Then property set needs to be searched.
+
+****************************************************************************************************
+*/
+ePropertyIndex *eclasslist_propertyindex(
+    os_int cid)
+{
+    ePropertyIndex *ix;
+
+    if ((os_uint)cid >= ECLASSLIST_INDEX_SZ || eglobal->propertyindex == OS_NULL) {
+        return OS_NULL;
+    }
+    ix = eclasslist_get_ix(cid);
+    if (ix) return ix;
+
+    return eclasslist_build_propertyindex(cid);
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Mark class'es property index outdated.
+
+  The eclasslist_invalidate_propertyindex function is called when property is added to
+  class'es property set. The index is rebuilt when needed next time. os_lock() must be on
+  when this is called.
+
+  @param   cid Class identifier.
+  @return  None.
+
+****************************************************************************************************
+*/
+void eclasslist_invalidate_propertyindex(
+    os_int cid)
+{
+    if ((os_uint)cid >= ECLASSLIST_INDEX_SZ || eglobal->propertyindex == OS_NULL) return;
+    eclasslist_retire_propertyindex(cid);
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Build property index when class'es property set is complete.
+
+  The eclasslist_propertysetdone function is called by eObject::propertysetdone() at end of
+  class setup. It replaces index built for incomplete property set, if any, and publishes
+  the final index, so that readers never need to build it. os_lock() must be on.
+
+  @param   cid Class identifier.
+  @return  None.
+
+****************************************************************************************************
+*/
+void eclasslist_propertysetdone(
+    os_int cid)
+{
+    if ((os_uint)cid >= ECLASSLIST_INDEX_SZ || eglobal->propertyindex == OS_NULL) return;
+    eclasslist_retire_propertyindex(cid);
+    eclasslist_build_propertyindex(cid);
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Replace class'es property index with OS_NULL and release expired indexes.
+
+  Other threads may still be using the replaced index, so it is moved to retired list and
+  released only after ECLASSLIST_INDEX_RETIRE_MS. Readers take index pointer and use it
+  within one function call which doesn't block, so by then no thread can hold it. This keeps
+  memory of superseded indexes bounded, instead of keeping them all until exit.
+  os_lock() must be on.
+
+  @param   cid Class identifier, must be below ECLASSLIST_INDEX_SZ.
+  @return  None.
+
+****************************************************************************************************
+*/
+static void eclasslist_retire_propertyindex(
+    os_int cid)
+{
+    ePropertyIndex *ix, **pix;
+
+    /* Release retired indexes which have expired. Newest are first in list, so once
+       one has expired, all after it have expired too.
+     */
+    for (pix = &eglobal->propertyindex_old; *pix; pix = &(*pix)->old)
+    {
+        if (os_has_elapsed(&(*pix)->retired, ECLASSLIST_INDEX_RETIRE_MS))
+        {
+            ix = *pix;
+            *pix = OS_NULL;
+            while (ix) {
+                ePropertyIndex *next_ix = ix->old;
+                eclasslist_free_propertyindex(ix);
+                ix = next_ix;
+            }
+            break;
+        }
+    }
+
+    ix = eglobal->propertyindex[cid];
+    if (ix == OS_NULL) return;
+
+    eclasslist_set_ix(cid, OS_NULL);
+    os_get_timer(&ix->retired);
+    ix->old = eglobal->propertyindex_old;
+    eglobal->propertyindex_old = ix;
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Build flat property index for class.
+
+  @param   cid Class identifier, must be below ECLASSLIST_INDEX_SZ.
+  @return  Pointer to property index, OS_NULL if property numbers are too large.
+
+****************************************************************************************************
+*/
+static ePropertyIndex *eclasslist_build_propertyindex(
+    os_int cid)
+{
+    ePropertyIndex *ix;
+    eContainer *pset;
+    eVariable *p;
+    os_int n;
+
+    os_lock();
+    ix = eglobal->propertyindex[cid];
+    if (ix) goto getout;
+
+    pset = eglobal->propertysets->firstc(cid);
+    n = 0;
+    if (pset) for (p = pset->firstv(); p; p = p->nextv())
+    {
+        if (p->oid() > ECLASSLIST_MAX_PROPERTY_NR) goto getout;
+        if (p->oid() >= n) n = p->oid() + 1;
+    }
+
+    ix = (ePropertyIndex*)os_malloc(sizeof(ePropertyIndex), OS_NULL);
+    ix->pset = pset;
+    ix->n = n;
+    ix->p = OS_NULL;
+    ix->dense = OS_FALSE;
+    if (pset) {
+        ix->dense = (os_boolean)((pset->flags() & EPSET_DENSE) != 0);
+    }
+    ix->old = OS_NULL;
+    ix->retired = 0;
+    if (n)
+    {
+        ix->p = (eVariable**)os_malloc(n * sizeof(eVariable*), OS_NULL);
+        os_memclear(ix->p, n * sizeof(eVariable*));
+
+        /* If there are multiple variables with same property number, the first one is used
+           (same as pset->firstv(propertynr)).
+         */
+        for (p = pset->firstv(); p; p = p->nextv()) {
+            if (p->oid() >= 0 && ix->p[p->oid()] == OS_NULL) ix->p[p->oid()] = p;
+        }
+    }
+    eclasslist_set_ix(cid, ix);
+
+getout:
+    os_unlock();
+    return ix;
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Release memory allocated for property index.
+
+  @param   ix Property index.
+  @return  None.
+
+****************************************************************************************************
+*/
+static void eclasslist_free_propertyindex(
+    ePropertyIndex *ix)
+{
+    if (ix->p) {
+        os_free(ix->p, ix->n * sizeof(eVariable*));
+    }
+    os_free(ix, sizeof(ePropertyIndex));
+}
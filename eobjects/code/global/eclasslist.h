@@ -26,6 +26,52 @@ typedef eObject *(*eNewObjFunc)(
     e_oid id,
     os_int flags);
 
+/* Flat property index is kept for classes with class ID below this.
+ */
+#define ECLASSLIST_INDEX_SZ 2048
+
+/* Property index is not built for classes with property numbers above this.
+ */
+#define ECLASSLIST_MAX_PROPERTY_NR 1023
+
+/* Replaced property index is released after this many milliseconds.
+ */
+#define ECLASSLIST_INDEX_RETIRE_MS 2000
+
+/* Flat property index of a class, built from class'es property set when the set is complete
+   or on first use. Once published, the index is not modified, so it can be used without
+   locking.
+ */
+typedef struct ePropertyIndex
+{
+    /* Class'es property set, OS_NULL if class has no properties.
+     */
+    eContainer *pset;
+
+    /* Number of items in p array (largest property number + 1).
+     */
+    os_int n;
+
+    /* Pointers to eVariables describing properties, indexed by property number.
+       OS_NULL for unused property numbers.
+     */
+    eVariable **p;
+
+    /* OS_TRUE if class'es property values are stored in dense mode eSet (EPSET_DENSE).
+     */
+    os_boolean dense;
+
+    /* Next replaced index in retired list. Replaced index is kept for
+       ECLASSLIST_INDEX_RETIRE_MS, since other threads may still use it.
+     */
+    struct ePropertyIndex *old;
+
+    /* Timer value when this index was replaced.
+     */
+    os_timer retired;
+}
+ePropertyIndex;
+
 /* Add class to class list.
  */
 void eclasslist_add(
@@ -50,6 +96,26 @@ os_boolean eclasslist_isinstanceof(
 os_char *eclasslist_classname(
     os_int cid);
 
+/* Get class identifier by class name.
+ */
+os_int eclasslist_classid(
+    const os_char *classname);
+
+/* Get flat property index for class, OS_NULL if class has no index.
+ */
+ePropertyIndex *eclasslist_propertyindex(
+    os_int cid);
+
+/* Mark class'es property index outdated, when property is added.
+ */
+void eclasslist_invalidate_propertyindex(
+    os_int cid);
+
+/* Build and publish class'es property index when property set is complete.
+ */
+void eclasslist_propertysetdone(
+    os_int cid);
+
 /* Initialize class list.
  */
 void eclasslist_initialize();
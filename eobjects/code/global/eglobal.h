@@ -24,6 +24,7 @@
 class eThreadHandle;
 class eConsole;
 class eNetService;
+struct eInternedStr;
 
 /* Space allocation for process name, nr, id, etc. strings.
  */
@@ -74,6 +75,24 @@ typedef struct eGlobal
      */
     eContainer *propertysets;
 
+    /** Flat property indexes by class ID, ECLASSLIST_INDEX_SZ items. Items are set when
+        class setup is done or when first needed. Read without lock with acquire and
+        written under os_lock() with release, see eclasslist.cpp.
+     */
+    struct ePropertyIndex **propertyindex;
+
+    /** Replaced property indexes, newest first. Released after ECLASSLIST_INDEX_RETIRE_MS.
+     */
+    struct ePropertyIndex *propertyindex_old;
+
+    /** Interned string hash table, see estrintern.h. Allocated when first string is
+        interned, strintern_lock must be locked when accessing.
+     */
+    struct eInternedStr **strintern_table;
+    os_int strintern_nbuckets;
+    os_int strintern_count;
+    osalMutex strintern_lock;
+
     /** Pointer to process thread handle.
      */
     eThreadHandle *processhandle;
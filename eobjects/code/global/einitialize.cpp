@@ -66,6 +66,10 @@ void eobjects_initialize(
      */
     eclasslist_initialize();
 
+    /* Initialize interned string table lock.
+     */
+    estrintern_initialize();
+
     /* Initialize network
      */
     if ((flags & EOBJECTS_NO_NETWORK_INIT) == 0)
@@ -145,6 +149,10 @@ void eobjects_shutdown()
      */
     eclasslist_release();
 
+    /* Free interned strings.
+     */
+    estrintern_shutdown();
+
     /* Delete handle tables.
      */
     ehandleroot_shutdown();
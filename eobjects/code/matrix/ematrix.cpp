@@ -27,11 +27,6 @@ const os_char
  */
 #define OEMATRIX_APPROX_BUF_SZ 128
 
-/* Flags for getptrs() function.
- */
-#define EMATRIX_ALLOCATE_IF_NEEDED 1
-#define EMATRIX_CLEAR_ELEMENT 2
-
 typedef union
 {
     os_long l;
@@ -843,6 +838,8 @@ failed:
   @brief Write matrix specific content to stream as JSON.
 
   The eMatrix::json_writer() function writes class specific object content to stream as JSON.
+  Rows of numeric matrix are formatted directly into stack buffer, which is written to
+  stream when full or at end of row. This avoids converting each value trough eVariable.
 
   @param  stream The stream to write to.
   @param  sflags Serialization flags. Typically EOBJ_SERIALIZE_DEFAULT.
@@ -862,8 +859,19 @@ eStatus eMatrix::json_writer(
     os_boolean comma1, comma2;
     eVariable tmp;
     eObject *o;
+    os_char buf[EMTX_JSON_BUF_SZ], *p, *e;
+    os_long l;
+    os_double d;
     os_int row, column, type_id;
-    os_boolean has_value;
+    os_boolean has_value, is_numeric, is_float;
+
+    is_numeric = (m_datatype != OS_OBJECT && m_datatype != OS_STR);
+    is_float = (m_datatype == OS_FLOAT || m_datatype == OS_DOUBLE ||
+        m_datatype == OS_DEC01 || m_datatype == OS_DEC001);
+
+    /* Write buffer when there is no room for one more number.
+     */
+    e = buf + sizeof(buf) - EVARIABLE_NBUF_SZ - 4;
 
     indent++;
     if (json_puts(stream, "[")) goto failed;
@@ -884,6 +892,47 @@ eStatus eMatrix::json_writer(
         comma1 = OS_TRUE;
 
         if (json_indent(stream, indent, EJSON_NEW_LINE_BEFORE /* , &comma */)) goto failed;
+
+        if (is_numeric)
+        {
+            p = buf;
+            *(p++) = '[';
+            for (column = 0; column < m_ncolumns; column++)
+            {
+                if (column) *(p++) = ',';
+
+                if (m_columns && column == EMTX_FLAGS_COLUMN_NR) {
+                    p = eint2str(p, row + 1, buf + sizeof(buf) - p);
+                    has_value = OS_TRUE;
+                }
+                else if (is_float) {
+                    d = getd(row, column, &has_value);
+                    if (has_value) {
+                        p = edouble2str(p, d, buf + sizeof(buf) - p, EVARP_DEFAULT_DIGS);
+                    }
+                }
+                else {
+                    l = getl(row, column, &has_value);
+                    if (has_value) {
+                        p = eint2str(p, l, buf + sizeof(buf) - p);
+                    }
+                }
+
+                if (!has_value) {
+                    *(p++) = '\"';
+                    *(p++) = '\"';
+                }
+
+                if (p >= e) {
+                    if (stream->write(buf, p - buf)) goto failed;
+                    p = buf;
+                }
+            }
+            *(p++) = ']';
+            if (stream->write(buf, p - buf)) goto failed;
+            continue;
+        }
+
         if (json_puts(stream, "[")) goto failed;
         comma2 = OS_FALSE;
 
@@ -945,6 +994,90 @@ eStatus eMatrix::json_writer(
 failed:
     return ESTATUS_FAILED;
 }
+
+
+/**
+****************************************************************************************************
+
+  @brief Read matrix specific content from JSON.
+
+  The eMatrix::json_reader() function reads rows written by json_writer() directly into
+  the matrix. Matrix data type and size are set from properties before content is read,
+  so the matrix doesn't need to grow while reading. If this is a table, the flags column
+  holds row number written by json_writer(), which is used to place the row.
+
+  @param  reader JSON tokenizer.
+  @param  token First token of the content, '['.
+  @param  sflags Serialization flags. Typically EOBJ_SERIALIZE_DEFAULT.
+
+  @return If successfull the function returns ESTATUS_SUCCESS (0). Other return values
+          indicate an error.
+
+****************************************************************************************************
+*/
+eStatus eMatrix::json_reader(
+    eJsonReader *reader,
+    os_int token,
+    os_int sflags)
+{
+    eContainer tmp;
+    eVariable *x;
+    eObject *o;
+    os_int row, column;
+
+    if (token != EJSON_TOKEN_BEGIN_ARRAY) return ESTATUS_FAILED;
+
+    row = 0;
+    while ((token = reader->next()) != EJSON_TOKEN_END_ARRAY)
+    {
+        if (token != EJSON_TOKEN_BEGIN_ARRAY) return ESTATUS_FAILED;
+
+        column = 0;
+        while ((token = reader->next()) != EJSON_TOKEN_END_ARRAY)
+        {
+            if (token == EJSON_TOKEN_VALUE)
+            {
+                x = reader->value();
+                if (m_columns && column == EMTX_FLAGS_COLUMN_NR) {
+                    row = x->geti() - 1;
+                    if (row < 0) return ESTATUS_FAILED;
+                    setl(row, column, EMTX_FLAGS_ROW_OK);
+                }
+                else switch (x->type())
+                {
+                    case OS_LONG:
+                        setl(row, column, x->getl());
+                        break;
+
+                    case OS_DOUBLE:
+                        setd(row, column, x->getd());
+                        break;
+
+                    case OS_STR:
+                        if (!x->isempty()) sets(row, column, x->gets());
+                        break;
+
+                    default:
+                        break;
+                }
+            }
+            else if (token == EJSON_TOKEN_BEGIN_OBJECT)
+            {
+                o = tmp.json_read_value(reader, token, OS_NULL, sflags);
+                if (o == OS_NULL) return ESTATUS_FAILED;
+                seto(row, column, o);
+                delete o;
+            }
+            else {
+                return ESTATUS_FAILED;
+            }
+            column++;
+        }
+        row++;
+    }
+
+    return ESTATUS_SUCCESS;
+}
 #endif
 
 
@@ -1875,6 +2008,44 @@ return_empty:
 }
 
 
+/**
+****************************************************************************************************
+
+  @brief Take over data blocks of another matrix.
+
+  The eMatrix::adopt_data function releases current data of this matrix and moves data
+  blocks of source matrix to this matrix, without copying elements. Data type and size are
+  set from source matrix. Source matrix keeps it's data type and number of columns, but is
+  left without rows. Table configuration is not changed, caller must make sure that columns
+  match.
+
+  @param  src Source matrix.
+  @return None.
+
+****************************************************************************************************
+*/
+void eMatrix::adopt_data(
+    eMatrix *src)
+{
+    eBuffer *buffer, *nextbuffer;
+
+    clear();
+
+    for (buffer = eBuffer::cast(src->first());
+         buffer;
+         buffer = nextbuffer)
+    {
+        nextbuffer = eBuffer::cast(buffer->next());
+        if (buffer->oid() > 0) {
+            buffer->adopt(this);
+        }
+    }
+
+    resize(src->m_datatype, src->m_nrows, src->m_ncolumns);
+    src->resize(src->m_datatype, 0, src->m_ncolumns);
+}
+
+
 /**
 ****************************************************************************************************
 
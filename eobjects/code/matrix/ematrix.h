@@ -54,6 +54,10 @@ extern const os_char
  */
 #define EMTX_FLAGS_ROW_OK 1
 
+/* Size of stack buffer for formatting numeric matrix rows as JSON.
+ */
+#define EMTX_JSON_BUF_SZ 512
+
 /* Operation argument for select_update_remove() function.
  */
 typedef enum {
@@ -63,6 +67,49 @@ typedef enum {
 }
 eMtxOp;
 
+/* Table change record, given as appendix of ECALLBACK_TABLE_CONTENT_CHANGED callback. Record
+   is eContainer holding operation (EOID_PARAMETER), table flags (EOID_FLAGS), where clause
+   (EOID_TABLE_WHERE) and inserted or updated row(s) (EOID_CONTENT). Used for journaling.
+ */
+#define EMTX_JOURNAL_INSERT 1
+#define EMTX_JOURNAL_UPDATE 2
+#define EMTX_JOURNAL_REMOVE 3
+
+/* Flags for getptrs() function.
+ */
+#define EMATRIX_ALLOCATE_IF_NEEDED 1
+#define EMATRIX_CLEAR_ELEMENT 2
+
+/* Memory image snapshot file, see ematrix_snapshot.cpp. Header and data blocks are aligned
+   to EMTX_SNAPSHOT_ALIGN bytes within the file.
+ */
+#define EMTX_SNAPSHOT_VERSION 1
+#define EMTX_SNAPSHOT_ALIGN 64
+#define EMTX_SNAPSHOT_MAGIC "eMtxSnp"
+#define EMTX_SNAPSHOT_BYTE_ORDER 0x01020304
+#define EMTX_SNAPSHOT_EXT ".mtx"
+
+/* Memory image snapshot file header, EMTX_SNAPSHOT_ALIGN bytes.
+ */
+typedef struct eMatrixSnapshotHeader
+{
+    os_char magic[8];
+    os_int version;
+    os_int byte_order;
+    os_int hdr_sz;
+    os_int datatype;
+    os_int typesz;
+    os_int elemsz;
+    os_int per_block;
+    os_int block_sz;
+    os_int nrows;
+    os_int ncolumns;
+    os_int nblocks;
+    os_int reserved;
+    os_long seq;
+}
+eMatrixSnapshotHeader;
+
 
 /**
 ****************************************************************************************************
@@ -173,6 +220,13 @@ public:
         eStream *stream,
         os_int sflags,
         os_int indent);
+
+    /* Read matrix specific content from JSON.
+     */
+    virtual eStatus json_reader(
+        eJsonReader *reader,
+        os_int token,
+        os_int sflags);
 #endif
 
 
@@ -339,6 +393,59 @@ public:
         os_int column,
         os_boolean *hasvalue = OS_NULL);
 
+    /* Take over data blocks of another matrix, source matrix is left without rows.
+     */
+    void adopt_data(
+        eMatrix *src);
+
+
+    /**
+    ************************************************************************************************
+
+      @name Memory image snapshot, ematrix_snapshot.cpp.
+
+    ************************************************************************************************
+    */
+    /* Check if matrix content can be saved as memory image snapshot.
+     */
+    os_boolean snapshot_supported();
+
+    /* Save matrix data blocks as memory image snapshot file.
+     */
+    eStatus save_snapshot(
+        const os_char *path,
+        os_long seq);
+
+    /* Load matrix data blocks from memory image snapshot file.
+     */
+    eStatus load_snapshot(
+        const os_char *path,
+        os_long seq);
+
+
+    /**
+    ************************************************************************************************
+
+      @name Bulk array access, ematrix_array.cpp.
+
+    ************************************************************************************************
+    */
+    /* Store array of values into matrix, element index is row * ncolumns + column.
+     */
+    void set_array(
+        os_int elem_ix,
+        const void *src,
+        os_int n,
+        osalTypeId src_type);
+
+    /* Get array of values from matrix.
+     */
+    os_int get_array(
+        os_int elem_ix,
+        void *dst,
+        os_int n,
+        osalTypeId dst_type);
+
 
 protected:
     /**
@@ -431,6 +538,14 @@ protected:
         eDBM *dbm,
         os_boolean *row_to_update_found);
 
+    /* ematrix_as_table.cpp: Inform parent about table change, with change record.
+     */
+    void table_changed(
+        os_int op,
+        const os_char *where_clause,
+        eContainer *rows,
+        os_int tflags);
+
     /* ematrix_as_table.cpp: Pass messages to DBM object.
      */
     void dbm_message(
@@ -0,0 +1,507 @@
+/**
+
+  @file    ematrix_array.cpp
+  @brief   Bulk transfer of numeric arrays to and from eMatrix.
+  @author  Pekka Lehtikoski
+  @version 1.0
+  @date    18.10.2026
+
+  Arrays, like IO signal arrays, are copied into matrix's eBuffer storage one block at a time.
+  If array and matrix data types are the same, block is copied with os_memcpy(). Otherwise
+  elements are converted in chunks through os_long or os_double temporary array, so that
+  type switch is done once per chunk, not once per element.
+
+  Element index is row * ncolumns + column: Array fills matrix row by row.
+
+  Copyright 2020 Pekka Lehtikoski. This file is part of the eobjects project and shall only be used,
+  modified, and distributed under the terms of the project licensing. By continuing to use, modify,
+  or distribute this file you indicate that you have read the license and understand and accept
+  it fully.
+
+****************************************************************************************************
+*/
+#include "eobjects.h"
+
+/* Number of elements converted at a time through temporary array on stack.
+ */
+#define EMTX_ARRAY_CHUNK 64
+
+/* Forward referred static functions.
+ */
+static void emtx_array_to_long(
+    const os_char *src,
+    osalTypeId type_id,
+    os_long *dst,
+    os_int n);
+
+static void emtx_array_from_long(
+    const os_long *src,
+    os_char *dst,
+    osalTypeId type_id,
+    os_int n);
+
+static void emtx_array_to_double(
+    const os_char *src,
+    osalTypeId type_id,
+    os_double *dst,
+    os_int n);
+
+static void emtx_array_from_double(
+    const os_double *src,
+    os_char *dst,
+    osalTypeId type_id,
+    os_int n);
+
+
+/**
+****************************************************************************************************
+
+  @brief Store array of values into matrix.
+
+  The eMatrix::set_array() function stores n values from array src into matrix, starting from
+  element index elem_ix. The matrix must have columns, rows are added if needed. Values are
+  converted from src_type to matrix data type. Matrix data type should be set by allocate(),
+  which selects matching data type for each array type.
+
+  @param  elem_ix Index of first element to set, row * ncolumns + column.
+  @param  src Pointer to array.
+  @param  n Number of elements in array.
+  @param  src_type Array element type: OS_BOOLEAN, OS_CHAR, OS_UCHAR, OS_SHORT, OS_USHORT,
+          OS_INT, OS_UINT, OS_LONG, OS_FLOAT or OS_DOUBLE.
+  @return None.
+
+****************************************************************************************************
+*/
+void eMatrix::set_array(
+    os_int elem_ix,
+    const void *src,
+    os_int n,
+    osalTypeId src_type)
+{
+    eBuffer *buffer;
+    const os_char *s;
+    os_char *dataptr, *typeptr;
+    os_long lbuf[EMTX_ARRAY_CHUNK];
+    os_double dbuf[EMTX_ARRAY_CHUNK];
+    os_int per_block, ix, count, chunk, i, nrows, src_sz;
+    os_boolean use_double;
+
+    if (n <= 0 || elem_ix < 0 || m_ncolumns <= 0) return;
+
+    nrows = (elem_ix + n + m_ncolumns - 1) / m_ncolumns;
+    if (nrows > m_nrows) {
+        resize(m_datatype, nrows, m_ncolumns);
+    }
+
+    s = (const os_char*)src;
+    src_sz = (os_int)osal_type_size(src_type);
+    use_double = (os_boolean)(OSAL_IS_FLOAT_TYPE(src_type) || OSAL_IS_FLOAT_TYPE(m_datatype));
+
+    switch (m_datatype)
+    {
+        case OS_CHAR:
+        case OS_SHORT:
+        case OS_INT:
+        case OS_LONG:
+        case OS_FLOAT:
+        case OS_DOUBLE:
+            break;
+
+        /* Objects and fixed decimals: Element by element.
+         */
+        default:
+            while (n > 0) {
+                chunk = n < EMTX_ARRAY_CHUNK ? n : EMTX_ARRAY_CHUNK;
+                if (use_double) {
+                    emtx_array_to_double(s, src_type, dbuf, chunk);
+                    for (i = 0; i < chunk; i++, elem_ix++) {
+                        setd(elem_ix / m_ncolumns, elem_ix % m_ncolumns, dbuf[i]);
+                    }
+                }
+                else {
+                    emtx_array_to_long(s, src_type, lbuf, chunk);
+                    for (i = 0; i < chunk; i++, elem_ix++) {
+                        setl(elem_ix / m_ncolumns, elem_ix % m_ncolumns, lbuf[i]);
+                    }
+                }
+                s += chunk * src_sz;
+                n -= chunk;
+            }
+            return;
+    }
+
+    per_block = elems_per_block();
+    while (n > 0)
+    {
+        ix = elem_ix % per_block;
+        count = per_block - ix;
+        if (count > n) count = n;
+
+        buffer = getbuffer(elem_ix / per_block + 1, EMATRIX_ALLOCATE_IF_NEEDED);
+        if (buffer == OS_NULL) return;
+        dataptr = buffer->ptr() + ix * m_typesz;
+
+        if (src_type == m_datatype) {
+            os_memcpy(dataptr, s, count * m_typesz);
+        }
+        else {
+            for (i = 0; i < count; i += chunk) {
+                chunk = count - i;
+                if (chunk > EMTX_ARRAY_CHUNK) chunk = EMTX_ARRAY_CHUNK;
+                if (use_double) {
+                    emtx_array_to_double(s + i * src_sz, src_type, dbuf, chunk);
+                    emtx_array_from_double(dbuf, dataptr + i * m_typesz, m_datatype, chunk);
+                }
+                else {
+                    emtx_array_to_long(s + i * src_sz, src_type, lbuf, chunk);
+                    emtx_array_from_long(lbuf, dataptr + i * m_typesz, m_datatype, chunk);
+                }
+            }
+        }
+
+        /* Floating point elements are marked non empty by element type.
+         */
+        if (m_datatype == OS_FLOAT || m_datatype == OS_DOUBLE) {
+            typeptr = buffer->ptr() + per_block * m_typesz + ix;
+            for (i = 0; i < count; i++) {
+                typeptr[i] = (os_char)m_datatype;
+            }
+        }
+
+        s += count * src_sz;
+        elem_ix += count;
+        n -= count;
+    }
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Get array of values from matrix.
+
+  The eMatrix::get_array() function copies up to n values from matrix, starting from element
+  index elem_ix, into array dst. Values are converted from matrix data type to dst_type.
+  Empty elements are not separated from values: Integer matrix returns minimum value for
+  the type, floating point matrix returns zero.
+
+  @param  elem_ix Index of first element to get, row * ncolumns + column.
+  @param  dst Pointer to array.
+  @param  n Number of elements to get.
+  @param  dst_type Array element type: OS_BOOLEAN, OS_CHAR, OS_UCHAR, OS_SHORT, OS_USHORT,
+          OS_INT, OS_UINT, OS_LONG, OS_FLOAT or OS_DOUBLE.
+  @return Number of elements stored in dst. This is less than n if matrix ends.
+
+****************************************************************************************************
+*/
+os_int eMatrix::get_array(
+    os_int elem_ix,
+    void *dst,
+    os_int n,
+    osalTypeId dst_type)
+{
+    eBuffer *buffer;
+    os_char *d, *dataptr;
+    os_long lbuf[EMTX_ARRAY_CHUNK];
+    os_double dbuf[EMTX_ARRAY_CHUNK];
+    os_int per_block, ix, count, chunk, i, nelems, dst_sz;
+    os_boolean use_double;
+
+    if (elem_ix < 0) return 0;
+    nelems = m_nrows * m_ncolumns - elem_ix;
+    if (n > nelems) n = nelems;
+    if (n <= 0) return 0;
+    nelems = n;
+
+    d = (os_char*)dst;
+    dst_sz = (os_int)osal_type_size(dst_type);
+    use_double = (os_boolean)(OSAL_IS_FLOAT_TYPE(dst_type) || OSAL_IS_FLOAT_TYPE(m_datatype));
+
+    switch (m_datatype)
+    {
+        case OS_CHAR:
+        case OS_SHORT:
+        case OS_INT:
+        case OS_LONG:
+        case OS_FLOAT:
+        case OS_DOUBLE:
+            break;
+
+        /* Objects and fixed decimals: Element by element.
+         */
+        default:
+            while (n > 0) {
+                chunk = n < EMTX_ARRAY_CHUNK ? n : EMTX_ARRAY_CHUNK;
+                if (use_double) {
+                    for (i = 0; i < chunk; i++, elem_ix++) {
+                        dbuf[i] = getd(elem_ix / m_ncolumns, elem_ix % m_ncolumns);
+                    }
+                    emtx_array_from_double(dbuf, d, dst_type, chunk);
+                }
+                else {
+                    for (i = 0; i < chunk; i++, elem_ix++) {
+                        lbuf[i] = getl(elem_ix / m_ncolumns, elem_ix % m_ncolumns);
+                    }
+                    emtx_array_from_long(lbuf, d, dst_type, chunk);
+                }
+                d += chunk * dst_sz;
+                n -= chunk;
+            }
+            return nelems;
+    }
+
+    per_block = elems_per_block();
+    while (n > 0)
+    {
+        ix = elem_ix % per_block;
+        count = per_block - ix;
+        if (count > n) count = n;
+
+        /* Block which has never been written.
+         */
+        buffer = getbuffer(elem_ix / per_block + 1, 0);
+        if (buffer == OS_NULL) {
+            os_memclear(d, count * dst_sz);
+        }
+        else {
+            dataptr = buffer->ptr() + ix * m_typesz;
+            if (dst_type == m_datatype) {
+                os_memcpy(d, dataptr, count * m_typesz);
+            }
+            else {
+                for (i = 0; i < count; i += chunk) {
+                    chunk = count - i;
+                    if (chunk > EMTX_ARRAY_CHUNK) chunk = EMTX_ARRAY_CHUNK;
+                    if (use_double) {
+                        emtx_array_to_double(dataptr + i * m_typesz, m_datatype, dbuf, chunk);
+                        emtx_array_from_double(dbuf, d + i * dst_sz, dst_type, chunk);
+                    }
+                    else {
+                        emtx_array_to_long(dataptr + i * m_typesz, m_datatype, lbuf, chunk);
+                        emtx_array_from_long(lbuf, d + i * dst_sz, dst_type, chunk);
+                    }
+                }
+            }
+        }
+
+        d += count * dst_sz;
+        elem_ix += count;
+        n -= count;
+    }
+
+    return nelems;
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Convert typed array to os_long array.
+
+  @param  src Source array.
+  @param  type_id Source element type.
+  @param  dst Destination array.
+  @param  n Number of elements.
+
+****************************************************************************************************
+*/
+static void emtx_array_to_long(
+    const os_char *src,
+    osalTypeId type_id,
+    os_long *dst,
+    os_int n)
+{
+    os_int i;
+
+    switch (type_id)
+    {
+        case OS_BOOLEAN:
+        case OS_CHAR:
+            for (i = 0; i < n; i++) dst[i] = ((const os_char*)src)[i];
+            break;
+
+        case OS_UCHAR:
+            for (i = 0; i < n; i++) dst[i] = ((const os_uchar*)src)[i];
+            break;
+
+        case OS_SHORT:
+            for (i = 0; i < n; i++) dst[i] = ((const os_short*)src)[i];
+            break;
+
+        case OS_USHORT:
+            for (i = 0; i < n; i++) dst[i] = ((const os_ushort*)src)[i];
+            break;
+
+        case OS_INT:
+            for (i = 0; i < n; i++) dst[i] = ((const os_int*)src)[i];
+            break;
+
+        case OS_UINT:
+            for (i = 0; i < n; i++) dst[i] = ((const os_uint*)src)[i];
+            break;
+
+        case OS_LONG:
+            os_memcpy(dst, src, n * sizeof(os_long));
+            break;
+
+        case OS_FLOAT:
+            for (i = 0; i < n; i++) dst[i] = eround_double_to_long(((const os_float*)src)[i]);
+            break;
+
+        case OS_DOUBLE:
+            for (i = 0; i < n; i++) dst[i] = eround_double_to_long(((const os_double*)src)[i]);
+            break;
+
+        default:
+            os_memclear(dst, n * sizeof(os_long));
+            break;
+    }
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Convert os_long array to typed array.
+
+  @param  src Source array.
+  @param  dst Destination array.
+  @param  type_id Destination element type.
+  @param  n Number of elements.
+
+****************************************************************************************************
+*/
+static void emtx_array_from_long(
+    const os_long *src,
+    os_char *dst,
+    osalTypeId type_id,
+    os_int n)
+{
+    os_int i;
+
+    switch (type_id)
+    {
+        case OS_BOOLEAN:
+            for (i = 0; i < n; i++) dst[i] = (os_char)(src[i] != 0);
+            break;
+
+        case OS_CHAR:
+            for (i = 0; i < n; i++) dst[i] = (os_char)src[i];
+            break;
+
+        case OS_UCHAR:
+            for (i = 0; i < n; i++) ((os_uchar*)dst)[i] = (os_uchar)src[i];
+            break;
+
+        case OS_SHORT:
+            for (i = 0; i < n; i++) ((os_short*)dst)[i] = (os_short)src[i];
+            break;
+
+        case OS_USHORT:
+            for (i = 0; i < n; i++) ((os_ushort*)dst)[i] = (os_ushort)src[i];
+            break;
+
+        case OS_INT:
+            for (i = 0; i < n; i++) ((os_int*)dst)[i] = (os_int)src[i];
+            break;
+
+        case OS_UINT:
+            for (i = 0; i < n; i++) ((os_uint*)dst)[i] = (os_uint)src[i];
+            break;
+
+        case OS_LONG:
+            os_memcpy(dst, src, n * sizeof(os_long));
+            break;
+
+        case OS_FLOAT:
+            for (i = 0; i < n; i++) ((os_float*)dst)[i] = (os_float)src[i];
+            break;
+
+        case OS_DOUBLE:
+            for (i = 0; i < n; i++) ((os_double*)dst)[i] = (os_double)src[i];
+            break;
+
+        default:
+            break;
+    }
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Convert typed array to os_double array.
+
+  @param  src Source array.
+  @param  type_id Source element type.
+  @param  dst Destination array.
+  @param  n Number of elements.
+
+****************************************************************************************************
+*/
+static void emtx_array_to_double(
+    const os_char *src,
+    osalTypeId type_id,
+    os_double *dst,
+    os_int n)
+{
+    os_long lbuf[EMTX_ARRAY_CHUNK];
+    os_int i;
+
+    switch (type_id)
+    {
+        case OS_FLOAT:
+            for (i = 0; i < n; i++) dst[i] = ((const os_float*)src)[i];
+            break;
+
+        case OS_DOUBLE:
+            os_memcpy(dst, src, n * sizeof(os_double));
+            break;
+
+        default:
+            emtx_array_to_long(src, type_id, lbuf, n);
+            for (i = 0; i < n; i++) dst[i] = (os_double)lbuf[i];
+            break;
+    }
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Convert os_double array to typed array.
+
+  Integer values are rounded to nearest.
+
+  @param  src Source array.
+  @param  dst Destination array.
+  @param  type_id Destination element type.
+  @param  n Number of elements.
+
+****************************************************************************************************
+*/
+static void emtx_array_from_double(
+    const os_double *src,
+    os_char *dst,
+    osalTypeId type_id,
+    os_int n)
+{
+    os_long lbuf[EMTX_ARRAY_CHUNK];
+    os_int i;
+
+    switch (type_id)
+    {
+        case OS_FLOAT:
+            for (i = 0; i < n; i++) ((os_float*)dst)[i] = (os_float)src[i];
+            break;
+
+        case OS_DOUBLE:
+            os_memcpy(dst, src, n * sizeof(os_double));
+            break;
+
+        default:
+            for (i = 0; i < n; i++) lbuf[i] = eround_double_to_long(src[i]);
+            emtx_array_from_long(lbuf, dst, type_id, n);
+            break;
+    }
+}
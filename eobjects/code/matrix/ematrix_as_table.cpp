@@ -149,7 +149,7 @@ void eMatrix::insert(
             }
             while (row);
         }
-        docallback(ECALLBACK_TABLE_CONTENT_CHANGED);
+        table_changed(EMTX_JOURNAL_INSERT, OS_NULL, rows, tflags);
 
         if (local_dbm_use) {
             dbm->trigdata_send();
@@ -384,7 +384,7 @@ eStatus eMatrix::update(
     if ((tflags & ETABLE_INSERT_OR_UPDATE) && !row_to_update_found)
     {
         insert_one_row(row, -1, dbm);
-        docallback(ECALLBACK_TABLE_CONTENT_CHANGED);
+        table_changed(EMTX_JOURNAL_INSERT, OS_NULL, row, tflags);
         s = ESTATUS_SUCCESS;
     }
 
@@ -393,7 +393,7 @@ eStatus eMatrix::update(
             s = ESTATUS_SUCCESS;
         }
         else if (s == ESTATUS_SUCCESS) {
-           docallback(ECALLBACK_TABLE_CONTENT_CHANGED);
+           table_changed(EMTX_JOURNAL_UPDATE, where_clause, row, tflags);
         }
     }
 
@@ -442,7 +442,7 @@ void eMatrix::remove(
         s = ESTATUS_SUCCESS;
     }
     else if (s == ESTATUS_SUCCESS) {
-        docallback(ECALLBACK_TABLE_CONTENT_CHANGED);
+        table_changed(EMTX_JOURNAL_REMOVE, where_clause, OS_NULL, tflags);
     }
 
     if (local_dbm_use) {
@@ -765,6 +765,64 @@ getout:
 }
 
 
+/**
+****************************************************************************************************
+
+  @brief Inform parent object about table change.
+
+  The eMatrix::table_changed() function calls parent's oncallback() with
+  ECALLBACK_TABLE_CONTENT_CHANGED event. Change record describing the operation is given as
+  appendix, so that parent, like ePersistent, can journal the change instead of saving the
+  whole matrix. Record is generated only if parent is ePersistent which is journaling
+  changes, otherwise callback is done without appendix.
+
+  @param   op Operation, EMTX_JOURNAL_INSERT, EMTX_JOURNAL_UPDATE or EMTX_JOURNAL_REMOVE.
+  @param   where_clause Where clause for update and remove, OS_NULL for insert.
+  @param   rows Inserted or updated row(s), OS_NULL for remove.
+  @param   tflags Table flags given to the operation. Only ETABLE_INSERT_OR_UPDATE is recorded.
+  @return  None.
+
+****************************************************************************************************
+*/
+void eMatrix::table_changed(
+    os_int op,
+    const os_char *where_clause,
+    eContainer *rows,
+    os_int tflags)
+{
+    eContainer *record;
+    eVariable *v;
+    eObject *p;
+
+    if (!hascallback()) return;
+
+    p = parent();
+    if (p == OS_NULL || p->classid() != ECLASSID_PERSISTENT ||
+        !ePersistent::cast(p)->journaling())
+    {
+        docallback(ECALLBACK_TABLE_CONTENT_CHANGED);
+        return;
+    }
+
+    record = new eContainer(ETEMPORARY);
+    v = new eVariable(record, EOID_PARAMETER);
+    v->setl(op);
+    v = new eVariable(record, EOID_FLAGS);
+    v->setl(tflags & ETABLE_INSERT_OR_UPDATE);
+    if (where_clause)
+    {
+        v = new eVariable(record, EOID_TABLE_WHERE);
+        v->sets(where_clause);
+    }
+    if (rows) {
+        rows->clone(record, EOID_CONTENT);
+    }
+
+    docallback(ECALLBACK_TABLE_CONTENT_CHANGED, record);
+    delete record;
+}
+
+
 /**
 ****************************************************************************************************
 
@@ -0,0 +1,489 @@
+/**
+
+  @file    ematrix_snapshot.cpp
+  @brief   Memory image snapshot of eMatrix data.
+  @author  Pekka Lehtikoski
+  @version 1.0
+  @date    18.10.2026
+
+  Large persistent tables are slow to load through stream deserializer, since every element
+  is parsed and set separately. Memory image snapshot stores matrix data blocks as they are
+  in memory, so that loading reads each block directly into eBuffer which then becomes the
+  matrix's block storage. Nothing is parsed per element, except strings.
+
+  File layout, all sections start at EMTX_SNAPSHOT_ALIGN byte boundary:
+  - eMatrixSnapshotHeader.
+  - Block directory: Buffer number (eBuffer oid) of each stored block, os_int each.
+  - Data blocks, block_sz bytes each: per_block elements followed by per_block type bytes
+    for matrices which have element type.
+  - Strings of OS_OBJECT matrix: Element index, length including terminating null character
+    and the string, until element index -1.
+
+  The snapshot is specific to build: Header holds byte order, element sizes and number of
+  elements per block. If elements per block differ, blocks are copied element by element.
+  Matrix holding objects (OS_OBJECT elements) cannot be saved as snapshot.
+
+  Copyright 2020 Pekka Lehtikoski. This file is part of the eobjects project and shall only be used,
+  modified, and distributed under the terms of the project licensing. By continuing to use, modify,
+  or distribute this file you indicate that you have read the license and understand and accept
+  it fully.
+
+****************************************************************************************************
+*/
+#include "eobjects.h"
+
+/* Round size up to alignment.
+ */
+#define EMTX_SNAPSHOT_ROUND(n) (((n) + EMTX_SNAPSHOT_ALIGN - 1) & ~(EMTX_SNAPSHOT_ALIGN - 1))
+
+/* Zero bytes for padding.
+ */
+static const os_char emtx_snapshot_zeros[EMTX_SNAPSHOT_ALIGN] = {0};
+
+/* Forward referred static functions.
+ */
+static eStatus emtx_snapshot_write(
+    osalStream stream,
+    const os_char *buf,
+    os_memsz n);
+
+static eStatus emtx_snapshot_read(
+    osalStream stream,
+    os_char *buf,
+    os_memsz n);
+
+static void emtx_snapshot_scrub(
+    os_char *dataptr,
+    os_char *typeptr,
+    os_int count,
+    os_int typesz);
+
+
+/**
+****************************************************************************************************
+
+  @brief Check if matrix content can be saved as memory image snapshot.
+
+  Snapshot can be saved of matrix with fixed size data type. Matrix with OS_OBJECT data type
+  can be saved if it holds only numbers and strings, but no objects.
+
+  @return OS_TRUE if snapshot can be saved.
+
+****************************************************************************************************
+*/
+os_boolean eMatrix::snapshot_supported()
+{
+    eBuffer *buffer;
+    os_char *typeptr;
+    os_int i, per_block;
+
+    if (m_datatype != OS_OBJECT) return OS_TRUE;
+
+    per_block = elems_per_block();
+    for (buffer = eBuffer::cast(first());
+         buffer;
+         buffer = eBuffer::cast(buffer->next()))
+    {
+        if (buffer->oid() <= 0) continue;
+        typeptr = buffer->ptr() + per_block * m_typesz;
+        for (i = 0; i < per_block; i++) {
+            if (typeptr[i] == OS_OBJECT) return OS_FALSE;
+        }
+    }
+    return OS_TRUE;
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Save matrix data blocks as memory image snapshot file.
+
+  The eMatrix::save_snapshot function writes header, block directory and data blocks of the
+  matrix to file. Data is written directly to OS file stream, not encoded as serialized
+  object. Only data is saved, table configuration is saved with the matrix object.
+
+  @param  path OS path to snapshot file.
+  @param  seq Sequence number to store in header. Used to verify that snapshot belongs to
+          the same save as the object holding the matrix.
+  @return ESTATUS_SUCCESS if successfull, ESTATUS_NOT_SUPPORTED if matrix holds objects.
+          Other nonzero values indicate an error.
+
+****************************************************************************************************
+*/
+eStatus eMatrix::save_snapshot(
+    const os_char *path,
+    os_long seq)
+{
+    eMatrixSnapshotHeader hdr;
+    eOsStream *stream;
+    eBuffer *buffer;
+    eVariable tmp;
+    osalStream os;
+    os_char *dataptr, *typeptr, *s;
+    os_int *dir, dir_sz, nblocks, per_block, used_sz, i, rec[2];
+    eStatus st;
+
+    if (!snapshot_supported()) return ESTATUS_NOT_SUPPORTED;
+
+    per_block = elems_per_block();
+    used_sz = per_block * m_elemsz;
+
+    nblocks = 0;
+    for (buffer = eBuffer::cast(first());
+         buffer;
+         buffer = eBuffer::cast(buffer->next()))
+    {
+        if (buffer->oid() > 0) nblocks++;
+    }
+
+    dir_sz = nblocks * (os_int)sizeof(os_int);
+    dir = (os_int*)os_malloc(dir_sz + 1, OS_NULL);
+    nblocks = 0;
+    for (buffer = eBuffer::cast(first());
+         buffer;
+         buffer = eBuffer::cast(buffer->next()))
+    {
+        if (buffer->oid() > 0) dir[nblocks++] = buffer->oid();
+    }
+
+    os_memclear(&hdr, sizeof(hdr));
+    os_strncpy(hdr.magic, EMTX_SNAPSHOT_MAGIC, sizeof(hdr.magic));
+    hdr.version = EMTX_SNAPSHOT_VERSION;
+    hdr.byte_order = EMTX_SNAPSHOT_BYTE_ORDER;
+    hdr.hdr_sz = EMTX_SNAPSHOT_ROUND((os_int)sizeof(hdr) + dir_sz);
+    hdr.datatype = m_datatype;
+    hdr.typesz = m_typesz;
+    hdr.elemsz = m_elemsz;
+    hdr.per_block = per_block;
+    hdr.block_sz = EMTX_SNAPSHOT_ROUND(used_sz);
+    hdr.nrows = m_nrows;
+    hdr.ncolumns = m_ncolumns;
+    hdr.nblocks = nblocks;
+    hdr.seq = seq;
+
+    stream = new eOsStream(ETEMPORARY);
+    tmp.sets("file:");
+    tmp.appends(path);
+    st = stream->open(tmp.gets(), OS_NULL, OSAL_STREAM_WRITE);
+    if (st) goto getout;
+    os = stream->osstream();
+
+    /* Header and block directory.
+     */
+    st = emtx_snapshot_write(os, (os_char*)&hdr, sizeof(hdr));
+    if (st) goto getout;
+    st = emtx_snapshot_write(os, (os_char*)dir, dir_sz);
+    if (st) goto getout;
+    st = emtx_snapshot_write(os, emtx_snapshot_zeros, hdr.hdr_sz - (os_int)sizeof(hdr) - dir_sz);
+    if (st) goto getout;
+
+    /* Data blocks in same order as in directory.
+     */
+    for (buffer = eBuffer::cast(first());
+         buffer;
+         buffer = eBuffer::cast(buffer->next()))
+    {
+        if (buffer->oid() <= 0) continue;
+        st = emtx_snapshot_write(os, buffer->ptr(), used_sz);
+        if (st) goto getout;
+        st = emtx_snapshot_write(os, emtx_snapshot_zeros, hdr.block_sz - used_sz);
+        if (st) goto getout;
+    }
+
+    /* Strings.
+     */
+    if (m_datatype == OS_OBJECT)
+    {
+        for (buffer = eBuffer::cast(first());
+             buffer;
+             buffer = eBuffer::cast(buffer->next()))
+        {
+            if (buffer->oid() <= 0) continue;
+            dataptr = buffer->ptr();
+            typeptr = dataptr + per_block * m_typesz;
+            for (i = 0; i < per_block; i++)
+            {
+                if (typeptr[i] != OS_STR) continue;
+                os_memcpy(&s, dataptr + i * m_typesz, sizeof(os_char*));
+                rec[0] = (buffer->oid() - 1) * per_block + i;
+                rec[1] = (os_int)os_strlen(s);
+                st = emtx_snapshot_write(os, (os_char*)rec, sizeof(rec));
+                if (st) goto getout;
+                st = emtx_snapshot_write(os, s, rec[1]);
+                if (st) goto getout;
+            }
+        }
+    }
+    rec[0] = -1;
+    rec[1] = 0;
+    st = emtx_snapshot_write(os, (os_char*)rec, sizeof(rec));
+    if (st) goto getout;
+
+    if (osal_stream_flush(os, OSAL_STREAM_DEFAULT)) {
+        st = ESTATUS_FAILED;
+    }
+
+getout:
+    delete stream;
+    os_free(dir, dir_sz + 1);
+    return st;
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Load matrix data blocks from memory image snapshot file.
+
+  The eMatrix::load_snapshot function replaces matrix data by data blocks read from file.
+  If number of elements per block matches, each block is read directly into eBuffer which
+  is adopted as matrix block storage. Otherwise blocks are copied element by element.
+  Pointers in blocks are meaningless once loaded, so elements which held strings are set
+  from string section of the file.
+
+  @param  path OS path to snapshot file.
+  @param  seq Expected sequence number. Snapshot with other sequence number is not loaded.
+  @return ESTATUS_SUCCESS if successfull. Other values indicate that snapshot file was not
+          found, did not match or was corrupted. If the file was corrupted, matrix is left
+          without rows.
+
+****************************************************************************************************
+*/
+eStatus eMatrix::load_snapshot(
+    const os_char *path,
+    os_long seq)
+{
+    eMatrixSnapshotHeader hdr;
+    eOsStream *stream;
+    eBuffer *buffer, strbuf;
+    eVariable tmp;
+    osalStream os;
+    os_char *dataptr, *typeptr, *blockbuf = OS_NULL, pad[EMTX_SNAPSHOT_ALIGN];
+    os_int *dir = OS_NULL, dir_sz = 0, used_sz = 0, per_block, max_nr, nr, i, k,
+        elem_ix, nelems, rec[2];
+    os_boolean direct, modified = OS_FALSE;
+    eStatus st;
+
+    stream = new eOsStream(ETEMPORARY);
+    tmp.sets("file:");
+    tmp.appends(path);
+    st = stream->open(tmp.gets(), OS_NULL, OSAL_STREAM_READ);
+    if (st) goto getout;
+    os = stream->osstream();
+
+    /* Check that header matches this build and the expected save.
+     */
+    st = emtx_snapshot_read(os, (os_char*)&hdr, sizeof(hdr));
+    if (st) goto getout;
+    st = ESTATUS_FAILED;
+    if (os_strncmp(hdr.magic, EMTX_SNAPSHOT_MAGIC, sizeof(hdr.magic)) ||
+        hdr.version != EMTX_SNAPSHOT_VERSION ||
+        hdr.byte_order != EMTX_SNAPSHOT_BYTE_ORDER ||
+        hdr.seq != seq ||
+        hdr.nrows < 0 || hdr.ncolumns < 0 || hdr.nblocks < 0 ||
+        hdr.per_block <= 0 ||
+        hdr.typesz != typesz((osalTypeId)hdr.datatype) ||
+        hdr.block_sz != EMTX_SNAPSHOT_ROUND(hdr.per_block * hdr.elemsz))
+    {
+        goto getout;
+    }
+    dir_sz = hdr.nblocks * (os_int)sizeof(os_int);
+    if (hdr.hdr_sz != EMTX_SNAPSHOT_ROUND((os_int)sizeof(hdr) + dir_sz)) goto getout;
+
+    dir = (os_int*)os_malloc(dir_sz + 1, OS_NULL);
+    st = emtx_snapshot_read(os, (os_char*)dir, dir_sz);
+    if (st) goto getout;
+    st = emtx_snapshot_read(os, pad, hdr.hdr_sz - (os_int)sizeof(hdr) - dir_sz);
+    if (st) goto getout;
+
+    modified = OS_TRUE;
+    clear();
+    allocate((osalTypeId)hdr.datatype, hdr.nrows, hdr.ncolumns);
+    st = ESTATUS_FAILED;
+    if (m_typesz != hdr.typesz || m_elemsz != hdr.elemsz) goto getout;
+
+    per_block = elems_per_block();
+    direct = (os_boolean)(per_block == hdr.per_block);
+    used_sz = hdr.per_block * hdr.elemsz;
+    nelems = m_nrows * m_ncolumns;
+    max_nr = nelems ? (nelems - 1) / hdr.per_block + 1 : 0;
+    if (!direct) {
+        blockbuf = os_malloc(used_sz, OS_NULL);
+    }
+
+    /* Data blocks.
+     */
+    for (k = 0; k < hdr.nblocks; k++)
+    {
+        nr = dir[k];
+        if (nr <= 0 || nr > max_nr) goto getout;
+
+        if (direct)
+        {
+            if (first(nr)) goto getout;
+            buffer = new eBuffer(this, nr);
+            dataptr = buffer->allocate(eglobal->matrix_buffer_allocation_sz);
+            st = emtx_snapshot_read(os, dataptr, used_sz);
+            if (st) goto getout;
+            if (m_datatype == OS_OBJECT) {
+                emtx_snapshot_scrub(dataptr, dataptr + per_block * m_typesz,
+                    per_block, m_typesz);
+            }
+        }
+        else
+        {
+            st = emtx_snapshot_read(os, blockbuf, used_sz);
+            if (st) goto getout;
+            for (i = 0; i < hdr.per_block; i++)
+            {
+                elem_ix = (nr - 1) * hdr.per_block + i;
+                if (elem_ix >= nelems) break;
+                dataptr = getptrs(elem_ix / m_ncolumns, elem_ix % m_ncolumns,
+                    &typeptr, EMATRIX_ALLOCATE_IF_NEEDED);
+                if (dataptr == OS_NULL) continue;
+                os_memcpy(dataptr, blockbuf + i * m_typesz, m_typesz);
+                if (typeptr)
+                {
+                    *typeptr = blockbuf[hdr.per_block * m_typesz + i];
+                    if (m_datatype == OS_OBJECT) {
+                        emtx_snapshot_scrub(dataptr, typeptr, 1, m_typesz);
+                    }
+                }
+            }
+        }
+
+        st = emtx_snapshot_read(os, pad, hdr.block_sz - used_sz);
+        if (st) goto getout;
+        st = ESTATUS_FAILED;
+    }
+
+    /* Strings.
+     */
+    while (OS_TRUE)
+    {
+        st = emtx_snapshot_read(os, (os_char*)rec, sizeof(rec));
+        if (st) goto getout;
+        st = ESTATUS_FAILED;
+        if (rec[0] < 0) break;
+        if (rec[0] >= nelems || rec[1] <= 0 || m_datatype != OS_OBJECT) goto getout;
+
+        dataptr = strbuf.allocate(rec[1]);
+        st = emtx_snapshot_read(os, dataptr, rec[1]);
+        if (st) goto getout;
+        st = ESTATUS_FAILED;
+        dataptr[rec[1] - 1] = '\0';
+        sets(rec[0] / m_ncolumns, rec[0] % m_ncolumns, dataptr);
+    }
+    st = ESTATUS_SUCCESS;
+
+getout:
+    if (st && modified) {
+        nr = m_ncolumns;
+        clear();
+        resize(m_datatype, 0, nr);
+    }
+    delete stream;
+    if (dir) os_free(dir, dir_sz + 1);
+    if (blockbuf) os_free(blockbuf, used_sz);
+    return st;
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Write to OS stream.
+
+  @param  stream OS stream.
+  @param  buf Data to write.
+  @param  n Number of bytes to write.
+  @return ESTATUS_SUCCESS if all data was written, ESTATUS_FAILED otherwise.
+
+****************************************************************************************************
+*/
+static eStatus emtx_snapshot_write(
+    osalStream stream,
+    const os_char *buf,
+    os_memsz n)
+{
+    os_memsz nwritten;
+
+    while (n > 0)
+    {
+        if (osal_stream_write(stream, buf, n, &nwritten, OSAL_STREAM_DEFAULT)) {
+            return ESTATUS_FAILED;
+        }
+        if (nwritten <= 0) return ESTATUS_FAILED;
+        buf += nwritten;
+        n -= nwritten;
+    }
+    return ESTATUS_SUCCESS;
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Read from OS stream.
+
+  @param  stream OS stream.
+  @param  buf Buffer where to read.
+  @param  n Number of bytes to read.
+  @return ESTATUS_SUCCESS if all data was read, ESTATUS_FAILED at error or end of file.
+
+****************************************************************************************************
+*/
+static eStatus emtx_snapshot_read(
+    osalStream stream,
+    os_char *buf,
+    os_memsz n)
+{
+    os_memsz nread;
+
+    while (n > 0)
+    {
+        if (osal_stream_read(stream, buf, n, &nread, OSAL_STREAM_DEFAULT)) {
+            return ESTATUS_FAILED;
+        }
+        if (nread <= 0) return ESTATUS_FAILED;
+        buf += nread;
+        n -= nread;
+    }
+    return ESTATUS_SUCCESS;
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Mark loaded string and object elements empty.
+
+  Pointers stored in snapshot file are not valid. Elements are marked empty, so that setting
+  string to element doesn't free invalid pointer.
+
+  @param  dataptr Pointer to first element data.
+  @param  typeptr Pointer to first element type.
+  @param  count Number of elements.
+  @param  typesz Element data size.
+  @return None.
+
+****************************************************************************************************
+*/
+static void emtx_snapshot_scrub(
+    os_char *dataptr,
+    os_char *typeptr,
+    os_int count,
+    os_int typesz)
+{
+    os_int i;
+
+    for (i = 0; i < count; i++)
+    {
+        if (typeptr[i] == OS_STR || typeptr[i] == OS_OBJECT)
+        {
+            os_memclear(dataptr + i * typesz, typesz);
+            typeptr[i] = OS_UNDEFINED_TYPE;
+        }
+    }
+}
@@ -604,6 +604,11 @@ eStatus eName::mapname2(
     m_namespace = ns;
     m_is_process_ns = (info & E_INFO_PROCES_NS) ? OS_TRUE : OS_FALSE;
 
+    /* Mapped string names are interned, so that name lookup with interned key and copying
+       the name do not need to compare or copy the string.
+     */
+    intern();
+
     /* If process name space, synchronize.
      */
     if (m_is_process_ns) os_lock();
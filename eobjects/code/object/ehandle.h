@@ -119,6 +119,7 @@ class eHandle
     friend class eHandleTable;
     friend class eRoot;
     friend class ePointer;
+    friend class eBindingChannel;
 
 public:
     eHandle();
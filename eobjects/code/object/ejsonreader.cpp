@@ -0,0 +1,342 @@
+/**
+
+  @file    ejsonreader.cpp
+  @brief   Streaming JSON tokenizer.
+  @author  Pekka Lehtikoski
+  @version 1.0
+  @date    18.10.2026
+
+  The eJsonReader reads JSON from eStream one token at a time. Strings and numbers are
+  collected into small stack buffer and appended to value variable, so memory use doesn't
+  depend on size of the JSON input.
+
+  Copyright 2020 Pekka Lehtikoski. This file is part of the eobjects project and shall only be used,
+  modified, and distributed under the terms of the project licensing. By continuing to use, modify,
+  or distribute this file you indicate that you have read the license and understand and accept
+  it fully.
+
+****************************************************************************************************
+*/
+#include "eobjects.h"
+#if E_SUPPROT_JSON
+
+
+/**
+****************************************************************************************************
+  Constructor.
+****************************************************************************************************
+*/
+eJsonReader::eJsonReader(
+    eStream *stream)
+{
+    m_stream = stream;
+    m_c = -1;
+    m_isstring = OS_FALSE;
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Read next token.
+
+  The eJsonReader::next() function skips white space, commas and colons and returns the
+  next token.
+
+  @return Structural token '{', '}', '[' or ']', EJSON_TOKEN_VALUE if string, number, true,
+          false or null was read into value(), EJSON_TOKEN_END at end of stream or
+          EJSON_TOKEN_ERROR if the input is not valid JSON.
+
+****************************************************************************************************
+*/
+os_int eJsonReader::next()
+{
+    os_int c;
+
+    while (OS_TRUE)
+    {
+        c = getch();
+        switch (c)
+        {
+            case ' ':
+            case '\t':
+            case '\n':
+            case '\r':
+            case ',':
+            case ':':
+                break;
+
+            case '{':
+            case '}':
+            case '[':
+            case ']':
+                return c;
+
+            case '\"':
+                return read_string();
+
+            default:
+                if (c >= E_STREAM_CTRL_BASE || c < 0) return EJSON_TOKEN_END;
+                return read_literal(c);
+        }
+    }
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Skip value.
+
+  The eJsonReader::skip() function reads past the value which starts with token. Used to
+  skip items which the reader doesn't know, like "bindings".
+
+  @param  token First token of the value.
+  @return ESTATUS_SUCCESS if successfull, ESTATUS_FAILED if JSON is broken.
+
+****************************************************************************************************
+*/
+eStatus eJsonReader::skip(
+    os_int token)
+{
+    os_int depth = 0;
+
+    while (OS_TRUE)
+    {
+        switch (token)
+        {
+            case EJSON_TOKEN_BEGIN_OBJECT:
+            case EJSON_TOKEN_BEGIN_ARRAY:
+                depth++;
+                break;
+
+            case EJSON_TOKEN_END_OBJECT:
+            case EJSON_TOKEN_END_ARRAY:
+                depth--;
+                break;
+
+            case EJSON_TOKEN_VALUE:
+                break;
+
+            default:
+                return ESTATUS_FAILED;
+        }
+
+        if (depth <= 0) return ESTATUS_SUCCESS;
+        token = next();
+    }
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Read quoted string.
+
+  The eJsonReader::read_string() function reads string after the opening quote and stores
+  it to value. Escape sequences are decoded, "\u" escapes as UTF-8. Surrogate pair is
+  combined into one character, unpaired surrogate is replaced by U+FFFD.
+
+  @return EJSON_TOKEN_VALUE if successfull, EJSON_TOKEN_ERROR if string is not terminated.
+
+****************************************************************************************************
+*/
+os_int eJsonReader::read_string()
+{
+    os_char buf[EJSON_READER_BUF_SZ];
+    os_int c, i, n, u;
+    os_uint code;
+    os_boolean high;
+
+    m_value.sets(osal_str_empty);
+    m_isstring = OS_TRUE;
+    n = 0;
+    code = 0;
+    high = OS_FALSE;
+
+    while (OS_TRUE)
+    {
+        /* Keep room for replacement character and one UTF-8 character.
+         */
+        if (n > EJSON_READER_BUF_SZ - 8) {
+            m_value.appends_nbytes(buf, n);
+            n = 0;
+        }
+
+        c = getch();
+        if (c >= E_STREAM_CTRL_BASE || c < 0) return EJSON_TOKEN_ERROR;
+        if (c == '\"') {
+            if (high) n = put_replacement_char(buf, n);
+            break;
+        }
+
+        if (c != '\\') {
+            if (high) {
+                n = put_replacement_char(buf, n);
+                high = OS_FALSE;
+            }
+            buf[n++] = (os_char)c;
+            continue;
+        }
+
+        /* High surrogate not followed by "\u" escape.
+         */
+        c = getch();
+        if (high && c != 'u') {
+            n = put_replacement_char(buf, n);
+            high = OS_FALSE;
+        }
+
+        switch (c)
+        {
+            case 'b': buf[n++] = '\b'; break;
+            case 'f': buf[n++] = '\f'; break;
+            case 'n': buf[n++] = '\n'; break;
+            case 'r': buf[n++] = '\r'; break;
+            case 't': buf[n++] = '\t'; break;
+
+            case 'u':
+                u = 0;
+                for (i = 0; i < 4; i++) {
+                    c = getch();
+                    if (c >= '0' && c <= '9') u = 16 * u + c - '0';
+                    else if (c >= 'a' && c <= 'f') u = 16 * u + c - 'a' + 10;
+                    else if (c >= 'A' && c <= 'F') u = 16 * u + c - 'A' + 10;
+                    else return EJSON_TOKEN_ERROR;
+                }
+
+                /* High surrogate, wait for low one. Previous high surrogate without
+                   low one is replaced.
+                 */
+                if (u >= 0xD800 && u < 0xDC00) {
+                    if (high) n = put_replacement_char(buf, n);
+                    code = (os_uint)(u - 0xD800) << 10;
+                    high = OS_TRUE;
+                    break;
+                }
+                if (u >= 0xDC00 && u < 0xE000) {
+                    u = high ? (os_int)(0x10000 + code + (u - 0xDC00)) : 0xFFFD;
+                }
+                else if (high) {
+                    n = put_replacement_char(buf, n);
+                }
+                high = OS_FALSE;
+                code = 0;
+
+                if (u < 0x80) {
+                    buf[n++] = (os_char)u;
+                }
+                else if (u < 0x800) {
+                    buf[n++] = (os_char)(0xC0 | (u >> 6));
+                    buf[n++] = (os_char)(0x80 | (u & 0x3F));
+                }
+                else if (u < 0x10000) {
+                    buf[n++] = (os_char)(0xE0 | (u >> 12));
+                    buf[n++] = (os_char)(0x80 | ((u >> 6) & 0x3F));
+                    buf[n++] = (os_char)(0x80 | (u & 0x3F));
+                }
+                else {
+                    buf[n++] = (os_char)(0xF0 | (u >> 18));
+                    buf[n++] = (os_char)(0x80 | ((u >> 12) & 0x3F));
+                    buf[n++] = (os_char)(0x80 | ((u >> 6) & 0x3F));
+                    buf[n++] = (os_char)(0x80 | (u & 0x3F));
+                }
+                break;
+
+            default: /* '\"', '\\' and '/' */
+                if (c >= E_STREAM_CTRL_BASE || c < 0) return EJSON_TOKEN_ERROR;
+                buf[n++] = (os_char)c;
+                break;
+        }
+    }
+
+    if (n) {
+        m_value.appends_nbytes(buf, n);
+    }
+    return EJSON_TOKEN_VALUE;
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Store U+FFFD replacement character as UTF-8.
+
+  @param   buf Buffer where to store, must have room for 3 bytes.
+  @param   n Number of bytes in buffer.
+  @return  Number of bytes in buffer after the character.
+
+****************************************************************************************************
+*/
+os_int eJsonReader::put_replacement_char(
+    os_char *buf,
+    os_int n)
+{
+    buf[n++] = (os_char)0xEF;
+    buf[n++] = (os_char)0xBF;
+    buf[n++] = (os_char)0xBD;
+    return n;
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Read number, true, false or null.
+
+  The eJsonReader::read_literal() function reads unquoted value. Integer number is stored
+  as long integer and number with decimal point or exponent as double. true and false are
+  stored as 1 and 0, null leaves value empty.
+
+  @param  c First character of the literal.
+  @return EJSON_TOKEN_VALUE if successfull, EJSON_TOKEN_ERROR if literal is not valid.
+
+****************************************************************************************************
+*/
+os_int eJsonReader::read_literal(
+    os_int c)
+{
+    os_char buf[EJSON_READER_BUF_SZ];
+    os_int n = 0;
+    os_boolean isfloat = OS_FALSE;
+
+    m_isstring = OS_FALSE;
+
+    while ((c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') ||
+        c == '-' || c == '+' || c == '.' || c == 'E')
+    {
+        if (n >= EJSON_READER_BUF_SZ - 1) return EJSON_TOKEN_ERROR;
+        if (c == '.' || c == 'e' || c == 'E') isfloat = OS_TRUE;
+        buf[n++] = (os_char)c;
+        c = getch();
+    }
+    buf[n] = '\0';
+    m_c = c;
+
+    if (n == 0) return EJSON_TOKEN_ERROR;
+
+    if (!os_strcmp(buf, "true")) {
+        m_value.setl(1);
+    }
+    else if (!os_strcmp(buf, "false")) {
+        m_value.setl(0);
+    }
+    else if (!os_strcmp(buf, "null")) {
+        m_value.clear();
+    }
+    else if ((buf[0] >= '0' && buf[0] <= '9') || buf[0] == '-') {
+        if (isfloat) {
+            m_value.setd(osal_str_to_double(buf, OS_NULL));
+        }
+        else {
+            m_value.setl(osal_str_to_int(buf, OS_NULL));
+        }
+    }
+    else {
+        return EJSON_TOKEN_ERROR;
+    }
+
+    return EJSON_TOKEN_VALUE;
+}
+
+#endif
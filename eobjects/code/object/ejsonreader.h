@@ -0,0 +1,134 @@
+/**
+
+  @file    ejsonreader.h
+  @brief   Streaming JSON tokenizer.
+  @author  Pekka Lehtikoski
+  @version 1.0
+  @date    18.10.2026
+
+  The eJsonReader reads JSON from eStream one token at a time. Objects are constructed
+  directly from tokens by eObject::json_read() and class specific json_reader() functions,
+  no intermediate document tree is built.
+
+  Copyright 2020 Pekka Lehtikoski. This file is part of the eobjects project and shall only be used,
+  modified, and distributed under the terms of the project licensing. By continuing to use, modify,
+  or distribute this file you indicate that you have read the license and understand and accept
+  it fully.
+
+****************************************************************************************************
+*/
+#pragma once
+#ifndef EJSONREADER_H_
+#define EJSONREADER_H_
+#include "eobjects.h"
+#if E_SUPPROT_JSON
+
+/**
+****************************************************************************************************
+  Defines
+****************************************************************************************************
+*/
+
+/* JSON tokens returned by eJsonReader::next(). Structural tokens are the characters
+   themselves. EJSON_TOKEN_VALUE is string, number, true, false or null, the value is
+   in eJsonReader::value().
+ */
+#define EJSON_TOKEN_ERROR -1
+#define EJSON_TOKEN_END 0
+#define EJSON_TOKEN_BEGIN_OBJECT '{'
+#define EJSON_TOKEN_END_OBJECT '}'
+#define EJSON_TOKEN_BEGIN_ARRAY '['
+#define EJSON_TOKEN_END_ARRAY ']'
+#define EJSON_TOKEN_VALUE 'v'
+
+/* Size of stack buffer used to collect characters of a string or number before
+   appending them to value.
+ */
+#define EJSON_READER_BUF_SZ 128
+
+
+/**
+****************************************************************************************************
+
+  @brief JSON tokenizer class.
+
+  The eJsonReader is used as local variable while reading one JSON object tree. Commas and
+  colons are separators, the caller knows from position whether string is name or value.
+
+****************************************************************************************************
+*/
+class eJsonReader
+{
+public:
+    /* Constructor.
+     */
+    eJsonReader(
+        eStream *stream);
+
+    /* Read next token.
+     */
+    os_int next();
+
+    /* Value of last EJSON_TOKEN_VALUE.
+     */
+    inline eVariable *value()
+        {return &m_value; }
+
+    /* Value of last EJSON_TOKEN_VALUE is string.
+     */
+    inline os_boolean isstring()
+        {return m_isstring; }
+
+    /* Skip value which starts with token.
+     */
+    eStatus skip(
+        os_int token);
+
+protected:
+    /* Get next character from stream.
+     */
+    inline os_int getch()
+    {
+        os_int c;
+        if (m_c >= 0) {
+            c = m_c;
+            m_c = -1;
+            return c;
+        }
+        return m_stream->readchar();
+    }
+
+    /* Read quoted string.
+     */
+    os_int read_string();
+
+    /* Store U+FFFD replacement character in buffer, returns new byte count.
+     */
+    os_int put_replacement_char(
+        os_char *buf,
+        os_int n);
+
+    /* Read number, true, false or null.
+     */
+    os_int read_literal(
+        os_int c);
+
+    /** Stream to read from.
+     */
+    eStream *m_stream;
+
+    /** Character read ahead, -1 if none.
+     */
+    os_int m_c;
+
+    /** Value of last EJSON_TOKEN_VALUE.
+     */
+    eVariable m_value;
+
+    /** Last value was quoted string.
+     */
+    os_boolean m_isstring;
+};
+
+#endif
+#endif
@@ -35,7 +35,9 @@ class eContainer;
 class eNameSpace;
 class eName;
 class eStream;
+class eJsonReader;
 class eEnvelope;
+struct eBindParams;
 class eThread;
 class ePointer;
 class ePropertyBinding;
@@ -81,6 +83,11 @@ class eRowSetBinding;
  */
 #define EPRO_NO_ERRORS EMSG_NO_ERRORS
 
+/* Flags for propertysetdone() function, stored in property set container's flags.
+ */
+#define EPSET_DEFAULT 0
+#define EPSET_DENSE EOBJ_CUST_FLAG1
+
 /* Serialization flags eObject::write(), eObject::read() and clonegeeric() functions.
  */
 #define EOBJ_SERIALIZE_DEFAULT 0
@@ -530,10 +537,11 @@ public:
         return ESTATUS_FAILED;
     }
 
-    /* Save this object to a file
+    /* Save this object to a file, or append it to end of file.
      */
     eStatus save(
-        const os_char *path);
+        const os_char *path,
+        os_boolean append = OS_FALSE);
 
     /* Load object from a file
      */
@@ -567,6 +575,14 @@ public:
         eStream *stream,
         os_int sflags = EOBJ_SERIALIZE_DEFAULT);
 
+    /* Read JSON value, starting with token, as new child object.
+     */
+    eObject *json_read_value(
+        eJsonReader *reader,
+        os_int token,
+        const os_char *name = OS_NULL,
+        os_int sflags = EOBJ_SERIALIZE_DEFAULT);
+
     /* Print object as JSON to console.
      */
     void print_json(os_int sflags = EOBJ_JSON_LIST_NAMESPACE);
@@ -585,6 +601,13 @@ public:
         eStream *stream,
         os_int sflags = EOBJ_SERIALIZE_DEFAULT,
         os_int indent = 0);
+
+    /* Class specific part of JSON reader, token is the first token of "content" value.
+     */
+    virtual eStatus json_reader(
+        eJsonReader *reader,
+        os_int token,
+        os_int sflags = EOBJ_SERIALIZE_DEFAULT);
 #endif
 
     /**
@@ -870,7 +893,8 @@ public:
     /* Property set for class done, complete it.
      */
     static void propertysetdone(
-        os_int cid);
+        os_int cid,
+        os_int psflags = EPSET_DEFAULT);
 
     /* Get pointer to class'es property set.
      */
@@ -996,14 +1020,16 @@ public:
         os_int localpropertynr,
         const os_char *remotepath,
         const os_char *remoteproperty,
-        os_int bflags = 0);
+        os_int bflags = 0,
+        const eBindParams *bparams = OS_NULL);
 
     /* Bind properties, remote property .
      */
     void bind(
         os_int localpropertynr,
         const os_char *remotepath,
-        os_int bflags = 0);
+        os_int bflags = 0,
+        const eBindParams *bparams = OS_NULL);
 
     /* Create bindings container for the object.
      */
@@ -1019,9 +1045,10 @@ public:
     eRowSetBinding *firstrb(
         e_oid id);
 
-    /* Check if this object has server side bindings.
+    /* Check if this object has server side bindings, to any or to specific property.
      */
-    os_boolean is_bound();
+    os_boolean is_bound(
+        os_int propertynr = -1);
 
 
     /**
@@ -1173,6 +1200,27 @@ protected:
         const os_char *item,
         os_int flags,
         os_int bit);
+
+    /* Read JSON object after '{' as new child object.
+     */
+    eObject *json_read_object(
+        eJsonReader *reader,
+        const os_char *name,
+        os_int sflags);
+
+    /* Read JSON array of strings, like "names" or "flags".
+     */
+    eStatus json_read_list(
+        eJsonReader *reader,
+        os_int token,
+        eContainer *list);
+
+    /* Read JSON "properties" and set property values.
+     */
+    eStatus json_read_properties(
+        eJsonReader *reader,
+        os_int token,
+        os_int sflags);
 #endif
 
     /* Pointer to object's handle.
@@ -76,7 +76,13 @@ void eObject::forwardproperty(
             any limit to buffered memory use.
           - EBIND_METADATA: If meta data, like text, unit, attributes, etc exists, it is
             also transferred from remote object to local object.
+          - EBIND_BATCH: Changes are sent together with changes of other batched bindings
+            to the same remote thread, as one message per thread cycle with one acknowledge.
+          - EBIND_LATEST: Only the latest value matters, keep at most one forwarded value
+            waiting for acknowledge instead of EBIND_MAX_ACK_COUNT.
           - EBIND_TEMPORARY: Binding is temporary and will not be cloned nor serialized.
+  @param  bparams Optional rate limit and deadband options, OS_NULL if none. Options apply
+          to values forwarded in both directions.
   @param  envelope Used for server binding only. OS_NULL for clint binding.
   @return None.
 
@@ -86,7 +92,8 @@ void eObject::bind(
     os_int localpropertynr,
     const os_char *remotepath,
     const os_char *remoteproperty,
-    os_int bflags)
+    os_int bflags,
+    const eBindParams *bparams)
 {
     eContainer *bindings;
     ePropertyBinding *binding;
@@ -105,7 +112,7 @@ void eObject::bind(
 
     /* Bind properties. This function will send message to remote object to bind.
      */
-    binding->bind(localpropertynr, remotepath, remoteproperty, bflags);
+    binding->bind(localpropertynr, remotepath, remoteproperty, bflags, bparams);
 }
 
 
@@ -122,7 +129,8 @@ void eObject::bind(
 void eObject::bind(
     os_int localpropertynr,
     const os_char *remotepath,
-    os_int bflags)
+    os_int bflags,
+    const eBindParams *bparams)
 {
     eVariable v;
     os_char *p, *e;
@@ -141,7 +149,7 @@ void eObject::bind(
         ee = evarp_value;
     }
 
-    bind(localpropertynr, p, ee, bflags);
+    bind(localpropertynr, p, ee, bflags, bparams);
 }
 
 
@@ -333,12 +341,16 @@ eRowSetBinding *eObject::firstrb(
   sense to transfer camera data, if noone is looking at it. Also some objects should not be
   deleted until noone uses them.
 
+  @param   propertynr Check only bindings to this property. -1 to check bindings to any
+           property. This allows to produce optional data, like reduced resolution preview
+           of a camera image, only when someone has bound to it.
   @return  OS_TRUE if this object has serve side bindings (is "needed" or "looked at").
            OS_FALSE if not.
 
 ****************************************************************************************************
 */
-os_boolean eObject::is_bound()
+os_boolean eObject::is_bound(
+    os_int propertynr)
 {
     eContainer *bindings;
     ePropertyBinding *binding;
@@ -355,7 +367,8 @@ os_boolean eObject::is_bound()
         if (h->m_object->classid() == ECLASSID_PROPERTY_BINDING) {
             binding = ePropertyBinding::cast(h->m_object);
             if ((binding->bflags() & EBIND_CLIENT) == 0 &&
-                binding->state() != E_BINDING_UNUSED)
+                binding->state() != E_BINDING_UNUSED &&
+                (propertynr < 0 || binding->bound_propertynr() == propertynr))
             {
                 return OS_TRUE;
             }
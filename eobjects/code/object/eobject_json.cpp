@@ -18,6 +18,22 @@
 #include "eobjects.h"
 #if E_SUPPROT_JSON
 
+/* Items of object written by json_write(), in order they are written after "class".
+ */
+#define EJSON_LAYOUT_NAMES 1
+#define EJSON_LAYOUT_OID 2
+#define EJSON_LAYOUT_FLAGS 3
+#define EJSON_LAYOUT_PROPERTIES 4
+#define EJSON_LAYOUT_NSPACE 5
+#define EJSON_LAYOUT_BINDINGS 6
+#define EJSON_LAYOUT_CONTENT 7
+#define EJSON_LAYOUT_END 8
+
+/* Forward referred static functions.
+ */
+static os_int json_layout_stage(
+    const os_char *key);
+
 
 /* Print object as JSON to console.
  */
@@ -42,6 +58,17 @@ eStatus eObject::json_writer(
     return ESTATUS_SUCCESS;
 }
 
+/* Class specific part of JSON reader. Content of classes which don't have reader is skipped.
+ */
+eStatus eObject::json_reader(
+    eJsonReader *reader,
+    os_int token,
+    os_int sflags)
+{
+    osal_debug_error("json_reader is not overloaded for the class");
+    return reader->skip(token);
+}
+
 
 /**
 ****************************************************************************************************
@@ -295,17 +322,20 @@ failed:
 /**
 ****************************************************************************************************
 
-  @brief Read object from stream.
+  @brief Read object from JSON stream.
 
-  The eObject::read() function reads class information, etc from the stream, creates new
-  child object and reads child object content and attachments.
+  The eObject::json_read() function reads JSON from stream and creates new child object.
+  Objects are constructed directly while tokens are read, without intermediate document
+  tree, so large JSON files can be read with little extra memory.
 
-  @param  stream The stream to write to.
-  @param  sflags Serialization flags.
-            - EOBJ_SERIALIZE_DEFAULT (0) Default
-            - EOBJ_JSON_ONLY_CONTENT Serialze only content, no metadata.
+  JSON object which starts with "class" item, as written by json_write(), is restored as
+  object of that class. Other JSON is read as plain data: JSON object becomes eContainer
+  with named children, array becomes eContainer and other values eVariable.
 
-  @return If successfull the function returns pointer to te new child object.
+  @param  stream The stream to read from.
+  @param  sflags Serialization flags, EOBJ_SERIALIZE_DEFAULT.
+
+  @return If successfull the function returns pointer to the new child object.
           If reading object from stream fails, value OS_NULL is returned.
 
 ****************************************************************************************************
@@ -314,49 +344,386 @@ eObject *eObject::json_read(
     eStream *stream,
     os_int sflags)
 {
-    os_int cid, oid, oflags;
-    os_long n_attachements, i;
+    eJsonReader reader(stream);
+    return json_read_value(&reader, reader.next(), OS_NULL, sflags);
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Read JSON value as new child object.
+
+  The eObject::json_read_value() function reads JSON value which starts with token as new
+  child object of this object.
+
+  @param  reader JSON tokenizer.
+  @param  token First token of the value, as returned by reader->next().
+  @param  name Name for the new object (item name within JSON object), OS_NULL if none.
+  @param  sflags Serialization flags, EOBJ_SERIALIZE_DEFAULT.
+
+  @return Pointer to the new child object, OS_NULL if JSON is not valid.
+
+****************************************************************************************************
+*/
+eObject *eObject::json_read_value(
+    eJsonReader *reader,
+    os_int token,
+    const os_char *name,
+    os_int sflags)
+{
     eObject *child;
 
-    /* Read class identifier, object identifier, persistant object flags
-       and number of attachments.
-     */
-    if (*stream >> cid) goto failed;
-    if (*stream >> oid) goto failed;
-    if (*stream >> oflags) goto failed;
-    if (*stream >> n_attachements) goto failed;
+    switch (token)
+    {
+        case EJSON_TOKEN_BEGIN_OBJECT:
+            return json_read_object(reader, name, sflags);
 
-    /* Generate new object.
-     */
-    child = newchild(cid, oid);
-    if (child == OS_NULL) goto failed;
+        case EJSON_TOKEN_BEGIN_ARRAY:
+            child = new eContainer(this);
+            if (name) child->addname(name, 0, eobj_parent_ns);
+            while ((token = reader->next()) != EJSON_TOKEN_END_ARRAY)
+            {
+                if (child->json_read_value(reader, token, OS_NULL, sflags) == OS_NULL) {
+                    delete child;
+                    return OS_NULL;
+                }
+            }
+            return child;
 
-    /* Set flags.
+        case EJSON_TOKEN_VALUE:
+            child = new eVariable(this);
+            eVariable::cast(child)->setv(reader->value());
+            if (name) child->addname(name, 0, eobj_parent_ns);
+            return child;
+
+        default:
+            return OS_NULL;
+    }
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Read JSON object as new child object.
+
+  The eObject::json_read_object() function is called after '{' has been read. Object is
+  restored only if it has exact layout written by json_write(): The first item is "class"
+  naming a known class, and it is followed only by "names", "oid", "flags", "properties",
+  "nspace", "bindings" and "content" items in this order. "names", "oid" and "flags" are
+  collected first and the object is created before "properties" and "content" are read.
+  "nspace" and "bindings" are skipped.
+
+  If the layout doesn't match before the object is created, the JSON object is read as
+  plain data into eContainer, including items already read. So plain JSON object whose
+  first key happens to be "class" loads as data.
+
+  @param  reader JSON tokenizer.
+  @param  name Name for the new object, OS_NULL if none.
+  @param  sflags Serialization flags, EOBJ_SERIALIZE_DEFAULT.
+
+  @return Pointer to the new child object, OS_NULL if JSON is not valid.
+
+****************************************************************************************************
+*/
+eObject *eObject::json_read_object(
+    eJsonReader *reader,
+    const os_char *name,
+    os_int sflags)
+{
+    eObject *child = OS_NULL, *list;
+    eContainer names, flaglist;
+    eVariable key, classname, oidvalue, *v;
+    const os_char *k;
+    os_int token, cid, oid, oflags, stage, item_stage, seen;
+    os_boolean has_namespace, pending = OS_FALSE;
+
+    token = reader->next();
+
+    /* Object written by json_write() starts with "class" item, which names known class.
+       If class is not known, "class" is read as plain item.
      */
-    child->setflags(oflags);
+    if (token != EJSON_TOKEN_VALUE || !reader->isstring() ||
+        os_strcmp(reader->value()->gets(), "class"))
+    {
+        goto plain_object;
+    }
+    key.setv(reader->value());
+    pending = OS_TRUE;
+    token = reader->next();
+    cid = 0;
+    if (token == EJSON_TOKEN_VALUE && reader->isstring()) {
+        classname.setv(reader->value());
+        cid = eclasslist_classid(classname.gets());
+    }
+    if (cid == 0) goto plain_object;
+    pending = OS_FALSE;
+
+    oid = EOID_ITEM;
+    stage = seen = 0;
+    while (OS_TRUE)
+    {
+        token = reader->next();
+        if (token == EJSON_TOKEN_END_OBJECT) {
+            k = OS_NULL;
+            item_stage = EJSON_LAYOUT_END;
+        }
+        else {
+            if (token != EJSON_TOKEN_VALUE || !reader->isstring()) goto failed;
+            key.setv(reader->value());
+            k = key.gets();
+            item_stage = json_layout_stage(k);
+            token = reader->next();
+
+            /* Unknown, repeated or out of order item: Not written by json_write().
+             */
+            pending = OS_TRUE;
+            if (item_stage <= stage) {
+                if (child) goto failed;
+                goto not_serialized;
+            }
+
+            switch (item_stage)
+            {
+                case EJSON_LAYOUT_NAMES:
+                case EJSON_LAYOUT_FLAGS:
+                    if (token != EJSON_TOKEN_BEGIN_ARRAY) goto not_serialized;
+                    if (json_read_list(reader, token, item_stage == EJSON_LAYOUT_NAMES
+                        ? &names : &flaglist)) goto failed;
+                    stage = item_stage;
+                    seen |= 1 << item_stage;
+                    pending = OS_FALSE;
+                    continue;
+
+                case EJSON_LAYOUT_OID:
+                    if (token != EJSON_TOKEN_VALUE || reader->isstring()) goto not_serialized;
+                    oidvalue.setv(reader->value());
+                    oid = oidvalue.geti();
+                    stage = item_stage;
+                    seen |= 1 << item_stage;
+                    pending = OS_FALSE;
+                    continue;
+
+                default:
+                    break;
+            }
+        }
+        stage = item_stage;
+
+        /* Create the object when we know object identifier and flags.
+         */
+        if (child == OS_NULL)
+        {
+            oflags = EOBJ_DEFAULT;
+            has_namespace = OS_FALSE;
+            for (v = flaglist.firstv(); v; v = v->nextv())
+            {
+                if (!os_strcmp(v->gets(), "attachment")) oflags |= EOBJ_IS_ATTACHMENT;
+                else if (!os_strcmp(v->gets(), "namespace")) has_namespace = OS_TRUE;
+                else if (!os_strcmp(v->gets(), "cf_1")) oflags |= EOBJ_CUST_FLAG1;
+                else if (!os_strcmp(v->gets(), "cf_2")) oflags |= EOBJ_CUST_FLAG2;
+                else if (!os_strcmp(v->gets(), "cf_3")) oflags |= EOBJ_CUST_FLAG3;
+                else if (!os_strcmp(v->gets(), "cf_4")) oflags |= EOBJ_CUST_FLAG4;
+                else if (!os_strcmp(v->gets(), "cf_5")) oflags |= EOBJ_CUST_FLAG5;
+            }
+
+            child = newchild(cid, oid, oflags);
+            if (child == OS_NULL) goto failed;
+            if (has_namespace) child->ns_create();
+            for (v = names.firstv(); v; v = v->nextv()) {
+                child->addname(v->gets());
+            }
+            if (name) child->addname(name, 0, eobj_parent_ns);
+        }
 
-    /* Read the object content.
+        if (k == OS_NULL) break;
+
+        if (item_stage == EJSON_LAYOUT_PROPERTIES) {
+            if (child->json_read_properties(reader, token, sflags)) goto failed;
+        }
+        else if (item_stage == EJSON_LAYOUT_CONTENT) {
+            if (child->json_reader(reader, token, sflags)) goto failed;
+        }
+        else {
+            if (reader->skip(token)) goto failed;
+        }
+    }
+
+    return child;
+
+    /* Layout doesn't match: Read as plain JSON object, starting with items already read.
+       Pending item's key is in key and first token of it's value in token.
      */
-    if (child->reader(stream, sflags)) goto failed;
+not_serialized:
+    child = new eContainer(this);
+    child->ns_create();
+    if (name) child->addname(name, 0, eobj_parent_ns);
+    v = new eVariable(child);
+    v->setv(&classname);
+    v->addname("class", 0, eobj_parent_ns);
+    if (seen & (1 << EJSON_LAYOUT_NAMES)) {
+        list = names.clone(child, EOID_ITEM);
+        list->addname("names", 0, eobj_parent_ns);
+    }
+    if (seen & (1 << EJSON_LAYOUT_OID)) {
+        v = new eVariable(child);
+        v->setv(&oidvalue);
+        v->addname("oid", 0, eobj_parent_ns);
+    }
+    if (seen & (1 << EJSON_LAYOUT_FLAGS)) {
+        list = flaglist.clone(child, EOID_ITEM);
+        list->addname("flags", 0, eobj_parent_ns);
+    }
+    goto pending_item;
 
-    /* Read attachments.
+    /* Plain JSON object. If pending is set, value of item in key has not been read yet.
      */
-    for (i = 0; i<n_attachements; i++)
+plain_object:
+    child = new eContainer(this);
+    child->ns_create();
+    if (name) child->addname(name, 0, eobj_parent_ns);
+
+pending_item:
+    if (pending)
     {
-        if (read(stream, sflags) == OS_NULL) goto failed;
+        if (child->json_read_value(reader, token, key.gets(), sflags) == OS_NULL) {
+            goto failed;
+        }
+        token = reader->next();
     }
 
-    /* Object successfully read, return pointer to it.
-     */
+    while (token != EJSON_TOKEN_END_OBJECT)
+    {
+        if (token != EJSON_TOKEN_VALUE || !reader->isstring()) goto failed;
+        key.setv(reader->value());
+        token = reader->next();
+        if (child->json_read_value(reader, token, key.gets(), sflags) == OS_NULL) {
+            goto failed;
+        }
+        token = reader->next();
+    }
     return child;
 
-    /* Reading object failed.
-     */
 failed:
+    osal_debug_error("json_read: Invalid JSON");
+    delete child;
     return OS_NULL;
 }
 
 
+/**
+****************************************************************************************************
+
+  @brief Get position of JSON item in json_write() layout.
+
+  @param  key Item name.
+  @return EJSON_LAYOUT_NAMES... EJSON_LAYOUT_CONTENT, 0 if item is not in the layout.
+
+****************************************************************************************************
+*/
+static os_int json_layout_stage(
+    const os_char *key)
+{
+    static const os_char *const keys[] = {"names", "oid", "flags", "properties",
+        "nspace", "bindings", "content"};
+    os_int i;
+
+    for (i = 0; i < (os_int)(sizeof(keys) / sizeof(keys[0])); i++) {
+        if (!os_strcmp(key, keys[i])) return i + EJSON_LAYOUT_NAMES;
+    }
+    return 0;
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Read JSON array of strings, like "names" or "flags".
+
+  @param  reader JSON tokenizer.
+  @param  token First token of the value, must be '['.
+  @param  list Container into which to add each item as eVariable.
+
+  @return ESTATUS_SUCCESS if successfull, ESTATUS_FAILED if JSON is not valid.
+
+****************************************************************************************************
+*/
+eStatus eObject::json_read_list(
+    eJsonReader *reader,
+    os_int token,
+    eContainer *list)
+{
+    eVariable *v;
+
+    if (token != EJSON_TOKEN_BEGIN_ARRAY) return ESTATUS_FAILED;
+    while ((token = reader->next()) != EJSON_TOKEN_END_ARRAY)
+    {
+        if (token != EJSON_TOKEN_VALUE) return ESTATUS_FAILED;
+        v = new eVariable(list);
+        v->setv(reader->value());
+    }
+    return ESTATUS_SUCCESS;
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Read JSON "properties" and set property values.
+
+  The eObject::json_read_properties() function sets properties by name. Property value
+  which is JSON object, like matrix configuration, is read as object and stored in the
+  property value. Properties which this class doesn't have are ignored.
+
+  @param  reader JSON tokenizer.
+  @param  token First token of the value, must be '{'.
+  @param  sflags Serialization flags, EOBJ_SERIALIZE_DEFAULT.
+
+  @return ESTATUS_SUCCESS if successfull, ESTATUS_FAILED if JSON is not valid.
+
+****************************************************************************************************
+*/
+eStatus eObject::json_read_properties(
+    eJsonReader *reader,
+    os_int token,
+    os_int sflags)
+{
+    eContainer tmp;
+    eVariable x;
+    eObject *o;
+    os_int nr;
+
+    if (token != EJSON_TOKEN_BEGIN_OBJECT) return ESTATUS_FAILED;
+    while ((token = reader->next()) != EJSON_TOKEN_END_OBJECT)
+    {
+        if (token != EJSON_TOKEN_VALUE) return ESTATUS_FAILED;
+        nr = propertynr(reader->value()->gets());
+        token = reader->next();
+
+        if (token == EJSON_TOKEN_VALUE) {
+            if (nr >= 0) setpropertyv(nr, reader->value());
+        }
+        else if (token == EJSON_TOKEN_BEGIN_OBJECT) {
+            o = tmp.json_read_value(reader, token, OS_NULL, sflags);
+            if (o == OS_NULL) return ESTATUS_FAILED;
+            if (nr >= 0) {
+                x.seto(o, OS_TRUE);
+                setpropertyv(nr, &x);
+                x.clear();
+            }
+            else {
+                delete o;
+            }
+        }
+        else {
+            if (reader->skip(token)) return ESTATUS_FAILED;
+        }
+    }
+    return ESTATUS_SUCCESS;
+}
+
+
 /**
 ****************************************************************************************************
 
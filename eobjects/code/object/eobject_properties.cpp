@@ -134,10 +134,12 @@ eVariable *eObject::addproperty(
         pset->ns_create();
     }
 
-    /* Add variable for this property in property set and name it.
+    /* Add variable for this property in property set and name it. Flat property
+       index needs to be rebuilt, if it has been already used.
      */
     p = new eVariable(pset, propertynr, pflags);
     p->addname(propertyname);
+    eclasslist_invalidate_propertyindex(cid);
 
     /* Set name of the property to display to user.
      */
@@ -393,12 +395,16 @@ eVariable *eObject::addpropertys(
   The propertysetdone function lists attributes (subproperties) for each base property.
 
   @param  classid Specifies to which classes property set the property is being added.
+  @param  psflags EPSET_DEFAULT for normal operation. EPSET_DENSE to keep stored property
+          values of the class in flat slot array indexed by property number, for classes
+          whose properties change often. Costs memory per object.
   @return None.
 
 ****************************************************************************************************
 */
 void eObject::propertysetdone(
-    os_int cid)
+    os_int cid,
+    os_int psflags)
 {
     eContainer *pset;
     eVariable *p, *next_p, *mp;
@@ -411,6 +417,10 @@ void eObject::propertysetdone(
     pset = eglobal->propertysets->firstc(cid);
     if (pset == OS_NULL) return;
 
+    if (psflags & EPSET_DENSE) {
+        pset->setflags(EPSET_DENSE);
+    }
+
     for (p = pset->firstv(); p; p = next_p)
     {
         next_p = p->nextv();
@@ -437,6 +447,10 @@ void eObject::propertysetdone(
             }
         }
     }
+
+    /* Publish flat property index for the complete property set.
+     */
+    eclasslist_propertysetdone(cid);
 }
 
 
@@ -445,8 +459,9 @@ void eObject::propertysetdone(
 
   @brief Get pointer to class'es property set.
 
-  The Object::propertyset function gets pointer to class'es property set. Mutex lock is used
-  in case new classes are added.
+  The Object::propertyset function gets pointer to class'es property set. Pointer is taken
+  from class'es flat property index without locking. If class has no index (class ID is too
+  large), mutex lock is used in case new classes are added.
 
   @param   flags EPRO_NO_ERRORS to disable error reporting if class has no property set.
            EPRO_DEFAULT for normal operation.
@@ -458,11 +473,18 @@ void eObject::propertysetdone(
 eContainer *eObject::propertyset(
     os_int flags)
 {
+    ePropertyIndex *ix;
     eContainer *pset;
 
-    os_lock();
-    pset = eglobal->propertysets->firstc(classid());
-    os_unlock();
+    ix = eclasslist_propertyindex(classid());
+    if (ix) {
+        pset = ix->pset;
+    }
+    else {
+        os_lock();
+        pset = eglobal->propertysets->firstc(classid());
+        os_unlock();
+    }
 
 #ifdef OSAL_DEBUG
     if (pset == OS_NULL && (flags & EMSG_NO_ERRORS) == 0) {
@@ -481,7 +503,8 @@ eContainer *eObject::propertyset(
   @brief Get pointer to class'es first static property.
 
   The Object::firstp function gets pointer to class'first static property in property set.
-  Static properties are global and can be read only.
+  Static properties are global and can be read only. When property number is given as id,
+  the property is taken from class'es flat property index without searching or locking.
 
   @param   id Object idenfifier. Default value EOID_CHILD specifies to count a child objects,
            which are not flagged as an attachment. Value EOID_ALL specifies to get count all
@@ -499,8 +522,18 @@ eVariable *eObject::firstp(
     e_oid id,
     os_int flags)
 {
+    ePropertyIndex *ix;
     eContainer *pset;
 
+    if (id >= 0)
+    {
+        ix = eclasslist_propertyindex(classid());
+        if (ix) if (ix->pset)
+        {
+            return id < ix->n ? ix->p[id] : OS_NULL;
+        }
+    }
+
     pset = propertyset(flags);
 
     if (pset) {
@@ -643,7 +676,8 @@ void eObject::setpropertyv(
     os_int flags)
 {
     eSet *properties;
-    eVariable *p, *v;
+    eVariable *p, v;
+    ePropertyIndex *ix;
     os_int pflags, sflags;
 
     /* Get global eVariable describing this property.
@@ -656,8 +690,6 @@ void eObject::setpropertyv(
     }
     pflags = p->flags();
 
-    v = new eVariable(this, EOID_ITEM, EOBJ_IS_ATTACHMENT);
-
     /* Empty x and x as null pointer are the same thing, handled the same way.
      */
     if (x == OS_NULL)
@@ -673,8 +705,8 @@ void eObject::setpropertyv(
          */
         if (x->type() != OS_OBJECT)
         {
-            propertyv(propertynr, v);
-            if (!v->compare(x)) goto getout;
+            propertyv(propertynr, &v);
+            if (!v.compare(x)) return;
         }
 
         /* Call class'es onpropertychange function.
@@ -695,16 +727,27 @@ void eObject::setpropertyv(
             properties->setflags(EOBJ_IS_ATTACHMENT);
         }
 
+        /* If class has requested dense property storage, switch the set to dense mode.
+           This is done also for existing set, for example one created by reading or cloning.
+         */
+        if (!properties->isdense())
+        {
+            ix = eclasslist_propertyindex(classid());
+            if (ix) if (ix->dense) {
+                properties->setdense(ix->n);
+            }
+        }
+
         /* Find stored property value. If matches value to set, do nothing.
            If we have no property value stored, we are using default value:
            Compare to it, and skip if we are setting same default value.
          */
-        properties->getv(propertynr, v);
-        if (v->type() == OS_UNDEFINED_TYPE) {
-            if (!p->compare(x)) goto getout;
+        properties->getv(propertynr, &v);
+        if (v.type() == OS_UNDEFINED_TYPE) {
+            if (!p->compare(x)) return;
         }
         else {
-            if (!v->compare(x)) goto getout;
+            if (!v.compare(x)) return;
         }
 
         /* Early call class'es onpropertychange function.
@@ -747,10 +790,6 @@ void eObject::setpropertyv(
     /* Forward property value to bindings, if any.
      */
     forwardproperty(propertynr, x, source, flags);
-
-getout:
-    delete v;
-    return;
 }
 
 
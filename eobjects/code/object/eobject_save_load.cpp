@@ -21,16 +21,20 @@
 
    @brief Save this object to a file
 
-   The eObject::save function serializes this object into a file.
+   The eObject::save function serializes this object into a file. If append is set, the
+   serialized object is added to end of existing file, this is used for journals which are
+   sequences of objects.
 
    @param   path OS path to target file.
+   @param   append OS_TRUE to append to file, OS_FALSE to overwrite it.
    @return  If the file was successfully written, the function returns ESTATUS_SUCCESS.
             Other return values indicate an error.
 
 ****************************************************************************************************
 */
 eStatus eObject::save(
-    const os_char *path)
+    const os_char *path,
+    os_boolean append)
 {
     eVariable tmp;
     eOsStream *stream;
@@ -41,7 +45,8 @@ eStatus eObject::save(
     stream = new eOsStream(ETEMPORARY);
     tmp.sets("file:");
     tmp.appends(path);
-    s = stream->open(tmp.gets(), OS_NULL, OSAL_STREAM_WRITE);
+    s = stream->open(tmp.gets(), OS_NULL,
+        append ? OSAL_STREAM_WRITE|OSAL_STREAM_APPEND : OSAL_STREAM_WRITE);
     if (s) goto failed;
 
     /* Write file content.
@@ -43,6 +43,8 @@ eSet::eSet(
 {
     m_items = OS_NULL;
     m_used = m_alloc = 0;
+    m_slots = OS_NULL;
+    m_nslots = 0;
 }
 
 
@@ -63,9 +65,12 @@ eSet::~eSet()
      */
     clear();
 
-    /* Release items buffer
+    /* Release items buffer and dense slots.
      */
     os_free(m_items, m_alloc);
+    if (m_slots) {
+        os_free(m_slots, m_nslots * sizeof(eSetSlot));
+    }
 }
 
 
@@ -115,11 +120,18 @@ eObject *eSet::clone(
     os_uchar *src, *dst;
     os_uchar itype;
     os_short ibytes; /* + 3 -> must be 16 bit */
-    os_int spos, dpos;
+    os_int spos, dpos, used;
     os_memsz sz;
 
     clonedobj = new eSet(parent, id == EOID_CHILD ? oid() : id, flags());
 
+    /* Clone is in normal mode, so pack dense slot values for copying.
+     */
+    used = m_used;
+    if (m_slots) {
+        pack_slots();
+    }
+
     if (m_items)
     {
         clonedobj->m_items = (os_uchar*)os_malloc(m_used, &sz);
@@ -150,6 +162,7 @@ eObject *eSet::clone(
         }
         clonedobj->m_used = dpos;
     }
+    m_used = used;
 
     clonegeneric(clonedobj, aflags|EOBJ_CLONE_ALL_CHILDREN);
     return clonedobj;
@@ -220,9 +233,16 @@ eStatus eSet::writer(
     os_uchar iid, ibytes, itype;
     os_double d;
     os_long l;
-    os_int i;
+    os_int i, used;
     os_short s;
 
+    /* Dense slot values are serialized as packed items.
+     */
+    used = m_used;
+    if (m_slots) {
+        pack_slots();
+    }
+
     /* Begin the object and write version number.
      */
     if (stream->write_begin_block(version)) goto failed;
@@ -327,11 +347,13 @@ eStatus eSet::writer(
 
     /* Object successfully written.
      */
+    m_used = used;
     return ESTATUS_SUCCESS;
 
     /* Writing object failed.
      */
 failed:
+    m_used = used;
     return ESTATUS_WRITING_OBJ_FAILED;
 }
 
@@ -529,8 +551,16 @@ eStatus eSet::json_writer(
     os_uchar *p, *e;
     os_char nbuf[OSAL_NBUF_SZ];
     os_uchar iid, ibytes, itype;
+    os_int used;
     os_boolean comma = OS_TRUE;
 
+    /* Dense slot values are written as packed items.
+     */
+    used = m_used;
+    if (m_slots) {
+        pack_slots();
+    }
+
     /* Prepare to go trough items.
      */
     p = m_items;
@@ -612,9 +642,11 @@ eStatus eSet::json_writer(
         if (json_putv(stream, OS_NULL, v, sflags, indent + 1)) goto failed;
     }
 
+    m_used = used;
     return ESTATUS_SUCCESS;
 
 failed:
+    m_used = used;
     return ESTATUS_FAILED;
 }
 #endif
@@ -666,6 +698,17 @@ void eSet::setv(
 
     osal_debug_assert(id >= 0);
 
+    /* In dense mode value is kept in slot, unless it needs to be stored as variable.
+     */
+    if ((os_uint)id < (os_uint)m_nslots) if (m_slots[id].state != ESET_SLOT_VARIABLE)
+    {
+        if ((sflags & ESET_STORE_AS_VARIABLE) == 0) {
+            if (setslot(m_slots + id, x, sflags)) goto getout;
+        }
+        clearslot(m_slots + id);
+        goto store_as_var;
+    }
+
     /* If we have variable with this id, use it.
      */
     v = firstv(id);
@@ -676,6 +719,9 @@ void eSet::setv(
             goto getout;
         }
         delete v;
+        if ((os_uint)id < (os_uint)m_nslots) {
+            m_slots[id].state = ESET_SLOT_EMPTY;
+        }
         goto getout;
     }
 
@@ -872,6 +918,9 @@ store_as_var:
         ? EOBJ_NOT_CLONABLE|EOBJ_NOT_SERIALIZABLE : EOBJ_DEFAULT);
 
     v->setv(x, (sflags & (ESET_ADOPT_X_CONTENT|ESET_DELETE_X)) ? OS_TRUE : OS_FALSE);
+    if ((os_uint)id < (os_uint)m_nslots) {
+        m_slots[id].state = ESET_SLOT_VARIABLE;
+    }
 
 getout:
     if (sflags & ESET_DELETE_X) {
@@ -914,6 +963,12 @@ void eSet::seto(
     eVariable *v;
     osal_debug_assert(id >= 0);
 
+    /* In dense mode, value in slot is replaced by the object.
+     */
+    if ((os_uint)id < (os_uint)m_nslots) {
+        clearslot(m_slots + id);
+    }
+
     /* If we have variable with this id, use it.
      */
     v = firstv(id);
@@ -930,6 +985,9 @@ void eSet::seto(
         v = new eVariable(this, id, sflags & ESET_TEMPORARY
             ? EOBJ_NOT_CLONABLE|EOBJ_NOT_SERIALIZABLE : EOBJ_DEFAULT);
         v->seto(x, (sflags & ESET_DELETE_X) ? OS_TRUE : OS_FALSE);
+        if ((os_uint)id < (os_uint)m_nslots) {
+            m_slots[id].state = ESET_SLOT_VARIABLE;
+        }
     }
     return;
 
@@ -963,6 +1021,7 @@ os_boolean eSet::getv(
     os_int *sflags)
 {
     eVariable *v;
+    eSetSlot *slot;
     os_uchar *p, *e;
     os_uchar iid, ibytes, itype;
     os_double d;
@@ -974,6 +1033,34 @@ os_boolean eSet::getv(
         *sflags = ESET_PERSISTENT;
     }
 
+    /* In dense mode value is found directly by id.
+     */
+    if ((os_uint)id < (os_uint)m_nslots)
+    {
+        slot = m_slots + id;
+        switch (slot->state)
+        {
+            case ESET_SLOT_VALUE:
+                switch (slot->itype & OSAL_TYPEID_MASK)
+                {
+                    case OS_LONG: x->setl(slot->v.l); break;
+                    case OS_DOUBLE: x->setd(slot->v.d); break;
+                    default: x->sets(slot->v.s, slot->s_bytes); break;
+                }
+                if (sflags && (slot->itype & ESET_TYPEID_TEMPORARY)) {
+                    *sflags = ESET_TEMPORARY;
+                }
+                return OS_TRUE;
+
+            case ESET_SLOT_EMPTY:
+                x->clear();
+                return OS_FALSE;
+
+            default:
+                break;
+        }
+    }
+
     /* Try first if this value is stored in separate variable.
      */
     v = firstv(id);
@@ -1188,10 +1275,242 @@ const os_char *eSet::gets_ptr(
 void eSet::clear()
 {
     eVariable *v;
+    os_int i;
 
     while ((v = firstv())) {
         delete v;
     }
 
     m_used = 0;
+
+    for (i = 0; i < m_nslots; i++) {
+        clearslot(m_slots + i);
+    }
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Switch the set to dense mode.
+
+  The eSet::setdense function allocates flat array of value slots indexed by id, so that
+  values with id below nslots can be stored and found without searching packed items or
+  child variables. Objects and long strings are still stored as variables, the slot only
+  marks that value is in variable. Values already in the set are moved to slots.
+
+  Dense mode is used for properties of classes which have frequently changing properties,
+  see EPSET_DENSE. Clone, serialization and JSON still use packed item format, so a set in
+  dense mode is indistinguishable from normal one outside.
+
+  @param  nslots Number of slots, ids 0 ... nslots - 1 are kept in slots. Max 256.
+  @return None.
+
+****************************************************************************************************
+*/
+void eSet::setdense(
+    os_int nslots)
+{
+    eVariable x, *v;
+    eSetSlot *slots;
+    os_uchar *p, *e;
+    os_uchar iid;
+    os_memsz sz;
+
+    if (m_slots || nslots <= 0) return;
+    if (nslots > 256) nslots = 256;
+
+    sz = nslots * sizeof(eSetSlot);
+    slots = (eSetSlot*)os_malloc(sz, OS_NULL);
+    os_memclear(slots, sz);
+
+    /* Mark ids stored as variables.
+     */
+    for (v = firstv(); v; v = v->nextv())
+    {
+        if ((os_uint)v->oid() < (os_uint)nslots) {
+            slots[v->oid()].state = ESET_SLOT_VARIABLE;
+        }
+    }
+
+    /* Move packed items within slot range to slots. Items beyond slot range stay
+       in packed items buffer.
+     */
+    p = m_items;
+    e = p + m_used;
+    while (p < e)
+    {
+        iid = p[0];
+        if (iid < nslots)
+        {
+            getv(iid, &x);
+            setslot(slots + iid, &x,
+                (p[2] & ESET_TYPEID_TEMPORARY) ? ESET_TEMPORARY : ESET_PERSISTENT);
+            setv(iid, OS_NULL);
+            p = m_items;
+            e = p + m_used;
+            continue;
+        }
+        p += p[1] + 3;
+    }
+
+    m_slots = slots;
+    m_nslots = nslots;
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Store value in dense slot.
+
+  The eSet::setslot function stores integer, floating point or string value into slot.
+  Empty value clears the slot.
+
+  @param  slot Pointer to slot.
+  @param  x Value to store, OS_NULL to clear.
+  @param  sflags ESET_PERSISTENT (0) or ESET_TEMPORARY (1).
+  @return OS_TRUE if value was stored. OS_FALSE if value must be stored as variable.
+
+****************************************************************************************************
+*/
+os_boolean eSet::setslot(
+    eSetSlot *slot,
+    eVariable *x,
+    os_int sflags)
+{
+    const os_char *q;
+    os_memsz sz, alloc_sz;
+    os_uchar itype;
+
+    switch (x ? x->type() : OS_UNDEFINED_TYPE)
+    {
+        case OS_UNDEFINED_TYPE:
+            clearslot(slot);
+            return OS_TRUE;
+
+        case OS_OBJECT:
+        case OS_POINTER:
+            return OS_FALSE;
+
+        case OS_STR:
+            q = x->gets(&sz);
+            if (*q == '\0')
+            {
+                clearslot(slot);
+                return OS_TRUE;
+            }
+            if (sz > 255) return OS_FALSE;
+
+            if (slot->state != ESET_SLOT_VALUE ||
+                (slot->itype & OSAL_TYPEID_MASK) != OS_STR ||
+                slot->s_alloc < sz)
+            {
+                clearslot(slot);
+                slot->v.s = os_malloc(sz, &alloc_sz);
+                slot->s_alloc = (os_int)alloc_sz;
+            }
+            os_memcpy(slot->v.s, q, sz);
+            slot->s_bytes = (os_uchar)sz;
+            itype = OS_STR;
+            break;
+
+        case OS_FLOAT:
+        case OS_DOUBLE:
+        case OS_DEC01:
+        case OS_DEC001:
+            if (slot->state == ESET_SLOT_VALUE &&
+                (slot->itype & OSAL_TYPEID_MASK) == OS_STR)
+            {
+                clearslot(slot);
+            }
+            slot->v.d = x->getd();
+            itype = OS_DOUBLE;
+            break;
+
+        default:
+            if (slot->state == ESET_SLOT_VALUE &&
+                (slot->itype & OSAL_TYPEID_MASK) == OS_STR)
+            {
+                clearslot(slot);
+            }
+            slot->v.l = x->getl();
+            itype = OS_LONG;
+            break;
+    }
+
+    if (sflags & ESET_TEMPORARY) {
+        itype |= ESET_TYPEID_TEMPORARY;
+    }
+    slot->itype = itype;
+    slot->state = ESET_SLOT_VALUE;
+    return OS_TRUE;
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Clear dense slot.
+
+  The eSet::clearslot function releases string buffer of the slot, if any, and marks slot
+  empty.
+
+  @param  slot Pointer to slot.
+  @return None.
+
+****************************************************************************************************
+*/
+void eSet::clearslot(
+    eSetSlot *slot)
+{
+    if (slot->state == ESET_SLOT_VALUE &&
+        (slot->itype & OSAL_TYPEID_MASK) == OS_STR)
+    {
+        os_free(slot->v.s, slot->s_alloc);
+    }
+    os_memclear(slot, sizeof(eSetSlot));
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Copy dense slot values to packed items buffer.
+
+  The eSet::pack_slots function appends values in dense slots to m_items buffer in normal
+  packed format, for clone, writer and json_writer functions. The caller restores m_used
+  after use, slots remain the valid copy of values.
+
+  @return None.
+
+****************************************************************************************************
+*/
+void eSet::pack_slots()
+{
+    eVariable x;
+    eSetSlot *slots;
+    os_int i, nslots;
+
+    slots = m_slots;
+    nslots = m_nslots;
+    m_slots = OS_NULL;
+    m_nslots = 0;
+
+    for (i = 0; i < nslots; i++)
+    {
+        if (slots[i].state != ESET_SLOT_VALUE) continue;
+
+        switch (slots[i].itype & OSAL_TYPEID_MASK)
+        {
+            case OS_LONG: x.setl(slots[i].v.l); break;
+            case OS_DOUBLE: x.setd(slots[i].v.d); break;
+            default: x.sets(slots[i].v.s, slots[i].s_bytes); break;
+        }
+        setv(i, &x, (slots[i].itype & ESET_TYPEID_TEMPORARY)
+            ? ESET_TEMPORARY : ESET_PERSISTENT);
+    }
+
+    m_slots = slots;
+    m_nslots = nslots;
 }
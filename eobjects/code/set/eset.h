@@ -30,6 +30,43 @@
 #define ESET_ADOPT_X_CONTENT 64
 #define ESET_DELETE_X 128
 
+/* Dense slot states.
+ */
+#define ESET_SLOT_EMPTY 0
+#define ESET_SLOT_VALUE 1
+#define ESET_SLOT_VARIABLE 2
+
+/* Value slot in dense mode. Integer, double and short string values are kept in slot,
+   objects and long strings are stored as variables like in normal mode.
+ */
+typedef struct eSetSlot
+{
+    union
+    {
+        os_long l;
+        os_double d;
+        os_char *s;
+    }
+    v;
+
+    /* Bytes allocated for string value.
+     */
+    os_int s_alloc;
+
+    /* Bytes used by string value, including terminating '\0'.
+     */
+    os_uchar s_bytes;
+
+    /* Value type OS_LONG, OS_DOUBLE or OS_STR, possibly with temporary bit.
+     */
+    os_uchar itype;
+
+    /* ESET_SLOT_EMPTY, ESET_SLOT_VALUE or ESET_SLOT_VARIABLE.
+     */
+    os_uchar state;
+}
+eSetSlot;
+
 /**
 ****************************************************************************************************
   eSet stored set of values with integer keys.
@@ -240,9 +277,42 @@ public:
      */
     void clear();
 
+    /* Keep values with id below nslots in flat slot array (dense mode).
+     */
+    void setdense(
+        os_int nslots);
+
+    /* Check if set is in dense mode.
+     */
+    inline os_boolean isdense()
+    {
+        return (os_boolean)(m_slots != OS_NULL);
+    }
+
 
 protected:
 
+    /**
+    ************************************************************************************************
+      Protected member functions.
+    ************************************************************************************************
+    */
+    /* Store value in dense slot.
+     */
+    os_boolean setslot(
+        eSetSlot *slot,
+        eVariable *x,
+        os_int sflags);
+
+    /* Clear dense slot.
+     */
+    void clearslot(
+        eSetSlot *slot);
+
+    /* Copy dense slot values to packed items buffer for cloning and serialization.
+     */
+    void pack_slots();
+
     /**
     ************************************************************************************************
       Member variables.
@@ -259,6 +329,14 @@ protected:
     /* Buffer allocated, bytes.
      */
     os_int m_alloc;
+
+    /* Dense mode value slots indexed by id, OS_NULL if not in dense mode.
+     */
+    eSetSlot *m_slots;
+
+    /* Number of items in m_slots array.
+     */
+    os_int m_nslots;
 };
 
 #endif
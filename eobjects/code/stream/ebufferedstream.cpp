@@ -33,6 +33,16 @@ eBufferedStream::eBufferedStream(
     m_flags = 0;
     m_flushnow = OS_FALSE;
     m_send_size = 3900;
+    m_nbytes_written = 0;
+    m_nwrite_calls = 0;
+    m_zout = m_zin = OS_NULL;
+    m_zframe = m_zinframe = OS_NULL;
+    m_zframe_pos = m_zframe_n = m_zin_n = 0;
+    m_zout_codec = ECOMPRESS_CODEC_NONE;
+    m_zscan = EBUFFEREDSTREAM_SCAN_HELLO;
+    m_zscan_prevc = 0;
+    m_peer_caps = 0;
+    m_zraw_bytes = m_zcoded_bytes = m_zcpu_us = 0;
 }
 
 
@@ -83,6 +93,7 @@ eStatus eBufferedStream::setup_queues(
      */
     else
     {
+        release_codec();
         if (m_in == OS_NULL) m_in = new eQueue(this);
         if (m_out == OS_NULL) m_out = new eQueue(this);
         m_in->close();
@@ -107,6 +118,7 @@ eStatus eBufferedStream::setup_queues(
 */
 void eBufferedStream::delete_queues()
 {
+    release_codec();
     delete m_in;
     delete m_out;
     m_in = m_out = OS_NULL;
@@ -141,6 +153,10 @@ eStatus eBufferedStream::buffer_to_stream(
 
     m_flushnow |= flushnow;
 
+    if (m_zout) {
+        return compressed_buffer_to_stream();
+    }
+
     while (OS_TRUE)
     {
         n = m_out->bytes();
@@ -159,6 +175,7 @@ eStatus eBufferedStream::buffer_to_stream(
         }
 
         s = buffered_write(buf, nread, &nwritten);
+        m_nwrite_calls++;
         if (s) {
             break;
         }
@@ -166,6 +183,7 @@ eStatus eBufferedStream::buffer_to_stream(
         if (nwritten <= 0) {
             break;
         }
+        m_nbytes_written += nwritten;
 
         m_out->readx(OS_NULL, nwritten, &nread);
     }
@@ -174,6 +192,14 @@ eStatus eBufferedStream::buffer_to_stream(
         os_free(buf, m_send_size);
     }
 
+    /* Codec has been selected and everything written before it is out: Start compressing.
+     */
+    if (m_zout_codec != ECOMPRESS_CODEC_NONE && s == ESTATUS_SUCCESS && m_out->bytes() == 0)
+    {
+        start_compression();
+        s = compressed_buffer_to_stream();
+    }
+
     return s;
 }
 
@@ -206,7 +232,7 @@ eStatus eBufferedStream::stream_to_buffer()
             break;
         }
 
-        s2 = m_in->write(buf, nread);
+        s2 = m_zin ? decompress_to_buffer(buf, nread) : scan_to_buffer(buf, nread);
         if (s2) {
             s = s2;
             break;
@@ -218,6 +244,359 @@ eStatus eBufferedStream::stream_to_buffer()
 }
 
 
+/**
+****************************************************************************************************
+
+  @brief Start compressing output.
+
+  The eBufferedStream::setcodec() function selects codec to compress output for rest of the
+  session. Data already written to m_out is sent uncompressed. Once it is out, a codec
+  switch mark (keep alive with codec as count) is written and everything after it is
+  compressed. The receiving end finds the mark and starts decompressing. Connection calls
+  this only when hello from the other end tells that it selected the same codec.
+
+  @param  codec ECOMPRESS_CODEC_LZ to compress, ECOMPRESS_CODEC_NONE to do nothing.
+  @return If successfull, the function returns ESTATUS_SUCCESS. ESTATUS_NOT_SUPPORTED if
+          codec is not known.
+
+****************************************************************************************************
+*/
+eStatus eBufferedStream::setcodec(
+    os_int codec)
+{
+    if (codec == ECOMPRESS_CODEC_NONE || m_zout_codec) return ESTATUS_SUCCESS;
+    if (codec != ECOMPRESS_CODEC_LZ) return ESTATUS_NOT_SUPPORTED;
+
+    m_zout_codec = codec;
+    return ESTATUS_SUCCESS;
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Allocate compressor and write codec switch mark.
+
+  The eBufferedStream::start_compression() function is called by buffer_to_stream() when
+  codec has been selected and m_out is empty. The switch mark is placed in frame buffer,
+  so compressed_buffer_to_stream() writes it before the first compressed frame.
+
+****************************************************************************************************
+*/
+void eBufferedStream::start_compression()
+{
+    if (m_zout) return;
+
+    m_zout = (eCompressState*)os_malloc(sizeof(eCompressState), OS_NULL);
+    ecompress_init(m_zout, OS_TRUE);
+    m_zframe = os_malloc(EBUFFEREDSTREAM_ZFRAME_SZ + ECOMPRESS_MAX_BLOCK, OS_NULL);
+
+    m_zframe[0] = (os_char)E_STREAM_CTRL_CHAR;
+    m_zframe[1] = (os_char)(E_STREAM_CTRLCH_KEEPALIVE | m_zout_codec);
+    m_zframe_n = 2;
+    m_zframe_pos = 0;
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Allocate decompressor.
+
+  The eBufferedStream::start_decompression() function is called when codec switch mark is
+  received. Data after the mark is decompressed.
+
+  @param  codec Codec from the switch mark.
+  @return ESTATUS_SUCCESS if codec is supported, ESTATUS_FAILED if not (corrupted stream).
+
+****************************************************************************************************
+*/
+eStatus eBufferedStream::start_decompression(
+    os_int codec)
+{
+    if (codec != ECOMPRESS_CODEC_LZ) return ESTATUS_FAILED;
+    if (m_zin) return ESTATUS_SUCCESS;
+
+    m_zin = (eCompressState*)os_malloc(sizeof(eCompressState), OS_NULL);
+    ecompress_init(m_zin, OS_FALSE);
+    m_zinframe = os_malloc(EBUFFEREDSTREAM_ZFRAME_SZ, OS_NULL);
+    m_zin_n = 0;
+    return ESTATUS_SUCCESS;
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Release compression buffers.
+
+  The eBufferedStream::release_codec() function frees compressor and decompressor, if
+  allocated, and resets hello and codec switch state for next session.
+
+****************************************************************************************************
+*/
+void eBufferedStream::release_codec()
+{
+    if (m_zout)
+    {
+        ecompress_release(m_zout);
+        os_free(m_zout, sizeof(eCompressState));
+        os_free(m_zframe, EBUFFEREDSTREAM_ZFRAME_SZ + ECOMPRESS_MAX_BLOCK);
+        m_zout = OS_NULL;
+        m_zframe = OS_NULL;
+    }
+
+    if (m_zin)
+    {
+        ecompress_release(m_zin);
+        os_free(m_zin, sizeof(eCompressState));
+        os_free(m_zinframe, EBUFFEREDSTREAM_ZFRAME_SZ);
+        m_zin = OS_NULL;
+        m_zinframe = OS_NULL;
+    }
+
+    m_zframe_pos = m_zframe_n = m_zin_n = 0;
+    m_zout_codec = ECOMPRESS_CODEC_NONE;
+    m_zscan = EBUFFEREDSTREAM_SCAN_HELLO;
+    m_zscan_prevc = 0;
+    m_peer_caps = 0;
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Compress data from m_out and write it to the stream.
+
+  The eBufferedStream::compressed_buffer_to_stream() function is used by buffer_to_stream()
+  when compression is on. Data from m_out is compressed in blocks of max ECOMPRESS_MAX_BLOCK
+  bytes, each block is written as a frame: Frame type, 2 byte size and data. If compression
+  doesn't make block smaller, block is sent uncompressed. If the stream doesn't take whole
+  frame, rest of it is written on next call before anything else.
+
+  @return If no error detected, the function returns ESTATUS_SUCCESS.
+          Other return values indicate an error and that socket is to be disconnected.
+
+****************************************************************************************************
+*/
+eStatus eBufferedStream::compressed_buffer_to_stream()
+{
+    os_memsz n, nread, nwritten, zn;
+    os_char *src;
+    os_long t;
+    eStatus s = ESTATUS_SUCCESS;
+
+    src = m_zframe + EBUFFEREDSTREAM_ZFRAME_SZ;
+
+    while (OS_TRUE)
+    {
+        /* Finish writing current frame.
+         */
+        if (m_zframe_pos < m_zframe_n)
+        {
+            s = buffered_write(m_zframe + m_zframe_pos, m_zframe_n - m_zframe_pos, &nwritten);
+            m_nwrite_calls++;
+            if (s || nwritten <= 0) {
+                break;
+            }
+            m_nbytes_written += nwritten;
+            m_zframe_pos += nwritten;
+            continue;
+        }
+
+        n = m_out->bytes();
+        if ((n < m_send_size && !m_flushnow) || n < 1) {
+            if (n < 1) m_flushnow = OS_FALSE;
+            break;
+        }
+
+        m_out->readx(src, ECOMPRESS_MAX_BLOCK, &nread);
+        if (nread == 0) {
+            break;
+        }
+
+        t = etime();
+        zn = ecompress(m_zout, src, nread, m_zframe + ECOMPRESS_FRAME_HDR_SZ,
+            ECOMPRESS_BOUND(ECOMPRESS_MAX_BLOCK));
+        if (zn < 0 || zn >= nread) {
+            os_memcpy(m_zframe + ECOMPRESS_FRAME_HDR_SZ, src, nread);
+            zn = nread;
+            m_zframe[0] = ECOMPRESS_FRAME_RAW;
+        }
+        else {
+            m_zframe[0] = ECOMPRESS_FRAME_LZ;
+        }
+        m_zcpu_us += etime() - t;
+
+        m_zframe[1] = (os_char)zn;
+        m_zframe[2] = (os_char)(zn >> 8);
+        m_zframe_n = zn + ECOMPRESS_FRAME_HDR_SZ;
+        m_zframe_pos = 0;
+        m_zraw_bytes += nread;
+        m_zcoded_bytes += m_zframe_n;
+    }
+
+    return s;
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Decompress received data into m_in.
+
+  The eBufferedStream::decompress_to_buffer() function collects received bytes into frames
+  and decompresses each complete frame into m_in queue. A frame with zero size payload is
+  complete when the header has been received, and adds nothing to m_in.
+
+  @param  buf Data received from the stream.
+  @param  n Number of bytes in buf.
+  @return If no error detected, the function returns ESTATUS_SUCCESS. ESTATUS_FAILED
+          indicates corrupted data and that socket is to be disconnected.
+
+****************************************************************************************************
+*/
+eStatus eBufferedStream::decompress_to_buffer(
+    const os_char *buf,
+    os_memsz n)
+{
+    os_char out[ECOMPRESS_MAX_BLOCK];
+    os_memsz frame_sz, data_sz, count, m;
+    os_uchar type;
+    os_long t;
+    eStatus s;
+
+    while (n > 0)
+    {
+        /* Collect frame header first.
+         */
+        if (m_zin_n < ECOMPRESS_FRAME_HDR_SZ)
+        {
+            count = ECOMPRESS_FRAME_HDR_SZ - m_zin_n;
+            if (count > n) count = n;
+            os_memcpy(m_zinframe + m_zin_n, buf, count);
+            m_zin_n += count;
+            buf += count;
+            n -= count;
+            if (m_zin_n < ECOMPRESS_FRAME_HDR_SZ) break;
+        }
+
+        /* Then data.
+         */
+        data_sz = (os_uchar)m_zinframe[1] | ((os_memsz)(os_uchar)m_zinframe[2] << 8);
+        frame_sz = ECOMPRESS_FRAME_HDR_SZ + data_sz;
+        if (frame_sz > EBUFFEREDSTREAM_ZFRAME_SZ) return ESTATUS_FAILED;
+
+        count = frame_sz - m_zin_n;
+        if (count > n) count = n;
+        os_memcpy(m_zinframe + m_zin_n, buf, count);
+        m_zin_n += count;
+        buf += count;
+        n -= count;
+        if (m_zin_n < frame_sz) break;
+
+        /* Whole frame received.
+         */
+        m_zin_n = 0;
+        s = ESTATUS_SUCCESS;
+        type = (os_uchar)m_zinframe[0];
+        if (type == ECOMPRESS_FRAME_RAW)
+        {
+            if (data_sz) {
+                ecompress_append(m_zin, m_zinframe + ECOMPRESS_FRAME_HDR_SZ, data_sz);
+                s = m_in->write(m_zinframe + ECOMPRESS_FRAME_HDR_SZ, data_sz);
+            }
+        }
+        else if (type == ECOMPRESS_FRAME_LZ)
+        {
+            if (data_sz) {
+                t = etime();
+                m = edecompress(m_zin, m_zinframe + ECOMPRESS_FRAME_HDR_SZ, data_sz,
+                    out, sizeof(out));
+                m_zcpu_us += etime() - t;
+                if (m < 0) return ESTATUS_FAILED;
+                if (m) s = m_in->write(out, m);
+            }
+        }
+        else
+        {
+            return ESTATUS_FAILED;
+        }
+
+        if (s) return s;
+    }
+
+    return ESTATUS_SUCCESS;
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Move received uncompressed data into m_in.
+
+  The eBufferedStream::scan_to_buffer() function writes received data to m_in queue. Keep
+  alive sequences used for connection setup are left in data, m_in ignores them when read.
+  - Hello is expected as the first two bytes from the other end. If the data starts with
+    something else, the other end is older version and nothing is scanned after that.
+  - If hello selected a codec, data is scanned for codec switch mark. Data after the mark
+    is compressed and passed to decompress_to_buffer(). Keep alive with count other than
+    zero doesn't appear in data otherwise, control character in data is always encoded
+    as E_STREAM_CTRLCH_IN_DATA.
+
+  @param  buf Data received from the stream.
+  @param  n Number of bytes in buf.
+  @return If no error detected, the function returns ESTATUS_SUCCESS. Other return values
+          indicate an error and that socket is to be disconnected.
+
+****************************************************************************************************
+*/
+eStatus eBufferedStream::scan_to_buffer(
+    const os_char *buf,
+    os_memsz n)
+{
+    os_memsz i;
+    os_int count;
+    os_uchar c;
+    os_boolean is_ka;
+    eStatus s;
+
+    for (i = 0; i < n && m_zscan != EBUFFEREDSTREAM_SCAN_OFF; i++)
+    {
+        c = (os_uchar)buf[i];
+        is_ka = (os_boolean)(m_zscan_prevc == E_STREAM_CTRL_CHAR &&
+            (c & E_STREAM_CTRLCH_MASK) == E_STREAM_CTRLCH_KEEPALIVE);
+        count = c & E_STREAM_COUNT_MASK;
+        m_zscan_prevc = c;
+
+        if (m_zscan == EBUFFEREDSTREAM_SCAN_HELLO)
+        {
+            if (c == E_STREAM_CTRL_CHAR) continue;
+            if (is_ka && (count & E_STREAM_KEEPALIVE_HELLO))
+            {
+                m_peer_caps = count;
+                m_zscan = (count & E_STREAM_KEEPALIVE_CODEC_MASK)
+                    ? EBUFFEREDSTREAM_SCAN_SWITCH : EBUFFEREDSTREAM_SCAN_OFF;
+            }
+            else {
+                m_zscan = EBUFFEREDSTREAM_SCAN_OFF;
+            }
+        }
+        else if (is_ka && count && (count & ~E_STREAM_KEEPALIVE_CODEC_MASK) == 0)
+        {
+            s = m_in->write(buf, i + 1);
+            if (s) return s;
+            s = start_decompression(count);
+            if (s) return s;
+            m_zscan = EBUFFEREDSTREAM_SCAN_OFF;
+            return decompress_to_buffer(buf + i + 1, n - i - 1);
+        }
+    }
+
+    return m_in->write(buf, n);
+}
+
+
 /**
 ****************************************************************************************************
 
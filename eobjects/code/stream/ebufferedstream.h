@@ -21,6 +21,18 @@
 #include "eobjects.h"
 
 
+/* Maximum size of compressed frame, header included.
+ */
+#define EBUFFEREDSTREAM_ZFRAME_SZ \
+    (ECOMPRESS_FRAME_HDR_SZ + ECOMPRESS_BOUND(ECOMPRESS_MAX_BLOCK))
+
+/* Scanning uncompressed input: Expecting hello as first two bytes, looking for codec
+   switch mark, or nothing to look for.
+ */
+#define EBUFFEREDSTREAM_SCAN_HELLO 0
+#define EBUFFEREDSTREAM_SCAN_SWITCH 1
+#define EBUFFEREDSTREAM_SCAN_OFF 2
+
 /**
 ****************************************************************************************************
   eBufferedStream base class.
@@ -73,6 +85,65 @@ public:
      */
     virtual os_int readchar();
 
+    /* Number of bytes written to stream but not yet flushed.
+     */
+    virtual os_memsz outbytes()
+    {
+        if (m_out) return m_out->bytes() + m_zframe_n - m_zframe_pos;
+        return 0;
+    }
+
+    /* Output statistics, bytes and write calls to underlying stream.
+     */
+    virtual void outstats(
+        os_long *nbytes,
+        os_long *ncalls)
+    {
+        *nbytes = m_nbytes_written;
+        *ncalls = m_nwrite_calls;
+    }
+
+    /* Start compressing output after data already written.
+     */
+    virtual eStatus setcodec(
+        os_int codec);
+
+    /* Capabilities from hello received from the other end, 0 if none received.
+     */
+    virtual os_int peercaps()
+    {
+        return m_peer_caps;
+    }
+
+    /* Capabilities echoed back by the other end, found when received data is written to
+       input queue.
+     */
+    virtual os_int peerecho()
+    {
+        if (m_in) return m_in->peerecho();
+        return 0;
+    }
+
+    /* Compression statistics.
+     */
+    virtual void codecstats(
+        os_long *raw_bytes,
+        os_long *coded_bytes,
+        os_long *cpu_us)
+    {
+        *raw_bytes = m_zraw_bytes;
+        *coded_bytes = m_zcoded_bytes;
+        *cpu_us = m_zcpu_us;
+    }
+
+    /* Move received data to input buffer without waiting.
+     */
+    virtual eStatus receive()
+    {
+        if (m_in) return stream_to_buffer();
+        return ESTATUS_SUCCESS;
+    }
+
 
 protected:
 
@@ -149,6 +220,35 @@ protected:
      */
     eStatus stream_to_buffer();
 
+    /* Compress data from m_out into frames and write these to the stream.
+     */
+    eStatus compressed_buffer_to_stream();
+
+    /* Decompress received frames into m_in.
+     */
+    eStatus decompress_to_buffer(
+        const os_char *buf,
+        os_memsz n);
+
+    /* Move received uncompressed data into m_in, look for hello and codec switch.
+     */
+    eStatus scan_to_buffer(
+        const os_char *buf,
+        os_memsz n);
+
+    /* Allocate compressor and write codec switch mark.
+     */
+    void start_compression();
+
+    /* Allocate decompressor.
+     */
+    eStatus start_decompression(
+        os_int codec);
+
+    /* Release compression buffers.
+     */
+    void release_codec();
+
 
     /**
     ************************************************************************************************
@@ -173,6 +273,51 @@ protected:
     os_int m_flags;
 
     os_boolean m_flushnow;
+
+    /** Total number of bytes passed to buffered_write().
+     */
+    os_long m_nbytes_written;
+
+    /** Number of buffered_write() calls (system calls for socket, etc).
+     */
+    os_long m_nwrite_calls;
+
+    /** Compressor and decompressor state, OS_NULL if compression is not used.
+     */
+    eCompressState *m_zout;
+    eCompressState *m_zin;
+
+    /** Codec selected by setcodec(). Compression starts when m_out has been written out.
+     */
+    os_int m_zout_codec;
+
+    /** Scanning uncompressed input: EBUFFEREDSTREAM_SCAN_HELLO, EBUFFEREDSTREAM_SCAN_SWITCH
+        or EBUFFEREDSTREAM_SCAN_OFF, and previous byte scanned.
+     */
+    os_int m_zscan;
+    os_uchar m_zscan_prevc;
+
+    /** Capabilities from hello received from the other end, 0 if none received.
+     */
+    os_int m_peer_caps;
+
+    /** Outgoing frame buffer: Header, compressed data and source block. Frame is
+        written from m_zframe_pos to m_zframe_n.
+     */
+    os_char *m_zframe;
+    os_memsz m_zframe_pos;
+    os_memsz m_zframe_n;
+
+    /** Incoming frame being received, m_zin_n bytes received so far.
+     */
+    os_char *m_zinframe;
+    os_memsz m_zin_n;
+
+    /** Compression statistics.
+     */
+    os_long m_zraw_bytes;
+    os_long m_zcoded_bytes;
+    os_long m_zcpu_us;
 };
 
 #endif
@@ -0,0 +1,365 @@
+/**
+
+  @file    ecompress.cpp
+  @brief   Streaming LZ compression for connections.
+  @author  Pekka Lehtikoski
+  @version 1.0
+  @date    18.10.2026
+
+  Compressed block is sequence of: Token byte (high nibble literal count, low nibble match
+  length - 4), optional literal count extension bytes, literals, 2 byte match offset (LSB
+  first) and optional match length extension bytes. Extension bytes are added while value
+  is 255. Last sequence of the block has only literals. Match offset refers to history
+  window, which holds uncompressed data of the session, so matches can reach into earlier
+  blocks.
+
+  Copyright 2020 Pekka Lehtikoski. This file is part of the eobjects project and shall only be used,
+  modified, and distributed under the terms of the project licensing. By continuing to use, modify,
+  or distribute this file you indicate that you have read the license and understand and accept
+  it fully.
+
+****************************************************************************************************
+*/
+#include "eobjects.h"
+
+/* Minimum match length.
+ */
+#define ECOMPRESS_MIN_MATCH 4
+
+/* Byte from history window by stream position.
+ */
+#define ECOMPRESS_AT(w, p) ((w)[(p) & ECOMPRESS_WINDOW_MASK])
+
+/* Forward referred static functions.
+ */
+static os_memsz ecompress_sequence(
+    os_uchar *window,
+    os_uint lit_pos,
+    os_uint lit_n,
+    os_uint offset,
+    os_uint match_n,
+    os_uchar *dst,
+    os_memsz dst_pos,
+    os_memsz dst_sz);
+
+
+/**
+****************************************************************************************************
+
+  @brief Allocate and clear compression state.
+
+  The ecompress_init() function allocates history window, and for compressor also hash
+  table. Compressor and decompressor start from identical cleared window.
+
+  @param   state Compression state to set up.
+  @param   compressor OS_TRUE for compressor, OS_FALSE for decompressor.
+  @return  None.
+
+****************************************************************************************************
+*/
+void ecompress_init(
+    eCompressState *state,
+    os_boolean compressor)
+{
+    state->window = (os_uchar*)os_malloc(ECOMPRESS_WINDOW_SZ, OS_NULL);
+    os_memclear(state->window, ECOMPRESS_WINDOW_SZ);
+    state->htab = OS_NULL;
+    if (compressor)
+    {
+        state->htab = (os_uint*)os_malloc(ECOMPRESS_HASH_SZ * sizeof(os_uint), OS_NULL);
+        os_memclear(state->htab, ECOMPRESS_HASH_SZ * sizeof(os_uint));
+    }
+    state->pos = 0;
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Release memory allocated for compression state.
+
+  @param   state Compression state.
+  @return  None.
+
+****************************************************************************************************
+*/
+void ecompress_release(
+    eCompressState *state)
+{
+    if (state->window)
+    {
+        os_free(state->window, ECOMPRESS_WINDOW_SZ);
+        state->window = OS_NULL;
+    }
+    if (state->htab)
+    {
+        os_free(state->htab, ECOMPRESS_HASH_SZ * sizeof(os_uint));
+        state->htab = OS_NULL;
+    }
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Compress a block.
+
+  The ecompress() function copies the block to history window and compresses it. Block is
+  added to history even if compression fails, so if the caller sends the block uncompressed,
+  decompressor needs to add it to history by ecompress_append().
+
+  @param   state Compressor state.
+  @param   src Data to compress.
+  @param   n Number of bytes to compress, max ECOMPRESS_MAX_BLOCK.
+  @param   dst Buffer for compressed data.
+  @param   dst_sz Buffer size, ECOMPRESS_BOUND(n) is always enough.
+  @return  Compressed size in bytes, -1 if compressed data doesn't fit into dst.
+
+****************************************************************************************************
+*/
+os_memsz ecompress(
+    eCompressState *state,
+    const os_char *src,
+    os_memsz n,
+    os_char *dst,
+    os_memsz dst_sz)
+{
+    os_uchar *w;
+    os_uint start, end, ip, anchor, cand, d, len, x, h;
+    os_memsz i, op;
+
+    w = state->window;
+    start = state->pos;
+    end = start + (os_uint)n;
+    for (i = 0; i < n; i++) {
+        ECOMPRESS_AT(w, start + (os_uint)i) = (os_uchar)src[i];
+    }
+    state->pos = end;
+
+    ip = anchor = start;
+    op = 0;
+    while (end - ip >= ECOMPRESS_MIN_MATCH)
+    {
+        x = (os_uint)ECOMPRESS_AT(w, ip) |
+            ((os_uint)ECOMPRESS_AT(w, ip + 1) << 8) |
+            ((os_uint)ECOMPRESS_AT(w, ip + 2) << 16) |
+            ((os_uint)ECOMPRESS_AT(w, ip + 3) << 24);
+        h = (x * 2654435761U) >> (32 - ECOMPRESS_HASH_BITS);
+        cand = state->htab[h];
+        state->htab[h] = ip;
+
+        /* Candidate must be within history which is not overwritten by this block.
+         */
+        d = ip - cand;
+        if (d == 0 || d > 0xFFFF || d > ECOMPRESS_WINDOW_SZ - (end - ip) ||
+            ECOMPRESS_AT(w, cand) != ECOMPRESS_AT(w, ip) ||
+            ECOMPRESS_AT(w, cand + 1) != ECOMPRESS_AT(w, ip + 1) ||
+            ECOMPRESS_AT(w, cand + 2) != ECOMPRESS_AT(w, ip + 2) ||
+            ECOMPRESS_AT(w, cand + 3) != ECOMPRESS_AT(w, ip + 3))
+        {
+            ip++;
+            continue;
+        }
+
+        len = ECOMPRESS_MIN_MATCH;
+        while (ip + len != end && ECOMPRESS_AT(w, cand + len) == ECOMPRESS_AT(w, ip + len)) {
+            len++;
+        }
+
+        op = ecompress_sequence(w, anchor, ip - anchor, d, len, (os_uchar*)dst, op, dst_sz);
+        if (op < 0) return -1;
+        ip += len;
+        anchor = ip;
+    }
+
+    /* Last literals.
+     */
+    return ecompress_sequence(w, anchor, end - anchor, 0, 0, (os_uchar*)dst, op, dst_sz);
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Decompress a block.
+
+  The edecompress() function decompresses a block and adds uncompressed data to history
+  window.
+
+  @param   state Decompressor state.
+  @param   src Compressed data.
+  @param   n Compressed data size in bytes.
+  @param   dst Buffer for uncompressed data.
+  @param   dst_sz Buffer size, ECOMPRESS_MAX_BLOCK is always enough.
+  @return  Uncompressed size in bytes, -1 if data is corrupted.
+
+****************************************************************************************************
+*/
+os_memsz edecompress(
+    eCompressState *state,
+    const os_char *src,
+    os_memsz n,
+    os_char *dst,
+    os_memsz dst_sz)
+{
+    const os_uchar *s;
+    os_uchar *w, c;
+    os_uint pos, d, lit_n, match_n, b;
+    os_memsz ip, op;
+
+    s = (const os_uchar*)src;
+    w = state->window;
+    pos = state->pos;
+    ip = op = 0;
+
+    while (ip < n)
+    {
+        b = s[ip++];
+        lit_n = b >> 4;
+        match_n = b & 0x0F;
+        if (lit_n == 15)
+        {
+            do {
+                if (ip >= n) return -1;
+                b = s[ip++];
+                lit_n += b;
+            }
+            while (b == 255);
+        }
+
+        if (lit_n > n - ip || lit_n > dst_sz - op) return -1;
+        while (lit_n--)
+        {
+            c = s[ip++];
+            ECOMPRESS_AT(w, pos++) = c;
+            dst[op++] = (os_char)c;
+        }
+
+        /* Last sequence has only literals.
+         */
+        if (ip >= n) break;
+
+        if (n - ip < 2) return -1;
+        d = (os_uint)s[ip] | ((os_uint)s[ip + 1] << 8);
+        ip += 2;
+        if (d == 0) return -1;
+
+        if (match_n == 15)
+        {
+            do {
+                if (ip >= n) return -1;
+                b = s[ip++];
+                match_n += b;
+            }
+            while (b == 255);
+        }
+        match_n += ECOMPRESS_MIN_MATCH;
+
+        if (match_n > dst_sz - op) return -1;
+        while (match_n--)
+        {
+            c = ECOMPRESS_AT(w, pos - d);
+            ECOMPRESS_AT(w, pos++) = c;
+            dst[op++] = (os_char)c;
+        }
+    }
+
+    state->pos = pos;
+    return op;
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Add uncompressed block to decompressor's history.
+
+  Compressor adds every block to it's history, so decompressor must do the same for blocks
+  which were sent uncompressed.
+
+  @param   state Decompressor state.
+  @param   src Uncompressed data.
+  @param   n Data size in bytes.
+  @return  None.
+
+****************************************************************************************************
+*/
+void ecompress_append(
+    eCompressState *state,
+    const os_char *src,
+    os_memsz n)
+{
+    os_memsz i;
+
+    for (i = 0; i < n; i++) {
+        ECOMPRESS_AT(state->window, state->pos++) = (os_uchar)src[i];
+    }
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Write one sequence of compressed data.
+
+  @param   window History window holding the literals.
+  @param   lit_pos Stream position of first literal.
+  @param   lit_n Number of literals.
+  @param   offset Match offset, ignored if match_n is 0.
+  @param   match_n Match length, 0 for last sequence of block.
+  @param   dst Buffer for compressed data.
+  @param   dst_pos Current position in dst.
+  @param   dst_sz Buffer size.
+  @return  New position in dst, -1 if buffer is too small.
+
+****************************************************************************************************
+*/
+static os_memsz ecompress_sequence(
+    os_uchar *window,
+    os_uint lit_pos,
+    os_uint lit_n,
+    os_uint offset,
+    os_uint match_n,
+    os_uchar *dst,
+    os_memsz dst_pos,
+    os_memsz dst_sz)
+{
+    os_uint ml, x;
+
+    /* Worst case size: token, length extensions, literals and offset.
+     */
+    if (dst_pos + 1 + lit_n / 255 + 1 + lit_n + 2 + match_n / 255 + 1 > dst_sz) {
+        return -1;
+    }
+
+    ml = match_n ? match_n - ECOMPRESS_MIN_MATCH : 0;
+    dst[dst_pos++] = (os_uchar)(((lit_n < 15 ? lit_n : 15) << 4) | (ml < 15 ? ml : 15));
+
+    if (lit_n >= 15)
+    {
+        for (x = lit_n - 15; x >= 255; x -= 255) {
+            dst[dst_pos++] = 255;
+        }
+        dst[dst_pos++] = (os_uchar)x;
+    }
+
+    while (lit_n--) {
+        dst[dst_pos++] = ECOMPRESS_AT(window, lit_pos++);
+    }
+
+    if (match_n)
+    {
+        dst[dst_pos++] = (os_uchar)offset;
+        dst[dst_pos++] = (os_uchar)(offset >> 8);
+
+        if (ml >= 15)
+        {
+            for (x = ml - 15; x >= 255; x -= 255) {
+                dst[dst_pos++] = 255;
+            }
+            dst[dst_pos++] = (os_uchar)x;
+        }
+    }
+
+    return dst_pos;
+}
@@ -0,0 +1,106 @@
+/**
+
+  @file    ecompress.h
+  @brief   Streaming LZ compression for connections.
+  @author  Pekka Lehtikoski
+  @version 1.0
+  @date    18.10.2026
+
+  Simple LZ77 block compressor in LZ4 style, with history window which is kept over blocks
+  for whole session. Repeated paths and property names in envelopes are found from history,
+  so they compress well even when each block is small.
+
+  Copyright 2020 Pekka Lehtikoski. This file is part of the eobjects project and shall only be used,
+  modified, and distributed under the terms of the project licensing. By continuing to use, modify,
+  or distribute this file you indicate that you have read the license and understand and accept
+  it fully.
+
+****************************************************************************************************
+*/
+#pragma once
+#ifndef ECOMPRESS_H_
+#define ECOMPRESS_H_
+#include "eobjects.h"
+
+/* Codec identifiers, negotiated by connection handshake.
+ */
+#define ECOMPRESS_CODEC_NONE 0
+#define ECOMPRESS_CODEC_LZ 1
+
+/* Session history window size, must be power of two and at most 65536 (2 byte offset).
+ */
+#define ECOMPRESS_WINDOW_SZ 16384
+#define ECOMPRESS_WINDOW_MASK (ECOMPRESS_WINDOW_SZ - 1)
+
+/* Hash table size for finding matches (compressor only).
+ */
+#define ECOMPRESS_HASH_BITS 12
+#define ECOMPRESS_HASH_SZ (1 << ECOMPRESS_HASH_BITS)
+
+/* Maximum uncompressed block size, and maximum compressed size for block of n bytes.
+ */
+#define ECOMPRESS_MAX_BLOCK 4096
+#define ECOMPRESS_BOUND(n) ((n) + (n) / 255 + 16)
+
+/* Frame header on the wire: Frame type byte and 2 byte payload size.
+ */
+#define ECOMPRESS_FRAME_HDR_SZ 3
+#define ECOMPRESS_FRAME_RAW 0x5A
+#define ECOMPRESS_FRAME_LZ 0x5B
+
+/* Compression state for one direction of a connection.
+ */
+typedef struct eCompressState
+{
+    /* History window, last ECOMPRESS_WINDOW_SZ bytes of uncompressed data.
+     */
+    os_uchar *window;
+
+    /* Hash table of positions in history, OS_NULL for decompressor.
+     */
+    os_uint *htab;
+
+    /* Total number of uncompressed bytes processed (wraps around).
+     */
+    os_uint pos;
+}
+eCompressState;
+
+/* Allocate and clear compression state.
+ */
+void ecompress_init(
+    eCompressState *state,
+    os_boolean compressor);
+
+/* Release memory allocated for compression state.
+ */
+void ecompress_release(
+    eCompressState *state);
+
+/* Compress block of max ECOMPRESS_MAX_BLOCK bytes, returns compressed size or -1 if
+   it doesn't fit in dst.
+ */
+os_memsz ecompress(
+    eCompressState *state,
+    const os_char *src,
+    os_memsz n,
+    os_char *dst,
+    os_memsz dst_sz);
+
+/* Decompress block, returns decompressed size or -1 if data is corrupted.
+ */
+os_memsz edecompress(
+    eCompressState *state,
+    const os_char *src,
+    os_memsz n,
+    os_char *dst,
+    os_memsz dst_sz);
+
+/* Add block which was sent uncompressed to decompressor's history.
+ */
+void ecompress_append(
+    eCompressState *state,
+    const os_char *src,
+    os_memsz n);
+
+#endif
@@ -245,7 +245,8 @@ eStatus eOsStream::close()
   This prevents the socket from getting stick if both ends are writing large amount of data
   at same time.
 
-  @param  flags Ignored for now.
+  @param  flags ESTREAM_FLUSH_KEEP_BUFFERED to flush only the underlying stream, without
+          writing data from output queue. Otherwise 0.
   @return If successfull, the function returns ESTATUS_SUCCESS (0). Otherwise if socket is not
           open returns ESTATUS failed.
 
@@ -254,13 +255,13 @@ eStatus eOsStream::close()
 eStatus eOsStream::flush(
     os_int flags)
 {
-    OSAL_UNUSED(flags);
-
     if (m_out == OS_NULL) {
         return ESTATUS_FAILED;
     }
 
-    buffer_to_stream(OS_TRUE);
+    if ((flags & ESTREAM_FLUSH_KEEP_BUFFERED) == 0) {
+        buffer_to_stream(OS_TRUE);
+    }
 
     return m_iface->stream_flush(m_stream, OSAL_STREAM_DEFAULT)
         ? ESTATUS_FAILED : ESTATUS_SUCCESS;
@@ -503,7 +504,8 @@ eStatus eOsStream::buffered_read(
   @param   nstreams Number of items in streams array.
   @param   evnt Operating system event to wait for.
   @param   timeout_ms Maximum time to wait in select, ms. If zero, timeout is not used (infinite).
-  @param   flags Reserved, set 0 for now.
+  @param   flags ESTREAM_SELECT_WAIT_ONLY to only wait for event, without reading received data
+           into input buffer. Otherwise set OSAL_STREAM_DEFAULT.
 
   @return  None.
 
@@ -520,7 +522,6 @@ eStatus eOsStream::select(
     eOsStream **osstreams;
     osalStream osalsock[OSAL_SOCKET_SELECT_MAX];
     os_int i;
-    OSAL_UNUSED(flags);
 
     if (m_use_select)
     {
@@ -544,7 +545,19 @@ eStatus eOsStream::select(
         if (s) return ESTATUS_FROM_OSAL_STATUS(s);
     }
 
-    if (m_in) {
+    /* Stream without select support: No socket events, just wait briefly for thread event.
+     */
+    else if (flags & ESTREAM_SELECT_WAIT_ONLY)
+    {
+        if (evnt) {
+            osal_event_wait(evnt, EOSSTREAM_POLL_WAIT_MS);
+        }
+        else {
+            os_timeslice();
+        }
+    }
+
+    if (m_in && (flags & ESTREAM_SELECT_WAIT_ONLY) == 0) {
         return stream_to_buffer();
     }
 
@@ -20,6 +20,10 @@
 
 class eQueue;
 
+/* Wait time for thread event in select() without socket select support, ms.
+ */
+#define EOSSTREAM_POLL_WAIT_MS 10
+
 /**
 ****************************************************************************************************
   EOSAL library stream as eobjects stream.
@@ -51,6 +51,7 @@ eQueue::eQueue(
     m_bytes = 0;
     m_flushctrl_last_c = 0;
     m_flush_count = 0;
+    m_echo_caps = 0;
 
     m_nblocks = 0;
     m_max_blocks = 100000;
@@ -183,6 +184,7 @@ eStatus eQueue::close()
     m_bytes = 0;
     m_flushctrl_last_c = 0;
     m_flush_count = 0;
+    m_echo_caps = 0;
 
     return ESTATUS_SUCCESS;
 }
@@ -426,7 +428,7 @@ eStatus eQueue::write_plain(
 
     m_bytes += buf_sz;
 
-    /* If we need to calculate incoming flush controls.
+    /* If we need to calculate incoming flush controls (and look for echoed capabilities).
      */
     if (buf_sz > 0 && (m_flags & OSAL_FLUSH_CTRL_COUNT))
     {
@@ -434,10 +436,7 @@ eStatus eQueue::write_plain(
 
         if (m_flushctrl_last_c == E_STREAM_CTRL_CHAR)
         {
-            if (*u == E_STREAM_CTRLCH_FLUSH)
-            {
-                m_flush_count++;
-            }
+            scan_ctrl(*u);
         }
 
         count = buf_sz - 1;
@@ -445,10 +444,7 @@ eStatus eQueue::write_plain(
         {
             if (*(u++) == E_STREAM_CTRL_CHAR)
             {
-                if (*u == E_STREAM_CTRLCH_FLUSH)
-                {
-                    m_flush_count++;
-                }
+                scan_ctrl(*u);
             }
         }
 
@@ -696,7 +692,7 @@ void eQueue::read_decoded(
                 {
                     m_rd_repeat_char = E_STREAM_CTRL_CHAR;
                     m_rd_repeat_count = (c & E_STREAM_COUNT_MASK);
-                    buf[n++] = c;
+                    buf[n++] = (os_char)E_STREAM_CTRL_CHAR;
                     if (n >= buf_sz) break;
                 }
                 continue;
@@ -895,6 +891,12 @@ eStatus eQueue::writechar(
             break;
 
         default:
+            /* Keep alive with count field, see E_STREAM_KEEPALIVE_HELLO.
+             */
+            if ((c & E_STREAM_CTRL_MASK) == E_STREAM_KEEPALIVE) {
+                c = E_STREAM_CTRLCH_KEEPALIVE | (c & E_STREAM_COUNT_MASK);
+                break;
+            }
             putcharacter(c);
             m_bytes++;
             return ESTATUS_SUCCESS;
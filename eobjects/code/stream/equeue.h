@@ -162,6 +162,14 @@ public:
         return m_flush_count;
     }
 
+    /** Capabilities echoed by keep alive with E_STREAM_KEEPALIVE_ECHO, found by the same scan
+        as flush controls. Requires OSAL_FLUSH_CTRL_COUNT flag for open().
+     */
+    virtual os_int peerecho()
+    {
+        return m_echo_caps;
+    }
+
 private:
 
     /**
@@ -173,6 +181,22 @@ private:
      */
     void newblock();
 
+    /* Count flush control or record echoed capabilities, c is character after control
+       character in data written by write_plain().
+     */
+    inline void scan_ctrl(
+        os_uchar c)
+    {
+        if (c == E_STREAM_CTRLCH_FLUSH) {
+            m_flush_count++;
+        }
+        else if ((c & (E_STREAM_CTRLCH_MASK|E_STREAM_KEEPALIVE_HELLO|E_STREAM_KEEPALIVE_ECHO))
+            == (E_STREAM_CTRLCH_KEEPALIVE|E_STREAM_KEEPALIVE_ECHO))
+        {
+            m_echo_caps |= (c & E_STREAM_COUNT_MASK);
+        }
+    }
+
     /* Detach oldest block from queue and free memory allocatd for it.
      */
     void delblock();
@@ -333,6 +357,10 @@ private:
     /** Last character of previous write_plain() call.
      */
     os_uchar m_flushctrl_last_c;
+
+    /** Capabilities echoed by the other end, see peerecho().
+     */
+    os_int m_echo_caps;
 };
 
 #endif
@@ -70,6 +70,17 @@
  */
 #define E_STREAM_COUNT_MASK 0x1F
 
+/** Keep alive character's count field carries connection setup, older versions ignore it.
+    Hello is the first thing sent after authentication: E_STREAM_KEEPALIVE_HELLO bit set
+    and bits 0 - 3 tell capabilities of the sender. Count 1 - 7 without hello bit marks that
+    all data after it is compressed with codec given by count. E_STREAM_KEEPALIVE_ECHO
+    without hello bit echoes capability bit 3 back to the sender of hello, to confirm that
+    hello was received and the capability is agreed.
+ */
+#define E_STREAM_KEEPALIVE_HELLO 0x10
+#define E_STREAM_KEEPALIVE_ECHO 0x08
+#define E_STREAM_KEEPALIVE_CODEC_MASK 0x07
+
 
 /**
 ****************************************************************************************************
@@ -117,6 +128,24 @@
 
 
 
+/**
+****************************************************************************************************
+  Flags for eStream::select(): ESTREAM_SELECT_WAIT_ONLY waits for socket or thread event without
+  moving received data to stream's input buffer. Used while raw socket handshake is in progress.
+****************************************************************************************************
+*/
+#define ESTREAM_SELECT_WAIT_ONLY 0x10000
+
+/**
+****************************************************************************************************
+  Flags for eStream::flush(): ESTREAM_FLUSH_KEEP_BUFFERED flushes only the underlying stream and
+  keeps data in stream's output buffer. Used while raw socket handshake is in progress, so that
+  hello queued when the socket was connected stays behind the handshake bytes.
+****************************************************************************************************
+*/
+#define ESTREAM_FLUSH_KEEP_BUFFERED 0x20000
+
+
 /**
 ****************************************************************************************************
   Default socket port number for eobject communication. TCP ports 6371 - 6375 are unassigned.
@@ -242,6 +271,64 @@ public:
         return -1;
     }
 
+    /** Number of bytes written to stream but not yet flushed.
+     */
+    virtual os_memsz outbytes()
+    {
+        return 0;
+    }
+
+    /** Output statistics: Total number of bytes passed to underlying stream and number
+        of underlying write calls used to pass these.
+     */
+    virtual void outstats(
+        os_long *nbytes,
+        os_long *ncalls)
+    {
+        *nbytes = *ncalls = 0;
+    }
+
+    /* Start compressing output after data already written, codec ECOMPRESS_CODEC_*.
+     */
+    virtual eStatus setcodec(
+        os_int codec)
+    {
+        return codec == ECOMPRESS_CODEC_NONE ? ESTATUS_SUCCESS : ESTATUS_NOT_SUPPORTED;
+    }
+
+    /* Capabilities from hello received from the other end, 0 if none received.
+     */
+    virtual os_int peercaps()
+    {
+        return 0;
+    }
+
+    /* Capabilities echoed back by the other end, 0 if no echo received.
+     */
+    virtual os_int peerecho()
+    {
+        return 0;
+    }
+
+    /* Compression statistics: Uncompressed and compressed bytes written, and time spent
+       compressing and decompressing in microseconds.
+     */
+    virtual void codecstats(
+        os_long *raw_bytes,
+        os_long *coded_bytes,
+        os_long *cpu_us)
+    {
+        *raw_bytes = *coded_bytes = *cpu_us = 0;
+    }
+
+    /* Move received data from underlying stream to input buffer without waiting. Used
+       when select() has been called for multiple streams with ESTREAM_SELECT_WAIT_ONLY.
+     */
+    virtual eStatus receive()
+    {
+        return ESTATUS_SUCCESS;
+    }
+
     /* Wait for stream or thread event.
      */
     virtual eStatus select(
@@ -0,0 +1,211 @@
+/**
+
+  @file    edouble2str.cpp
+  @brief   Convert floating point number to string without memory allocation.
+  @author  Pekka Lehtikoski
+  @version 1.0
+  @date    18.10.2026
+
+  Numbers which fit into 64 bit integer when scaled by number of decimal digits are formatted
+  with integer arithmetic. Very large or small numbers, infinity and NaN are passed to
+  osal_double_to_str().
+
+  Copyright 2020 Pekka Lehtikoski. This file is part of the eobjects project and shall only be used,
+  modified, and distributed under the terms of the project licensing. By continuing to use, modify,
+  or distribute this file you indicate that you have read the license and understand and accept
+  it fully.
+
+****************************************************************************************************
+*/
+#include "eobjects.h"
+
+/* Scaled value must stay below 2^52, so that rounding by adding 0.5 is exact.
+ */
+#define EDOUBLE2STR_MAX_SCALED 4503599627370496.0
+
+/* Powers of ten, 10^0 ... 10^EDOUBLE2STR_MAX_DIGS.
+ */
+static const os_double edouble2str_pow10d[EDOUBLE2STR_MAX_DIGS + 1] = {
+    1.0, 1.0e1, 1.0e2, 1.0e3, 1.0e4, 1.0e5, 1.0e6, 1.0e7,
+    1.0e8, 1.0e9, 1.0e10, 1.0e11, 1.0e12, 1.0e13, 1.0e14, 1.0e15};
+
+static const os_long edouble2str_pow10l[EDOUBLE2STR_MAX_DIGS + 1] = {
+    1LL, 10LL, 100LL, 1000LL, 10000LL, 100000LL, 1000000LL, 10000000LL,
+    100000000LL, 1000000000LL, 10000000000LL, 100000000000LL, 1000000000000LL,
+    10000000000000LL, 100000000000000LL, 1000000000000000LL};
+
+/* Forward referred static functions.
+ */
+static os_long edouble2str_round(
+    os_double x,
+    os_int d);
+
+
+/**
+****************************************************************************************************
+
+  @brief Convert double to string, without terminating the string.
+  @anchor edouble2str
+
+  The edouble2str() function converts floating point number x to string and stores the
+  resulting characters into dst. Terminating '\0' is NOT stored, as with eint2str().
+
+  With ddigs EDOUBLE2STR_SHORTEST the function selects smallest number of decimal digits with
+  which the string reads back as exactly the same double, so 0.1 is "0.1" and 3.0 is "3".
+  If no such count up to EDOUBLE2STR_MAX_DIGS exists, the number is rounded to as many
+  digits as fit in double precision.
+
+  @param dst Pointer where to store the resulting characters.
+  @param x Value to convert to string.
+  @param max_chars Maximum number of characters to store. This is to prevent buffer overflow.
+  @param ddigs Number of digits after decimal point, or EDOUBLE2STR_SHORTEST.
+
+  @return  Pointer to character position just after stored characters. OS_NULL if max_chars
+           would have been exceeded.
+
+****************************************************************************************************
+*/
+os_char *edouble2str(
+    os_char *dst,
+    os_double x,
+    os_memsz max_chars,
+    os_int ddigs)
+{
+    os_char nbuf[EDOUBLE2STR_BUF_SZ], *e;
+    os_double scaled;
+    os_long n, ip;
+    os_memsz bytes;
+    os_int d, i;
+
+    if (dst == OS_NULL) return OS_NULL;
+    e = dst + max_chars;
+
+    /* NaN, infinity and numbers too large for integer formatting.
+     */
+    if (x != x || x > EDOUBLE2STR_MAX_SCALED || x < -EDOUBLE2STR_MAX_SCALED) {
+        goto slow;
+    }
+
+    if (ddigs < 0)
+    {
+        /* Find the smallest number of decimals which reads back as x. Division by exact
+           power of ten is correctly rounded, so n / 10^d == x if and only if decimal
+           string of n scaled by 10^-d converts back to x.
+         */
+        n = 0;
+        for (d = 0; d <= EDOUBLE2STR_MAX_DIGS; d++)
+        {
+            scaled = x * edouble2str_pow10d[d];
+            if (scaled > EDOUBLE2STR_MAX_SCALED || scaled < -EDOUBLE2STR_MAX_SCALED) {
+                if (d == 0) goto slow;
+                d--;
+                break;
+            }
+            n = (os_long)(scaled < 0 ? scaled - 0.5 : scaled + 0.5);
+            if ((os_double)n / edouble2str_pow10d[d] == x) break;
+        }
+        if (d > EDOUBLE2STR_MAX_DIGS) d = EDOUBLE2STR_MAX_DIGS;
+        n = edouble2str_round(x, d);
+
+        /* No exact match: Number like 1/3 is rounded to available precision and trailing
+           zeros are removed. Tiny number, which would round to zero, is formatted by osal.
+         */
+        if ((os_double)n / edouble2str_pow10d[d] != x)
+        {
+            if (n == 0) goto slow;
+            while (d > 0 && n % 10 == 0) {
+                n /= 10;
+                d--;
+            }
+        }
+    }
+    else
+    {
+        d = ddigs;
+        if (d > EDOUBLE2STR_MAX_DIGS) d = EDOUBLE2STR_MAX_DIGS;
+        scaled = x * edouble2str_pow10d[d];
+        if (scaled > EDOUBLE2STR_MAX_SCALED || scaled < -EDOUBLE2STR_MAX_SCALED) {
+            goto slow;
+        }
+        n = edouble2str_round(x, d);
+    }
+
+    /* Sign. Number which rounds to zero is written without it.
+     */
+    if (n < 0) {
+        if (dst >= e) return OS_NULL;
+        *(dst++) = '-';
+        n = -n;
+    }
+
+    /* Integer part, decimal point and fraction zero padded to d digits.
+     */
+    ip = n / edouble2str_pow10l[d];
+    dst = eint2str(dst, ip, e - dst);
+    if (dst == OS_NULL || d == 0) return dst;
+
+    if (dst >= e) return OS_NULL;
+    *(dst++) = '.';
+    return eint2str(dst, n - ip * edouble2str_pow10l[d], e - dst, d, '0');
+
+slow:
+    if (ddigs < 0) ddigs = EVARP_DEFAULT_DIGS;
+    bytes = osal_double_to_str(nbuf, sizeof(nbuf), x, ddigs, OSAL_FLOAT_DEFAULT) - 1;
+    for (i = 0; i < bytes; i++) {
+        if (dst >= e) return OS_NULL;
+        *(dst++) = nbuf[i];
+    }
+    return dst;
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Round number scaled by power of ten to integer.
+
+  The edouble2str_round() function multiplies x by 10^d and rounds to nearest integer, exact
+  halfway away from zero. The product is rounded to double, so it may be exactly k + 0.5
+  although x is slightly below or above the halfway value: 2.675 * 100 gives 267.5, while
+  the double 2.675 is 2.67499999... In that case exact error of the product is calculated
+  with Dekker's two product and tells which way to round. This needs no math library and
+  costs nothing for other values.
+
+  @param   x Value to round, |x * 10^d| must be below EDOUBLE2STR_MAX_SCALED.
+  @param   d Number of decimal digits, 0 ... EDOUBLE2STR_MAX_DIGS.
+  @return  Rounded integer.
+
+****************************************************************************************************
+*/
+static os_long edouble2str_round(
+    os_double x,
+    os_int d)
+{
+    const os_double split = 134217729.0; /* 2^27 + 1 */
+    os_double p, scaled, f, err, xh, xl, ph, pl;
+    os_long n;
+
+    p = edouble2str_pow10d[d];
+    scaled = x * p;
+    n = (os_long)(scaled < 0 ? scaled - 0.5 : scaled + 0.5);
+
+    /* Fraction is exact, since scaled is below 2^52.
+     */
+    f = scaled - (os_double)(os_long)scaled;
+    if (f != 0.5 && f != -0.5) return n;
+
+    /* Split x and p into halves, so that partial products are exact, and get the
+       rounding error of x * p.
+     */
+    xh = split * x;
+    xh = xh - (xh - x);
+    xl = x - xh;
+    ph = split * p;
+    ph = ph - (ph - p);
+    pl = p - ph;
+    err = ((xh * ph - scaled) + xh * pl + xl * ph) + xl * pl;
+
+    if (err == 0.0) return n;
+    if (scaled > 0) return err < 0 ? n - 1 : n;
+    return err > 0 ? n + 1 : n;
+}
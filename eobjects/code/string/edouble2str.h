@@ -0,0 +1,42 @@
+/**
+
+  @file    edouble2str.h
+  @brief   Convert floating point number to string without memory allocation.
+  @author  Pekka Lehtikoski
+  @version 1.0
+  @date    18.10.2026
+
+  Copyright 2020 Pekka Lehtikoski. This file is part of the eobjects project and shall only be used,
+  modified, and distributed under the terms of the project licensing. By continuing to use, modify,
+  or distribute this file you indicate that you have read the license and understand and accept
+  it fully.
+
+****************************************************************************************************
+*/
+#pragma once
+#ifndef EDOUBLE2STR_H_
+#define EDOUBLE2STR_H_
+#include "eobjects.h"
+
+/* Give as ddigs argument to edouble2str() to get shortest string which reads back as the
+   same double value.
+ */
+#define EDOUBLE2STR_SHORTEST -1
+
+/* Maximum number of digits after decimal point.
+ */
+#define EDOUBLE2STR_MAX_DIGS 15
+
+/* Buffer size large enough for any number formatted by edouble2str().
+ */
+#define EDOUBLE2STR_BUF_SZ 64
+
+/* Convert double to string, without terminating the string.
+ */
+os_char *edouble2str(
+    os_char *dst,
+    os_double x,
+    os_memsz max_chars,
+    os_int ddigs = EDOUBLE2STR_SHORTEST);
+
+#endif
@@ -0,0 +1,284 @@
+/**
+
+  @file    estrintern.cpp
+  @brief   Process wide table of interned strings.
+  @author  Pekka Lehtikoski
+  @version 1.0
+  @date    18.10.2026
+
+  Interned strings are kept in hash table in global structure. The table and reference counts
+  are protected by own mutex, a string can be shared by variables of different threads.
+
+  Copyright 2020 Pekka Lehtikoski. This file is part of the eobjects project and shall only be used,
+  modified, and distributed under the terms of the project licensing. By continuing to use, modify,
+  or distribute this file you indicate that you have read the license and understand and accept
+  it fully.
+
+****************************************************************************************************
+*/
+#include "eobjects.h"
+
+/* Forward referred static functions.
+ */
+static void estrintern_grow();
+
+/* Interned string table has own lock, so that strings can be interned and released without
+   os_lock(), which is held long by threads working on the object tree. No other eobjects
+   lock is taken while this lock is held, so it can be used with or without os_lock() on.
+ */
+#define estrintern_lock() osal_mutex_lock(eglobal->strintern_lock)
+#define estrintern_unlock() osal_mutex_unlock(eglobal->strintern_lock)
+
+
+/**
+****************************************************************************************************
+
+  @brief Create lock for interned string table.
+
+  The estrintern_initialize() function is called by eobjects_initialize() before any string
+  is interned.
+
+****************************************************************************************************
+*/
+void estrintern_initialize()
+{
+    eglobal->strintern_lock = osal_mutex_create();
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Calculate hash of a string.
+
+  The estrintern_hash() function calculates 32 bit FNV-1a hash of the string.
+
+  @param   str Pointer to string.
+  @param   nchars Number of characters, not including terminating NULL character.
+  @return  Hash value.
+
+****************************************************************************************************
+*/
+os_uint estrintern_hash(
+    const os_char *str,
+    os_memsz nchars)
+{
+    os_uint h = 2166136261U;
+
+    while (nchars-- > 0) {
+        h ^= (os_uchar)*(str++);
+        h *= 16777619U;
+    }
+    return h;
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Get interned string.
+
+  The estrintern() function looks for string from interned string table. If found, reference
+  is added to it and it is returned. If not found and add_new is set, the string is added to
+  the table with reference count 1.
+
+  @param   str String to look for. OS_NULL is same as empty string.
+  @param   nchars Number of characters, not including terminating NULL character. -1 if string
+           is NULL terminated.
+  @param   add_new OS_TRUE to add string if not found, OS_FALSE to only look for existing one.
+  @return  Pointer to interned string, release with estrintern_release(). OS_NULL if string was
+           not found and add_new is OS_FALSE.
+
+****************************************************************************************************
+*/
+eInternedStr *estrintern(
+    const os_char *str,
+    os_memsz nchars,
+    os_boolean add_new)
+{
+    eInternedStr *s;
+    os_memsz allocated;
+    os_uint hash;
+
+    if (str == OS_NULL) str = osal_str_empty;
+    if (nchars < 0) nchars = os_strlen(str) - 1;
+    hash = estrintern_hash(str, nchars);
+
+    estrintern_lock();
+    if (eglobal->strintern_table)
+    {
+        for (s = eglobal->strintern_table[hash & (eglobal->strintern_nbuckets - 1)];
+             s; s = s->next)
+        {
+            if (s->hash == hash && s->sz == nchars + 1 &&
+                !os_strncmp(s->str, str, nchars))
+            {
+                s->refcnt++;
+                estrintern_unlock();
+                return s;
+            }
+        }
+    }
+
+    if (!add_new) {
+        estrintern_unlock();
+        return OS_NULL;
+    }
+
+    if (eglobal->strintern_count >= 2 * eglobal->strintern_nbuckets) {
+        estrintern_grow();
+    }
+
+    s = (eInternedStr*)os_malloc((os_memsz)offsetof(eInternedStr, str) + nchars + 1,
+        &allocated);
+    s->hash = hash;
+    s->refcnt = 1;
+    s->sz = nchars + 1;
+    s->allocated = allocated;
+    os_memcpy(s->str, str, nchars);
+    s->str[nchars] = '\0';
+
+    s->next = eglobal->strintern_table[hash & (eglobal->strintern_nbuckets - 1)];
+    eglobal->strintern_table[hash & (eglobal->strintern_nbuckets - 1)] = s;
+    eglobal->strintern_count++;
+    estrintern_unlock();
+    return s;
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Add reference to interned string.
+
+  The estrintern_addref() function is called when interned string is copied.
+
+  @param   s Pointer to interned string.
+  @return  None.
+
+****************************************************************************************************
+*/
+void estrintern_addref(
+    eInternedStr *s)
+{
+    estrintern_lock();
+    s->refcnt++;
+    estrintern_unlock();
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Release reference to interned string.
+
+  The estrintern_release() function decrements reference count. When last reference is released,
+  the string is removed from the table and freed.
+
+  @param   s Pointer to interned string.
+  @return  None.
+
+****************************************************************************************************
+*/
+void estrintern_release(
+    eInternedStr *s)
+{
+    eInternedStr **p;
+
+    estrintern_lock();
+    if (--(s->refcnt) > 0) {
+        estrintern_unlock();
+        return;
+    }
+
+    p = eglobal->strintern_table + (s->hash & (eglobal->strintern_nbuckets - 1));
+    while (*p) {
+        if (*p == s) {
+            *p = s->next;
+            eglobal->strintern_count--;
+            break;
+        }
+        p = &(*p)->next;
+    }
+    estrintern_unlock();
+
+    os_free(s, s->allocated);
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Free interned string table at shutdown.
+
+  The estrintern_shutdown() function should be called when all threads except current one have
+  been terminated. Strings still in table are freed, no variable may refer to those anymore.
+
+****************************************************************************************************
+*/
+void estrintern_shutdown()
+{
+    eInternedStr *s, *next_s;
+    os_int i;
+
+    if (eglobal->strintern_table)
+    {
+        for (i = 0; i < eglobal->strintern_nbuckets; i++) {
+            for (s = eglobal->strintern_table[i]; s; s = next_s) {
+                next_s = s->next;
+                os_free(s, s->allocated);
+            }
+        }
+
+        os_free(eglobal->strintern_table, eglobal->strintern_nbuckets * sizeof(eInternedStr*));
+        eglobal->strintern_table = OS_NULL;
+        eglobal->strintern_nbuckets = 0;
+        eglobal->strintern_count = 0;
+    }
+
+    if (eglobal->strintern_lock)
+    {
+        osal_mutex_delete(eglobal->strintern_lock);
+        eglobal->strintern_lock = OS_NULL;
+    }
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Allocate or grow hash table.
+
+  The estrintern_grow() function allocates hash table when first string is interned, and
+  doubles number of buckets when the table gets crowded. Interned string table must be
+  locked.
+
+****************************************************************************************************
+*/
+static void estrintern_grow()
+{
+    eInternedStr **table, *s, *next_s;
+    os_int nbuckets, i;
+    os_memsz sz;
+
+    nbuckets = eglobal->strintern_nbuckets
+        ? 2 * eglobal->strintern_nbuckets : ESTRINTERN_INITIAL_NBUCKETS;
+    sz = nbuckets * sizeof(eInternedStr*);
+    table = (eInternedStr**)os_malloc(sz, OS_NULL);
+    os_memclear(table, sz);
+
+    if (eglobal->strintern_table)
+    {
+        for (i = 0; i < eglobal->strintern_nbuckets; i++) {
+            for (s = eglobal->strintern_table[i]; s; s = next_s) {
+                next_s = s->next;
+                s->next = table[s->hash & (nbuckets - 1)];
+                table[s->hash & (nbuckets - 1)] = s;
+            }
+        }
+        os_free(eglobal->strintern_table, eglobal->strintern_nbuckets * sizeof(eInternedStr*));
+    }
+
+    eglobal->strintern_table = table;
+    eglobal->strintern_nbuckets = nbuckets;
+}
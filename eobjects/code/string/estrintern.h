@@ -0,0 +1,112 @@
+/**
+
+  @file    estrintern.h
+  @brief   Process wide table of interned strings.
+  @author  Pekka Lehtikoski
+  @version 1.0
+  @date    18.10.2026
+
+  Interned string is stored only once per process. It is reference counted and has precomputed
+  hash and size, so two interned strings are equal only if they are the same pointer, and
+  copying one never allocates memory. Used for object names, matrix column names and
+  enumeration like values.
+
+  Copyright 2020 Pekka Lehtikoski. This file is part of the eobjects project and shall only be used,
+  modified, and distributed under the terms of the project licensing. By continuing to use, modify,
+  or distribute this file you indicate that you have read the license and understand and accept
+  it fully.
+
+****************************************************************************************************
+*/
+#pragma once
+#ifndef ESTRINTERN_H_
+#define ESTRINTERN_H_
+#include "eobjects.h"
+
+/* Initial number of hash buckets. Table size is doubled when average chain grows longer
+   than two.
+ */
+#define ESTRINTERN_INITIAL_NBUCKETS 256
+
+
+/**
+****************************************************************************************************
+  Interned string. The string is allocated as part of the structure, str[] continues past
+  end of the structure.
+****************************************************************************************************
+*/
+typedef struct eInternedStr
+{
+    /** Next string in same hash bucket.
+     */
+    struct eInternedStr *next;
+
+    /** Hash of the string.
+     */
+    os_uint hash;
+
+    /** Reference count.
+     */
+    os_int refcnt;
+
+    /** String size in bytes, including terminating NULL character.
+     */
+    os_memsz sz;
+
+    /** Bytes allocated for the structure.
+     */
+    os_memsz allocated;
+
+    /** String content.
+     */
+    os_char str[1];
+}
+eInternedStr;
+
+
+/**
+****************************************************************************************************
+  Functions
+****************************************************************************************************
+*/
+
+/* Calculate hash of a string.
+ */
+os_uint estrintern_hash(
+    const os_char *str,
+    os_memsz nchars);
+
+/* Create lock for interned string table at initialization.
+ */
+void estrintern_initialize();
+
+/* Get interned string, add new one if not found and add_new is set.
+ */
+eInternedStr *estrintern(
+    const os_char *str,
+    os_memsz nchars = -1,
+    os_boolean add_new = OS_TRUE);
+
+/* Add reference to interned string.
+ */
+void estrintern_addref(
+    eInternedStr *s);
+
+/* Release reference to interned string, free the string when last reference is released.
+ */
+void estrintern_release(
+    eInternedStr *s);
+
+/* Free interned string table and lock at shutdown.
+ */
+void estrintern_shutdown();
+
+/* Get interned string structure from pointer to it's content.
+ */
+inline eInternedStr *estrintern_get(
+    const os_char *str)
+{
+    return (eInternedStr*)(str - offsetof(eInternedStr, str));
+}
+
+#endif
@@ -58,6 +58,7 @@ eThread::eThread(
      */
     m_message_queue = new eContainer(OS_NULL, EOID_INTERNAL, EOBJ_TEMPORARY_ATTACHMENT);
 
+    m_binding_channels = OS_NULL;
     m_exit_requested = OS_FALSE;
 }
 
@@ -155,6 +156,10 @@ void eThread::onmessage(
             case ECMD_EXIT_THREAD:
                 m_exit_requested = OS_TRUE;
                 return;
+
+            case ECMD_FWRD_BATCH:
+                eBindingChannel::receive(this, envelope);
+                return;
         }
     }
 
@@ -297,7 +302,8 @@ void eThread::queue(
   @brief Process messages.
 
   The alive function processed messages incoming to thread. It takes a message
-  item at a time and and forwards those.
+  item at a time and and forwards those. When all messages have been processed, property
+  values collected by binding channels are sent.
 
   @return None.
 
@@ -329,9 +335,15 @@ void eThread::alive(
         }
         os_unlock();
 
-        /* If no message, do nothing more.
+        /* If no message, send batched binding updates and return.
          */
-        if (envelope == OS_NULL) return;
+        if (envelope == OS_NULL)
+        {
+            if (m_binding_channels) {
+                flush_bindingchannels();
+            }
+            return;
+        }
 
         /* Call message processing.
          */
@@ -342,3 +354,64 @@ void eThread::alive(
         delete envelope;
     }
 }
+
+
+/**
+****************************************************************************************************
+
+  @brief Get binding channel to remote thread.
+
+  The eThread::bindingchannel function returns binding channel, which collects values of
+  batched property bindings to remote thread. Channel is created when needed for the first
+  time.
+
+  @param  path Path to remote thread.
+  @return Pointer to binding channel.
+
+****************************************************************************************************
+*/
+eBindingChannel *eThread::bindingchannel(
+    const os_char *path)
+{
+    eBindingChannel *channel;
+
+    if (m_binding_channels == OS_NULL)
+    {
+        m_binding_channels = new eContainer(this, EOID_INTERNAL, EOBJ_IS_ATTACHMENT);
+        m_binding_channels->ns_create();
+    }
+
+    channel = eBindingChannel::cast(m_binding_channels->byname(path));
+    if (channel == OS_NULL)
+    {
+        channel = new eBindingChannel(m_binding_channels);
+        channel->addname(path);
+        channel->set_path(path);
+    }
+    return channel;
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Send values collected by binding channels.
+
+  The eThread::flush_bindingchannels function is called by alive() when thread has processed
+  all received messages.
+
+  @return None.
+
+****************************************************************************************************
+*/
+void eThread::flush_bindingchannels()
+{
+    eObject *o;
+
+    for (o = m_binding_channels->first(); o; o = o->next())
+    {
+        if (o->classid() == ECLASSID_BINDING_CHANNEL) {
+            eBindingChannel::cast(o)->flush();
+        }
+    }
+}
@@ -144,9 +144,18 @@ public:
     void alive(
         os_int flags = EALIVE_WAIT_FOR_EVENT);
 
+    /* Get binding channel to remote thread, create if it doesn't exist.
+     */
+    eBindingChannel *bindingchannel(
+        const os_char *path);
+
 
 protected:
 
+    /* Send values collected by binding channels.
+     */
+    void flush_bindingchannels();
+
     /**
     ************************************************************************************************
       Member variables.
@@ -161,6 +170,10 @@ protected:
      */
     eContainer *m_message_queue;
 
+    /* Binding channels to remote threads named by path, OS_NULL if none.
+     */
+    eContainer *m_binding_channels;
+
     /* Exit requested
      */
     os_boolean m_exit_requested;
@@ -441,9 +441,14 @@ void eVariable::clear()
            buffer.
          */
         case OS_STR:
-            /* If separate string buffer has been allocated.
+            /* If interned string, release reference. Otherwise if separate string buffer
+               has been allocated, free it.
              */
-            if (m_vflags & EVAR_STRBUF_ALLOCATED)
+            if (m_vflags & EVAR_STR_INTERNED)
+            {
+                estrintern_release(estrintern_get(m_value.strptr.ptr));
+            }
+            else if (m_vflags & EVAR_STRBUF_ALLOCATED)
             {
                 os_free(m_value.strptr.ptr, m_value.strptr.allocated);
             }
@@ -473,7 +478,7 @@ void eVariable::clear()
      */
     settype(OS_UNDEFINED_TYPE);
     m_value.valbuf.tmpstr = OS_NULL;
-    m_vflags &= ~EVAR_STRBUF_ALLOCATED;
+    m_vflags &= ~(EVAR_STRBUF_ALLOCATED|EVAR_STR_INTERNED);
 }
 
 
@@ -660,6 +665,68 @@ void eVariable::sets(
 }
 
 
+/**
+****************************************************************************************************
+
+  @brief Set interned string value to variable.
+
+  The setis() function sets string value to variable as interned string, see estrintern.h.
+  The string content is shared by all variables with the same interned value: Copying the
+  value with setv() doesn't allocate memory and compare() can tell equal strings by pointer.
+  Use for names, column names and enumeration like values, which repeat often.
+
+  @param   x Value to set. OS_NULL is same as empty string.
+  @param   add_new OS_TRUE to add string to interned string table if not there already.
+           OS_FALSE to set interned string only if one exists, otherwise plain string is set.
+  @return  None.
+
+****************************************************************************************************
+*/
+void eVariable::setis(
+    const os_char *x,
+    os_boolean add_new)
+{
+    eInternedStr *s;
+    os_int change;
+
+    s = estrintern(x, -1, add_new);
+    if (s == OS_NULL) {
+        sets(x);
+        return;
+    }
+
+    /* Check if the new value is different from the old one.
+     */
+    if (type() == OS_STR)
+    {
+        if ((m_vflags & EVAR_STR_INTERNED) && m_value.strptr.ptr == s->str) {
+            estrintern_release(s);
+            return;
+        }
+        change = os_strcmp(s->str, (m_vflags & EVAR_STRBUF_ALLOCATED)
+            ? m_value.strptr.ptr : m_value.strbuf.buf);
+    }
+    else {
+        change = OS_TRUE;
+    }
+
+    /* Release any allocated memory and set pointer to interned string content.
+     */
+    clear();
+    m_value.strptr.ptr = s->str;
+    m_value.strptr.used = s->sz;
+    m_value.strptr.allocated = 0;
+    m_vflags |= EVAR_STRBUF_ALLOCATED|EVAR_STR_INTERNED;
+    settype(OS_STR);
+
+    /* Inform parent object that a variable value was changed.
+     */
+    if (change && (m_vflags & EVAR_NOSAVE) == 0) {
+        docallback(ECALLBACK_VARIABLE_VALUE_CHANGED);
+    }
+}
+
+
 /**
 ****************************************************************************************************
 
@@ -696,7 +763,7 @@ void eVariable::setv(
 
     if (srctype == OS_STR && oldtype == OS_STR)
     {
-        /* Check if the new string is same as old one. .
+        /* Check if the new string is same as old one. Same interned string is the same pointer.
          */
         oldstr = (m_vflags & EVAR_STRBUF_ALLOCATED) ? m_value.strptr.ptr : m_value.strbuf.buf;
         newstr = (x->m_vflags & EVAR_STRBUF_ALLOCATED) ? x->m_value.strptr.ptr : x->m_value.strbuf.buf;
@@ -722,9 +789,29 @@ void eVariable::setv(
         case OS_STR:
             clear();
 
+            /* If interned string, share it. Copying only adds reference.
+             */
+            if (x->m_vflags & EVAR_STR_INTERNED)
+            {
+                m_value.strptr.ptr = x->m_value.strptr.ptr;
+                m_value.strptr.used = x->m_value.strptr.used;
+                m_value.strptr.allocated = 0;
+                m_vflags |= EVAR_STRBUF_ALLOCATED|EVAR_STR_INTERNED;
+
+                if (move_value)
+                {
+                    x->settype(OS_UNDEFINED_TYPE);
+                    x->m_vflags &= ~(EVAR_STRBUF_ALLOCATED|EVAR_STR_INTERNED);
+                }
+                else
+                {
+                    estrintern_addref(estrintern_get(m_value.strptr.ptr));
+                }
+            }
+
             /* If separate string buffer has been allocated.
              */
-            if (x->m_vflags & EVAR_STRBUF_ALLOCATED)
+            else if (x->m_vflags & EVAR_STRBUF_ALLOCATED)
             {
                 if (move_value)
                 {
@@ -1084,10 +1171,9 @@ os_double eVariable::getd()
 os_char *eVariable::gets(
     os_memsz *sz)
 {
-    os_char *str, *vstr, buf[64];
+    os_char *str, *vstr, buf[EVARIABLE_NBUF_SZ];
     eValueX *ex;
     os_memsz vsz;
-    os_int di;
 
     switch (type())
     {
@@ -1135,16 +1221,8 @@ os_char *eVariable::gets(
     switch (type())
     {
         case OS_LONG:
-            vsz = osal_int_to_str(buf, sizeof(buf), m_value.valbuf.v.l);
-            break;
-
         case OS_DOUBLE:
-            di = digs();
-            if (di == EVARP_DIGS_UNDEFINED) {
-                di = EVARP_DEFAULT_DIGS;
-            }
-            vsz = osal_double_to_str(buf, sizeof(buf),
-                m_value.valbuf.v.d, di, OSAL_FLOAT_DEFAULT);
+            gets_buf(buf, sizeof(buf), &vsz);
             break;
 
         case OS_OBJECT:
@@ -1188,6 +1266,67 @@ getout:
 }
 
 
+/**
+****************************************************************************************************
+
+  @brief Get variable value as string without allocating memory.
+
+  The gets_buf() function is like gets(), but integer and floating point values are formatted
+  into buffer given as argument, and temporary string buffer of the variable is not touched.
+  Use when values are converted to text repeatedly, like when drawing table cells.
+  String value is returned as pointer to variable's own string, like gets() does.
+
+  @param   buf Buffer for formatted number, EVARIABLE_NBUF_SZ bytes is always enough.
+  @param   buf_sz Buffer size in bytes.
+  @param   sz Pointer to integer where to store number of bytes in returned string,
+           including terminating NULL character. OS_NULL if not needed.
+  @return  Pointer to variable value as string. Valid until variable value is modified,
+           or buf goes out of scope.
+
+****************************************************************************************************
+*/
+const os_char *eVariable::gets_buf(
+    os_char *buf,
+    os_memsz buf_sz,
+    os_memsz *sz)
+{
+    eValueX *ex;
+    os_char *e;
+    os_int di;
+
+    switch (type())
+    {
+        case OS_LONG:
+            e = eint2str(buf, m_value.valbuf.v.l, buf_sz - 1);
+            break;
+
+        case OS_DOUBLE:
+            di = digs();
+            if (di == EVARP_DIGS_UNDEFINED) {
+                di = EVARP_DEFAULT_DIGS;
+            }
+            e = edouble2str(buf, m_value.valbuf.v.d, buf_sz - 1, di);
+            break;
+
+        case OS_OBJECT:
+            ex = getx();
+            if (ex) return ex->gets_buf(buf, buf_sz, sz);
+            return gets(sz);
+
+        default:
+            return gets(sz);
+    }
+
+    /* Buffer is too small, use temporary string buffer.
+     */
+    if (e == OS_NULL) return gets(sz);
+
+    *e = '\0';
+    if (sz) *sz = e - buf + 1;
+    return buf;
+}
+
+
 /**
 ****************************************************************************************************
 
@@ -1514,6 +1653,13 @@ os_int eVariable::compare(
             switch (y->type())
             {
                 case OS_STR:
+                    /* Same interned string, no need to compare content.
+                     */
+                    if ((x->m_vflags & y->m_vflags & EVAR_STR_INTERNED) &&
+                        x->m_value.strptr.ptr == y->m_value.strptr.ptr)
+                    {
+                        break;
+                    }
                     rval = os_strcmp(y->gets(), x->gets());
                     break;
 
@@ -1685,6 +1831,42 @@ os_boolean eVariable::autotype(
 }
 
 
+/**
+****************************************************************************************************
+
+  @brief Convert string value to interned string.
+
+  The eVariable::intern() function replaces string value of the variable with interned string,
+  see setis(). Variable value doesn't change, so no callback is generated. If variable doesn't
+  contain a string or the string is interned already, the function does nothing.
+
+  @return  None.
+
+****************************************************************************************************
+*/
+void eVariable::intern()
+{
+    eInternedStr *s;
+
+    if (type() != OS_STR || (m_vflags & EVAR_STR_INTERNED)) return;
+
+    if (m_vflags & EVAR_STRBUF_ALLOCATED)
+    {
+        s = estrintern(m_value.strptr.ptr, m_value.strptr.used - 1);
+        os_free(m_value.strptr.ptr, m_value.strptr.allocated);
+    }
+    else
+    {
+        s = estrintern(m_value.strbuf.buf, m_value.strbuf.used - 1);
+    }
+
+    m_value.strptr.ptr = s->str;
+    m_value.strptr.used = s->sz;
+    m_value.strptr.allocated = 0;
+    m_vflags |= EVAR_STRBUF_ALLOCATED|EVAR_STR_INTERNED;
+}
+
+
 /**
 ****************************************************************************************************
 
@@ -1985,9 +2167,15 @@ void eVariable::appends_nbytes(
     if (str) os_memcpy(newval + (used - 1), str, nchars);
     newval[n-1] = '\0';
 
-    /* If we need to delete old buffer.
+    /* If we need to delete old buffer. Interned string is never modified, release reference
+       to it (allocated is zero, so we always get here).
      */
-    if (m_vflags & EVAR_STRBUF_ALLOCATED)
+    if (m_vflags & EVAR_STR_INTERNED)
+    {
+        estrintern_release(estrintern_get(m_value.strptr.ptr));
+        m_vflags &= ~EVAR_STR_INTERNED;
+    }
+    else if (m_vflags & EVAR_STRBUF_ALLOCATED)
     {
         os_free(m_value.strptr.ptr, m_value.strptr.allocated);
     }
@@ -2064,6 +2252,8 @@ void eVariable::singleline()
     os_memsz used;
 
     if (type() != OS_STR) return;
+    if (os_strchr(gets(), '\n') == OS_NULL) return;
+    unintern();
 
     if (m_vflags & EVAR_STRBUF_ALLOCATED) {
         p = m_value.strptr.ptr;
@@ -2073,7 +2263,6 @@ void eVariable::singleline()
         p = m_value.strbuf.buf;
         used = m_value.strbuf.used;
     }
-    if (os_strchr(p, '\n') == OS_NULL) return;
 
     while ((q = os_strstr(p, "-\n", OSAL_STRING_DEFAULT))) {
         os_memmove(q, q + 2, used - (q - p));
@@ -2111,6 +2300,7 @@ void eVariable::tolower()
     os_uchar c;
 
     if (type() != OS_STR) return;
+    unintern();
 
     if (m_vflags & EVAR_STRBUF_ALLOCATED) {
         p = m_value.strptr.ptr;
@@ -2179,6 +2369,7 @@ os_boolean eVariable::clean_to_append_oix()
     os_char *path;
 
     if (type() != OS_STR) return OS_FALSE;
+    unintern();
 
     /* If separate string buffer has been allocated.
      */
@@ -2243,6 +2434,43 @@ os_boolean eVariable::clean_to_append_oix()
 }
 
 
+/**
+****************************************************************************************************
+
+  @brief Make private copy of interned string.
+
+  The eVariable::unintern_internal() function is called trough unintern() by functions which
+  modify string value in place. Interned string is copied to variable's own buffer and
+  reference to it is released.
+
+****************************************************************************************************
+*/
+void eVariable::unintern_internal()
+{
+    eInternedStr *s;
+    os_memsz n;
+
+    s = estrintern_get(m_value.strptr.ptr);
+    n = s->sz;
+
+    if (n <= EVARIABLE_STRBUF_SZ)
+    {
+        os_memcpy(m_value.strbuf.buf, s->str, n);
+        m_value.strbuf.used = (os_uchar)n;
+        m_vflags &= ~(EVAR_STRBUF_ALLOCATED|EVAR_STR_INTERNED);
+    }
+    else
+    {
+        m_value.strptr.ptr = os_malloc(n, &m_value.strptr.allocated);
+        os_memcpy(m_value.strptr.ptr, s->str, n);
+        m_value.strptr.used = n;
+        m_vflags &= ~EVAR_STR_INTERNED;
+    }
+
+    estrintern_release(s);
+}
+
+
 /**
 ****************************************************************************************************
 
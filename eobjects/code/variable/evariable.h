@@ -21,6 +21,7 @@
 #include "eobjects.h"
 
 class eValueX;
+struct eInternedStr;
 
 /**
 ****************************************************************************************************
@@ -33,6 +34,10 @@ class eValueX;
  */
 #define EVARIABLE_STRBUF_SZ ((os_memsz)(sizeof(os_memsz)*2 + sizeof(os_char*) - sizeof(os_uchar)))
 
+/** Buffer size for gets_buf(), enough for any integer or floating point value.
+ */
+#define EVARIABLE_NBUF_SZ EDOUBLE2STR_BUF_SZ
+
 /* Variable property numbers. Avoid changing these numbers, used by derived and other classess.
  */
 #define EVARP_VALUE 1
@@ -100,6 +105,11 @@ extern const os_char
 #define EVAR_NOSAVE      0x0400
 #define EVAR_STRBUF_ALLOCATED 0x2000
 
+/* String value is interned string, see estrintern.h. Set together with EVAR_STRBUF_ALLOCATED,
+   strptr.ptr points to shared string content and strptr.allocated is zero.
+ */
+#define EVAR_STR_INTERNED 0x1000
+
 /* Serialize type and number of decimal digits in flags.
  */
 #define EVAR_SERIALIZATION_MASK 0x03FF
@@ -261,6 +271,12 @@ public:
         const os_char *x,
         os_memsz max_chars = -1);
 
+    /* Set interned string value to variable.
+     */
+    void setis(
+        const os_char *x,
+        os_boolean add_new = OS_TRUE);
+
     /* Copy or move variable value from another variable.
      */
     void setv(
@@ -316,6 +332,13 @@ public:
      */
     void gets_free();
 
+    /* Get variable value as string, numbers are formatted into buffer given as argument.
+     */
+    const os_char *gets_buf(
+        os_char *buf,
+        os_memsz buf_sz,
+        os_memsz *sz = OS_NULL);
+
     /* Get pointer to object contained by variable.
      */
     eObject *geto();
@@ -384,6 +407,15 @@ public:
         eObject *xx,
         os_int flags = 0);
 
+    /* Convert string value to interned string.
+     */
+    void intern();
+
+    /** Check if variable value is interned string.
+     */
+    inline os_boolean isinterned()
+        {return (m_vflags & EVAR_STR_INTERNED) ? OS_TRUE : OS_FALSE; }
+
     /* Remove white space from beginning and end of string values.
      */
     void removeblancs();
@@ -490,6 +522,15 @@ protected:
         if (tmpstrallocated()) gets_free();
     }
 
+    /** Make private copy of interned string before modifying it in place.
+     */
+    inline void unintern()
+    {
+        if (m_vflags & EVAR_STR_INTERNED) unintern_internal();
+    }
+
+    void unintern_internal();
+
     os_int sbits_internal();
     os_long tstamp_internal();
 
@@ -69,7 +69,9 @@ void eobjects_shutdown();
 #include "code/syncmsg/esyncconnector.h"
 #include "code/syncmsg/esynchronized.h"
 #include "code/binding/ebinding.h"
+#include "code/binding/ebindingchannel.h"
 #include "code/binding/epropertybinding.h"
+#include "code/envelope/epathdict.h"
 #include "code/envelope/eenvelope.h"
 #include "code/table/ewhere.h"
 #include "code/table/erange.h"
@@ -80,6 +82,7 @@ void eobjects_shutdown();
 #include "code/table/edbm.h"
 #include "code/table/etablemessages.h"
 #include "code/matrix/ematrix.h"
+#include "code/bitmap/ebitmap_pool.h"
 #include "code/bitmap/ebitmap.h"
 #include "code/thread/ethreadhandle.h"
 #include "code/thread/ethread.h"
@@ -88,19 +91,26 @@ void eobjects_shutdown();
 #include "code/global/eprocess.h"
 #include "code/global/elogindata.h"
 #include "code/global/eglobal.h"
+#include "code/stream/ecompress.h"
 #include "code/stream/estream.h"
 #include "code/stream/equeue.h"
 #include "code/stream/ebufferedstream.h"
 #include "code/stream/eosstream.h"
 #include "code/stream/ebuffer.h"
+#include "code/object/ejsonreader.h"
 #include "code/fsys/efilesystem.h"
+#include "code/fsys/efilewriter.h"
 #include "code/fsys/edirectory.h"
+#include "code/bitmap/ebitmapcodec.h"
 #include "code/connection/econnection.h"
+#include "code/connection/econnectionworker.h"
 #include "code/connection/eendpoint.h"
 #include "code/helpers/etypeenum_helpers.h"
 #include "code/helpers/eliststr_helpers.h"
 #include "code/helpers/eobjflags_helpers.h"
 #include "code/string/eint2str.h"
+#include "code/string/edouble2str.h"
+#include "code/string/estrintern.h"
 #include "code/main/emain.h"
 
 #endif
@@ -18,6 +18,7 @@
 #define EIO_H_
 #include "extensions/netservice/enetservice.h"
 #include "extensions/io/eio_defs.h"
+#include "extensions/io/eio_history.h"
 #include "extensions/io/eio_signal.h"
 #include "extensions/io/eio_variable.h"
 #include "extensions/io/eio_mblk.h"
@@ -28,5 +29,6 @@
 #include "extensions/io/eio_device.h"
 #include "extensions/io/eio_network.h"
 #include "extensions/io/eio_root.h"
+#include "extensions/io/eio_infocache.h"
 #include "extensions/io/eio_thread.h"
 #endif
@@ -28,6 +28,8 @@ eioBrickBuffer::eioBrickBuffer(
     : eioAssembly(parent, oid, flags)
 {
     m_output = new eVariable(this);
+    m_preview = new eVariable(this);
+    m_preview_size = EIO_BRICK_DEFAULT_PREVIEW_SIZE;
     clear_member_variables();
     initproperties();
     ns_create();
@@ -69,6 +71,10 @@ void eioBrickBuffer::setupclass()
     addpropertys(cls, EVARP_TEXT, evarp_text, "text", EPRO_PERSISTENT|EPRO_NOONPRCH);
     addpropertys(cls, EVARP_VALUE, evarp_value, "value", EPRO_SIMPLE|EPRO_NOONPRCH);
     addpropertyb(cls, EIOP_BOUND, eiop_bound, "bound", EPRO_SIMPLE|EPRO_RDONLY);
+    addpropertys(cls, EIOP_PREVIEW, eiop_preview, "preview", EPRO_SIMPLE|EPRO_NOONPRCH);
+    v = addpropertyl(cls, EIOP_PREVIEW_SIZE, eiop_preview_size, EIO_BRICK_DEFAULT_PREVIEW_SIZE,
+        "preview size", EPRO_SIMPLE);
+    v->setpropertys(EVARP_UNIT, "pixels");
     addpropertys(cls, EIOP_ASSEMBLY_TYPE, eiop_assembly_type, "assembly type", EPRO_PERSISTENT|EPRO_NOONPRCH);
     addpropertys(cls, EIOP_ASSEMBLY_EXP, eiop_assembly_exp, "exp", EPRO_PERSISTENT|EPRO_NOONPRCH);
     addpropertys(cls, EIOP_ASSEMBLY_IMP, eiop_assembly_imp, "imp", EPRO_PERSISTENT|EPRO_NOONPRCH);
@@ -109,6 +115,11 @@ eStatus eioBrickBuffer::onpropertychange(
     switch (propertynr)
     {
         case EVARP_VALUE:
+        case EIOP_PREVIEW:
+            break;
+
+        case EIOP_PREVIEW_SIZE:
+            m_preview_size = x->geti();
             break;
 
         default:
@@ -144,6 +155,14 @@ eStatus eioBrickBuffer::simpleproperty(
             x->setv(m_output);
             break;
 
+        case EIOP_PREVIEW:
+            x->setv(m_preview);
+            break;
+
+        case EIOP_PREVIEW_SIZE:
+            x->setl(m_preview_size);
+            break;
+
         default:
             return eioAssembly::simpleproperty(propertynr, x);
     }
@@ -408,12 +427,11 @@ eStatus eioBrickBuffer::get()
 {
     eBitmap *bitmap;
     iocBrickHdr *hdr;
-    os_uchar *data, *dst;
+    os_uchar *data;
     os_memsz buf_sz, data_sz;
     osalBitmapFormat format;
     os_uchar compression;
-    os_int width, height, y;
-    os_int pixel_nbytes, dst_row_nbytes, src_row_nbytes, copy_nbytes;
+    os_int width, height;
     osalStatus s;
 
     /* Setup all signals, if we have not done that already.
@@ -422,6 +440,13 @@ eStatus eioBrickBuffer::get()
         return ESTATUS_PENDING;
     }
 
+    /* If previous frame was adopted by eBitmap, give a recycled frame buffer to the brick
+       buffer to receive into.
+     */
+    if (m_brick_buffer.buf == OS_NULL && m_frame_pool) {
+        m_brick_buffer.buf = m_frame_pool->take(&m_brick_buffer.buf_alloc_sz);
+    }
+
     /* Receive data, return ESTATUS_SUCCESS if we got no data.
      */
     s = ioc_run_brick_receive(&m_brick_buffer);
@@ -445,30 +470,9 @@ eStatus eioBrickBuffer::get()
 
         if (compression == IOC_UNCOMPRESSED)
         {
-            /* Handle bitmap row alignment when copying.
-             */
-            pixel_nbytes = bitmap->pixel_nbytes();
-            dst_row_nbytes = bitmap->row_nbytes();
-            src_row_nbytes = pixel_nbytes * width;
-            if (pixel_nbytes == 3) {
-                src_row_nbytes = (src_row_nbytes + 1) / 2;
-                src_row_nbytes *= 2;
-            }
-            dst = bitmap->ptr();
-
-            if (src_row_nbytes == dst_row_nbytes) {
-                os_memcpy(dst, data, height * src_row_nbytes);
-            }
-            else {
-                copy_nbytes = dst_row_nbytes;
-                if (src_row_nbytes < copy_nbytes) copy_nbytes = src_row_nbytes;
-
-                for (y = 0; y < height; y++) {
-                    os_memcpy(dst, data, copy_nbytes);
-                    os_memclear(dst + copy_nbytes, dst_row_nbytes - copy_nbytes);
-                    dst += dst_row_nbytes;
-                    data += src_row_nbytes;
-                }
+            if (frame_to_bitmap(bitmap, data, data_sz)) {
+                delete bitmap;
+                return ESTATUS_FAILED;
             }
         }
         else if (compression & IOC_JPEG)
@@ -478,9 +482,17 @@ eStatus eioBrickBuffer::get()
         else
         {
             osal_debug_error_int("unsupported brick compression = ", compression);
+            delete bitmap;
             return ESTATUS_FAILED;
         }
 
+        /* Preview only uncompressed frames: Scaling a JPEG frame would decode it here in
+           the IO thread. JPEG frames are small already, viewers can bind to "x" instead.
+         */
+        if (compression == IOC_UNCOMPRESSED) {
+            forward_preview(bitmap);
+        }
+
         /* Set output and forward property value to bindings, if any.
          */
         m_output->seto(bitmap, OS_TRUE);
@@ -491,6 +503,130 @@ eStatus eioBrickBuffer::get()
 }
 
 
+/**
+****************************************************************************************************
+
+  @brief Forward reduced resolution preview of camera frame.
+
+  The eioBrickBuffer::forward_preview function scales the camera frame to fit within
+  "previewsize" x "previewsize" pixels and forwards it as "preview" property. Remote viewers,
+  which do not need full resolution, bind to "preview" instead of "x" and receive only a
+  fraction of the data. Nothing is done if no one is bound to the preview. Called only for
+  uncompressed frames, so no JPEG decoding is done in the IO thread.
+
+  @param   bitmap Received uncompressed camera frame.
+
+****************************************************************************************************
+*/
+void eioBrickBuffer::forward_preview(
+    eBitmap *bitmap)
+{
+    eBitmap *preview;
+
+    if (m_preview_size <= 0 || !is_bound(EIOP_PREVIEW)) {
+        return;
+    }
+
+    preview = new eBitmap(ETEMPORARY);
+    if (bitmap->scale_to_fit(preview, m_preview_size, m_preview_size)) {
+        delete preview;
+        return;
+    }
+
+    m_preview->seto(preview, OS_TRUE);
+    forwardproperty(EIOP_PREVIEW, m_preview, OS_NULL, 0);
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Move received camera frame into eBitmap.
+
+  The eioBrickBuffer::frame_to_bitmap function sets uncompressed camera frame as bitmap
+  content. If row alignment of received data matches the eBitmap, the brick receive buffer
+  is adopted by the bitmap as pooled frame buffer and no data is copied. A recycled buffer
+  is given to the brick buffer to receive the next frame. Otherwise rows are copied into
+  a pooled frame buffer.
+
+  Frame buffers are returned to the pool when the last bitmap (clones included) referring
+  to the buffer is deleted.
+
+  @param   bitmap Bitmap, allocated with EBITMAP_NO_NEW_MEMORY_ALLOCATION flag.
+  @param   data Pointer to pixel data within brick buffer.
+  @param   data_sz Pixel data size in bytes.
+  @return  ESTATUS_SUCCESS if all is fine, ESTATUS_FAILED if memory allocation failed.
+
+****************************************************************************************************
+*/
+eStatus eioBrickBuffer::frame_to_bitmap(
+    eBitmap *bitmap,
+    os_uchar *data,
+    os_memsz data_sz)
+{
+    eBitmapPoolBuf *pool_buf;
+    os_uchar *dst;
+    os_memsz bitmap_sz;
+    os_int width, height, y;
+    os_int pixel_nbytes, dst_row_nbytes, src_row_nbytes, copy_nbytes;
+
+    if (m_frame_pool == OS_NULL) {
+        m_frame_pool = new eBitmapPool();
+    }
+
+    /* Handle bitmap row alignment.
+     */
+    width = bitmap->width();
+    height = bitmap->height();
+    pixel_nbytes = bitmap->pixel_nbytes();
+    dst_row_nbytes = bitmap->row_nbytes();
+    src_row_nbytes = pixel_nbytes * width;
+    if (pixel_nbytes == 3) {
+        src_row_nbytes = (src_row_nbytes + 1) / 2;
+        src_row_nbytes *= 2;
+    }
+    bitmap_sz = (os_memsz)dst_row_nbytes * (os_memsz)height;
+
+    /* Zero copy: Take the receive buffer from brick buffer and let bitmap use it.
+     */
+    if (src_row_nbytes == dst_row_nbytes && data_sz >= bitmap_sz) {
+        pool_buf = m_frame_pool->adopt(m_brick_buffer.buf, m_brick_buffer.buf_alloc_sz);
+        if (pool_buf) {
+            bitmap->adopt_pool_buf(pool_buf, data - m_brick_buffer.buf);
+            m_brick_buffer.buf = OS_NULL;
+            m_brick_buffer.buf_sz = 0;
+            m_brick_buffer.buf_alloc_sz = 0;
+            return ESTATUS_SUCCESS;
+        }
+    }
+
+    /* Row alignment differs, copy row by row into pooled buffer.
+     */
+    pool_buf = m_frame_pool->alloc(bitmap_sz);
+    if (pool_buf == OS_NULL) {
+        return ESTATUS_FAILED;
+    }
+    dst = pool_buf->buf;
+    copy_nbytes = dst_row_nbytes;
+    if (src_row_nbytes < copy_nbytes) copy_nbytes = src_row_nbytes;
+    if ((os_memsz)src_row_nbytes * height > data_sz) {
+        height = (os_int)(data_sz / src_row_nbytes);
+        os_memclear(dst + (os_memsz)height * dst_row_nbytes,
+            bitmap_sz - (os_memsz)height * dst_row_nbytes);
+    }
+
+    for (y = 0; y < height; y++) {
+        os_memcpy(dst, data, copy_nbytes);
+        os_memclear(dst + copy_nbytes, dst_row_nbytes - copy_nbytes);
+        dst += dst_row_nbytes;
+        data += src_row_nbytes;
+    }
+
+    bitmap->adopt_pool_buf(pool_buf, 0);
+    return ESTATUS_SUCCESS;
+}
+
+
 /**
 ****************************************************************************************************
 
@@ -504,6 +640,12 @@ void eioBrickBuffer::cleanup()
 {
     ioc_release_brick_buffer(&m_brick_buffer);
 
+    /* Frame buffers still used by bitmaps are freed when released.
+     */
+    if (m_frame_pool) {
+        m_frame_pool->release();
+    }
+
     if (m_h_exp.mblk) {
         ioc_release_handle(&m_h_exp);
     }
@@ -550,6 +692,7 @@ void eioBrickBuffer::clear_member_variables()
     m_from_device = OS_TRUE;
     m_flat_buffer = OS_TRUE;
     m_is_camera = OS_FALSE;
+    m_frame_pool = OS_NULL;
 }
 
 
@@ -18,6 +18,10 @@
 #define EIO_BRICKBUF_H_
 #include "extensions/io/eio.h"
 
+/* Default maximum width and height of camera preview, pixels.
+ */
+#define EIO_BRICK_DEFAULT_PREVIEW_SIZE 320
+
 /**
 ****************************************************************************************************
   eioBrickBuffer handles "brick" data transfer to/from device.
@@ -93,6 +97,18 @@ protected:
 
     eStatus try_finalize_setup();
 
+    /* Move received camera frame into eBitmap, without copying if possible.
+     */
+    eStatus frame_to_bitmap(
+        eBitmap *bitmap,
+        os_uchar *data,
+        os_memsz data_sz);
+
+    /* Forward reduced resolution preview of uncompressed camera frame to bindings, if any.
+     */
+    void forward_preview(
+        eBitmap *bitmap);
+
     eStatus try_signal_setup(
         iocSignal *sig,
         const os_char *name,
@@ -174,6 +190,16 @@ protected:
     /** Variable holding output state.
      */
     eVariable *m_output;
+
+    /** Variable holding reduced resolution preview of the output, and maximum preview
+        width and height in pixels.
+     */
+    eVariable *m_preview;
+    os_int m_preview_size;
+
+    /** Pool of camera frame buffers, OS_NULL if not camera or no frames received yet.
+     */
+    eBitmapPool *m_frame_pool;
 };
 
 #endif
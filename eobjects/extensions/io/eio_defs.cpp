@@ -23,4 +23,13 @@ const os_char
     eiop_assembly_type[] = "atype",
     eiop_assembly_exp[] = "exp",
     eiop_assembly_imp[] = "imp",
-    eiop_assembly_timeout[] = "timeout";
+    eiop_assembly_timeout[] = "timeout",
+    eiop_nscanned[] = "nscanned",
+    eiop_nchanged[] = "nchanged",
+    eiop_history[] = "history",
+    eiop_max_latency[] = "maxlatency",
+    eiop_loop_rate[] = "looprate",
+    eiop_loop_time[] = "looptime",
+    eiop_idle[] = "idle",
+    eiop_preview[] = "preview",
+    eiop_preview_size[] = "previewsize";
@@ -26,6 +26,15 @@
 #define EIOP_ASSEMBLY_EXP 36
 #define EIOP_ASSEMBLY_IMP 37
 #define EIOP_ASSEMBLY_TIMEOUT 39
+#define EIOP_NSCANNED 40
+#define EIOP_NCHANGED 41
+#define EIOP_HISTORY 42
+#define EIOP_MAX_LATENCY 43
+#define EIOP_LOOP_RATE 44
+#define EIOP_LOOP_TIME 45
+#define EIOP_IDLE 46
+#define EIOP_PREVIEW 47
+#define EIOP_PREVIEW_SIZE 48
 
 /* Property names.
  */
@@ -35,7 +44,16 @@ extern const os_char
     eiop_assembly_type[],
     eiop_assembly_exp[],
     eiop_assembly_imp[],
-    eiop_assembly_timeout[];
+    eiop_assembly_timeout[],
+    eiop_nscanned[],
+    eiop_nchanged[],
+    eiop_history[],
+    eiop_max_latency[],
+    eiop_loop_rate[],
+    eiop_loop_time[],
+    eiop_idle[],
+    eiop_preview[],
+    eiop_preview_size[];
 
 #endif
 
@@ -30,11 +30,23 @@ eioDevice::eioDevice(
     m_mblks = m_io = m_assemblies = OS_NULL;
     m_bound = OS_FALSE;
     m_connected = OS_FALSE;
+    m_info = OS_NULL;
     initproperties();
     ns_create();
 }
 
 
+/**
+****************************************************************************************************
+  Virtual destructor.
+****************************************************************************************************
+*/
+eioDevice::~eioDevice()
+{
+    eioInfoCache::release(m_info);
+}
+
+
 /**
 ****************************************************************************************************
 
@@ -33,6 +33,10 @@ public:
         e_oid id = EOID_ITEM,
         os_int flags = EOBJ_DEFAULT);
 
+    /* Virtual destructor.
+     */
+    virtual ~eioDevice();
+
     /* Casting eObject pointer to eioDevice pointer.
      */
     inline static eioDevice *cast(
@@ -85,6 +89,12 @@ public:
     eContainer *assemblies();
     inline eContainer *mblks() {return m_mblks; }
 
+    /* Parsed info the device has been set up with, OS_NULL if none. set_info() takes
+       over caller's reference to info.
+     */
+    inline class eioInfo *info() {return m_info; }
+    inline void set_info(class eioInfo *info) {m_info = info; }
+
 protected:
     /**
     ************************************************************************************************
@@ -114,6 +124,11 @@ protected:
      */
     os_boolean m_connected;
 
+    /* Parsed info the device has been set up with, shared with other devices with
+       identical info, see eio_infocache.h.
+     */
+    class eioInfo *m_info;
+
 };
 
 #endif
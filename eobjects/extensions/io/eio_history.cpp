@@ -0,0 +1,448 @@
+/**
+
+  @file    eio_history.cpp
+  @brief   Time series history of IO variable.
+  @author  Pekka Lehtikoski
+  @version 1.0
+  @date    18.10.2026
+
+  History keeps recent raw samples of an IO variable in a ring buffer, and the same data
+  downsampled to 1 second, 1 minute and 1 hour buckets with minimum, maximum and average.
+  Each level is a fixed size ring buffer, so memory use is bounded. History query picks
+  the finest level which reaches back to start of requested time range, and merges entries
+  so that the number of returned points stays below the limit, however long the time range.
+
+  Values are stored as os_float for float and 8/16 bit integer signals, which are exact in
+  float, and as os_double otherwise.
+
+  Copyright 2020 Pekka Lehtikoski. This file is part of the eobjects project and shall only be used,
+  modified, and distributed under the terms of the project licensing. By continuing to use, modify,
+  or distribute this file you indicate that you have read the license and understand and accept
+  it fully.
+
+****************************************************************************************************
+*/
+#include "extensions/io/eio.h"
+
+/* Bucket widths of downsampled levels in microseconds: 1 second, 1 minute, 1 hour.
+ */
+static const os_long eio_history_width[EIO_HISTORY_NLEVELS] = {
+    1000000LL, 60000000LL, 3600000000LL};
+
+/* Minimum number of raw samples.
+ */
+#define EIO_HISTORY_MIN_NSAMPLES 16
+
+/* Working state of history query, rows are merged into row until time slot changes.
+ */
+typedef struct eioHistorySelect
+{
+    eMatrix *m;                 /* Result matrix. */
+    os_double row[EIO_HISTORY_NCOLUMNS]; /* Row being merged. */
+    os_double vmin, vmax, sum;  /* Minimum, maximum and sum of values in row. */
+    os_long tstart;             /* Start of the query time range. */
+    os_long slot_w;             /* Width of time slot for one row. */
+    os_long cur_slot;           /* Time slot of row being merged. */
+    os_int count;               /* Number of values in row. */
+    os_int nrows;               /* Number of rows stored in matrix. */
+    os_boolean have_row;        /* Row has data. */
+}
+eioHistorySelect;
+
+/* Forward referred static functions.
+ */
+static void eio_history_emit(
+    eioHistorySelect *sel);
+
+
+/**
+****************************************************************************************************
+
+  @brief Constructor.
+
+  @param   nsamples Number of raw samples to keep.
+  @param   type_id Signal data type, selects if values are stored as os_float or os_double.
+
+****************************************************************************************************
+*/
+eioHistory::eioHistory(
+    os_int nsamples,
+    osalTypeId type_id)
+{
+    os_int i;
+
+    switch (type_id)
+    {
+        case OS_BOOLEAN:
+        case OS_CHAR:
+        case OS_UCHAR:
+        case OS_SHORT:
+        case OS_USHORT:
+        case OS_FLOAT:
+            m_use_float = OS_TRUE;
+            m_value_sz = sizeof(os_float);
+            break;
+
+        default:
+            m_use_float = OS_FALSE;
+            m_value_sz = sizeof(os_double);
+            break;
+    }
+
+    if (nsamples < EIO_HISTORY_MIN_NSAMPLES) {
+        nsamples = EIO_HISTORY_MIN_NSAMPLES;
+    }
+    alloc_ring(m_ring, nsamples, 0);
+    for (i = 0; i < EIO_HISTORY_NLEVELS; i++) {
+        alloc_ring(m_ring + i + 1, EIO_HISTORY_NBUCKETS, eio_history_width[i]);
+    }
+    m_latest_ti = 0;
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Destructor.
+
+****************************************************************************************************
+*/
+eioHistory::~eioHistory()
+{
+    os_int i;
+
+    for (i = 0; i <= EIO_HISTORY_NLEVELS; i++) {
+        free_ring(m_ring + i);
+    }
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Add a value to history.
+
+  The eioHistory::add() function stores value as raw sample, and updates the latest bucket of
+  each downsampled level, or starts a new bucket.
+
+  @param   ti Time stamp, microseconds.
+  @param   value Value to add.
+  @param   sbits State bits.
+
+****************************************************************************************************
+*/
+void eioHistory::add(
+    os_long ti,
+    os_double value,
+    os_int sbits)
+{
+    eioHistoryRing *r;
+    os_long start;
+    os_int lv, ix;
+
+    if (ti < m_latest_ti) ti = m_latest_ti;
+    m_latest_ti = ti;
+
+    r = m_ring;
+    ix = r->head;
+    r->tstamp[ix] = ti;
+    setval(r->vmin, ix, value);
+    r->sbits[ix] = (os_char)sbits;
+    if (++(r->head) >= r->capacity) r->head = 0;
+    if (r->count < r->capacity) r->count++;
+
+    for (lv = 1; lv <= EIO_HISTORY_NLEVELS; lv++)
+    {
+        r = m_ring + lv;
+        start = ti - ti % r->width;
+
+        if (r->count) {
+            ix = ringix(r, r->count - 1);
+            if (r->tstamp[ix] == start) {
+                if (value < getval(r->vmin, ix)) setval(r->vmin, ix, value);
+                if (value > getval(r->vmax, ix)) setval(r->vmax, ix, value);
+                r->sum[ix] += value;
+                r->n[ix]++;
+                r->sbits[ix] = (os_char)sbits;
+                continue;
+            }
+        }
+
+        ix = r->head;
+        r->tstamp[ix] = start;
+        setval(r->vmin, ix, value);
+        setval(r->vmax, ix, value);
+        r->sum[ix] = value;
+        r->n[ix] = 1;
+        r->sbits[ix] = (os_char)sbits;
+        if (++(r->head) >= r->capacity) r->head = 0;
+        if (r->count < r->capacity) r->count++;
+    }
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Get history within time range as matrix.
+
+  The eioHistory::select() function returns history between tstart and tend as a matrix with
+  EIO_HISTORY_NCOLUMNS columns: Time stamp, minimum, maximum, average and state bits. Time
+  range is divided into max_points equal slots and entries within same slot are merged into
+  one row. Rows are ordered by time. Empty slots produce no rows.
+
+  Beginning of the time range is taken from the finest level which reaches back to it (or
+  the coarsest level), and the function switches to finer levels as soon as those have data.
+  So recent part of a long time range has full resolution, as far as max_points allows.
+
+  @param   tstart Start of time range, microseconds.
+  @param   tend End of time range, microseconds. 0 for up to latest value.
+  @param   max_points Maximum number of rows to return.
+  @param   parent Parent object for the matrix, OS_NULL if none.
+  @param   id Object identifier for the matrix.
+  @return  New matrix, OS_DOUBLE data type.
+
+****************************************************************************************************
+*/
+eMatrix *eioHistory::select(
+    os_long tstart,
+    os_long tend,
+    os_int max_points,
+    eObject *parent,
+    e_oid id)
+{
+    eioHistorySelect sel;
+    eioHistoryRing *r;
+    os_long pos, seg_end, o;
+    os_int lv, f;
+
+    os_memclear(&sel, sizeof(sel));
+    sel.m = new eMatrix(parent, id);
+    sel.m->allocate(OS_DOUBLE, 0, EIO_HISTORY_NCOLUMNS);
+
+    if (tend <= 0 || tend > m_latest_ti) tend = m_latest_ti;
+    if (tstart > tend || m_ring[0].count == 0) return sel.m;
+    if (max_points < 1) max_points = 1;
+    sel.tstart = tstart;
+    sel.slot_w = (tend - tstart) / max_points + 1;
+
+    pos = tstart;
+    while (pos <= tend)
+    {
+        /* Select the finest level which reaches back to pos, or the coarsest level.
+         */
+        for (lv = 0; lv < EIO_HISTORY_NLEVELS; lv++) {
+            r = m_ring + lv;
+            if (r->count) if (oldest(r) <= pos) break;
+        }
+        r = m_ring + lv;
+
+        /* Switch to finer level when it starts.
+         */
+        seg_end = tend + 1;
+        for (f = 0; f < lv; f++) {
+            if (m_ring[f].count) {
+                o = oldest(m_ring + f);
+                if (o > pos && o < seg_end) seg_end = o;
+            }
+        }
+
+        o = select_level(r, pos, seg_end, &sel);
+        if (o <= pos) {
+            if (seg_end > tend) break;
+            o = seg_end;
+        }
+        pos = o;
+    }
+
+    if (sel.have_row) {
+        eio_history_emit(&sel);
+    }
+
+    return sel.m;
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Merge entries of one level within time segment to query result.
+
+  The eioHistory::select_level() function merges entries of a ring buffer, which start before
+  seg_end and end after pos, into query result rows.
+
+  @param   r Ring buffer.
+  @param   pos Start of the segment, microseconds.
+  @param   seg_end End of the segment, first time stamp not included.
+  @param   sel Query state.
+  @return  End time of the last merged entry. pos if nothing was merged.
+
+****************************************************************************************************
+*/
+os_long eioHistory::select_level(
+    eioHistoryRing *r,
+    os_long pos,
+    os_long seg_end,
+    eioHistorySelect *sel)
+{
+    os_double v, vmax, sum;
+    os_long t, slot, end_t;
+    os_int i, ix, n;
+
+    end_t = pos;
+    for (i = find(r, pos); i < r->count; i++)
+    {
+        ix = ringix(r, i);
+        t = r->tstamp[ix];
+        if (t >= seg_end) break;
+        end_t = t + (r->width ? r->width : 1);
+
+        slot = t < sel->tstart ? 0 : (t - sel->tstart) / sel->slot_w;
+        if (sel->have_row && slot != sel->cur_slot) {
+            eio_history_emit(sel);
+        }
+
+        v = getval(r->vmin, ix);
+        if (r->width) {
+            vmax = getval(r->vmax, ix);
+            sum = r->sum[ix];
+            n = r->n[ix];
+        }
+        else {
+            vmax = sum = v;
+            n = 1;
+        }
+
+        if (!sel->have_row) {
+            sel->row[EIO_HISTORY_COL_TSTAMP] = (os_double)t;
+            sel->vmin = v;
+            sel->vmax = vmax;
+            sel->sum = sum;
+            sel->count = n;
+            sel->cur_slot = slot;
+            sel->have_row = OS_TRUE;
+        }
+        else {
+            if (v < sel->vmin) sel->vmin = v;
+            if (vmax > sel->vmax) sel->vmax = vmax;
+            sel->sum += sum;
+            sel->count += n;
+        }
+        sel->row[EIO_HISTORY_COL_SBITS] = (os_uchar)r->sbits[ix];
+    }
+
+    return end_t;
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Store merged query row into result matrix.
+
+  @param   sel Query state.
+
+****************************************************************************************************
+*/
+static void eio_history_emit(
+    eioHistorySelect *sel)
+{
+    sel->row[EIO_HISTORY_COL_MIN] = sel->vmin;
+    sel->row[EIO_HISTORY_COL_MAX] = sel->vmax;
+    sel->row[EIO_HISTORY_COL_AVG] = sel->sum / sel->count;
+    sel->m->set_array(sel->nrows++ * EIO_HISTORY_NCOLUMNS, sel->row,
+        EIO_HISTORY_NCOLUMNS, OS_DOUBLE);
+    sel->have_row = OS_FALSE;
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Find first entry which ends at or after time ti.
+
+  Binary search, time stamps within ring buffer are in ascending order.
+
+  @param   r Ring buffer.
+  @param   ti Time stamp, microseconds.
+  @return  Index of the entry, 0 = oldest. r->count if no such entry.
+
+****************************************************************************************************
+*/
+os_int eioHistory::find(
+    eioHistoryRing *r,
+    os_long ti)
+{
+    os_int lo, hi, mid;
+    os_long w;
+
+    w = r->width ? r->width : 1;
+    lo = 0;
+    hi = r->count;
+    while (lo < hi) {
+        mid = (lo + hi) / 2;
+        if (r->tstamp[ringix(r, mid)] + w > ti) {
+            hi = mid;
+        }
+        else {
+            lo = mid + 1;
+        }
+    }
+    return lo;
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Allocate ring buffer.
+
+  @param   r Ring buffer to set up.
+  @param   capacity Number of samples or buckets.
+  @param   width Bucket width, 0 for raw samples.
+
+****************************************************************************************************
+*/
+void eioHistory::alloc_ring(
+    eioHistoryRing *r,
+    os_int capacity,
+    os_long width)
+{
+    os_memclear(r, sizeof(eioHistoryRing));
+    r->capacity = capacity;
+    r->width = width;
+    r->tstamp = (os_long*)os_malloc(capacity * sizeof(os_long), OS_NULL);
+    r->vmin = os_malloc(capacity * m_value_sz, OS_NULL);
+    r->sbits = os_malloc(capacity, OS_NULL);
+    if (width) {
+        r->vmax = os_malloc(capacity * m_value_sz, OS_NULL);
+        r->sum = (os_double*)os_malloc(capacity * sizeof(os_double), OS_NULL);
+        r->n = (os_int*)os_malloc(capacity * sizeof(os_int), OS_NULL);
+    }
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Free ring buffer.
+
+  @param   r Ring buffer.
+
+****************************************************************************************************
+*/
+void eioHistory::free_ring(
+    eioHistoryRing *r)
+{
+    os_int capacity;
+
+    capacity = r->capacity;
+    os_free(r->tstamp, capacity * sizeof(os_long));
+    os_free(r->vmin, capacity * m_value_sz);
+    os_free(r->sbits, capacity);
+    if (r->width) {
+        os_free(r->vmax, capacity * m_value_sz);
+        os_free(r->sum, capacity * sizeof(os_double));
+        os_free(r->n, capacity * sizeof(os_int));
+    }
+}
@@ -0,0 +1,175 @@
+/**
+
+  @file    eio_history.h
+  @brief   Time series history of IO variable.
+  @author  Pekka Lehtikoski
+  @version 1.0
+  @date    18.10.2026
+
+  Copyright 2020 Pekka Lehtikoski. This file is part of the eobjects project and shall only be used,
+  modified, and distributed under the terms of the project licensing. By continuing to use, modify,
+  or distribute this file you indicate that you have read the license and understand and accept
+  it fully.
+
+****************************************************************************************************
+*/
+#pragma once
+#ifndef EIO_HISTORY_H_
+#define EIO_HISTORY_H_
+#include "extensions/io/eio.h"
+
+/* Number of downsampled levels in addition to raw samples, and number of buckets kept
+   for each level.
+ */
+#define EIO_HISTORY_NLEVELS 3
+#define EIO_HISTORY_NBUCKETS 512
+
+/* Default maximum number of points returned by history query.
+ */
+#define EIO_HISTORY_DEFAULT_NPOINTS 300
+
+/* Columns of history query result matrix.
+ */
+#define EIO_HISTORY_COL_TSTAMP 0
+#define EIO_HISTORY_COL_MIN 1
+#define EIO_HISTORY_COL_MAX 2
+#define EIO_HISTORY_COL_AVG 3
+#define EIO_HISTORY_COL_SBITS 4
+#define EIO_HISTORY_NCOLUMNS 5
+
+struct eioHistorySelect;
+
+/* Ring buffer of raw samples or downsampled buckets. Values are stored as os_float or
+   os_double, depending on signal type. For raw samples vmax, sum and n are not used.
+ */
+typedef struct eioHistoryRing
+{
+    os_long *tstamp;            /* Sample time, or bucket start time. */
+    os_char *vmin;              /* Sample value, or minimum within bucket. */
+    os_char *vmax;              /* Maximum within bucket. */
+    os_double *sum;             /* Sum of values within bucket. */
+    os_int *n;                  /* Number of values within bucket. */
+    os_char *sbits;             /* State bits of latest value. */
+    os_long width;              /* Bucket width in microseconds, 0 for raw samples. */
+    os_int capacity;            /* Maximum number of samples or buckets. */
+    os_int head;                /* Index where to store next sample or bucket. */
+    os_int count;               /* Number of samples or buckets stored. */
+}
+eioHistoryRing;
+
+
+/**
+****************************************************************************************************
+  eioHistory keeps recent values of an IO variable, and downsampled min/max/avg buckets.
+****************************************************************************************************
+*/
+class eioHistory
+{
+public:
+    /* Constructor.
+     */
+    eioHistory(
+        os_int nsamples,
+        osalTypeId type_id);
+
+    /* Destructor.
+     */
+    ~eioHistory();
+
+    /* Add a value to history.
+     */
+    void add(
+        os_long ti,
+        os_double value,
+        os_int sbits);
+
+    /* Get history within time range as matrix, at most max_points rows.
+     */
+    eMatrix *select(
+        os_long tstart,
+        os_long tend,
+        os_int max_points = EIO_HISTORY_DEFAULT_NPOINTS,
+        eObject *parent = OS_NULL,
+        e_oid id = EOID_ITEM);
+
+protected:
+    /* Allocate ring buffer.
+     */
+    void alloc_ring(
+        eioHistoryRing *r,
+        os_int capacity,
+        os_long width);
+
+    /* Free ring buffer.
+     */
+    void free_ring(
+        eioHistoryRing *r);
+
+    /* Get and set values in ring buffer, as os_float or os_double.
+     */
+    inline os_double getval(
+        const os_char *arr,
+        os_int ix)
+    {
+        return m_use_float ? ((const os_float*)arr)[ix] : ((const os_double*)arr)[ix];
+    }
+
+    inline void setval(
+        os_char *arr,
+        os_int ix,
+        os_double x)
+    {
+        if (m_use_float) ((os_float*)arr)[ix] = (os_float)x;
+        else ((os_double*)arr)[ix] = x;
+    }
+
+    /* Physical index of ring buffer entry, 0 is oldest.
+     */
+    inline os_int ringix(
+        eioHistoryRing *r,
+        os_int i)
+    {
+        i += r->head - r->count;
+        return i < 0 ? i + r->capacity : i;
+    }
+
+    /* Find first entry of ring buffer which ends at or after time ti.
+     */
+    os_int find(
+        eioHistoryRing *r,
+        os_long ti);
+
+    /* Time stamp of the oldest entry in ring buffer.
+     */
+    inline os_long oldest(
+        eioHistoryRing *r)
+    {
+        return r->tstamp[ringix(r, 0)];
+    }
+
+    /* Merge entries of one level within time segment to query result.
+     */
+    os_long select_level(
+        eioHistoryRing *r,
+        os_long pos,
+        os_long seg_end,
+        struct eioHistorySelect *sel);
+
+    /* Raw samples and downsampled levels.
+     */
+    eioHistoryRing m_ring[EIO_HISTORY_NLEVELS + 1];
+
+    /* Store values as os_float (OS_TRUE) or os_double.
+     */
+    os_boolean m_use_float;
+
+    /* Value size in bytes.
+     */
+    os_short m_value_sz;
+
+    /* Latest time stamp, history times never go backwards.
+     */
+    os_long m_latest_ti;
+};
+
+#endif
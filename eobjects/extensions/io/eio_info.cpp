@@ -20,18 +20,14 @@
  */
 typedef struct eioInfoParserState
 {
-    /** Pointer to iocom root object
+    /** Parsed info into which signals, memory blocks and assemblies are recorded.
      */
-    iocRoot *root;
+    eioInfo *info;
 
     eioMblkInfo minfo;
 
     eioSignalInfo sinfo;
 
-    /** Resize memory blocks while parsing flag.
-     */
-    os_boolean resize_mblks;
-
     /** Current type as enumeration value, like OS_SHORT. This is set to default
         at beginning of memory block and modified by "type" tag.
      */
@@ -66,6 +62,13 @@ typedef struct eioInfoParserState
 eioInfoParserState;
 
 
+/* Forward referred static functions.
+ */
+static os_boolean eio_same_signal(
+    eioInfoSignal *a,
+    eioInfoSignal *b);
+
+
 /**
 ****************************************************************************************************
 
@@ -74,6 +77,10 @@ eioInfoParserState;
   The eioRoot::info_callback() function is called when device information data is received from
   connection or when connection status changes.
 
+  If the device has already been set up with identical info block, it is rebound to it's
+  existing IO objects without parsing. Otherwise parsed info is taken from cache, or the info
+  block is parsed and cached, and changes are applied to the device.
+
   @param   handle Memory block handle.
   @param   start_addr Address of first changed byte.
   @param   end_addr Address of the last changed byte.
@@ -94,13 +101,13 @@ void eioRoot::info_callback(
     eioRoot *t = (eioRoot*)context;
     iocRoot *root;
     iocMemoryBlock *mblk;
-    osalJsonIndex jindex;
-    osalStatus s;
-    eStatus es;
-    eioInfoParserState state;
+    eioDevice *device;
+    eioInfo *info;
+    eioMblkInfo minfo;
+    const os_char *buf;
+    os_uint hash;
     OSAL_UNUSED(start_addr);
     OSAL_UNUSED(flags);
-    OSAL_UNUSED(context);
 
     /* If actual data received (not connection status change).
      */
@@ -111,35 +118,248 @@ void eioRoot::info_callback(
     mblk = ioc_handle_lock_to_mblk(handle, &root);
     if (mblk == OS_NULL) return;
 
-    s = osal_create_json_indexer(&jindex, mblk->buf, mblk->nbytes, 0);
-    if (s) goto getout;
-
-    os_memclear(&state, sizeof(state));
-    state.root = root;
+    os_memclear(&minfo, sizeof(minfo));
 #if IOC_MBLK_SPECIFIC_DEVICE_NAME
-    state.minfo.device_name = mblk->device_name;
-    state.minfo.device_nr = mblk->device_nr;
-    state.minfo.network_name = mblk->network_name;
+    minfo.device_name = mblk->device_name;
+    minfo.device_nr = mblk->device_nr;
+    minfo.network_name = mblk->network_name;
 #else
-    state.minfo.device_name = root->device_name;
-    state.minfo.device_nr = root->device_nr;
-    state.minfo.network_name = mblk->network_name;
+    minfo.device_name = root->device_name;
+    minfo.device_nr = root->device_nr;
+    minfo.network_name = mblk->network_name;
 #endif
-    state.minfo.eio_root = t;
-    state.resize_mblks = OS_TRUE;
+    minfo.root = root;
+    minfo.eio_root = t;
 
-    os_lock();
+    /* Hash is calculated before os_lock(), it is the only pass over the whole info block
+       when info is unchanged.
+     */
+    buf = (const os_char*)mblk->buf;
+    hash = estrintern_hash(buf, mblk->nbytes);
 
-    es = t->process_info_block(&state, osal_str_empty, &jindex);
-    if (es) goto getout;
+    os_lock();
+    device = t->get_device(&minfo);
+    if (device)
+    {
+        info = device->info();
+        if (info) if (info->matches(hash, buf, mblk->nbytes)) {
+            t->rebind_by_info(device, info, &minfo);
+            goto getout;
+        }
 
-    os_unlock();
+        info = t->parse_info(hash, buf, mblk->nbytes);
+        if (info) {
+            t->apply_info(device, info, &minfo);
+        }
+    }
 
 getout:
+    os_unlock();
     ioc_unlock(root);
 }
 
 
+/**
+****************************************************************************************************
+
+  @brief Get parsed info block.
+
+  The eioRoot::parse_info() function looks for the info block from cache. If not found, the
+  packed JSON is copied, parsed and added to cache. ioc_lock() and os_lock() must be on.
+
+  @param   hash Hash of packed JSON, see estrintern_hash().
+  @param   buf Packed JSON.
+  @param   nbytes Size of packed JSON in bytes.
+  @return  Parsed info, the caller holds a reference to it. OS_NULL if parsing failed.
+
+****************************************************************************************************
+*/
+eioInfo *eioRoot::parse_info(
+    os_uint hash,
+    const os_char *buf,
+    os_memsz nbytes)
+{
+    eioInfo *info;
+    osalJsonIndex jindex;
+    eioInfoParserState state;
+
+    info = m_info_cache->get(hash, buf, nbytes);
+    if (info) return info;
+
+    info = new eioInfo(hash, buf, nbytes);
+    if (info->buf() == OS_NULL) goto failed;
+
+    if (osal_create_json_indexer(&jindex, info->buf(), info->nbytes(), 0)) goto failed;
+
+    os_memclear(&state, sizeof(state));
+    state.info = info;
+    if (process_info_block(&state, osal_str_empty, &jindex)) goto failed;
+
+    m_info_cache->add(info);
+    return info;
+
+failed:
+    delete info;
+    return OS_NULL;
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Set up device by new or changed info.
+
+  The eioRoot::apply_info() function creates or updates IO objects for signals and assemblies
+  in info. If the device has been set up by earlier info, only signals which are new or
+  changed are set up, and signals and assemblies no longer in info are deleted.
+  ioc_lock() and os_lock() must be on.
+
+  @param   device IO device object.
+  @param   info Parsed info. The device takes over caller's reference.
+  @param   minfo Device and network name, iocom root.
+
+****************************************************************************************************
+*/
+void eioRoot::apply_info(
+    eioDevice *device,
+    eioInfo *info,
+    eioMblkInfo *minfo)
+{
+    eioInfo *old_info;
+    eioInfoSignal *s, *old_s;
+    eioMblk *mblk;
+    eContainer *assemblies;
+    const os_char *mblk_name;
+    os_int i, j;
+
+    old_info = device->info();
+
+    resize_memory_blocks_by_info(info, minfo);
+
+    /* Set up signals which are new or changed. Signals are grouped by memory block,
+       so memory block object is looked up once per group.
+     */
+    mblk = OS_NULL;
+    mblk_name = OS_NULL;
+    for (i = 0; i < info->nsignals(); i++)
+    {
+        s = info->signal(i);
+        if (old_info) {
+            j = old_info->find_signal(s, i);
+            if (j >= 0) if (eio_same_signal(s, old_info->signal(j))) continue;
+        }
+
+        if (mblk == OS_NULL || os_strcmp(s->mblk_name, mblk_name))
+        {
+            minfo->mblk_name = s->mblk_name;
+            mblk_name = s->mblk_name;
+            mblk = device->connected(minfo);
+            if (mblk == OS_NULL) {
+                osal_debug_error_str("apply_info: Mblk could not be created: ", mblk_name);
+                continue;
+            }
+        }
+        setup_signal(device, mblk, minfo, &s->sinfo);
+    }
+    minfo->mblk_name = OS_NULL;
+
+    /* Delete signals and assemblies which are no longer in info.
+     */
+    if (old_info)
+    {
+        for (j = 0; j < old_info->nsignals(); j++) {
+            old_s = old_info->signal(j);
+            if (info->find_signal(old_s, j) < 0) {
+                delete_signal(device, old_s, info);
+            }
+        }
+
+        assemblies = device->assemblies();
+        for (j = 0; j < old_info->nassemblies(); j++) {
+            if (info->find_assembly(old_info->assembly(j)->name) < 0) {
+                delete assemblies->byname(old_info->assembly(j)->name);
+            }
+        }
+    }
+
+    /* Assemblies are set up again, this reinitializes IOCOM brick buffers.
+     */
+    for (i = 0; i < info->nassemblies(); i++) {
+        new_assembly(device, info->assembly(i));
+    }
+
+    device->set_info(info);
+    eioInfoCache::release(old_info);
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Rebind reconnected device with unchanged info.
+
+  The eioRoot::rebind_by_info() function is called when a device reconnects with the same
+  info block it was set up with. Existing IO objects are reused: Memory blocks are resized,
+  signals are rebound in one pass without name lookups, and assemblies are set up again.
+  ioc_lock() and os_lock() must be on.
+
+  @param   device IO device object.
+  @param   info Parsed info the device was set up with.
+  @param   minfo Device and network name, iocom root.
+
+****************************************************************************************************
+*/
+void eioRoot::rebind_by_info(
+    eioDevice *device,
+    eioInfo *info,
+    eioMblkInfo *minfo)
+{
+    eContainer *mblks;
+    eObject *o, *sig;
+    os_int i;
+
+    resize_memory_blocks_by_info(info, minfo);
+
+    mblks = device->mblks();
+    if (mblks) for (o = mblks->first(); o; o = o->next())
+    {
+        if (o->classid() != ECLASSID_EIO_MBLK) continue;
+        for (sig = eioMblk::cast(o)->esignals()->first(); sig; sig = sig->next()) {
+            if (sig->classid() == ECLASSID_EIO_SIGNAL) {
+                ((eioSignal*)sig)->rebind();
+            }
+        }
+    }
+
+    for (i = 0; i < info->nassemblies(); i++) {
+        new_assembly(device, info->assembly(i));
+    }
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Check if signal is unchanged.
+
+  @param   a Signal from new info.
+  @param   b Signal with the same memory block and signal name from old info.
+  @return  OS_TRUE if group, address, size and type are the same.
+
+****************************************************************************************************
+*/
+static os_boolean eio_same_signal(
+    eioInfoSignal *a,
+    eioInfoSignal *b)
+{
+    return (os_boolean)(a->sinfo.addr == b->sinfo.addr &&
+        a->sinfo.n == b->sinfo.n &&
+        a->sinfo.ncolumns == b->sinfo.ncolumns &&
+        a->sinfo.flags == b->sinfo.flags &&
+        !os_strcmp(a->sinfo.group_name, b->sinfo.group_name));
+}
+
+
 /**
 ****************************************************************************************************
 
@@ -217,9 +437,9 @@ eStatus eioRoot::process_info_block(
                 }
                 return new_signal_by_info(state);
             }
-            if (is_mblk_block && state->resize_mblks)
+            if (is_mblk_block && state->minfo.mblk_name)
             {
-                resize_memory_block_by_info(state);
+                state->info->add_mblk(state->minfo.mblk_name, state->max_addr);
             }
             if (is_assembly_block) {
                 return new_assembly_by_info(state);
@@ -424,11 +644,11 @@ eStatus eioRoot::process_info_array(
 /**
 ****************************************************************************************************
 
-  @brief Add IO signal to dynamic information.
+  @brief Record IO signal in parsed info.
 
-  The new_signal_by_info() function adds a new IO signal to dynamic information. This
-  function is called when parting packed JSON in info block. Synchronization ioc_lock()
-  must be on when this function is called.
+  The new_signal_by_info() function records a new IO signal in parsed info, IO objects are
+  created later by apply_info(). This function is called when parting packed JSON in info
+  block. Synchronization ioc_lock() must be on when this function is called.
 
   @param   state Structure holding current JSON parsing state.
   @return  OSAL_SUCCESS if all is fine, other values indicate an error.
@@ -461,7 +681,7 @@ eStatus eioRoot::new_signal_by_info(
     if (n < 1) n = 1;
 
     state->sinfo.flags = signal_type_id;
-    new_signal(&state->minfo, &state->sinfo);
+    state->info->add_signal(state->minfo.mblk_name, &state->sinfo);
 
     switch(signal_type_id)
     {
@@ -501,9 +721,10 @@ eStatus eioRoot::new_signal_by_info(
 /**
 ****************************************************************************************************
 
-  @brief Add an assembly to dynamic information.
+  @brief Record an assembly in parsed info.
 
-  The new_assembly_by_infoinfo()...
+  The new_assembly_by_info() records assembly parameters, the assembly object is created
+  or set up again by apply_info() or rebind_by_info().
 
   @param   state Structure holding current JSON parsing state.
   @return  OSAL_SUCCESS if all is fine, other values indicate an error.
@@ -514,7 +735,6 @@ eStatus eioRoot::new_assembly_by_info(
     eioInfoParserState *state)
 {
     eioAssemblyParams prm;
-    eVariable device_id;
 
     os_memclear(&prm, sizeof(prm));
     prm.name = state->assembly_name;
@@ -523,9 +743,7 @@ eStatus eioRoot::new_assembly_by_info(
     prm.imp_str = state->imp_str;
     prm.timeout_ms = state->timeout_ms;
 
-    device_id = state->minfo.device_name;
-    device_id += state->minfo.device_nr;
-    new_assembly(device_id.gets(), state->minfo.network_name , &prm);
+    state->info->add_assembly(&prm);
     return ESTATUS_SUCCESS;
 }
 
@@ -533,45 +751,53 @@ eStatus eioRoot::new_assembly_by_info(
 /**
 ****************************************************************************************************
 
-  @brief Processing packed JSON, resize a memory block.
+  @brief Resize memory blocks by parsed info.
 
-  The ioc_resize_memory_block_by_info() function resized a memory block (By making it bigger,
-  if needed. Memory block will never be shrunk). This function is used at IO device to
+  The resize_memory_blocks_by_info() function resizes device's memory blocks (By making them
+  bigger, if needed. Memory block will never be shrunk). This function is used at IO device to
   configure signals and memory block sizes by information in JSON. Synchronization ioc_lock()
   must be on when this function is called.
 
-  @param   state Structure holding current JSON parsing state.
+  @param   info Parsed info, holds first unused address of each memory block.
+  @param   minfo Device name and number, iocom root.
   @return  None.
 
 ****************************************************************************************************
 */
-void eioRoot::resize_memory_block_by_info(
-    eioInfoParserState *state)
+void eioRoot::resize_memory_blocks_by_info(
+    eioInfo *info,
+    eioMblkInfo *minfo)
 {
     iocRoot *root;
     iocMemoryBlock *mblk;
-    os_int sz;
+    eioInfoMblk *m;
+    os_int i, sz;
 
-    root = state->root;
-    sz = state->max_addr;
-    if (sz < IOC_MIN_MBLK_SZ) sz = IOC_MIN_MBLK_SZ;
+    root = minfo->root;
 
 #if IOC_MBLK_SPECIFIC_DEVICE_NAME==0
-    if (root->device_nr != state->device_nr) return;
-    if (os_strcmp(root->device_name, state->device_name)) return;
+    if (root->device_nr != minfo->device_nr) return;
+    if (os_strcmp(root->device_name, minfo->device_name)) return;
 #endif
 
-    for (mblk = root->mblk.first;
-         mblk;
-         mblk = mblk->link.next)
+    for (i = 0; i < info->nmblks(); i++)
     {
+        m = info->mblk(i);
+        sz = m->max_addr;
+        if (sz < IOC_MIN_MBLK_SZ) sz = IOC_MIN_MBLK_SZ;
+
+        for (mblk = root->mblk.first;
+             mblk;
+             mblk = mblk->link.next)
+        {
 #if IOC_MBLK_SPECIFIC_DEVICE_NAME
-        if (mblk->device_nr != state->minfo.device_nr) continue;
-        if (os_strcmp(mblk->device_name, state->minfo.device_name)) continue;
+            if (mblk->device_nr != minfo->device_nr) continue;
+            if (os_strcmp(mblk->device_name, minfo->device_name)) continue;
 #endif
-        if (os_strcmp(mblk->mblk_name, state->minfo.mblk_name)) continue;
+            if (os_strcmp(mblk->mblk_name, m->mblk_name)) continue;
 
-        ioc_resize_mblk(mblk, sz, 0);
-        break;
+            ioc_resize_mblk(mblk, sz, 0);
+            break;
+        }
     }
 }
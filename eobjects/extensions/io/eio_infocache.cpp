@@ -0,0 +1,380 @@
+/**
+
+  @file    eio_infocache.cpp
+  @brief   Cache of parsed device information blocks.
+  @author  Pekka Lehtikoski
+  @version 1.0
+  @date    18.10.2026
+
+  When many devices of the same kind connect, for example after a power failure, each sends
+  identical info block. Parsing the packed JSON and looking up or creating IO objects for every
+  signal one by one keeps IO thread busy for a long time. Parsed info blocks are cached here
+  keyed by content hash, so each distinct info block is parsed only once. eioDevice keeps
+  reference to the info it was set up with, which allows a reconnecting device with unchanged
+  info to rebind to it's existing objects, and to apply only differences when info changes.
+
+  Cache is accessed only with os_lock() on.
+
+  Copyright 2020 Pekka Lehtikoski. This file is part of the eobjects project and shall only be used,
+  modified, and distributed under the terms of the project licensing. By continuing to use, modify,
+  or distribute this file you indicate that you have read the license and understand and accept
+  it fully.
+
+****************************************************************************************************
+*/
+#include "extensions/io/eio.h"
+
+
+/**
+****************************************************************************************************
+  Constructor, copies packed JSON. Items are added while parsing the copy.
+****************************************************************************************************
+*/
+eioInfo::eioInfo(
+    os_uint hash,
+    const os_char *buf,
+    os_memsz nbytes)
+{
+    m_hash = hash;
+    m_nbytes = nbytes;
+    m_buf = os_malloc(nbytes, OS_NULL);
+    if (m_buf) {
+        os_memcpy(m_buf, buf, nbytes);
+    }
+    else {
+        m_nbytes = 0;
+    }
+
+    m_signals = OS_NULL;
+    m_nsignals = m_signals_alloc = 0;
+    m_mblks = OS_NULL;
+    m_nmblks = m_mblks_alloc = 0;
+    m_assemblies = OS_NULL;
+    m_nassemblies = m_assemblies_alloc = 0;
+    m_nrefs = 1;
+    m_cache = OS_NULL;
+    m_next = OS_NULL;
+}
+
+
+/**
+****************************************************************************************************
+  Destructor.
+****************************************************************************************************
+*/
+eioInfo::~eioInfo()
+{
+    os_free(m_signals, m_signals_alloc * sizeof(eioInfoSignal));
+    os_free(m_mblks, m_mblks_alloc * sizeof(eioInfoMblk));
+    os_free(m_assemblies, m_assemblies_alloc * sizeof(eioAssemblyParams));
+    os_free(m_buf, m_nbytes);
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Check if this was parsed from given info block.
+
+  Hash is checked first, content is compared only if hash matches.
+
+  @param   hash Hash of packed JSON, see estrintern_hash().
+  @param   buf Packed JSON.
+  @param   nbytes Size of packed JSON in bytes.
+  @return  OS_TRUE if content is the same.
+
+****************************************************************************************************
+*/
+os_boolean eioInfo::matches(
+    os_uint hash,
+    const os_char *buf,
+    os_memsz nbytes)
+{
+    return (os_boolean)(hash == m_hash && nbytes == m_nbytes &&
+        !os_memcmp(buf, m_buf, nbytes));
+}
+
+
+/**
+****************************************************************************************************
+  Add signal, strings must point to packed JSON copy within this object.
+****************************************************************************************************
+*/
+void eioInfo::add_signal(
+    const os_char *mblk_name,
+    eioSignalInfo *sinfo)
+{
+    eioInfoSignal *s;
+
+    m_signals = (eioInfoSignal*)grow(m_signals, m_nsignals, &m_signals_alloc,
+        sizeof(eioInfoSignal));
+    if (m_signals == OS_NULL) return;
+    s = m_signals + m_nsignals++;
+    s->mblk_name = mblk_name;
+    s->sinfo = *sinfo;
+}
+
+
+/**
+****************************************************************************************************
+  Add memory block.
+****************************************************************************************************
+*/
+void eioInfo::add_mblk(
+    const os_char *mblk_name,
+    os_int max_addr)
+{
+    eioInfoMblk *m;
+
+    m_mblks = (eioInfoMblk*)grow(m_mblks, m_nmblks, &m_mblks_alloc, sizeof(eioInfoMblk));
+    if (m_mblks == OS_NULL) return;
+    m = m_mblks + m_nmblks++;
+    m->mblk_name = mblk_name;
+    m->max_addr = max_addr;
+}
+
+
+/**
+****************************************************************************************************
+  Add assembly.
+****************************************************************************************************
+*/
+void eioInfo::add_assembly(
+    eioAssemblyParams *prm)
+{
+    m_assemblies = (eioAssemblyParams*)grow(m_assemblies, m_nassemblies,
+        &m_assemblies_alloc, sizeof(eioAssemblyParams));
+    if (m_assemblies == OS_NULL) return;
+    m_assemblies[m_nassemblies++] = *prm;
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Find signal by memory block and signal name.
+
+  Signals are usually in the same order in old and new info block, so position hint_ix is
+  checked first and search continues from there.
+
+  @param   s Signal to look for, typically from another eioInfo.
+  @param   hint_ix Index where the signal is likely to be.
+  @return  Index of signal, -1 if not found.
+
+****************************************************************************************************
+*/
+os_int eioInfo::find_signal(
+    eioInfoSignal *s,
+    os_int hint_ix)
+{
+    eioInfoSignal *t;
+    os_int i, ix;
+
+    if (hint_ix < 0 || hint_ix >= m_nsignals) hint_ix = 0;
+
+    for (i = 0; i < m_nsignals; i++) {
+        ix = hint_ix + i;
+        if (ix >= m_nsignals) ix -= m_nsignals;
+        t = m_signals + ix;
+        if (!os_strcmp(t->sinfo.signal_name, s->sinfo.signal_name) &&
+            !os_strcmp(t->mblk_name, s->mblk_name))
+        {
+            return ix;
+        }
+    }
+    return -1;
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Find signal which maps to the same IO variable.
+
+  Parameter signals "set_x" and "x" are merged to one IO variable "x" within group.
+
+  @param   s Signal to look for.
+  @return  Index of signal, -1 if not found.
+
+****************************************************************************************************
+*/
+os_int eioInfo::find_variable(
+    eioInfoSignal *s)
+{
+    eioInfoSignal *t;
+    const os_char *name, *tname;
+    os_int ix;
+
+    name = s->sinfo.signal_name;
+    if (!os_strncmp(name, "set_", 4)) name += 4;
+
+    for (ix = 0; ix < m_nsignals; ix++) {
+        t = m_signals + ix;
+        tname = t->sinfo.signal_name;
+        if (!os_strncmp(tname, "set_", 4)) tname += 4;
+        if (!os_strcmp(tname, name) &&
+            !os_strcmp(t->sinfo.group_name, s->sinfo.group_name))
+        {
+            return ix;
+        }
+    }
+    return -1;
+}
+
+
+/**
+****************************************************************************************************
+  Find assembly by name, -1 if not found.
+****************************************************************************************************
+*/
+os_int eioInfo::find_assembly(
+    const os_char *name)
+{
+    os_int ix;
+
+    for (ix = 0; ix < m_nassemblies; ix++) {
+        if (!os_strcmp(m_assemblies[ix].name, name)) {
+            return ix;
+        }
+    }
+    return -1;
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Make room for one more item in array.
+
+  Array size is doubled when full.
+
+  @param   arr Current array, OS_NULL if none.
+  @param   n Number of items used.
+  @param   alloc_n Pointer to number of items allocated, updated.
+  @param   item_sz Item size in bytes.
+  @return  Pointer to array, OS_NULL if memory allocation failed (old array is freed).
+
+****************************************************************************************************
+*/
+void *eioInfo::grow(
+    void *arr,
+    os_int n,
+    os_int *alloc_n,
+    os_memsz item_sz)
+{
+    void *newarr;
+    os_int new_alloc_n;
+
+    if (n < *alloc_n) return arr;
+
+    new_alloc_n = *alloc_n ? 2 * *alloc_n : 16;
+    newarr = os_malloc(new_alloc_n * item_sz, OS_NULL);
+    if (newarr && n) {
+        os_memcpy(newarr, arr, n * item_sz);
+    }
+    os_free(arr, *alloc_n * item_sz);
+    *alloc_n = newarr ? new_alloc_n : 0;
+    return newarr;
+}
+
+
+/**
+****************************************************************************************************
+  Constructor.
+****************************************************************************************************
+*/
+eioInfoCache::eioInfoCache()
+{
+    m_first = OS_NULL;
+}
+
+
+/**
+****************************************************************************************************
+  Destructor. Devices release their info before the cache is deleted, anything left is
+  detached and freed.
+****************************************************************************************************
+*/
+eioInfoCache::~eioInfoCache()
+{
+    eioInfo *info;
+
+    while ((info = m_first)) {
+        m_first = info->m_next;
+        info->m_cache = OS_NULL;
+        delete info;
+    }
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Find parsed info block.
+
+  @param   hash Hash of packed JSON, see estrintern_hash().
+  @param   buf Packed JSON.
+  @param   nbytes Size of packed JSON in bytes.
+  @return  Pointer to parsed info with reference added, OS_NULL if not in cache.
+
+****************************************************************************************************
+*/
+eioInfo *eioInfoCache::get(
+    os_uint hash,
+    const os_char *buf,
+    os_memsz nbytes)
+{
+    eioInfo *info;
+
+    for (info = m_first; info; info = info->m_next) {
+        if (info->matches(hash, buf, nbytes)) {
+            info->m_nrefs++;
+            return info;
+        }
+    }
+    return OS_NULL;
+}
+
+
+/**
+****************************************************************************************************
+  Add newly parsed info block to cache. The caller holds the initial reference.
+****************************************************************************************************
+*/
+void eioInfoCache::add(
+    eioInfo *info)
+{
+    info->m_cache = this;
+    info->m_next = m_first;
+    m_first = info;
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Release reference to info.
+
+  When the last device using the info releases it, it is removed from cache and deleted.
+  Static function, since eioDevice may release it's info without access to the cache.
+
+  @param   info Info to release, OS_NULL is ignored.
+
+****************************************************************************************************
+*/
+void eioInfoCache::release(
+    eioInfo *info)
+{
+    eioInfo **pp;
+
+    if (info == OS_NULL) return;
+    if (--info->m_nrefs > 0) return;
+
+    if (info->m_cache) for (pp = &info->m_cache->m_first; *pp; pp = &(*pp)->m_next) {
+        if (*pp == info) {
+            *pp = info->m_next;
+            break;
+        }
+    }
+    delete info;
+}
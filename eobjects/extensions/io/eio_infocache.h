@@ -0,0 +1,188 @@
+/**
+
+  @file    eio_infocache.h
+  @brief   Cache of parsed device information blocks.
+  @author  Pekka Lehtikoski
+  @version 1.0
+  @date    18.10.2026
+
+  Copyright 2020 Pekka Lehtikoski. This file is part of the eobjects project and shall only be used,
+  modified, and distributed under the terms of the project licensing. By continuing to use, modify,
+  or distribute this file you indicate that you have read the license and understand and accept
+  it fully.
+
+****************************************************************************************************
+*/
+#pragma once
+#ifndef EIO_INFOCACHE_H_
+#define EIO_INFOCACHE_H_
+#include "extensions/io/eio.h"
+
+class eioInfoCache;
+
+/* Signal parsed from info block.
+ */
+typedef struct eioInfoSignal
+{
+    const os_char *mblk_name;
+    eioSignalInfo sinfo;
+}
+eioInfoSignal;
+
+/* Memory block parsed from info block, max_addr is first unused address.
+ */
+typedef struct eioInfoMblk
+{
+    const os_char *mblk_name;
+    os_int max_addr;
+}
+eioInfoMblk;
+
+
+/**
+****************************************************************************************************
+  eioInfo holds signals, memory blocks and assemblies parsed from one info block. Strings
+  point to copy of the packed JSON kept by this object. Devices with identical info block
+  share the same eioInfo.
+****************************************************************************************************
+*/
+class eioInfo
+{
+public:
+    /* Constructor, copies packed JSON.
+     */
+    eioInfo(
+        os_uint hash,
+        const os_char *buf,
+        os_memsz nbytes);
+
+    /* Destructor.
+     */
+    ~eioInfo();
+
+    /* Check if this was parsed from given info block.
+     */
+    os_boolean matches(
+        os_uint hash,
+        const os_char *buf,
+        os_memsz nbytes);
+
+    /* Add parsed items.
+     */
+    void add_signal(
+        const os_char *mblk_name,
+        eioSignalInfo *sinfo);
+
+    void add_mblk(
+        const os_char *mblk_name,
+        os_int max_addr);
+
+    void add_assembly(
+        eioAssemblyParams *prm);
+
+    /* Find signal by memory block and signal name, -1 if not found.
+     */
+    os_int find_signal(
+        eioInfoSignal *s,
+        os_int hint_ix);
+
+    /* Find signal which maps to the same IO variable (group and signal name without
+       "set_" prefix), -1 if not found.
+     */
+    os_int find_variable(
+        eioInfoSignal *s);
+
+    /* Find assembly by name, -1 if not found.
+     */
+    os_int find_assembly(
+        const os_char *name);
+
+    /* Copy of packed JSON, parsed from this buffer.
+     */
+    inline os_char *buf() {return m_buf; }
+    inline os_memsz nbytes() {return m_nbytes; }
+
+    /* Parsed items.
+     */
+    inline os_int nsignals() {return m_nsignals; }
+    inline eioInfoSignal *signal(os_int ix) {return m_signals + ix; }
+    inline os_int nmblks() {return m_nmblks; }
+    inline eioInfoMblk *mblk(os_int ix) {return m_mblks + ix; }
+    inline os_int nassemblies() {return m_nassemblies; }
+    inline eioAssemblyParams *assembly(os_int ix) {return m_assemblies + ix; }
+
+protected:
+    friend class eioInfoCache;
+
+    /* Make room for one more item in array.
+     */
+    void *grow(
+        void *arr,
+        os_int n,
+        os_int *alloc_n,
+        os_memsz item_sz);
+
+    /* Content hash and copy of packed JSON.
+     */
+    os_uint m_hash;
+    os_char *m_buf;
+    os_memsz m_nbytes;
+
+    /* Parsed signals, memory blocks and assemblies, number used and allocated.
+     */
+    eioInfoSignal *m_signals;
+    os_int m_nsignals, m_signals_alloc;
+    eioInfoMblk *m_mblks;
+    os_int m_nmblks, m_mblks_alloc;
+    eioAssemblyParams *m_assemblies;
+    os_int m_nassemblies, m_assemblies_alloc;
+
+    /* Number of devices using this info, cache holding this info and next info in cache.
+     */
+    os_int m_nrefs;
+    eioInfoCache *m_cache;
+    eioInfo *m_next;
+};
+
+
+/**
+****************************************************************************************************
+  eioInfoCache keeps parsed info blocks in use, keyed by content hash. An info block is
+  parsed once, however many devices send the same one.
+****************************************************************************************************
+*/
+class eioInfoCache
+{
+public:
+    /* Constructor.
+     */
+    eioInfoCache();
+
+    /* Destructor.
+     */
+    ~eioInfoCache();
+
+    /* Find parsed info block and add reference to it, OS_NULL if not cached.
+     */
+    eioInfo *get(
+        os_uint hash,
+        const os_char *buf,
+        os_memsz nbytes);
+
+    /* Add newly parsed info block to cache, with one reference.
+     */
+    void add(
+        eioInfo *info);
+
+    /* Release reference, info is deleted when no longer used.
+     */
+    static void release(
+        eioInfo *info);
+
+protected:
+    /* Cached info blocks.
+     */
+    eioInfo *m_first;
+};
+
+#endif
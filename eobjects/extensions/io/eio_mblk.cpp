@@ -33,6 +33,11 @@ eioMblk::eioMblk(
     m_mblk_flags = 0;
     m_eio_root = OS_NULL;
     m_connected = OS_FALSE;
+    os_memclear(m_received, sizeof(m_received));
+    m_shadow = OS_NULL;
+    m_shadow_nbytes = 0;
+    m_changed = OS_NULL;
+    m_nscanned = m_nchanged = 0;
 
     initproperties();
     ns_create();
@@ -46,11 +51,16 @@ eioMblk::eioMblk(
 */
 eioMblk::~eioMblk()
 {
+    if (m_eio_root) {
+        m_eio_root->unqueue_received(this);
+    }
+
     if (m_handle_set) {
         ioc_remove_callback(&m_handle, callback, this);
         ioc_release_handle(&m_handle);
         m_handle_set = OS_FALSE;
     }
+    alloc_shadow(0);
 }
 
 
@@ -76,6 +86,8 @@ void eioMblk::setupclass()
     eclasslist_add(cls, (eNewObjFunc)OS_NULL, "eioMblk", ECLASSID_CONTAINER);
     addpropertys(cls, ECONTP_TEXT, econtp_text, "text", EPRO_PERSISTENT|EPRO_NOONPRCH);
     addpropertyb(cls, EIOP_CONNECTED, eiop_connected, "connected", EPRO_SIMPLE|EPRO_RDONLY);
+    addpropertyl(cls, EIOP_NSCANNED, eiop_nscanned, "signals scanned", EPRO_SIMPLE|EPRO_RDONLY);
+    addpropertyl(cls, EIOP_NCHANGED, eiop_nchanged, "signals changed", EPRO_SIMPLE|EPRO_RDONLY);
     propertysetdone(cls);
     os_unlock();
 }
@@ -143,6 +155,14 @@ eStatus eioMblk::simpleproperty(
             x->setl(m_connected);
             break;
 
+        case EIOP_NSCANNED:
+            x->setl(m_nscanned);
+            break;
+
+        case EIOP_NCHANGED:
+            x->setl(m_nchanged);
+            break;
+
         default:
             return eContainer::simpleproperty(propertynr, x);
     }
@@ -208,12 +228,21 @@ void eioMblk::disconnected(
         }
     }
 
+    if (m_eio_root) {
+        m_eio_root->unqueue_received(this);
+    }
+
     if (m_handle_set) {
         ioc_remove_callback(&m_handle, callback, this);
         ioc_release_handle(&m_handle);
         m_handle_set = OS_FALSE;
     }
 
+    /* Shadow copy is reallocated when data is received after reconnect, so that all
+       signals are updated.
+     */
+    alloc_shadow(0);
+
     setpropertyl(EIOP_CONNECTED, OS_FALSE);
 }
 
@@ -235,6 +264,26 @@ eContainer *eioMblk::esignals()
 }
 
 
+/**
+****************************************************************************************************
+
+  @brief Callback when memory block data is received or triggered.
+
+  The eioMblk::callback() function is called by IOCOM with ioc_lock() on. It doesn't touch
+  object tree and doesn't take os_lock(): Received address range is only queued for the IO
+  thread, which moves data to signals by signals_up(). This way IO data transfer doesn't
+  stall other threads which need os_lock(), and vice versa.
+
+  @param   handle Memory block handle.
+  @param   start_addr Address of first changed byte.
+  @param   end_addr Address of the last changed byte.
+  @param   flags IOC_MBLK_CALLBACK_RECEIVE, etc.
+  @param   context Pointer to eioMblk.
+
+  @return  None.
+
+****************************************************************************************************
+*/
 void eioMblk::callback(
     struct iocHandle *handle,
     os_int start_addr,
@@ -242,67 +291,336 @@ void eioMblk::callback(
     os_ushort flags,
     void *context)
 {
-    eObject *f, *l, *sig;
     eioMblk *t;
-    eioSignal *p;
-    eContainer *esignals;
+    OSAL_UNUSED(handle);
 
-    if ((flags & (IOC_MBLK_CALLBACK_RECEIVE|IOC_MBLK_CALLBACK_WRITE_TRIGGER|
-        IOC_MBLK_CALLBACK_RECEIVE_TRIGGER)) == 0)
-    {
+    t = (eioMblk*)context;
+    if (t->m_eio_root == OS_NULL) {
         return;
     }
 
-    os_lock();
+    if (flags & IOC_MBLK_CALLBACK_RECEIVE) {
+        t->m_eio_root->queue_received(t, start_addr, end_addr);
+    }
 
-    t = (eioMblk*)context;
+    else if (flags & (IOC_MBLK_CALLBACK_WRITE_TRIGGER|IOC_MBLK_CALLBACK_RECEIVE_TRIGGER)) {
+        t->m_eio_root->trig_io();
+    }
+}
 
-    if (flags & (IOC_MBLK_CALLBACK_WRITE_TRIGGER|IOC_MBLK_CALLBACK_RECEIVE_TRIGGER))
-    {
-        if (t->m_eio_root) {
-            t->m_eio_root->trig_io();
-        }
+
+/**
+****************************************************************************************************
+
+  @brief Move received data to signals.
+
+  The eioMblk::signals_up() function finds signals which overlap the address range, and calls
+  up() for those whose bytes (value or state bits) have really changed. Received bytes are
+  compared to shadow copy of the memory block, and changed bytes are marked in a bitmap.
+  Signals are ordered by address (object identifier), a signal's bytes are tested up to the
+  next signal's address. On first data after connect or resize, the whole memory block is
+  taken as shadow copy and all signals are updated, not only those in the address range:
+  Bytes outside the range would not be seen as changed later. Both os_lock() and ioc_lock()
+  must be on when this function is called.
+
+  @param   start_addr Address of first changed byte.
+  @param   end_addr Address of the last changed byte.
+
+****************************************************************************************************
+*/
+void eioMblk::signals_up(
+    os_int start_addr,
+    os_int end_addr)
+{
+    eObject *f, *l, *sig, *next_sig;
+    eioSignal *p;
+    iocMemoryBlock *mblk;
+    os_int sig_end_addr;
+    os_boolean all_changed;
+
+    mblk = m_handle.mblk;
+    if (m_esignals == OS_NULL || mblk == OS_NULL) {
+        return;
+    }
+    if (start_addr < 0) start_addr = 0;
+    if (end_addr >= mblk->nbytes) end_addr = mblk->nbytes - 1;
+    if (start_addr > end_addr) {
+        return;
     }
 
-    if (flags & IOC_MBLK_CALLBACK_RECEIVE) {
-        esignals = t->m_esignals;
-        if (esignals == OS_NULL) {
-            goto getout;
-        }
+    /* First data after connect or resize: Take shadow copy and update all signals.
+     */
+    all_changed = (os_boolean)(m_shadow_nbytes != mblk->nbytes);
+    if (all_changed) {
+        alloc_shadow(mblk->nbytes);
+        os_memcpy(m_shadow, mblk->buf, mblk->nbytes);
+        start_addr = 0;
+        end_addr = mblk->nbytes - 1;
+    }
+    else if (!diff_shadow(mblk->buf, start_addr, end_addr)) {
+        return;
+    }
 
-        f = esignals->first(start_addr, OS_FALSE);
-        if (f) {
-            f = f->prev();
-        }
-        if (f == OS_NULL) {
-            f = esignals->first(0, OS_FALSE);
-            if (f == OS_NULL) goto getout;
-        }
+    f = m_esignals->first(start_addr, OS_FALSE);
+    if (f) {
+        f = f->prev();
+    }
+    if (f == OS_NULL) {
+        f = m_esignals->first(0, OS_FALSE);
+        if (f == OS_NULL) goto getout;
+    }
 
-        l = esignals->first(end_addr, OS_FALSE);
-        if (l == OS_NULL) {
-            l = esignals->last();
-            if (l == OS_NULL) goto getout;
+    l = m_esignals->first(end_addr, OS_FALSE);
+    if (l == OS_NULL) {
+        l = m_esignals->last();
+        if (l == OS_NULL) goto getout;
+    }
+
+    sig = f;
+    while (sig)
+    {
+        for (next_sig = sig->next(); next_sig; next_sig = next_sig->next()) {
+            if (next_sig->classid() == ECLASSID_EIO_SIGNAL) break;
         }
 
-        sig = f;
-        while (sig)
+        if (sig->classid() == ECLASSID_EIO_SIGNAL)
         {
-            if (sig->classid() == ECLASSID_EIO_SIGNAL)
+            p = (eioSignal*)sig;
+            if (ioc_is_my_address(p->iosignal(), start_addr, end_addr))
             {
-                p = (eioSignal*)sig;
-                if (ioc_is_my_address(p->iosignal(), start_addr, end_addr)) {
+                m_nscanned++;
+                sig_end_addr = next_sig
+                    ? ((eioSignal*)next_sig)->iosignal()->addr - 1 : mblk->nbytes - 1;
+                if (all_changed || is_changed(p->iosignal()->addr, sig_end_addr)) {
+                    m_nchanged++;
                     p->up();
                 }
             }
+        }
 
-            if (sig == l) {
-                break;
-            }
-            sig = sig->next();
+        if (sig == l) {
+            break;
         }
+        sig = next_sig;
     }
+
 getout:
-    os_unlock();
-    return;
+    if (!all_changed) {
+        clear_changed(start_addr, end_addr);
+    }
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Compare received bytes to shadow copy.
+
+  The eioMblk::diff_shadow() function compares received bytes within address range to the
+  shadow copy, marks changed bytes in changed address bitmap and updates the shadow copy.
+  Middle part is compared in blocks of up to EIO_MBLK_DIFF_BLOCK_SZ bytes: Differences of
+  eight byte words are OR-ed together without branches, so the compiler can vectorize the
+  loop, and only a block with difference is compared byte by byte. Unchanged data, which is
+  the common case, costs one test per block. Words are loaded with os_memcpy(), so the
+  memory block buffer need not be aligned; the compiler turns the copy into a plain load
+  where the CPU allows unaligned access.
+
+  @param   buf Memory block data.
+  @param   start_addr Address of first received byte.
+  @param   end_addr Address of the last received byte, must be within shadow copy.
+  @return  OS_TRUE if any byte has changed.
+
+****************************************************************************************************
+*/
+os_boolean eioMblk::diff_shadow(
+    const os_char *buf,
+    os_int start_addr,
+    os_int end_addr)
+{
+    os_ulong wb, ws, diff;
+    os_int addr, word_end, n, i;
+    os_boolean changed;
+
+    changed = OS_FALSE;
+    addr = start_addr;
+    while (addr <= end_addr)
+    {
+        /* Compare block of whole words within range. Head and tail bytes which do not
+           fill a word are compared one by one below.
+         */
+        if ((addr & 7) == 0 && addr + 7 <= end_addr)
+        {
+            n = (end_addr + 1 - addr) & ~7;
+            if (n > EIO_MBLK_DIFF_BLOCK_SZ) n = EIO_MBLK_DIFF_BLOCK_SZ;
+            diff = 0;
+            for (i = 0; i < n; i += 8) {
+                os_memcpy(&wb, buf + addr + i, sizeof(wb));
+                os_memcpy(&ws, m_shadow + addr + i, sizeof(ws));
+                diff |= wb ^ ws;
+            }
+            word_end = addr + n;
+            if (diff == 0) {
+                addr = word_end;
+                continue;
+            }
+        }
+        else {
+            word_end = addr + 1;
+        }
+
+        /* Mark changed bytes.
+         */
+        for (i = addr; i < word_end; i++) {
+            if (buf[i] != m_shadow[i]) {
+                m_shadow[i] = buf[i];
+                m_changed[i >> 5] |= 1U << (i & 31);
+                changed = OS_TRUE;
+            }
+        }
+        addr = word_end;
+    }
+
+    return changed;
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Update shadow copy after local write to memory block.
+
+  The eioMblk::shadow_written() function is called after a signal has been written to the
+  memory block by this process. Written bytes are copied to the shadow copy, so that data
+  received later is compared to what is really in the memory block. Otherwise a received
+  value equal to the value before the local write would not be seen as a change.
+  ioc_lock() must be on when this function is called.
+
+  @param   start_addr Address of first written byte.
+  @param   end_addr Address of the last written byte.
+
+****************************************************************************************************
+*/
+void eioMblk::shadow_written(
+    os_int start_addr,
+    os_int end_addr)
+{
+    iocMemoryBlock *mblk;
+
+    /* No shadow copy yet: All signals are updated from first received data.
+     */
+    mblk = m_handle.mblk;
+    if (mblk == OS_NULL || m_shadow_nbytes != mblk->nbytes) {
+        return;
+    }
+
+    if (start_addr < 0) start_addr = 0;
+    if (end_addr >= mblk->nbytes) end_addr = mblk->nbytes - 1;
+    if (start_addr > end_addr) {
+        return;
+    }
+
+    os_memcpy(m_shadow + start_addr, mblk->buf + start_addr, end_addr - start_addr + 1);
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Check if any byte within address range has changed.
+
+  The eioMblk::is_changed() function tests bits of changed address bitmap, 32 bytes at a time.
+
+  @param   start_addr Address of first byte to check.
+  @param   end_addr Address of the last byte to check, must be within shadow copy.
+  @return  OS_TRUE if any byte within range is marked changed.
+
+****************************************************************************************************
+*/
+os_boolean eioMblk::is_changed(
+    os_int start_addr,
+    os_int end_addr)
+{
+    os_uint mask;
+    os_int w, end_w;
+
+    if (start_addr > end_addr) {
+        return OS_FALSE;
+    }
+
+    w = start_addr >> 5;
+    end_w = end_addr >> 5;
+    mask = ~0U << (start_addr & 31);
+    while (OS_TRUE) {
+        if (w == end_w) {
+            mask &= ~0U >> (31 - (end_addr & 31));
+            return (os_boolean)((m_changed[w] & mask) != 0);
+        }
+        if (m_changed[w] & mask) {
+            return OS_TRUE;
+        }
+        mask = ~0U;
+        w++;
+    }
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Clear changed bits of address range.
+
+  The eioMblk::clear_changed() function is called after signals within range have been
+  processed. Whole 32 bit words are cleared, bits are set only within the range being
+  processed.
+
+  @param   start_addr Address of first byte.
+  @param   end_addr Address of the last byte.
+
+****************************************************************************************************
+*/
+void eioMblk::clear_changed(
+    os_int start_addr,
+    os_int end_addr)
+{
+    os_int w, end_w;
+
+    end_w = end_addr >> 5;
+    for (w = start_addr >> 5; w <= end_w; w++) {
+        m_changed[w] = 0;
+    }
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Allocate or free shadow copy and changed address bitmap.
+
+  The eioMblk::alloc_shadow() function releases current shadow copy and bitmap, and allocates
+  new ones for memory block size given as argument. Bitmap is cleared.
+
+  @param   nbytes Memory block size in bytes, 0 to just release.
+
+****************************************************************************************************
+*/
+void eioMblk::alloc_shadow(
+    os_int nbytes)
+{
+    os_memsz bitmap_sz;
+
+    if (m_shadow) {
+        os_free(m_shadow, m_shadow_nbytes);
+        os_free(m_changed, ((m_shadow_nbytes + 31) >> 5) * sizeof(os_uint));
+        m_shadow = OS_NULL;
+        m_changed = OS_NULL;
+        m_shadow_nbytes = 0;
+    }
+
+    if (nbytes > 0) {
+        bitmap_sz = ((nbytes + 31) >> 5) * sizeof(os_uint);
+        m_shadow = os_malloc(nbytes, OS_NULL);
+        m_changed = (os_uint*)os_malloc(bitmap_sz, OS_NULL);
+        os_memclear(m_changed, bitmap_sz);
+        m_shadow_nbytes = nbytes;
+    }
 }
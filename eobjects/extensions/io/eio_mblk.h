@@ -18,6 +18,23 @@
 #define EIO_MBLK_H_
 #include "extensions/io/eio.h"
 
+/* Maximum number of bytes compared to shadow copy as one block, multiple of eight.
+ */
+#define EIO_MBLK_DIFF_BLOCK_SZ 64
+
+/* Received address range waiting for IO thread. There is one for each half of eioRoot's
+   double buffered received data queue, protected by eioRoot::io_lock().
+ */
+typedef struct eioMblkReceived
+{
+    class eioMblk *next;        /* Next memory block in the same queue. */
+    os_int start_addr;          /* First received address. */
+    os_int end_addr;            /* Last received address. */
+    os_boolean queued;          /* Memory block is in the queue. */
+}
+eioMblkReceived;
+
+
 /**
 ****************************************************************************************************
   eioMblk is like a box of objects.
@@ -83,6 +100,22 @@ public:
     inline iocHandle *handle_ptr() {return &m_handle;}
     inline os_short mblk_flags() {return m_mblk_flags; }
 
+    /* Received data queue entry, ix selects half of the double buffer.
+     */
+    inline eioMblkReceived *received(os_int ix) {return m_received + ix; }
+
+    /* Move received data from memory block to signals within address range.
+     */
+    void signals_up(
+        os_int start_addr,
+        os_int end_addr);
+
+    /* Update shadow copy after signal has been written to memory block by this process.
+     */
+    void shadow_written(
+        os_int start_addr,
+        os_int end_addr);
+
 protected:
     /**
     ************************************************************************************************
@@ -96,6 +129,30 @@ protected:
         os_ushort flags,
         void *context);
 
+    /* Compare received bytes to shadow copy and mark changed ones in bitmap.
+     */
+    os_boolean diff_shadow(
+        const os_char *buf,
+        os_int start_addr,
+        os_int end_addr);
+
+    /* Check if any byte within address range has changed.
+     */
+    os_boolean is_changed(
+        os_int start_addr,
+        os_int end_addr);
+
+    /* Clear changed bits of address range.
+     */
+    void clear_changed(
+        os_int start_addr,
+        os_int end_addr);
+
+    /* Allocate or free shadow copy and changed address bitmap.
+     */
+    void alloc_shadow(
+        os_int nbytes);
+
     /**
     ************************************************************************************************
       Member variables
@@ -109,6 +166,23 @@ protected:
 
     eContainer *m_esignals;
 
+    /* Received address ranges queued for IO thread.
+     */
+    eioMblkReceived m_received[2];
+
+    /* Shadow copy of memory block content, to find which signals have really changed.
+     */
+    os_char *m_shadow;
+    os_int m_shadow_nbytes;
+
+    /* Changed address bitmap, one bit for each byte of the memory block.
+     */
+    os_uint *m_changed;
+
+    /* Number of signals within received address ranges, and number of those which changed.
+     */
+    os_long m_nscanned;
+    os_long m_nchanged;
 
 };
 
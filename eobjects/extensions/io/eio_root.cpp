@@ -30,7 +30,12 @@ eioRoot::eioRoot(
     m_time_now = 0;
     m_io_trigger = OS_NULL;
     m_run_assemblies = new eContainer(ETEMPORARY);
+    m_has_run_assemblies = OS_FALSE;
     m_iocom_root = OS_NULL;
+    m_io_lock = osal_mutex_create();
+    m_received[0] = m_received[1] = OS_NULL;
+    m_received_ix = 0;
+    m_info_cache = new eioInfoCache();
 
     initproperties();
     ns_create();
@@ -46,6 +51,13 @@ eioRoot::~eioRoot()
 {
 // Remove root callback
     delete m_run_assemblies;
+
+    /* Delete child objects here, memory blocks use IO lock when deleted. Devices release
+       their info before the info cache is deleted.
+     */
+    clear();
+    delete m_info_cache;
+    osal_mutex_delete(m_io_lock);
 }
 
 
@@ -225,6 +237,28 @@ eioNetwork *eioRoot::get_network(
 }
 
 
+/**
+****************************************************************************************************
+  Find or create IO device object by device name and number, OS_NULL if names are not set.
+****************************************************************************************************
+*/
+eioDevice *eioRoot::get_device(
+    eioMblkInfo *minfo)
+{
+    os_char buf[IOC_DEVICE_ID_SZ], nbuf[OSAL_NBUF_SZ];
+
+    if (minfo->network_name[0] == '\0' || minfo->device_name[0] == '\0') {
+        return OS_NULL;
+    }
+
+    os_strncpy(buf, minfo->device_name, sizeof(buf));
+    osal_int_to_str(nbuf, sizeof(nbuf), minfo->device_nr);
+    os_strncat(buf, nbuf, sizeof(buf));
+
+    return get_network(minfo->network_name)->get_device(buf);
+}
+
+
 void eioRoot::run(
     os_long ti)
 {
@@ -245,6 +279,8 @@ void eioRoot::run(
         assembly = eioAssembly::cast(ref);
         assembly->run(ti);
     }
+
+    m_has_run_assemblies = (os_boolean)(m_run_assemblies->first() != OS_NULL);
 }
 
 
@@ -278,6 +314,149 @@ void eioRoot::assembly_to_run_list(
     if (enable) {
         p = new ePointer(m_run_assemblies);
         p->set(assembly);
+        m_has_run_assemblies = OS_TRUE;
+    }
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Queue received address range of memory block for IO thread.
+
+  The eioRoot::queue_received() function is called from IOCOM callback when data is received
+  for a memory block. Memory block is added to the received data queue being filled, or if it
+  is already there, the address range is extended. IO thread is triggered to process it.
+
+  Only IO lock is taken, so IOCOM doesn't need to wait for os_lock().
+
+  @param   mblk Memory block object.
+  @param   start_addr Address of first changed byte.
+  @param   end_addr Address of the last changed byte.
+
+****************************************************************************************************
+*/
+void eioRoot::queue_received(
+    eioMblk *mblk,
+    os_int start_addr,
+    os_int end_addr)
+{
+    eioMblkReceived *r;
+    os_int ix;
+
+    io_lock();
+    ix = m_received_ix;
+    r = mblk->received(ix);
+    if (r->queued) {
+        if (start_addr < r->start_addr) r->start_addr = start_addr;
+        if (end_addr > r->end_addr) r->end_addr = end_addr;
+    }
+    else {
+        r->start_addr = start_addr;
+        r->end_addr = end_addr;
+        r->queued = OS_TRUE;
+        r->next = m_received[ix];
+        m_received[ix] = mblk;
+    }
+    io_unlock();
+
+    trig_io();
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Remove memory block from received data queues.
+
+  The eioRoot::unqueue_received() function is called when memory block is disconnected or
+  deleted, so that IO thread will not access it.
+
+  @param   mblk Memory block object.
+
+****************************************************************************************************
+*/
+void eioRoot::unqueue_received(
+    eioMblk *mblk)
+{
+    eioMblk **pp;
+    os_int ix;
+
+    io_lock();
+    for (ix = 0; ix < 2; ix++)
+    {
+        if (!mblk->received(ix)->queued) continue;
+
+        for (pp = m_received + ix; *pp; pp = &(*pp)->received(ix)->next) {
+            if (*pp == mblk) {
+                *pp = mblk->received(ix)->next;
+                break;
+            }
+        }
+        mblk->received(ix)->queued = OS_FALSE;
+    }
+    io_unlock();
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Move queued received data to signals.
+
+  The eioRoot::process_received() function is called by IO thread. It swaps the double
+  buffered received data queues, so IOCOM callbacks fill the other one, and moves data of
+  queued address ranges to signals. Locks are taken one memory block at a time, so other
+  threads get os_lock() between memory blocks. Lock order is ioc_lock(), os_lock(), io_lock().
+
+****************************************************************************************************
+*/
+void eioRoot::process_received()
+{
+    eioMblk *mblk;
+    eioMblkReceived *r;
+    os_int ix, start_addr, end_addr;
+
+    start_addr = end_addr = 0;
+
+    io_lock();
+    ix = m_received_ix;
+    m_received_ix = 1 - ix;
+    mblk = m_received[ix];
+    io_unlock();
+
+    /* Nothing received is the common case, return without taking ioc_lock() and os_lock().
+     */
+    while (mblk)
+    {
+        ioc_lock(m_iocom_root);
+        os_lock();
+
+        /* Check again, unqueue_received() may have removed the memory block meanwhile.
+         */
+        io_lock();
+        mblk = m_received[ix];
+        if (mblk) {
+            r = mblk->received(ix);
+            m_received[ix] = r->next;
+            start_addr = r->start_addr;
+            end_addr = r->end_addr;
+            r->queued = OS_FALSE;
+        }
+        io_unlock();
+
+        if (mblk) {
+            mblk->signals_up(start_addr, end_addr);
+        }
+
+        os_unlock();
+        ioc_unlock(m_iocom_root);
+
+        /* Peek the next one without ioc_lock() and os_lock().
+         */
+        io_lock();
+        mblk = m_received[ix];
+        io_unlock();
     }
 }
 
@@ -342,13 +521,6 @@ void eioRoot::new_signal(
     eioSignalInfo *sinfo)
 {
     eioMblk *mblk;
-    eioSignal *signal;
-    eioDevice *device;
-    eioGroup *group;
-    eioVariable *variable;
-    eContainer *esignals;
-    eName *name;
-    const os_char *signal_name;
 
     mblk = connected(minfo);
     if (mblk == OS_NULL) {
@@ -356,6 +528,38 @@ void eioRoot::new_signal(
         return;
     }
 
+    setup_signal(eioDevice::cast(mblk->grandparent()), mblk, minfo, sinfo);
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Create or update IO signal and variable objects for a signal.
+
+  The eioRoot::setup_signal() function finds or creates IO group, variable and signal objects
+  for the signal and sets them up. Signal object is recreated if address has changed.
+
+  @param   device IO device object.
+  @param   mblk Memory block object for the signal, child of device.
+  @param   minfo Memory block information.
+  @param   sinfo Signal information.
+
+****************************************************************************************************
+*/
+void eioRoot::setup_signal(
+    eioDevice *device,
+    eioMblk *mblk,
+    eioMblkInfo *minfo,
+    eioSignalInfo *sinfo)
+{
+    eioSignal *signal;
+    eioGroup *group;
+    eioVariable *variable;
+    eContainer *esignals;
+    eName *name;
+    const os_char *signal_name;
+
     /* Skip "set_" in signal name. We are merging in and out of parameter settings
        as one variable.
      */
@@ -364,8 +568,6 @@ void eioRoot::new_signal(
         signal_name += 4;
     }
 
-    device = eioDevice::cast(mblk->grandparent());
-
     group = eioGroup::cast(device->io()->byname(sinfo->group_name));
     if (group == OS_NULL) {
         group = new eioGroup(device->io());
@@ -404,48 +606,112 @@ void eioRoot::new_signal(
 }
 
 
+/**
+****************************************************************************************************
+
+  @brief Delete IO signal which is no longer in device info.
+
+  The eioRoot::delete_signal() function deletes IO signal object. The IO variable is deleted
+  too, unless another signal in new info maps to it (parameter "set_x" and "x" share
+  variable "x").
+
+  @param   device IO device object.
+  @param   s Signal from old info.
+  @param   info New info.
+
+****************************************************************************************************
+*/
+void eioRoot::delete_signal(
+    eioDevice *device,
+    eioInfoSignal *s,
+    eioInfo *info)
+{
+    eContainer *mblks;
+    eioMblk *mblk;
+    eObject *group;
+    const os_char *signal_name;
+
+    mblks = device->mblks();
+    if (mblks) {
+        mblk = eioMblk::cast(mblks->byname(s->mblk_name));
+        if (mblk) {
+            delete mblk->esignals()->byname(s->sinfo.signal_name);
+        }
+    }
+
+    if (info->find_variable(s) >= 0) return;
+
+    group = device->io()->byname(s->sinfo.group_name);
+    if (group) {
+        signal_name = s->sinfo.signal_name;
+        if (!os_strncmp(signal_name, "set_", 4)) {
+            signal_name += 4;
+        }
+        delete group->byname(signal_name);
+    }
+}
+
+
 /**
 ****************************************************************************************************
 
   @brief Add a new assebly to under eioDevice.
 
+  If an assembly with the same name and kind already exists, it is set up again instead of
+  creating a new one, so that bindings to it (like a camera view) are kept over reconnect.
+
+  @param   device IO device object.
+  @param   prm Assembly parameters.
+
 ****************************************************************************************************
 */
 void eioRoot::new_assembly(
-    const os_char *device_id,
-    const os_char *network_name,
+    eioDevice *device,
     struct eioAssemblyParams *prm)
 {
-    eioNetwork *network;
-    eioDevice *device;
     eContainer *assemblies;
     eioAssembly *assembly;
+    eName *name;
     eVariable tmp;
+    os_int cid;
 
-    network = get_network(network_name);
-    if (network == OS_NULL) return;
-    device = network->get_device(device_id);
-    if (device == OS_NULL) return;
     assemblies = device->assemblies();
     if (assemblies == OS_NULL) return;
 
-    assembly = eioAssembly::cast(assemblies->byname(prm->name));
-    delete assembly;
-
     if (os_strstr(prm->type_str, "_flat", OSAL_STRING_DEFAULT) ||
         os_strstr(prm->type_str, "_ring", OSAL_STRING_DEFAULT))
     {
-        assembly = new eioBrickBuffer(assemblies);
+        cid = ECLASSID_EIO_BRICK_BUFFER;
     }
     else {
-        assembly = new eioSignalAssembly(assemblies);
+        cid = ECLASSID_EIO_SIGNAL_ASSEMBLY;
+    }
+
+    assembly = eioAssembly::cast(assemblies->byname(prm->name));
+    if (assembly) if (assembly->classid() != cid) {
+        delete assembly;
+        assembly = OS_NULL;
+    }
+
+    if (assembly == OS_NULL)
+    {
+        if (cid == ECLASSID_EIO_BRICK_BUFFER) {
+            assembly = new eioBrickBuffer(assemblies);
+        }
+        else {
+            assembly = new eioSignalAssembly(assemblies);
+        }
+
+        name = device->primaryname();
+        if (name) {
+            tmp = *name;
+            tmp += " ";
+        }
+        tmp += prm->name;
+        assembly->setpropertyv(EVARP_TEXT, &tmp);
+        assembly->addname(prm->name);
     }
 
-    tmp = device_id;
-    tmp += " ";
-    tmp += prm->name;
-    assembly->setpropertyv(EVARP_TEXT, &tmp);
-    assembly->addname(prm->name);
     assembly->setup(prm, m_iocom_root);
 }
 
@@ -20,6 +20,9 @@
 
 struct eioInfoParserState;
 struct eioAssemblyParams;
+struct eioInfoSignal;
+class eioInfo;
+class eioInfoCache;
 
 /**
 ****************************************************************************************************
@@ -98,8 +101,11 @@ public:
 
     inline iocRoot *iocom_root() {return m_iocom_root; }
 
-    inline void set_time_now(os_long ti) { m_time_now = ti; }
-    inline os_long time_now() {return m_time_now; }
+    /* Time stamp for signal changes. Written by IO thread and read by other threads, io_lock()
+       is taken since 64 bit write may not be atomic on 32 bit platforms.
+     */
+    inline void set_time_now(os_long ti) {io_lock(); m_time_now = ti; io_unlock(); }
+    inline os_long time_now() {os_long ti; io_lock(); ti = m_time_now; io_unlock(); return ti; }
 
     inline osalEvent io_trigger() {return m_io_trigger; }
     inline void save_io_trigger(osalEvent io_trigger) {m_io_trigger = io_trigger; }
@@ -107,6 +113,33 @@ public:
 
     void run(os_long ti);
 
+    /* Check if there are assemblies to run. Read by IO thread without os_lock(), a change
+       seen late only delays assembly by one IO loop.
+     */
+    inline os_boolean has_run_assemblies() {return m_has_run_assemblies; }
+
+    /* IO lock protects received data queues shared by IOCOM callbacks and IO thread.
+       It is held only briefly and no other lock may be taken while it is on.
+     */
+    inline void io_lock() {osal_mutex_lock(m_io_lock); }
+    inline void io_unlock() {osal_mutex_unlock(m_io_lock); }
+
+    /* Queue received address range of memory block for IO thread (IOCOM callback).
+     */
+    void queue_received(
+        eioMblk *mblk,
+        os_int start_addr,
+        os_int end_addr);
+
+    /* Remove memory block from received data queues.
+     */
+    void unqueue_received(
+        eioMblk *mblk);
+
+    /* Move queued received data to signals (IO thread).
+     */
+    void process_received();
+
     /* Add or remove an assebly to run list.
      */
     void assembly_to_run_list(
@@ -141,6 +174,11 @@ protected:
     eioNetwork *get_network(
         const os_char *network_name);
 
+    /* Find or create IO device object by device name and number.
+     */
+    eioDevice *get_device(
+        eioMblkInfo *minfo);
+
     /* Mark network object disconnected and delete it, if it is unused.
      */
     void disconnected(
@@ -150,9 +188,23 @@ protected:
         eioMblkInfo *minfo,
         eioSignalInfo *sinfo);
 
+    /* Create or update IO signal and variable objects for a signal.
+     */
+    void setup_signal(
+        eioDevice *device,
+        eioMblk *mblk,
+        eioMblkInfo *minfo,
+        eioSignalInfo *sinfo);
+
+    /* Delete IO signal, and IO variable if no signal in info maps to it.
+     */
+    void delete_signal(
+        eioDevice *device,
+        struct eioInfoSignal *s,
+        eioInfo *info);
+
     void new_assembly(
-        const os_char *device_id,
-        const os_char *network_name,
+        eioDevice *device,
         struct eioAssemblyParams *prm);
 
     /**
@@ -169,6 +221,27 @@ protected:
         os_ushort flags,
         void *context);
 
+    /* Get parsed info block from cache, or parse it.
+     */
+    eioInfo *parse_info(
+        os_uint hash,
+        const os_char *buf,
+        os_memsz nbytes);
+
+    /* Set up device by new or changed info.
+     */
+    void apply_info(
+        eioDevice *device,
+        eioInfo *info,
+        eioMblkInfo *minfo);
+
+    /* Rebind reconnected device with unchanged info.
+     */
+    void rebind_by_info(
+        eioDevice *device,
+        eioInfo *info,
+        eioMblkInfo *minfo);
+
     eStatus process_info_block(
         struct eioInfoParserState *state,
         const os_char *array_tag,
@@ -185,8 +258,9 @@ protected:
     eStatus new_assembly_by_info(
         eioInfoParserState *state);
 
-    void resize_memory_block_by_info(
-        eioInfoParserState *state);
+    void resize_memory_blocks_by_info(
+        eioInfo *info,
+        eioMblkInfo *minfo);
 
     /**
     ************************************************************************************************
@@ -204,9 +278,24 @@ protected:
 
     osalEvent m_io_trigger;
 
+    /* Lock for received data queues, see io_lock().
+     */
+    osalMutex m_io_lock;
+
+    /* Double buffered queues of memory blocks with received data. IOCOM callbacks add to
+       m_received[m_received_ix] while IO thread processes the other one.
+     */
+    eioMblk *m_received[2];
+    os_int m_received_ix;
+
     /* List of ePointers to assemblies to run.
      */
     eContainer *m_run_assemblies;
+    os_boolean m_has_run_assemblies;
+
+    /* Parsed info blocks, shared by devices with identical info.
+     */
+    eioInfoCache *m_info_cache;
 };
 
 
@@ -133,6 +133,38 @@ void eioSignal::setup(
     }
 }
 
+/**
+****************************************************************************************************
+
+  @brief Rebind to reconnected memory block.
+
+  The eioSignal::rebind() function is called instead of setup() when a device reconnects with
+  unchanged info. Memory block flags are refreshed and, like in setup(), the value is read
+  from memory block, or value set by user is written to it.
+  os_lock() must be on when this function is called.
+
+****************************************************************************************************
+*/
+void eioSignal::rebind()
+{
+    eioMblk *mblk;
+    eioVariable *v;
+
+    mblk = eioMblk::cast(grandparent());
+    m_mblk_flags = mblk->mblk_flags();
+
+    if ((m_mblk_flags & IOC_MBLK_DOWN) == 0) {
+        up();
+        return;
+    }
+
+    v = variable();
+    if (v) if (v->value_set_by_user() && (m_mblk_flags & IOC_MBLK_UP) == 0) {
+        v->down();
+    }
+}
+
+
 /* os_lock() must be on when this function is called.
  */
 void eioSignal::up()
@@ -141,11 +173,11 @@ void eioSignal::up()
     eMatrix *m;
     eValueX *x;
     iocValue vv;
-    os_memsz p_sz, type_sz;
-    os_int nrows, row, col;
-    osalTypeId type_id, mtx_type_id;
+    os_memsz p_sz;
+    os_int nrows;
+    osalTypeId type_id;
     os_char  buf[64], *p, state_bits;
-    os_long *l_ptr;
+    os_long abuf[16];
 
     v = eioVariable::cast(m_variable_ref->get());
     if (v == OS_NULL) {
@@ -177,12 +209,17 @@ void eioSignal::up()
         }
     }
 
-    /* If array.
+    /* If array. Matrix data type is selected by allocate() to hold all values of signal type,
+       array is copied to matrix blocks by set_array().
      */
     else if (m_signal.n > 1) {
-        type_sz = osal_type_size(type_id);
-        p_sz = m_signal.n * type_sz;
-        p = os_malloc(p_sz, OS_NULL);
+        p_sz = m_signal.n * osal_type_size(type_id);
+        if (p_sz <= (os_memsz)sizeof(abuf)) {
+            p = (os_char*)abuf;
+        }
+        else {
+            p = os_malloc(p_sz, OS_NULL);
+        }
 
         state_bits = ioc_move_array(&m_signal, 0, p, m_signal.n,
             OSAL_STATE_CONNECTED, IOC_SIGNAL_NO_THREAD_SYNC|type_id);
@@ -190,31 +227,12 @@ void eioSignal::up()
 
         nrows = (m_signal.n + m_ncolumns - 1) / m_ncolumns;
         m = new eMatrix(ETEMPORARY);
-        if (OSAL_IS_FLOAT_TYPE(type_id)) {
-            mtx_type_id = type_id;
-        }
-        else if (type_sz >= 4) {
-            mtx_type_id = OS_LONG;
-        }
-        else if (type_sz >= 2) {
-            mtx_type_id = OS_INT;
-        }
-        else {
-            mtx_type_id = OS_SHORT;
-        }
-        m->allocate(mtx_type_id, nrows, m_ncolumns);
-
-        l_ptr = (os_long*)p;
-        for (row = 0; row < nrows; row++) {
-            for (col = 0; col < m_ncolumns; col++) {
-                switch (type_id) {
-                    case OS_LONG: m->setl(row, col, *(l_ptr++)); break;
-                    default: break;
-                }
-            }
-        }
+        m->allocate(type_id, nrows, m_ncolumns);
+        m->set_array(0, p, m_signal.n, type_id);
 
-        os_free(p, p_sz);
+        if (p != (os_char*)abuf) {
+            os_free(p, p_sz);
+        }
 
         x->seto(m, OS_TRUE);
     }
@@ -241,15 +259,35 @@ void eioSignal::up()
     v->up(x);
 }
 
+/* Number of bytes signal takes in memory block, including state bits byte. Boolean array
+   is packed as bits, single boolean is within state bits.
+ */
+static os_int eio_signal_nbytes(
+    iocSignal *signal)
+{
+    osalTypeId type_id;
+
+    type_id = (osalTypeId)(signal->flags & OSAL_TYPEID_MASK);
+    if (type_id == OS_STR) {
+        return signal->n + 1;
+    }
+    if (type_id == OS_BOOLEAN) {
+        return signal->n > 1 ? (signal->n + 7) / 8 + 1 : 1;
+    }
+    return signal->n * (os_int)osal_type_size(type_id) + 1;
+}
+
 /* Does not modify x */
 void eioSignal::down(eVariable *x)
 {
-//     eMatrix *m;
+    eioMblk *mblk;
+    eObject *o;
     iocValue vv;
-//     os_memsz p_sz, type_sz;
-//     os_int nrows, row, col;
+    os_memsz p_sz, type_sz;
+    os_int n;
     osalTypeId type_id;
-    os_char  *p, state_bits;
+    os_char *p, state_bits;
+    os_long abuf[16];
 
     /* Toggle bits in state force changes to be transferred and callbacks to
      * occur, regardless if value is changed or not. Optimization: We may want
@@ -271,33 +309,34 @@ void eioSignal::down(eVariable *x)
             state_bits, OS_STR|IOC_SIGNAL_NO_THREAD_SYNC|IOC_SIGNAL_WRITE);
     }
 
-    /* If array.
+    /* If array, value is matrix. Values are converted to signal type by get_array(),
+       elements missing from matrix are written as zeros.
      */
     else if (m_signal.n > 1) {
-#if 0
+        o = x->geto();
+        if (o == OS_NULL || o->classid() != ECLASSID_MATRIX) {
+            return;
+        }
+
         type_sz = osal_type_size(type_id);
         p_sz = m_signal.n * type_sz;
-        p = os_malloc(p_sz, OS_NULL);
-
-        state_bits = ioc_move_array(&m_signal, 0, p, m_signal.n,
-            OSAL_STATE_CONNECTED, IOC_SIGNAL_NO_THREAD_SYNC);
-        x->set_sbits(state_bits);
-
-        nrows = (m_signal.n + m_ncolumns - 1) / m_ncolumns;
-        m = new eMatrix(ETEMPORARY);
+        if (p_sz <= (os_memsz)sizeof(abuf)) {
+            p = (os_char*)abuf;
+        }
+        else {
+            p = os_malloc(p_sz, OS_NULL);
+        }
 
-        l_ptr = (os_long*)p;
-        for (row = 0; row < nrows; row++) {
-            for (col = 0; col < m_ncolumns; col++) {
-                switch (type_id) {
-                    case OS_LONG: m->setl(row, col, *(l_ptr++)); break;
-                    default: break;
-                }
-            }
+        n = eMatrix::cast(o)->get_array(0, p, m_signal.n, type_id);
+        if (n < m_signal.n) {
+            os_memclear(p + n * type_sz, (m_signal.n - n) * type_sz);
         }
+        ioc_move_array(&m_signal, 0, p, m_signal.n,
+            state_bits, IOC_SIGNAL_NO_THREAD_SYNC|IOC_SIGNAL_WRITE|type_id);
 
-        os_free(p, p_sz);
-#endif
+        if (p != (os_char*)abuf) {
+            os_free(p, p_sz);
+        }
     }
 
     /* Otherwise plain signal.
@@ -318,6 +357,11 @@ void eioSignal::down(eVariable *x)
         ioc_move(&m_signal, &vv, 1, IOC_SIGNAL_NO_THREAD_SYNC|IOC_SIGNAL_WRITE /* |IOC_SIGNAL_NO_TBUF_CHECK */);
     }
 
+    /* Written value is now in memory block, keep the shadow copy in sync.
+     */
+    mblk = eioMblk::cast(grandparent());
+    mblk->shadow_written(m_signal.addr, m_signal.addr + eio_signal_nbytes(&m_signal) - 1);
+
     m_eio_root->trig_io();
 }
 
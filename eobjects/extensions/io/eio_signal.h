@@ -80,6 +80,10 @@ public:
         struct eioMblkInfo *minfo,
         struct eioSignalInfo *sinfo);
 
+    /* Rebind to reconnected memory block, signal configuration is unchanged.
+     */
+    void rebind();
+
     void up();
     void down(eVariable *x);
 
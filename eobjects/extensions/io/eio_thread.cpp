@@ -15,6 +15,14 @@
 */
 #include "extensions/io/eio.h"
 
+/* Default maximum time to wait for trigger, ms.
+ */
+#define EIO_THREAD_DEFAULT_MAX_LATENCY 2000
+
+/* Loop statistics are updated once per this period, microseconds.
+ */
+#define EIO_THREAD_STAT_PERIOD 1000000
+
 
 /**
 ****************************************************************************************************
@@ -29,6 +37,12 @@ eioThread::eioThread(
 {
     m_eio_root = OS_NULL;
     m_iocom_root = OS_NULL;
+    m_max_latency_ms = EIO_THREAD_DEFAULT_MAX_LATENCY;
+    m_stat_start = 0;
+    m_stat_busy_us = 0;
+    m_stat_nloops = 0;
+
+    initproperties();
 }
 
 
@@ -47,11 +61,24 @@ eioThread::eioThread(
 void eioThread::setupclass()
 {
     const os_int cls = ECLASSID_EIO_THREAD;
+    eVariable *v;
 
-    /* Add the class to class list.
+    /* Add the class to class list and properties to property set.
      */
     os_lock();
     eclasslist_add(cls, (eNewObjFunc)OS_NULL, "eioThread", ECLASSID_THREAD);
+    v = addpropertyl(cls, EIOP_MAX_LATENCY, eiop_max_latency, EIO_THREAD_DEFAULT_MAX_LATENCY,
+        "max latency", EPRO_SIMPLE);
+    v->setpropertys(EVARP_UNIT, "ms");
+    v = addpropertyd(cls, EIOP_LOOP_RATE, eiop_loop_rate, "loop rate", 1,
+        EPRO_RDONLY|EPRO_NOONPRCH);
+    v->setpropertys(EVARP_UNIT, "1/s");
+    v = addpropertyd(cls, EIOP_LOOP_TIME, eiop_loop_time, "loop time", 1,
+        EPRO_RDONLY|EPRO_NOONPRCH);
+    v->setpropertys(EVARP_UNIT, "us");
+    v = addpropertyd(cls, EIOP_IDLE, eiop_idle, "idle", 1, EPRO_RDONLY|EPRO_NOONPRCH);
+    v->setpropertys(EVARP_UNIT, "%");
+    propertysetdone(cls);
     os_unlock();
 }
 
@@ -95,51 +122,170 @@ void eioThread::onmessage(
 }
 
 
+/**
+****************************************************************************************************
+
+  @brief Called to inform the class about property value change (override).
+
+  The onpropertychange() function is called when class'es property changes, unless the
+  property is flagged with EPRO_NOONPRCH.
+  If property is flagged as EPRO_SIMPLE, this function shuold save the property value
+  in class members and and return it when simpleproperty() is called.
+
+  @param   propertynr Property number of changed property.
+  @param   x Variable containing the new value.
+  @param   flags
+  @return  If successfull, the function returns ESTATUS_SUCCESS (0). Nonzero return values do
+           indicate that there was no property with given property number.
+
+****************************************************************************************************
+*/
+eStatus eioThread::onpropertychange(
+    os_int propertynr,
+    eVariable *x,
+    os_int flags)
+{
+    switch (propertynr)
+    {
+        case EIOP_MAX_LATENCY:
+            m_max_latency_ms = x->geti();
+            if (m_max_latency_ms < 1) m_max_latency_ms = 1;
+            break;
+
+        default:
+            return eThread::onpropertychange(propertynr, x, flags);
+    }
+
+    return ESTATUS_SUCCESS;
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Get value of simple property (override).
+
+  The simpleproperty() function stores current value of simple property into variable x.
+
+  @param   propertynr Property number to get.
+  @param   x Variable into which to store the property value.
+  @return  If property with property number was stored in x, the function returns
+           ESTATUS_SUCCESS (0). Nonzero return values indicate that property with
+           given number was not among simple properties.
+
+****************************************************************************************************
+*/
+eStatus eioThread::simpleproperty(
+    os_int propertynr,
+    eVariable *x)
+{
+    switch (propertynr)
+    {
+        case EIOP_MAX_LATENCY:
+            x->setl(m_max_latency_ms);
+            break;
+
+        default:
+            return eThread::simpleproperty(propertynr, x);
+    }
+    return ESTATUS_SUCCESS;
+}
+
+
 /**
 ****************************************************************************************************
 
   @brief Maintain connections and end points, thread main loop.
 
-  The eioThread::run() function
-  The data is collected from "connect" and "endpoint" tables, both these tables are global
-  and owned by eProcess.
+  The eioThread::run() function waits until it is triggered, either by IOCOM callback when
+  data has been received for a memory block, by eioRoot::trig_io() or by a message to the thread.
+  If nothing triggers the thread, it runs anyway after "maxlatency" milliseconds, so that
+  connections are maintained and assemblies run.
+
+  Only memory blocks queued by IOCOM callbacks are processed, see eioRoot::process_received(),
+  and os_lock() is taken for assemblies only if there are assemblies to run.
 
 ****************************************************************************************************
 */
 void eioThread::run()
 {
     os_long ti;
-    timer(2000);
+
+    m_stat_start = etime();
 
     while (OS_TRUE)
     {
-        alive();
+        osal_event_wait(trigger(), m_max_latency_ms);
+        alive(EALIVE_RETURN_IMMEDIATELY);
         if (exitnow()) {
             break;
         }
 
         /* We have one time stamp, so changes happening same time have same time value.
+           Other threads read it, set_time_now() takes io_lock() for the write.
          */
         ti = etime();
-        os_lock();
         m_eio_root->set_time_now(ti);
-        os_unlock();
 
+        /* Receive data. IOCOM callbacks queue received memory block ranges, these
+           are moved to signals here, locking one memory block at a time.
+         */
         ioc_receive_all(m_iocom_root);
+        m_eio_root->process_received();
 
         /* Run assemblies that need running.
          */
-        os_lock();
-        m_eio_root->run(ti);
-        os_unlock();
+        if (m_eio_root->has_run_assemblies()) {
+            os_lock();
+            m_eio_root->run(ti);
+            os_unlock();
+        }
 
         ioc_send_all(m_iocom_root);
 
-        osal_trace2("HERE IO THREAD LOOP")        ;
+        update_stats(ti, etime());
     }
 }
 
 
+/**
+****************************************************************************************************
+
+  @brief Update loop statistics properties.
+
+  The eioThread::update_stats() function accumulates time spent processing, and once per
+  second sets loop rate (loops per second), average loop time (microseconds) and idle ratio
+  (percentage of time spent waiting) properties, for tuning IO under load.
+
+  @param   loop_start Time stamp when processing started, microseconds.
+  @param   loop_end Time stamp when processing ended, microseconds.
+
+****************************************************************************************************
+*/
+void eioThread::update_stats(
+    os_long loop_start,
+    os_long loop_end)
+{
+    os_long elapsed;
+
+    m_stat_busy_us += loop_end - loop_start;
+    m_stat_nloops++;
+
+    elapsed = loop_end - m_stat_start;
+    if (elapsed < EIO_THREAD_STAT_PERIOD) {
+        return;
+    }
+
+    setpropertyd(EIOP_LOOP_RATE, 1.0e6 * m_stat_nloops / elapsed);
+    setpropertyd(EIOP_LOOP_TIME, (os_double)m_stat_busy_us / m_stat_nloops);
+    setpropertyd(EIOP_IDLE, 100.0 * (elapsed - m_stat_busy_us) / elapsed);
+
+    m_stat_start = loop_end;
+    m_stat_busy_us = 0;
+    m_stat_nloops = 0;
+}
+
+
 /**
 ****************************************************************************************************
 
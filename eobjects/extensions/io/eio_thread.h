@@ -43,6 +43,19 @@ public:
     virtual void onmessage(
         eEnvelope *envelope);
 
+    /* Called when property value changes.
+     */
+    virtual eStatus onpropertychange(
+        os_int propertynr,
+        eVariable *x,
+        os_int flags);
+
+    /* Get value of simple property.
+     */
+    virtual eStatus simpleproperty(
+        os_int propertynr,
+        eVariable *x);
+
     /* Set pointer to network service (eNetService is owned by eProcess, os_lock() must
        be on to access.
      */
@@ -66,6 +79,11 @@ public:
 
 
 protected:
+    /* Update loop statistics properties.
+     */
+    void update_stats(
+        os_long loop_start,
+        os_long loop_end);
 
     /**
     ************************************************************************************************
@@ -79,6 +97,17 @@ protected:
     /** IO object hierarchy root (time stamps).
      */
     eioRoot *m_eio_root;
+
+    /** Maximum time to wait for trigger before running IO loop, ms ("maxlatency" property).
+     */
+    os_int m_max_latency_ms;
+
+    /** Loop statistics: Start of measurement period, time spent processing and number
+        of loops within the period.
+     */
+    os_long m_stat_start;
+    os_long m_stat_busy_us;
+    os_int m_stat_nloops;
 };
 
 
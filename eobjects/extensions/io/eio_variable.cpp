@@ -31,6 +31,20 @@ eioVariable::eioVariable(
     m_my_own_change = 0;
     m_value_set_by_user = OS_FALSE;
     m_bound = OS_FALSE;
+    m_history = OS_NULL;
+    m_history_nsamples = 0;
+    m_type_id = OS_DOUBLE;
+}
+
+
+/**
+****************************************************************************************************
+  Virtual destructor.
+****************************************************************************************************
+*/
+eioVariable::~eioVariable()
+{
+    delete m_history;
 }
 
 
@@ -58,7 +72,8 @@ void eioVariable::setupclass()
     v = addproperty(cls, EVARP_TSTAMP, evarp_tstamp, "timestamp", EPRO_PERSISTENT|EPRO_SIMPLE);
     v->setpropertys(EVARP_ATTR, "tstamp=\"yy,msec\"");
     addpropertyb(cls, EIOP_BOUND, eiop_bound, "bound", EPRO_SIMPLE|EPRO_RDONLY);
-    propertysetdone(cls);
+    addpropertyl(cls, EIOP_HISTORY, eiop_history, "history samples", EPRO_PERSISTENT|EPRO_SIMPLE);
+    propertysetdone(cls, EPSET_DENSE);
     os_unlock();
 }
 
@@ -103,6 +118,15 @@ eStatus eioVariable::onpropertychange(
             m_bound = (os_boolean)x->getl();
             break;
 
+        case EIOP_HISTORY:
+            m_history_nsamples = x->geti();
+            delete m_history;
+            m_history = OS_NULL;
+            if (m_history_nsamples > 0) {
+                m_history = new eioHistory(m_history_nsamples, m_type_id);
+            }
+            break;
+
         default:
             return eVariable::onpropertychange(propertynr, x, flags);
     }
@@ -136,6 +160,10 @@ eStatus eioVariable::simpleproperty(
             x->setl(m_bound);
             break;
 
+        case EIOP_HISTORY:
+            x->setl(m_history_nsamples);
+            break;
+
         default:
             return eVariable::simpleproperty(propertynr, x);
     }
@@ -218,6 +246,17 @@ void eioVariable::setup(
     mblk_flags = signal->mblk_flags();
 
     type_id = (sinfo->flags & OSAL_TYPEID_MASK);
+
+    /* History storage depends on signal type, start over if type changes.
+     */
+    if ((osalTypeId)type_id != m_type_id) {
+        m_type_id = (osalTypeId)type_id;
+        if (m_history) {
+            delete m_history;
+            m_history = new eioHistory(m_history_nsamples, m_type_id);
+        }
+    }
+
     if (OSAL_IS_INTEGER_TYPE(type_id))
     {
         osal_type_range((osalTypeId)type_id, &min_value, &max_value);
@@ -253,6 +292,12 @@ void eioVariable::setup(
  */
 void eioVariable::up(eValueX *x)
 {
+    /* Record value in history, arrays and strings are not recorded.
+     */
+    if (m_history) if (x->type() != OS_OBJECT && x->type() != OS_STR) {
+        m_history->add(x->tstamp(), x->getd(), x->sbits());
+    }
+
     m_my_own_change++;
     setpropertyo(EVARP_VALUE, x, EMSG_DEL_CONTENT);
     m_my_own_change--;
@@ -270,3 +315,37 @@ void eioVariable::down()
         }
     }
 }
+
+
+/**
+****************************************************************************************************
+
+  @brief Get history within time range as matrix.
+
+  The eioVariable::history() function returns recorded values of IO variable between tstart
+  and tend, downsampled so that there are at most max_points rows. Matrix columns are time
+  stamp, minimum, maximum, average and state bits, see EIO_HISTORY_COL_TSTAMP, etc.
+  History is recorded only if "history" property is set to number of raw samples to keep.
+  os_lock() must be on when this function is called.
+
+  @param   tstart Start of time range, microseconds.
+  @param   tend End of time range, microseconds. 0 for up to latest value.
+  @param   max_points Maximum number of rows to return, for example EIO_HISTORY_DEFAULT_NPOINTS.
+  @param   parent Parent object for the matrix, OS_NULL if none.
+  @param   id Object identifier for the matrix.
+  @return  New matrix, or OS_NULL if history is not enabled.
+
+****************************************************************************************************
+*/
+eMatrix *eioVariable::history(
+    os_long tstart,
+    os_long tend,
+    os_int max_points,
+    eObject *parent,
+    e_oid id)
+{
+    if (m_history == OS_NULL) {
+        return OS_NULL;
+    }
+    return m_history->select(tstart, tend, max_points, parent, id);
+}
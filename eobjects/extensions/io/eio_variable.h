@@ -18,6 +18,8 @@
 #define EIO_VARIABLE_H_
 #include "eobjects.h"
 
+class eioHistory;
+
 
 /**
 ****************************************************************************************************
@@ -41,6 +43,10 @@ public:
         e_oid id = EOID_ITEM,
         os_int flags = EOBJ_EROOT_OPTIONAL);
 
+    /* Virtual destructor.
+     */
+    virtual ~eioVariable();
+
     /* Cast eObject pointer to eioVariable pointer.
      */
     inline static eioVariable *cast(
@@ -92,6 +98,19 @@ public:
 
     void down();
 
+    /* Value has been set by user, and should be written to device when it connects.
+     */
+    inline os_boolean value_set_by_user() {return m_value_set_by_user; }
+
+    /* Get history within time range as matrix, OS_NULL if history is not enabled.
+     */
+    eMatrix *history(
+        os_long tstart,
+        os_long tend,
+        os_int max_points,
+        eObject *parent = OS_NULL,
+        e_oid id = EOID_ITEM);
+
 protected:
     /**
     ************************************************************************************************
@@ -114,6 +133,13 @@ protected:
     os_boolean m_bound;
     os_boolean m_value_set_by_user;
     os_short m_my_own_change;
+
+    /* Value history, OS_NULL if not enabled. m_history_nsamples is number of raw samples
+       to keep ("history" property) and m_type_id is signal data type.
+     */
+    eioHistory *m_history;
+    os_int m_history_nsamples;
+    osalTypeId m_type_id;
 };
 
 #endif
@@ -146,6 +146,10 @@ public:
      */
     inline iocRoot *iocom_root() {return &m_iocom_root; }
 
+    /* Get pointer to IO object hierarchy root, os_lock() must be on to access.
+     */
+    inline eioRoot *eio_root() {return m_eio_root; }
+
 protected:
     /**
     ************************************************************************************************
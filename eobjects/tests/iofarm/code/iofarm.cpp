@@ -0,0 +1,396 @@
+/**
+
+  @file    iofarm.cpp
+  @brief   Simulated iocom device farm for IO load benchmarking.
+  @author  Pekka Lehtikoski
+  @version 1.0
+  @date    18.10.2026
+
+  The farm creates iocom end point through eioProtocol, starts N simulated devices in this
+  process which connect to it over loopback socket, and measures how the IO object hierarchy
+  keeps up: Signal changes processed per second, latency from device write to update of
+  bound eioVariable, camera frames received and process CPU time per processed signal.
+
+  Copyright 2020 Pekka Lehtikoski. This file is part of the eobjects project and shall only be used,
+  modified, and distributed under the terms of the project licensing. By continuing to use, modify,
+  or distribute this file you indicate that you have read the license and understand and accept
+  it fully.
+
+****************************************************************************************************
+*/
+#include "iofarm.h"
+#include <stdio.h>
+#include <time.h>
+
+/* Number of signals written by devices, os_lock() must be on.
+ */
+os_long iofWriter::nwritten;
+
+/* Time to wait for devices to connect and be set up, and warm up time before measurement,
+   milliseconds.
+ */
+#define IOF_SETUP_TIMEOUT_MS 30000
+#define IOF_WARMUP_MS 1000
+
+
+/**
+****************************************************************************************************
+  Constructor.
+****************************************************************************************************
+*/
+iofWriter::iofWriter(
+    iofDevice **devices,
+    os_int ndevices)
+    : eThread()
+{
+    m_devices = devices;
+    m_ndevices = ndevices;
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Thread main loop, runs devices.
+
+  All simulated devices are run from this one thread, the devices' connections have their
+  own threads.
+
+****************************************************************************************************
+*/
+void iofWriter::run()
+{
+    os_long ti;
+    os_int i, n;
+
+    while (OS_TRUE)
+    {
+        alive(EALIVE_RETURN_IMMEDIATELY);
+        if (exitnow()) {
+            break;
+        }
+
+        ti = etime();
+        n = 0;
+        for (i = 0; i < m_ndevices; i++) {
+            n += m_devices[i]->run(ti);
+        }
+
+        if (n) {
+            os_lock();
+            nwritten += n;
+            os_unlock();
+        }
+
+        osal_sleep(1);
+    }
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Parse command line arguments into configuration.
+
+  Arguments are "name=value" pairs, for example "devices=50 signals=200 period=10". Unknown
+  arguments are reported and ignored.
+
+  @param   cfg Configuration to set, defaults are set first.
+  @param   argc Number of command line arguments.
+  @param   argv Array of string pointers, one for each command line argument.
+
+****************************************************************************************************
+*/
+void iof_configure(
+    iofConfig *cfg,
+    os_int argc,
+    os_char *argv[])
+{
+    static const struct {const os_char *name; os_memsz offset; } items[] = {
+        {"devices", offsetof(iofConfig, ndevices)},
+        {"signals", offsetof(iofConfig, nsignals)},
+        {"arrays", offsetof(iofConfig, narrays)},
+        {"arraysz", offsetof(iofConfig, array_n)},
+        {"period", offsetof(iofConfig, change_period_ms)},
+        {"changepct", offsetof(iofConfig, change_pct)},
+        {"cameras", offsetof(iofConfig, ncameras)},
+        {"camw", offsetof(iofConfig, camera_w)},
+        {"camh", offsetof(iofConfig, camera_h)},
+        {"camperiod", offsetof(iofConfig, camera_period_ms)},
+        {"duration", offsetof(iofConfig, duration_s)},
+        {"port", offsetof(iofConfig, port)}};
+    const os_int nitems = (os_int)(sizeof(items) / sizeof(items[0]));
+    const os_char *p, *e;
+    os_memsz n;
+    os_int i, j;
+
+    os_memclear(cfg, sizeof(iofConfig));
+    cfg->ndevices = 10;
+    cfg->nsignals = 100;
+    cfg->narrays = 2;
+    cfg->array_n = 16;
+    cfg->change_period_ms = 20;
+    cfg->change_pct = 10;
+    cfg->ncameras = 0;
+    cfg->camera_w = 320;
+    cfg->camera_h = 240;
+    cfg->camera_period_ms = 100;
+    cfg->duration_s = 10;
+    cfg->port = 6368;
+
+    for (i = 1; i < argc; i++)
+    {
+        p = argv[i];
+        e = os_strchr((os_char*)p, '=');
+        if (e == OS_NULL) goto unknown;
+        n = e - p;
+
+        for (j = 0; j < nitems; j++) {
+            if (os_strlen(items[j].name) == n + 1 && !os_strncmp(p, items[j].name, n)) {
+                *(os_int*)((os_char*)cfg + items[j].offset) =
+                    (os_int)osal_str_to_int(e + 1, OS_NULL);
+                break;
+            }
+        }
+        if (j < nitems) continue;
+
+unknown:
+        printf("unknown argument '%s'\n", p);
+    }
+
+    if (cfg->ndevices < 1) cfg->ndevices = 1;
+    if (cfg->array_n < 1) cfg->array_n = 1;
+    if (cfg->change_period_ms < 1) cfg->change_period_ms = 1;
+    if (cfg->ncameras > cfg->ndevices) cfg->ncameras = cfg->ndevices;
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Create loopback end point through eioProtocol.
+
+  The end point is created directly by the "iocom" protocol added to network service, the
+  same call eNetMaintainThread makes for rows of "endpoints" table.
+
+  @param   cfg Farm configuration.
+  @param   proto Set to pointer to the protocol.
+  @return  Protocol handle for end point, OS_NULL if failed.
+
+****************************************************************************************************
+*/
+static eProtocolHandle *iof_new_end_point(
+    iofConfig *cfg,
+    eProtocol **proto)
+{
+    eEndPointParameters prm;
+    eProtocolHandle *handle;
+    eVariable port;
+    eStatus s;
+
+    os_lock();
+    *proto = (eProtocol*)eglobal->netservice->protocols()->byname("iocom");
+    os_unlock();
+    if (*proto == OS_NULL) {
+        osal_debug_error("iofarm: iocom protocol not added");
+        return OS_NULL;
+    }
+
+    port = ":";
+    port.appendl(cfg->port);
+
+    os_memclear(&prm, sizeof(prm));
+    prm.port = port.gets();
+    prm.transport = ENET_ENDP_SOCKET;
+    prm.cloud_name = eglobal->cloud_name;
+    handle = (*proto)->new_end_point(0, &prm, &s);
+    if (handle && s) {
+        (*proto)->delete_end_point(handle);
+        handle = OS_NULL;
+    }
+    return handle;
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Bind probes to devices' time stamp variables and cameras.
+
+  Probes are created into a new thread, which is started after binding.
+
+  @param   cfg Farm configuration.
+  @param   monitor_thread_handle Handle for the probe thread.
+
+****************************************************************************************************
+*/
+static void iof_start_probes(
+    iofConfig *cfg,
+    eThreadHandle *monitor_thread_handle)
+{
+    eThread *t;
+    iofProbe *probe;
+    eVariable path;
+    os_int i;
+
+    t = new eThread();
+    for (i = 1; i <= cfg->ndevices; i++)
+    {
+        path = "//io/" IOF_NETWORK_NAME "/" IOF_DEVICE_NAME;
+        path.appendl(i);
+        path += "/io/farm/tstamp";
+        probe = new iofProbe(t, OS_FALSE);
+        probe->bind(EVARP_VALUE, path.gets(), EBIND_NOFLOWCLT);
+
+        if (i <= cfg->ncameras) {
+            path = "//io/" IOF_NETWORK_NAME "/" IOF_DEVICE_NAME;
+            path.appendl(i);
+            path += "/assembly/camera";
+            probe = new iofProbe(t, OS_TRUE);
+            probe->bind(EVARP_VALUE, path.gets(), EBIND_NOFLOWCLT);
+        }
+    }
+    t->start(monitor_thread_handle); /* After this t pointer is useless */
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Run the device farm benchmark.
+
+  Creates end point and devices, waits until eioRoot has set up all devices, binds probes,
+  runs devices for configured time and prints results. Network service with iocom protocol
+  must be running.
+
+  @param   cfg Farm configuration.
+  @return  ESTATUS_SUCCESS if all fine, other values indicate an error.
+
+****************************************************************************************************
+*/
+eStatus iof_run_farm(
+    iofConfig *cfg)
+{
+    eProtocol *proto;
+    eProtocolHandle *ep_handle;
+    iofDevice **devices;
+    eThread *t;
+    eThreadHandle writer_handle, monitor_handle;
+    eVariable connect_to;
+    iofStats stats;
+    eioRoot *eio_root;
+    os_timer start_t;
+    os_long start_us, elapsed_us, nchanged0, nchanged, nwritten0, nwritten;
+    clock_t cpu0, cpu;
+    os_double elapsed_s, cpu_us;
+    os_memsz sz;
+    os_int i, nready;
+
+    printf("%d devices, %d signals, %d arrays of %d, every %d ms %d%% changed, "
+        "%d cameras %dx%d every %d ms\n", cfg->ndevices, cfg->nsignals, cfg->narrays,
+        cfg->array_n, cfg->change_period_ms, cfg->change_pct, cfg->ncameras,
+        cfg->camera_w, cfg->camera_h, cfg->camera_period_ms);
+
+    os_lock();
+    eio_root = eglobal->netservice->eio_root();
+    os_unlock();
+    if (eio_root == OS_NULL) {
+        printf("network service not running\n");
+        return ESTATUS_FAILED;
+    }
+
+    ep_handle = iof_new_end_point(cfg, &proto);
+    if (ep_handle == OS_NULL) {
+        printf("unable to create iocom end point\n");
+        return ESTATUS_FAILED;
+    }
+
+    /* Create and connect simulated devices.
+     */
+    connect_to = "127.0.0.1:";
+    connect_to.appendl(cfg->port);
+    sz = cfg->ndevices * sizeof(iofDevice*);
+    devices = (iofDevice**)os_malloc(sz, OS_NULL);
+    for (i = 0; i < cfg->ndevices; i++) {
+        devices[i] = new iofDevice(cfg, i + 1);
+        devices[i]->connect(connect_to.gets());
+    }
+
+    /* Wait until eioRoot has applied all devices' info blocks.
+     */
+    os_get_timer(&start_t);
+    start_us = etime();
+    do {
+        osal_sleep(50);
+        os_lock();
+        nready = iof_count_ready_devices(eio_root);
+        os_unlock();
+    }
+    while (nready < cfg->ndevices && !os_has_elapsed(&start_t, IOF_SETUP_TIMEOUT_MS));
+    elapsed_us = etime() - start_us;
+    printf("%d of %d devices set up in %.1f ms\n", nready, cfg->ndevices, 0.001 * elapsed_us);
+
+    /* Bind probes, start writing and let things settle.
+     */
+    iof_start_probes(cfg, &monitor_handle);
+    t = new iofWriter(devices, cfg->ndevices);
+    t->start(&writer_handle); /* After this t pointer is useless */
+    osal_sleep(IOF_WARMUP_MS);
+
+    /* Measure.
+     */
+    iof_reset_stats();
+    os_lock();
+    nwritten0 = iofWriter::nwritten;
+    nchanged0 = iof_count_changes(eio_root);
+    os_unlock();
+    start_us = etime();
+    cpu0 = clock();
+
+    osal_sleep(1000 * cfg->duration_s);
+
+    os_lock();
+    nwritten = iofWriter::nwritten - nwritten0;
+    nchanged = iof_count_changes(eio_root) - nchanged0;
+    os_unlock();
+    elapsed_us = etime() - start_us;
+    cpu = clock() - cpu0;
+    iof_get_stats(&stats);
+
+    elapsed_s = 1.0e-6 * elapsed_us;
+    cpu_us = 1.0e6 * cpu / CLOCKS_PER_SEC;
+    printf("written %.0f signals/s, processed %.0f signals/s\n",
+        nwritten / elapsed_s, nchanged / elapsed_s);
+    printf("latency device write -> eioVariable: %lld updates, avg %.3f ms, max %.3f ms\n",
+        (long long)stats.nupdates,
+        stats.nupdates ? 0.001 * stats.latency_sum / stats.nupdates : 0.0,
+        0.001 * stats.latency_max);
+    if (cfg->ncameras) {
+        printf("camera: %.1f frames/s, %.2f MB/s\n", stats.nframes / elapsed_s,
+            1.0e-6 * stats.frame_bytes / elapsed_s);
+    }
+    printf("process CPU %.1f %%, %.3f us per processed signal (includes simulated devices)\n",
+        100.0 * cpu_us / elapsed_us, nchanged ? cpu_us / nchanged : 0.0);
+
+    /* Clean up.
+     */
+    writer_handle.terminate();
+    writer_handle.join();
+    monitor_handle.terminate();
+    monitor_handle.join();
+
+    for (i = 0; i < cfg->ndevices; i++) {
+        delete devices[i];
+    }
+    os_free(devices, sz);
+
+    proto->delete_end_point(ep_handle);
+    while (proto->is_end_point_running(ep_handle)) {
+        os_timeslice();
+    }
+    os_lock();
+    delete ep_handle;
+    os_unlock();
+
+    return ESTATUS_SUCCESS;
+}
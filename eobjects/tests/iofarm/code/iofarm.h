@@ -0,0 +1,359 @@
+/**
+
+  @file    iofarm.h
+  @brief   Simulated iocom device farm for IO load benchmarking.
+  @author  Pekka Lehtikoski
+  @version 1.0
+  @date    18.10.2026
+
+  Copyright 2020 Pekka Lehtikoski. This file is part of the eobjects project and shall only be used,
+  modified, and distributed under the terms of the project licensing. By continuing to use, modify,
+  or distribute this file you indicate that you have read the license and understand and accept
+  it fully.
+
+****************************************************************************************************
+*/
+#pragma once
+#ifndef IOFARM_H_
+#define IOFARM_H_
+#include "eobjects.h"
+#include "extensions/io/eio.h"
+#include "extensions/iocom/eiocom.h"
+
+/* Device and network names used by simulated devices. Device names in IO object hierarchy
+   are "farm1", "farm2"... within "//io/iofarm".
+ */
+#define IOF_DEVICE_NAME "farm"
+#define IOF_NETWORK_NAME "iofarm"
+
+/* Size of camera brick transfer buffer signal, bytes.
+ */
+#define IOF_CAMERA_BUF_SZ 8192
+
+/* Class identifiers.
+ */
+#define IOF_CLASSID_WRITER (ECLASSID_APP_BASE + 1)
+
+
+/**
+****************************************************************************************************
+  Farm configuration, set from command line "name=value" arguments.
+****************************************************************************************************
+*/
+typedef struct iofConfig
+{
+    /* Number of simulated devices ("devices").
+     */
+    os_int ndevices;
+
+    /* Scalar float signals per device ("signals").
+     */
+    os_int nsignals;
+
+    /* Float array signals per device ("arrays") and number of elements in each ("arraysz").
+     */
+    os_int narrays;
+    os_int array_n;
+
+    /* Change rate: Every "period" milliseconds each device writes "changepct" percent of
+       it's signals and arrays with new values.
+     */
+    os_int change_period_ms;
+    os_int change_pct;
+
+    /* Number of devices with camera brick stream ("cameras"), frame size ("camw", "camh")
+       and frame period ("camperiod").
+     */
+    os_int ncameras;
+    os_int camera_w;
+    os_int camera_h;
+    os_int camera_period_ms;
+
+    /* Measurement time, seconds ("duration").
+     */
+    os_int duration_s;
+
+    /* TCP port for loopback iocom end point ("port").
+     */
+    os_int port;
+}
+iofConfig;
+
+
+/**
+****************************************************************************************************
+  Measured statistics. Updated by probes, os_lock() must be on to access.
+****************************************************************************************************
+*/
+typedef struct iofStats
+{
+    /* Time stamp updates received through bound eioVariables, sum and maximum latency
+       from device write to update, microseconds.
+     */
+    os_long nupdates;
+    os_long latency_sum;
+    os_long latency_max;
+
+    /* Camera frames and bytes received through bound brick buffers.
+     */
+    os_long nframes;
+    os_long frame_bytes;
+}
+iofStats;
+
+
+/**
+****************************************************************************************************
+
+  @brief Simulated iocom device.
+
+  Each iofDevice has it's own iocom root, memory blocks and connection, like a real IO device
+  in separate process would. The device connects to the farm's loopback end point and is
+  seen by eioRoot through the normal eioProtocol path. Signals are described in packed JSON
+  "info" memory block. Device number 1 ... ncameras also stream camera frames as bricks.
+
+  The device is not an eObject, run() is called by iofWriter thread.
+
+****************************************************************************************************
+*/
+class iofDevice
+{
+public:
+    /* Constructor, creates memory blocks.
+     */
+    iofDevice(
+        iofConfig *cfg,
+        os_int device_nr);
+
+    /* Destructor, closes connection and releases memory blocks.
+     */
+    ~iofDevice();
+
+    /* Connect to farm's end point.
+     */
+    eStatus connect(
+        const os_char *parameters);
+
+    /* Write changed signals and camera frames which are due, returns number of signals
+       written.
+     */
+    os_int run(
+        os_long ti);
+
+protected:
+    /* Generate packed JSON info block describing the signals.
+     */
+    eStatus make_info();
+
+    /* Add signal to JSON and set up iocSignal for it.
+     */
+    void add_signal(
+        eVariable *json,
+        iocSignal *sig,
+        iocHandle *handle,
+        const os_char *name,
+        osalTypeId type_id,
+        os_int n,
+        os_int *addr);
+
+    /* Write signal values.
+     */
+    os_int write_signals();
+
+    /* Generate camera frame into brick buffer.
+     */
+    void make_frame(
+        os_long ti);
+
+    /* Pseudo random number.
+     */
+    inline os_uint rand_nr()
+    {
+        m_rand = m_rand * 1103515245 + 12345;
+        return m_rand >> 8;
+    }
+
+    /** Configuration and device number.
+     */
+    iofConfig *m_cfg;
+    os_int m_device_nr;
+
+    /** IOCOM root, memory block handles and connection.
+     */
+    iocRoot m_root;
+    iocHandle m_exp;
+    iocHandle m_imp;
+    iocHandle m_info;
+    iocConnection *m_con;
+
+    /** Memory block sizes, from JSON generation.
+     */
+    os_int m_exp_sz;
+    os_int m_imp_sz;
+
+    /** Packed JSON info block.
+     */
+    os_char *m_info_buf;
+    os_memsz m_info_sz;
+    os_memsz m_info_alloc_sz;
+
+    /** Time stamp signal, written last with every change.
+     */
+    iocSignal m_sig_tstamp;
+
+    /** Scalar and array signals, value buffer for writing arrays.
+     */
+    iocSignal *m_sigs;
+    iocSignal *m_arrays;
+    os_float *m_array_buf;
+
+    /** Camera brick buffer and it's signals.
+     */
+    os_boolean m_has_camera;
+    iocBrickBuffer m_brick;
+    iocSignal m_sig_cmd;
+    iocSignal m_sig_select;
+    iocSignal m_sig_err;
+    iocSignal m_sig_cs;
+    iocSignal m_sig_state;
+    iocSignal m_sig_buf;
+    iocSignal m_sig_head;
+    iocSignal m_sig_tail;
+
+    /** Next change and frame time, frame counter and random number state.
+     */
+    os_long m_next_change;
+    os_long m_next_frame;
+    os_int m_frame_nr;
+    os_uint m_rand;
+};
+
+
+/**
+****************************************************************************************************
+  Thread running all simulated devices.
+****************************************************************************************************
+*/
+class iofWriter : public eThread
+{
+public:
+    /* Constructor.
+     */
+    iofWriter(
+        iofDevice **devices,
+        os_int ndevices);
+
+    /* Get class identifier.
+     */
+    virtual os_int classid() {return IOF_CLASSID_WRITER; }
+
+    /* Thread main loop, runs devices.
+     */
+    virtual void run();
+
+    /* Number of signals written by devices, os_lock() must be on.
+     */
+    static os_long nwritten;
+
+protected:
+    iofDevice **m_devices;
+    os_int m_ndevices;
+};
+
+
+/**
+****************************************************************************************************
+
+  @brief Probe bound to an IO variable or brick buffer.
+
+  The iofProbe measures updates received through property binding, the same way as an
+  application or GUI would see them. For time stamp variables latency is the difference
+  between receive time and time stamp written by the device. Class identifier is not
+  overridden, so eVariable's property set is used for binding.
+
+****************************************************************************************************
+*/
+class iofProbe : public eVariable
+{
+public:
+    /* Constructor.
+     */
+    iofProbe(
+        eObject *parent,
+        os_boolean is_camera);
+
+    /* Called when property value changes.
+     */
+    virtual eStatus onpropertychange(
+        os_int propertynr,
+        eVariable *x,
+        os_int flags);
+
+protected:
+    os_boolean m_is_camera;
+    os_boolean m_got_first;
+};
+
+
+/* Parse command line arguments into configuration.
+ */
+void iof_configure(
+    iofConfig *cfg,
+    os_int argc,
+    os_char *argv[]);
+
+/* Run the device farm benchmark.
+ */
+eStatus iof_run_farm(
+    iofConfig *cfg);
+
+/* Statistics, see iofStats.
+ */
+void iof_reset_stats();
+
+void iof_get_stats(
+    iofStats *stats);
+
+/* Device side iocom calls, see iofarm_iocom.cpp.
+ */
+void iof_initialize_mblk(
+    iocHandle *handle,
+    iocRoot *root,
+    os_int device_nr,
+    const os_char *mblk_name,
+    os_char *buf,
+    os_int nbytes,
+    os_boolean up);
+
+void iof_send(
+    iocHandle *handle);
+
+void iof_receive(
+    iocHandle *handle);
+
+os_boolean iof_brick_empty(
+    iocBrickBuffer *brick);
+
+void iof_brick_send(
+    iocBrickBuffer *brick);
+
+void iof_set_brick_hdr_int(
+    os_uchar *field,
+    os_ulong value,
+    os_int nbytes);
+
+os_char *iof_pack_json(
+    const os_char *json,
+    os_memsz *nbytes,
+    os_memsz *alloc_sz);
+
+/* Count devices set up in IO object hierarchy, and signal changes processed. os_lock()
+   must be on.
+ */
+os_int iof_count_ready_devices(
+    eioRoot *eio_root);
+
+os_long iof_count_changes(
+    eioRoot *eio_root);
+
+#endif
@@ -0,0 +1,441 @@
+/**
+
+  @file    iofarm_device.cpp
+  @brief   Simulated iocom device.
+  @author  Pekka Lehtikoski
+  @version 1.0
+  @date    18.10.2026
+
+  Simulated device has it's own iocom root object with "exp" memory block for signals and
+  camera data, "imp" memory block for camera control and "info" memory block holding packed
+  JSON signal description. It connects to the farm's end point over loopback socket, so
+  eioRoot sees it just as it would see a real IO device. Device side iocom calls which are
+  not used elsewhere in eobjects are in iofarm_iocom.cpp.
+
+  Copyright 2020 Pekka Lehtikoski. This file is part of the eobjects project and shall only be used,
+  modified, and distributed under the terms of the project licensing. By continuing to use, modify,
+  or distribute this file you indicate that you have read the license and understand and accept
+  it fully.
+
+****************************************************************************************************
+*/
+#include "iofarm.h"
+
+
+/**
+****************************************************************************************************
+  Constructor, creates memory blocks.
+****************************************************************************************************
+*/
+iofDevice::iofDevice(
+    iofConfig *cfg,
+    os_int device_nr)
+{
+    iocStreamerSignals sig;
+    os_memsz sz;
+    os_long period_us;
+
+    m_cfg = cfg;
+    m_device_nr = device_nr;
+    m_con = OS_NULL;
+    m_exp_sz = m_imp_sz = 0;
+    m_info_buf = OS_NULL;
+    m_info_sz = m_info_alloc_sz = 0;
+    m_has_camera = (os_boolean)(device_nr <= cfg->ncameras);
+    m_frame_nr = 0;
+    m_rand = (os_uint)device_nr;
+
+    os_memclear(&m_exp, sizeof(iocHandle));
+    os_memclear(&m_imp, sizeof(iocHandle));
+    os_memclear(&m_info, sizeof(iocHandle));
+    os_memclear(&m_brick, sizeof(iocBrickBuffer));
+    os_memclear(&m_sig_tstamp, sizeof(iocSignal));
+    os_memclear(&m_sig_cmd, sizeof(iocSignal));
+    os_memclear(&m_sig_select, sizeof(iocSignal));
+    os_memclear(&m_sig_err, sizeof(iocSignal));
+    os_memclear(&m_sig_cs, sizeof(iocSignal));
+    os_memclear(&m_sig_state, sizeof(iocSignal));
+    os_memclear(&m_sig_buf, sizeof(iocSignal));
+    os_memclear(&m_sig_head, sizeof(iocSignal));
+    os_memclear(&m_sig_tail, sizeof(iocSignal));
+
+    sz = (cfg->nsignals + cfg->narrays + 1) * sizeof(iocSignal);
+    m_sigs = (iocSignal*)os_malloc(sz, OS_NULL);
+    os_memclear(m_sigs, sz);
+    m_arrays = m_sigs + cfg->nsignals;
+    m_array_buf = (os_float*)os_malloc((cfg->array_n + 1) * sizeof(os_float), OS_NULL);
+
+    /* Spread devices' writes evenly over change period.
+     */
+    period_us = 1000 * (os_long)cfg->change_period_ms;
+    m_next_change = etime() + (period_us ? (device_nr * 7919) % period_us : 0);
+    m_next_frame = 0;
+
+    ioc_initialize_root(&m_root, IOC_CREATE_OWN_MUTEX);
+    ioc_set_iodevice_id(&m_root, IOF_DEVICE_NAME, device_nr, OS_NULL, IOF_NETWORK_NAME);
+
+    if (make_info()) {
+        osal_debug_error_int("iofDevice: Generating info failed, device ", device_nr);
+    }
+
+    iof_initialize_mblk(&m_exp, &m_root, device_nr, "exp", OS_NULL, m_exp_sz, OS_TRUE);
+    if (m_has_camera) {
+        iof_initialize_mblk(&m_imp, &m_root, device_nr, "imp", OS_NULL, m_imp_sz, OS_FALSE);
+    }
+    iof_initialize_mblk(&m_info, &m_root, device_nr, "info", m_info_buf, (os_int)m_info_sz,
+        OS_TRUE);
+
+    /* Camera brick buffer, frames are sent from device.
+     */
+    if (m_has_camera) {
+        os_memclear(&sig, sizeof(iocStreamerSignals));
+        sig.to_device = OS_FALSE;
+        sig.flat_buffer = OS_TRUE;
+        sig.cmd = &m_sig_cmd;
+        sig.select = &m_sig_select;
+        sig.err = &m_sig_err;
+        sig.cs = &m_sig_cs;
+        sig.state = &m_sig_state;
+        sig.buf = &m_sig_buf;
+        sig.head = &m_sig_head;
+        sig.tail = &m_sig_tail;
+        ioc_initialize_brick_buffer(&m_brick, &sig, &m_root, 0, IOC_BRICK_DEVICE);
+    }
+}
+
+
+/**
+****************************************************************************************************
+  Destructor, closes connection and releases memory blocks.
+****************************************************************************************************
+*/
+iofDevice::~iofDevice()
+{
+    if (m_has_camera) {
+        ioc_release_brick_buffer(&m_brick);
+    }
+    ioc_release_root(&m_root);
+
+    os_free(m_sigs, (m_cfg->nsignals + m_cfg->narrays + 1) * sizeof(iocSignal));
+    os_free(m_array_buf, (m_cfg->array_n + 1) * sizeof(os_float));
+    if (m_info_buf) {
+        os_free(m_info_buf, m_info_alloc_sz);
+    }
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Connect to farm's end point.
+
+  The connection runs in it's own thread, like connection of a real device would.
+
+  @param   parameters Address to connect to, for example "127.0.0.1:6368".
+  @return  ESTATUS_SUCCESS if all fine, other values indicate an error.
+
+****************************************************************************************************
+*/
+eStatus iofDevice::connect(
+    const os_char *parameters)
+{
+    iocConnectionParams conprm;
+    osalStatus s;
+
+    m_con = ioc_initialize_connection(OS_NULL, &m_root);
+    os_memclear(&conprm, sizeof(conprm));
+    conprm.iface = OSAL_SOCKET_IFACE;
+    conprm.flags = IOC_SOCKET|IOC_CREATE_THREAD;
+    conprm.parameters = parameters;
+    s = ioc_connect(m_con, &conprm);
+    return s ? ESTATUS_FROM_OSAL_STATUS(s) : ESTATUS_SUCCESS;
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Write changed signals and camera frames which are due.
+
+  Called repeatedly by iofWriter thread.
+
+  @param   ti Current time, microseconds, see etime().
+  @return  Number of signals written.
+
+****************************************************************************************************
+*/
+os_int iofDevice::run(
+    os_long ti)
+{
+    os_long period_us;
+    os_int nwritten;
+
+    nwritten = 0;
+
+    if (m_has_camera) {
+        iof_receive(&m_imp);
+        if (ti >= m_next_frame && iof_brick_empty(&m_brick)) {
+            make_frame(ti);
+            m_next_frame = ti + 1000 * (os_long)m_cfg->camera_period_ms;
+        }
+        iof_brick_send(&m_brick);
+    }
+
+    if (ti >= m_next_change) {
+        nwritten = write_signals();
+
+        /* If we have fallen behind, skip missed writes rather than bursting.
+         */
+        period_us = 1000 * (os_long)m_cfg->change_period_ms;
+        m_next_change += period_us;
+        if (m_next_change < ti) {
+            m_next_change = ti + period_us;
+        }
+    }
+
+    if (nwritten || m_has_camera) {
+        iof_send(&m_exp);
+    }
+
+    return nwritten;
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Write signal values.
+
+  Writes "changepct" percent of scalar and array signals, picked at random, with new values.
+  Time stamp signal is written last, when it is received all values of the same write are
+  already in eioRoot's memory block.
+
+  @return  Number of signals written, including time stamp.
+
+****************************************************************************************************
+*/
+os_int iofDevice::write_signals()
+{
+    iocValue vv;
+    os_int nscalars, narrays, i, j, ix;
+
+    nscalars = m_cfg->nsignals * m_cfg->change_pct / 100;
+    if (nscalars == 0 && m_cfg->nsignals && m_cfg->change_pct) nscalars = 1;
+    narrays = m_cfg->narrays * m_cfg->change_pct / 100;
+    if (narrays == 0 && m_cfg->narrays && m_cfg->change_pct) narrays = 1;
+
+    ioc_lock(&m_root);
+
+    vv.state_bits = OSAL_STATE_CONNECTED;
+    for (i = 0; i < nscalars; i++) {
+        ix = (os_int)(rand_nr() % (os_uint)m_cfg->nsignals);
+        vv.value.d = (os_double)(rand_nr() & 0xFFFF);
+        ioc_move(m_sigs + ix, &vv, 1, IOC_SIGNAL_WRITE|IOC_SIGNAL_NO_THREAD_SYNC);
+    }
+
+    for (i = 0; i < narrays; i++) {
+        ix = (os_int)(rand_nr() % (os_uint)m_cfg->narrays);
+        for (j = 0; j < m_cfg->array_n; j++) {
+            m_array_buf[j] = (os_float)(rand_nr() & 0xFFFF);
+        }
+        ioc_move_array(m_arrays + ix, 0, m_array_buf, m_cfg->array_n, OSAL_STATE_CONNECTED,
+            IOC_SIGNAL_WRITE|IOC_SIGNAL_NO_THREAD_SYNC);
+    }
+
+    vv.value.l = etime();
+    ioc_move(&m_sig_tstamp, &vv, 1, IOC_SIGNAL_WRITE|IOC_SIGNAL_NO_THREAD_SYNC);
+
+    ioc_unlock(&m_root);
+
+    return nscalars + narrays + 1;
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Generate camera frame into brick buffer.
+
+  The frame is uncompressed RGB24 test pattern which changes with every frame. Rows are
+  padded to even number of bytes, as eioBrickBuffer::frame_to_bitmap() expects for RGB24,
+  so odd camera width works. Called only when the previous frame has been sent.
+
+  @param   ti Current time, microseconds, stored as frame time stamp.
+
+****************************************************************************************************
+*/
+void iofDevice::make_frame(
+    os_long ti)
+{
+    iocBrickHdr *hdr;
+    os_uchar *p, c;
+    os_memsz row_nbytes, pixel_nbytes, buf_sz, i;
+    os_ushort checksum;
+    os_int y;
+
+    pixel_nbytes = 3 * (os_memsz)m_cfg->camera_w;
+    row_nbytes = (pixel_nbytes + 1) & ~(os_memsz)1;
+    buf_sz = sizeof(iocBrickHdr) + row_nbytes * m_cfg->camera_h;
+
+    if (m_brick.buf == OS_NULL || m_brick.buf_alloc_sz < buf_sz) {
+        if (m_brick.buf) {
+            os_free(m_brick.buf, m_brick.buf_alloc_sz);
+        }
+        m_brick.buf = (os_uchar*)os_malloc(buf_sz, &m_brick.buf_alloc_sz);
+        if (m_brick.buf == OS_NULL) {
+            m_brick.buf_alloc_sz = 0;
+            return;
+        }
+    }
+
+    hdr = (iocBrickHdr*)m_brick.buf;
+    os_memclear(hdr, sizeof(iocBrickHdr));
+    hdr->format = OSAL_RGB24;
+    hdr->compression = IOC_UNCOMPRESSED;
+    iof_set_brick_hdr_int(hdr->width, m_cfg->camera_w, IOC_BRICK_DIM_SZ);
+    iof_set_brick_hdr_int(hdr->height, m_cfg->camera_h, IOC_BRICK_DIM_SZ);
+    iof_set_brick_hdr_int(hdr->buf_sz, buf_sz, IOC_BRICK_BYTES_SZ);
+    iof_set_brick_hdr_int(hdr->alloc_sz, buf_sz, IOC_BRICK_BYTES_SZ);
+    iof_set_brick_hdr_int(hdr->tstamp, ti, IOC_BRICK_TSTAMP_SZ);
+
+    p = m_brick.buf + sizeof(iocBrickHdr);
+    for (y = 0; y < m_cfg->camera_h; y++) {
+        c = (os_uchar)(y + 4 * m_frame_nr);
+        for (i = 0; i < pixel_nbytes; i++) {
+            *(p++) = c;
+        }
+        for (; i < row_nbytes; i++) {
+            *(p++) = 0;
+        }
+    }
+
+    checksum = os_checksum((const os_char*)m_brick.buf, buf_sz, OS_NULL);
+    iof_set_brick_hdr_int(hdr->checksum, checksum, IOC_BRICK_CHECKSUM_SZ);
+
+    m_brick.buf_sz = buf_sz;
+    m_brick.pos = 0;
+    m_frame_nr++;
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Generate packed JSON info block describing the signals.
+
+  Signals are in "farm" group of "exp" memory block: time stamp "tstamp", scalar signals
+  "s0", "s1"... and array signals "a0", "a1"... Camera devices have also "camera" groups in
+  "exp" and "imp" memory blocks and "camera" assembly, which eioRoot sets up as brick
+  buffer. Addresses are given explicitly and memory block sizes are calculated here.
+
+  @return  ESTATUS_SUCCESS if all fine, other values indicate an error.
+
+****************************************************************************************************
+*/
+eStatus iofDevice::make_info()
+{
+    eVariable json;
+    os_char nbuf[OSAL_NBUF_SZ];
+    os_int addr, i;
+
+    json = "{\"mblk\":[{\"name\":\"exp\",\"groups\":[{\"name\":\"farm\",\"signals\":[";
+    addr = 0;
+    add_signal(&json, &m_sig_tstamp, &m_exp, "tstamp", OS_LONG, 1, &addr);
+    for (i = 0; i < m_cfg->nsignals; i++) {
+        nbuf[0] = 's';
+        osal_int_to_str(nbuf + 1, sizeof(nbuf) - 1, i);
+        add_signal(&json, m_sigs + i, &m_exp, nbuf, OS_FLOAT, 1, &addr);
+    }
+    for (i = 0; i < m_cfg->narrays; i++) {
+        nbuf[0] = 'a';
+        osal_int_to_str(nbuf + 1, sizeof(nbuf) - 1, i);
+        add_signal(&json, m_arrays + i, &m_exp, nbuf, OS_FLOAT, m_cfg->array_n, &addr);
+    }
+    json += "]}";
+
+    if (m_has_camera) {
+        json += ",{\"name\":\"camera\",\"signals\":[";
+        add_signal(&json, &m_sig_state, &m_exp, "rec_state", OS_CHAR, 1, &addr);
+        add_signal(&json, &m_sig_err, &m_exp, "rec_err", OS_CHAR, 1, &addr);
+        add_signal(&json, &m_sig_cs, &m_exp, "rec_cs", OS_USHORT, 1, &addr);
+        add_signal(&json, &m_sig_head, &m_exp, "rec_head", OS_INT, 1, &addr);
+        add_signal(&json, &m_sig_buf, &m_exp, "rec_buf", OS_UCHAR, IOF_CAMERA_BUF_SZ, &addr);
+        json += "]}";
+    }
+    json += "]}";
+    m_exp_sz = addr;
+
+    if (m_has_camera) {
+        json += ",{\"name\":\"imp\",\"groups\":[{\"name\":\"camera\",\"signals\":[";
+        addr = 0;
+        add_signal(&json, &m_sig_cmd, &m_imp, "rec_cmd", OS_CHAR, 1, &addr);
+        json += "]}]}";
+        m_imp_sz = addr;
+    }
+    json += "]";
+
+    if (m_has_camera) {
+        json += ",\"assembly\":[{\"name\":\"camera\",\"type\":\"cam_flat\","
+            "\"exp\":\"exp\",\"imp\":\"imp\"}]";
+    }
+    json += "}";
+
+    m_info_buf = iof_pack_json(json.gets(), &m_info_sz, &m_info_alloc_sz);
+    return m_info_buf ? ESTATUS_SUCCESS : ESTATUS_FAILED;
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Add signal to JSON and set up iocSignal for it.
+
+  Address is advanced the same way as eioRoot does when it parses the info block: Each signal
+  takes it's data and one state bits byte.
+
+  @param   json JSON being generated.
+  @param   sig Signal structure to set up.
+  @param   handle Memory block handle.
+  @param   name Signal name.
+  @param   type_id Signal type, like OS_FLOAT.
+  @param   n Number of elements, 1 if not array.
+  @param   addr Pointer to current address within memory block, advanced.
+
+****************************************************************************************************
+*/
+void iofDevice::add_signal(
+    eVariable *json,
+    iocSignal *sig,
+    iocHandle *handle,
+    const os_char *name,
+    osalTypeId type_id,
+    os_int n,
+    os_int *addr)
+{
+    const os_char *p;
+    os_memsz len;
+
+    p = json->gets();
+    len = os_strlen(p);
+    if (len > 1 && p[len - 2] != '[') {
+        json->appends(",");
+    }
+    json->appends("{\"name\":\"");
+    json->appends(name);
+    json->appends("\",\"type\":\"");
+    json->appends(osal_typeid_to_name(type_id));
+    json->appends("\",\"addr\":");
+    json->appendl(*addr);
+    if (n > 1) {
+        json->appends(",\"array\":");
+        json->appendl(n);
+    }
+    json->appends("}");
+
+    sig->handle = handle;
+    sig->addr = *addr;
+    sig->n = n;
+    sig->flags = (os_short)type_id;
+
+    *addr += n * (os_int)osal_type_size(type_id) + 1;
+}
@@ -0,0 +1,161 @@
+/**
+
+  @file    iofarm_iocom.cpp
+  @brief   Device side iocom calls of simulated devices.
+  @author  Pekka Lehtikoski
+  @version 1.0
+  @date    18.10.2026
+
+  The eobjects library uses iocom only from the controller side, so simulated devices need
+  iocom and eosal functions which are not called anywhere else in eobjects: Memory block
+  initialization with static buffer, explicit send and receive, device side brick sending,
+  writing brick header integers and packing JSON. These calls are collected here, so that
+  iofarm_device.cpp uses only functions also used elsewhere in eobjects. If iocom's
+  device API differs from what is assumed here, this is the only file to fix.
+
+  Copyright 2020 Pekka Lehtikoski. This file is part of the eobjects project and shall only be used,
+  modified, and distributed under the terms of the project licensing. By continuing to use, modify,
+  or distribute this file you indicate that you have read the license and understand and accept
+  it fully.
+
+****************************************************************************************************
+*/
+#include "iofarm.h"
+
+
+/**
+****************************************************************************************************
+
+  @brief Initialize memory block of simulated device.
+
+  @param   handle Memory block handle to set up.
+  @param   root Device's iocom root.
+  @param   device_nr Device number.
+  @param   mblk_name Memory block name, like "exp".
+  @param   buf Static content, like packed JSON info. OS_NULL to allocate the block.
+  @param   nbytes Memory block size in bytes.
+  @param   up OS_TRUE for device to controller, OS_FALSE for controller to device.
+
+****************************************************************************************************
+*/
+void iof_initialize_mblk(
+    iocHandle *handle,
+    iocRoot *root,
+    os_int device_nr,
+    const os_char *mblk_name,
+    os_char *buf,
+    os_int nbytes,
+    os_boolean up)
+{
+    iocMemoryBlockParams blockprm;
+
+    os_memclear(&blockprm, sizeof(blockprm));
+    blockprm.device_name = IOF_DEVICE_NAME;
+    blockprm.device_nr = device_nr;
+    blockprm.network_name = IOF_NETWORK_NAME;
+    blockprm.mblk_name = mblk_name;
+    blockprm.buf = buf;
+    blockprm.nbytes = nbytes;
+    blockprm.flags = up ? IOC_MBLK_UP : IOC_MBLK_DOWN;
+    if (buf) {
+        blockprm.flags |= IOC_STATIC;
+    }
+    ioc_initialize_memory_block(handle, OS_NULL, root, &blockprm);
+}
+
+
+/**
+****************************************************************************************************
+  Send changes written to memory block.
+****************************************************************************************************
+*/
+void iof_send(
+    iocHandle *handle)
+{
+    ioc_send(handle);
+}
+
+
+/**
+****************************************************************************************************
+  Move received data into memory block.
+****************************************************************************************************
+*/
+void iof_receive(
+    iocHandle *handle)
+{
+    ioc_receive(handle);
+}
+
+
+/**
+****************************************************************************************************
+  Check if previous brick has been sent and a new one can be generated.
+****************************************************************************************************
+*/
+os_boolean iof_brick_empty(
+    iocBrickBuffer *brick)
+{
+    return (os_boolean)ioc_is_brick_empty(brick);
+}
+
+
+/**
+****************************************************************************************************
+  Continue sending brick from device.
+****************************************************************************************************
+*/
+void iof_brick_send(
+    iocBrickBuffer *brick)
+{
+    ioc_run_brick_send(brick);
+}
+
+
+/**
+****************************************************************************************************
+  Store integer in brick header field, counterpart of ioc_get_brick_hdr_int().
+****************************************************************************************************
+*/
+void iof_set_brick_hdr_int(
+    os_uchar *field,
+    os_ulong value,
+    os_int nbytes)
+{
+    ioc_set_brick_hdr_int(field, value, nbytes);
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Pack JSON text as iocom info block.
+
+  @param   json JSON text.
+  @param   nbytes Where to store packed size in bytes.
+  @param   alloc_sz Where to store allocated size, for os_free().
+  @return  Packed JSON, allocated by os_malloc(). OS_NULL if failed.
+
+****************************************************************************************************
+*/
+os_char *iof_pack_json(
+    const os_char *json,
+    os_memsz *nbytes,
+    os_memsz *alloc_sz)
+{
+    osalStream stream;
+    os_char *buf;
+
+    *nbytes = *alloc_sz = 0;
+    stream = osal_stream_buffer_open(OS_NULL, OS_NULL, OS_NULL, OSAL_STREAM_WRITE);
+    if (stream == OS_NULL) {
+        return OS_NULL;
+    }
+
+    buf = OS_NULL;
+    if (osal_compress_json(stream, json, OS_NULL, 0) == OSAL_SUCCESS) {
+        buf = osal_stream_buffer_adopt_content(stream, nbytes, alloc_sz);
+    }
+    osal_stream_close(stream, OSAL_STREAM_DEFAULT);
+    return buf;
+}
@@ -0,0 +1,197 @@
+/**
+
+  @file    iofarm_monitor.cpp
+  @brief   Measure IO updates received from simulated devices.
+  @author  Pekka Lehtikoski
+  @version 1.0
+  @date    18.10.2026
+
+  Probes are bound to time stamp IO variables and camera brick buffers of simulated devices,
+  and collect latency and frame statistics. Helper functions here walk the IO object
+  hierarchy to check which devices are set up, and to sum up signal changes processed by
+  eioRoot.
+
+  Copyright 2020 Pekka Lehtikoski. This file is part of the eobjects project and shall only be used,
+  modified, and distributed under the terms of the project licensing. By continuing to use, modify,
+  or distribute this file you indicate that you have read the license and understand and accept
+  it fully.
+
+****************************************************************************************************
+*/
+#include "iofarm.h"
+
+/* Statistics collected by probes, os_lock() must be on to access.
+ */
+static iofStats iof_stats;
+
+
+/**
+****************************************************************************************************
+  Constructor.
+****************************************************************************************************
+*/
+iofProbe::iofProbe(
+    eObject *parent,
+    os_boolean is_camera)
+    : eVariable(parent)
+{
+    m_is_camera = is_camera;
+    m_got_first = OS_FALSE;
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Called when property value changes.
+
+  The first value received after binding is the value which the IO variable already had,
+  it is not counted.
+
+  @param   propertynr Property number of changed property.
+  @param   x Variable containing the new value.
+  @param   flags
+  @return  If successfull, the function returns ESTATUS_SUCCESS (0). Other return values
+           indicate that the property number was not recognized, or an error.
+
+****************************************************************************************************
+*/
+eStatus iofProbe::onpropertychange(
+    os_int propertynr,
+    eVariable *x,
+    os_int flags)
+{
+    eBitmap *bitmap;
+    eObject *o;
+    os_long latency;
+
+    if (propertynr == EVARP_VALUE)
+    {
+        if (m_got_first)
+        {
+            if (m_is_camera)
+            {
+                o = x->geto();
+                bitmap = (o && o->classid() == ECLASSID_BITMAP) ? eBitmap::cast(o) : OS_NULL;
+                os_lock();
+                iof_stats.nframes++;
+                if (bitmap) {
+                    iof_stats.frame_bytes += (os_long)bitmap->row_nbytes() * bitmap->height();
+                }
+                os_unlock();
+            }
+            else
+            {
+                latency = etime() - x->getl();
+                os_lock();
+                iof_stats.nupdates++;
+                iof_stats.latency_sum += latency;
+                if (latency > iof_stats.latency_max) iof_stats.latency_max = latency;
+                os_unlock();
+            }
+        }
+        m_got_first = OS_TRUE;
+    }
+
+    return eVariable::onpropertychange(propertynr, x, flags);
+}
+
+
+/**
+****************************************************************************************************
+  Clear statistics, start of measurement period.
+****************************************************************************************************
+*/
+void iof_reset_stats()
+{
+    os_lock();
+    os_memclear(&iof_stats, sizeof(iofStats));
+    os_unlock();
+}
+
+
+/**
+****************************************************************************************************
+  Get copy of statistics.
+****************************************************************************************************
+*/
+void iof_get_stats(
+    iofStats *stats)
+{
+    os_lock();
+    *stats = iof_stats;
+    os_unlock();
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Count devices set up in IO object hierarchy.
+
+  A device is set up when it's info block has been applied, so it's IO variables and
+  assemblies exist and can be bound to. os_lock() must be on.
+
+  @param   eio_root IO object hierarchy root.
+  @return  Number of devices with info applied.
+
+****************************************************************************************************
+*/
+os_int iof_count_ready_devices(
+    eioRoot *eio_root)
+{
+    eObject *network, *o;
+    os_int count;
+
+    count = 0;
+    for (network = eio_root->first(); network; network = network->next())
+    {
+        if (network->classid() != ECLASSID_EIO_NETWORK) continue;
+        for (o = network->first(); o; o = o->next())
+        {
+            if (o->classid() != ECLASSID_EIO_DEVICE) continue;
+            if (eioDevice::cast(o)->info()) count++;
+        }
+    }
+    return count;
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Sum up signal changes processed by eioRoot.
+
+  Sums "nchanged" counters of all memory blocks. The counters are cumulative, processing
+  rate is the difference of two calls divided by time between them. os_lock() must be on.
+
+  @param   eio_root IO object hierarchy root.
+  @return  Number of signal changes processed.
+
+****************************************************************************************************
+*/
+os_long iof_count_changes(
+    eioRoot *eio_root)
+{
+    eObject *network, *o, *m;
+    eContainer *mblks;
+    os_long count;
+
+    count = 0;
+    for (network = eio_root->first(); network; network = network->next())
+    {
+        if (network->classid() != ECLASSID_EIO_NETWORK) continue;
+        for (o = network->first(); o; o = o->next())
+        {
+            if (o->classid() != ECLASSID_EIO_DEVICE) continue;
+            mblks = eioDevice::cast(o)->mblks();
+            if (mblks == OS_NULL) continue;
+            for (m = mblks->first(); m; m = m->next())
+            {
+                if (m->classid() != ECLASSID_EIO_MBLK) continue;
+                count += m->propertyl(EIOP_NCHANGED);
+            }
+        }
+    }
+    return count;
+}
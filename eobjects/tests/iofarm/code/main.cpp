@@ -0,0 +1,64 @@
+/**
+
+  @file    main.cpp
+  @brief   Simulated iocom device farm for IO load benchmarking.
+  @author  Pekka Lehtikoski
+  @version 1.0
+  @date    18.10.2026
+
+  Runs N simulated iocom devices in this process, connected to eioRoot through loopback socket
+  and eioProtocol, and reports how fast IO is processed. Configuration is given as "name=value"
+  command line arguments, for example:
+
+      iofarm devices=100 signals=500 arrays=4 arraysz=64 period=10 changepct=20 cameras=2
+
+  Copyright 2020 Pekka Lehtikoski. This file is part of the eobjects project and shall only be used,
+  modified, and distributed under the terms of the project licensing. By continuing to use, modify,
+  or distribute this file you indicate that you have read the license and understand and accept
+  it fully.
+
+****************************************************************************************************
+*/
+#include "iofarm.h"
+
+/* If needed for the operating system, EOSAL_C_MAIN macro generates the actual C main() function.
+   and macro EMAIN_CONSOLE_ENTRY eobjects specific osal_main() function which calls emain.
+ */
+EOSAL_C_MAIN
+EMAIN_CONSOLE_ENTRY("iofarm")
+
+/**
+****************************************************************************************************
+
+  @brief Application entry point.
+
+  The emain() function starts network service with iocom protocol, without end points or
+  user authentication, and runs the device farm.
+
+  @param   argc Number of command line arguments.
+  @param   argv Array of string pointers, one for each command line argument. UTF8 encoded.
+
+  @return  ESTATUS_SUCCESS if all fine, other values indicate an error.
+
+****************************************************************************************************
+*/
+eStatus emain(
+    os_int argc,
+    os_char *argv[])
+{
+    iofConfig cfg;
+    eStatus s;
+
+    iof_configure(&cfg, argc, argv);
+
+    enet_initialize_service();
+    os_lock(); /* root pointer used */
+    enet_add_protocol(new eioProtocol(eglobal_root()));
+    os_unlock();
+    enet_start_service(ENET_ENABLE_IOCOM_CLIENT);
+
+    s = iof_run_farm(&cfg);
+
+    enet_stop_service();
+    return s;
+}
@@ -0,0 +1,18 @@
+/**
+
+  @file    bitmap.h
+  @brief   Example code about bitmaps.
+  @author  Pekka Lehtikoski
+  @version 1.0
+  @date    18.10.2026
+
+  Copyright 2020 Pekka Lehtikoski. This file is part of the eobjects project and shall only be used,
+  modified, and distributed under the terms of the project licensing. By continuing to use, modify,
+  or distribute this file you indicate that you have read the license and understand and accept
+  it fully.
+
+****************************************************************************************************
+*/
+
+void bitmap_codec_1();
+void bitmap_scale_2();
@@ -0,0 +1,199 @@
+/**
+
+  @file    bitmap1.cpp
+  @brief   Bitmap codec benchmark.
+  @author  Pekka Lehtikoski
+  @version 1.0
+  @date    18.10.2026
+
+  This example runs several synthetic cameras, each a thread which generates a frame at
+  fixed rate and sends it to "//codec" to be compressed as JPEG. The benchmark is repeated
+  with different number of codec worker threads, and frame rate and latency from queueing
+  to reply are printed.
+
+  Copyright 2020 Pekka Lehtikoski. This file is part of the eobjects project and shall only be used,
+  modified, and distributed under the terms of the project licensing. By continuing to use, modify,
+  or distribute this file you indicate that you have read the license and understand and accept
+  it fully.
+
+****************************************************************************************************
+*/
+#include "eobjects.h"
+#include "bitmap.h"
+#include <stdio.h>
+
+/* Number of cameras, frames sent by each camera, frame period and size.
+ */
+#define B1_NRO_CAMERAS 4
+#define B1_NRO_FRAMES 60
+#define B1_FRAME_PERIOD_MS 33
+#define B1_WIDTH 1280
+#define B1_HEIGHT 720
+
+/* Class identifier for the camera thread.
+ */
+#define MY_CLASS_ID_4 (ECLASSID_APP_BASE + 4)
+
+/* Number of processed frames received back by cameras, and latency statistics.
+   Updated by camera threads, os_lock() must be on.
+ */
+static volatile os_int b1_nreplies;
+static os_long b1_latency_sum, b1_latency_max;
+
+
+/**
+****************************************************************************************************
+  Synthetic camera thread.
+****************************************************************************************************
+*/
+class b1Camera : public eThread
+{
+public:
+    /* Constructor.
+     */
+    b1Camera(
+        os_int camera_nr)
+        : eThread()
+    {
+        m_camera_nr = camera_nr;
+        m_nsent = 0;
+    }
+
+    /* Get class identifier.
+     */
+    virtual os_int classid()
+    {
+        return MY_CLASS_ID_4;
+    }
+
+    virtual void onmessage(
+        eEnvelope *envelope)
+    {
+        if (*envelope->target() == '\0')
+        {
+            switch (envelope->command())
+            {
+                case ECMD_TIMER:
+                    if (m_nsent < B1_NRO_FRAMES) {
+                        send_frame();
+                    }
+                    return;
+
+                case ECMD_BITMAP_CODEC_REPLY:
+                    frame_done(envelope);
+                    return;
+            }
+        }
+
+        eThread::onmessage(envelope);
+    }
+
+protected:
+    /* Generate moving test pattern and send it to be compressed.
+     */
+    void send_frame()
+    {
+        eBitmap *bitmap;
+        os_uchar *row, *p;
+        os_int x, y, row_nbytes;
+
+        bitmap = new eBitmap(this);
+        bitmap->allocate(OSAL_RGB24, B1_WIDTH, B1_HEIGHT);
+        row = bitmap->ptr();
+        row_nbytes = bitmap->row_nbytes();
+        for (y = 0; y < B1_HEIGHT; y++) {
+            p = row;
+            for (x = 0; x < B1_WIDTH; x++) {
+                *(p++) = (os_uchar)(x + 4 * m_nsent);
+                *(p++) = (os_uchar)(y + 64 * m_camera_nr);
+                *(p++) = (os_uchar)((x ^ y) >> 2);
+            }
+            row += row_nbytes;
+        }
+
+        message(ECMD_BITMAP_COMPRESS, "//codec", OS_NULL, bitmap, EMSG_DEL_CONTENT);
+        m_nsent++;
+    }
+
+    /* Compressed frame received back.
+     */
+    void frame_done(
+        eEnvelope *envelope)
+    {
+        eObject *c;
+        eVariable *v;
+        os_long latency;
+
+        c = envelope->content();
+        if (c == OS_NULL) return;
+        v = eVariable::cast(c->first(EOID_PARAMETER));
+        latency = v ? v->getl() : 0;
+
+        os_lock();
+        b1_latency_sum += latency;
+        if (latency > b1_latency_max) b1_latency_max = latency;
+        b1_nreplies++;
+        os_unlock();
+    }
+
+    os_int m_camera_nr;
+    os_int m_nsent;
+};
+
+
+/**
+****************************************************************************************************
+  Bitmap example 1: Compress frames from several cameras with 0, 1, 2 and 4 worker threads.
+****************************************************************************************************
+*/
+void bitmap_codec_1()
+{
+    static const os_int pool_sizes[] = {0, 1, 2, 4};
+    const os_int nframes = B1_NRO_CAMERAS * B1_NRO_FRAMES;
+    eThread *t;
+    eThreadHandle codechandle, camerahandle[B1_NRO_CAMERAS];
+    eContainer c;
+    os_timer start_t;
+    os_long start_us, elapsed_ms;
+    os_int i, j;
+
+    for (j = 0; j < (os_int)(sizeof(pool_sizes) / sizeof(os_int)); j++)
+    {
+        b1_nreplies = 0;
+        b1_latency_sum = b1_latency_max = 0;
+
+        /* Start codec, do not drop frames so that all are counted.
+         */
+        ebitmap_start_codec("//codec", pool_sizes[j], &codechandle);
+        c.setpropertyl_msg("//codec", 0, ebcodecp_max_queue);
+
+        os_get_timer(&start_t);
+        start_us = etime();
+        for (i = 0; i < B1_NRO_CAMERAS; i++) {
+            t = new b1Camera(i);
+            t->timer(B1_FRAME_PERIOD_MS);
+            t->start(&camerahandle[i]); /* After this t pointer is useless */
+        }
+
+        /* Wait until all frames have been received back, or 60 seconds.
+         */
+        while (b1_nreplies < nframes && !os_has_elapsed(&start_t, 60000)) {
+            osal_sleep(10);
+        }
+        elapsed_ms = (etime() - start_us) / 1000;
+
+        printf("%d cameras, %d worker threads: %d of %d frames in %lld ms, %.1f fps, "
+            "latency avg %.1f ms, max %.1f ms\n", B1_NRO_CAMERAS, pool_sizes[j],
+            b1_nreplies, nframes, (long long)elapsed_ms,
+            elapsed_ms ? 1000.0 * b1_nreplies / elapsed_ms : 0.0,
+            b1_nreplies ? 0.001 * b1_latency_sum / b1_nreplies : 0.0,
+            0.001 * b1_latency_max);
+
+        for (i = 0; i < B1_NRO_CAMERAS; i++) {
+            camerahandle[i].terminate();
+            camerahandle[i].join();
+        }
+        codechandle.terminate();
+        codechandle.join();
+    }
+}
@@ -0,0 +1,386 @@
+/**
+
+  @file    bitmap2.cpp
+  @brief   Bitmap scaling, pyramid and cropping unit test.
+  @author  Pekka Lehtikoski
+  @version 1.0
+  @date    18.10.2026
+
+  Small bitmaps with known content are scaled, cropped and reduced to pyramid, and the
+  result pixels are compared to expected values. Box filter is checked both shrinking and
+  enlarging, bilinear interpolation on a gradient. RGB24 bitmaps have row padding filled
+  with garbage, which must not leak into the result, and GRAYSCALE16 values must keep full
+  16 bit range.
+
+  Copyright 2020 Pekka Lehtikoski. This file is part of the eobjects project and shall only be used,
+  modified, and distributed under the terms of the project licensing. By continuing to use, modify,
+  or distribute this file you indicate that you have read the license and understand and accept
+  it fully.
+
+****************************************************************************************************
+*/
+#include "eobjects.h"
+#include "bitmap.h"
+#include <stdio.h>
+
+/* Garbage written to RGB24 row padding.
+ */
+#define B2_PADDING_BYTE 0xEE
+
+
+/* Print error message if condition is not true.
+ */
+static os_boolean b2_check(
+    os_boolean condition,
+    const os_char *what)
+{
+    if (!condition) printf("%s failed\n", what);
+    return condition;
+}
+
+/* Get pointer to pixel.
+ */
+static os_uchar *b2_pixel(
+    eBitmap *b,
+    os_int x,
+    os_int y)
+{
+    return b->ptr() + (os_memsz)y * b->row_nbytes() + (os_memsz)x * b->pixel_nbytes();
+}
+
+/* Get and set GRAYSCALE16 pixel.
+ */
+static os_int b2_get16(
+    eBitmap *b,
+    os_int x,
+    os_int y)
+{
+    return *(os_ushort*)b2_pixel(b, x, y);
+}
+
+static void b2_set16(
+    eBitmap *b,
+    os_int x,
+    os_int y,
+    os_int v)
+{
+    *(os_ushort*)b2_pixel(b, x, y) = (os_ushort)v;
+}
+
+/* Check that bitmap has expected format and size.
+ */
+static os_boolean b2_check_size(
+    eBitmap *b,
+    osalBitmapFormat format,
+    os_int width,
+    os_int height,
+    const os_char *what)
+{
+    if (b->format() == format && b->width() == width && b->height() == height) {
+        return OS_TRUE;
+    }
+    printf("%s: %dx%d format %d, expected %dx%d format %d\n", what, b->width(), b->height(),
+        (int)b->format(), width, height, (int)format);
+    return OS_FALSE;
+}
+
+/* Check GRAYSCALE8 bitmap against expected pixel values, tolerance in pixel value units.
+ */
+static os_boolean b2_check_gray8(
+    eBitmap *b,
+    const os_uchar *expected,
+    os_int tolerance,
+    const os_char *what)
+{
+    os_int x, y, v, e;
+
+    for (y = 0; y < b->height(); y++) {
+        for (x = 0; x < b->width(); x++) {
+            v = *b2_pixel(b, x, y);
+            e = expected[y * b->width() + x];
+            if (v < e - tolerance || v > e + tolerance) {
+                printf("%s: pixel %d,%d is %d, expected %d\n", what, x, y, v, e);
+                return OS_FALSE;
+            }
+        }
+    }
+    return OS_TRUE;
+}
+
+
+/**
+****************************************************************************************************
+  Box filter: Shrink averages blocks, enlarge replicates pixels.
+****************************************************************************************************
+*/
+static os_boolean b2_box()
+{
+    eBitmap src, dst;
+    os_int x, y;
+    os_boolean ok = OS_TRUE;
+
+    static const os_uchar shrunk[] = {
+        35, 55,
+        115, 135};
+
+    static const os_uchar enlarged[] = {
+        10, 10, 20, 20,
+        10, 10, 20, 20,
+        50, 50, 60, 60,
+        50, 50, 60, 60};
+
+    /* 4x4 source, pixel = 10 * x + 40 * y + 10.
+     */
+    src.allocate(OSAL_GRAYSCALE8, 4, 4);
+    for (y = 0; y < 4; y++) {
+        for (x = 0; x < 4; x++) {
+            *b2_pixel(&src, x, y) = (os_uchar)(10 * x + 40 * y + 10);
+        }
+    }
+
+    ok &= b2_check(src.scale(&dst, 2, 2) == ESTATUS_SUCCESS, "box shrink");
+    ok &= b2_check_size(&dst, OSAL_GRAYSCALE8, 2, 2, "box shrink");
+    if (ok) ok &= b2_check_gray8(&dst, shrunk, 0, "box shrink");
+
+    /* Enlarge the 2x2 top left block back to 4x4 with box filter.
+     */
+    src.allocate(OSAL_GRAYSCALE8, 2, 2);
+    *b2_pixel(&src, 0, 0) = 10;
+    *b2_pixel(&src, 1, 0) = 20;
+    *b2_pixel(&src, 0, 1) = 50;
+    *b2_pixel(&src, 1, 1) = 60;
+    ok &= b2_check(src.scale(&dst, 4, 4, EBITMAP_SCALE_BOX) == ESTATUS_SUCCESS, "box enlarge");
+    ok &= b2_check_size(&dst, OSAL_GRAYSCALE8, 4, 4, "box enlarge");
+    if (ok) ok &= b2_check_gray8(&dst, enlarged, 0, "box enlarge");
+
+    return ok;
+}
+
+
+/**
+****************************************************************************************************
+  Bilinear: Gradient is interpolated, uniform bitmap stays uniform.
+****************************************************************************************************
+*/
+static os_boolean b2_bilinear()
+{
+    eBitmap src, dst;
+    os_int x, y;
+    os_boolean ok = OS_TRUE;
+
+    static const os_uchar gradient[] = {0, 64, 191, 255};
+
+    src.allocate(OSAL_GRAYSCALE8, 2, 1);
+    *b2_pixel(&src, 0, 0) = 0;
+    *b2_pixel(&src, 1, 0) = 255;
+    ok &= b2_check(src.scale(&dst, 4, 1, EBITMAP_SCALE_BILINEAR) == ESTATUS_SUCCESS,
+        "bilinear gradient");
+    ok &= b2_check_size(&dst, OSAL_GRAYSCALE8, 4, 1, "bilinear gradient");
+    if (ok) ok &= b2_check_gray8(&dst, gradient, 1, "bilinear gradient");
+
+    src.allocate(OSAL_GRAYSCALE8, 5, 3);
+    for (y = 0; y < 3; y++) {
+        for (x = 0; x < 5; x++) {
+            *b2_pixel(&src, x, y) = 77;
+        }
+    }
+    ok &= b2_check(src.scale(&dst, 13, 7, EBITMAP_SCALE_BILINEAR) == ESTATUS_SUCCESS,
+        "bilinear uniform");
+    ok &= b2_check_size(&dst, OSAL_GRAYSCALE8, 13, 7, "bilinear uniform");
+    for (y = 0; y < dst.height() && ok; y++) {
+        for (x = 0; x < dst.width(); x++) {
+            if (*b2_pixel(&dst, x, y) != 77) {
+                printf("bilinear uniform: pixel %d,%d is %d\n", x, y, *b2_pixel(&dst, x, y));
+                ok = OS_FALSE;
+                break;
+            }
+        }
+    }
+
+    return ok;
+}
+
+
+/**
+****************************************************************************************************
+  RGB24: Rows are padded to 4 bytes, padding must not be used as pixel data.
+****************************************************************************************************
+*/
+static os_boolean b2_rgb24()
+{
+    eBitmap src, dst;
+    os_uchar *p;
+    os_int x, y, c, e;
+    os_boolean ok = OS_TRUE;
+
+    /* 6x2 source: 18 bytes of pixels and 2 bytes of padding per row. Channel c of pixel
+       x is 40 * x + c + 1 on the top row and 20 more on the bottom row.
+     */
+    src.allocate(OSAL_RGB24, 6, 2);
+    ok &= b2_check(src.row_nbytes() == 20, "rgb24 source row padding");
+    for (y = 0; y < 2; y++) {
+        p = src.ptr() + y * src.row_nbytes();
+        for (x = 0; x < src.row_nbytes(); x++) {
+            p[x] = B2_PADDING_BYTE;
+        }
+        for (x = 0; x < 6; x++) {
+            for (c = 0; c < 3; c++) {
+                p[3 * x + c] = (os_uchar)(40 * x + c + 1 + 20 * y);
+            }
+        }
+    }
+
+    /* Box shrink to 3x1: Average of 2x2 blocks, last pixel next to the padding.
+     */
+    ok &= b2_check(src.scale(&dst, 3, 1) == ESTATUS_SUCCESS, "rgb24 shrink");
+    ok &= b2_check_size(&dst, OSAL_RGB24, 3, 1, "rgb24 shrink");
+    ok &= b2_check(dst.row_nbytes() == 12, "rgb24 destination row padding");
+    for (x = 0; x < dst.width() && ok; x++) {
+        for (c = 0; c < 3; c++) {
+            e = 40 * (2 * x) + 20 + c + 1 + 10;
+            if (b2_pixel(&dst, x, 0)[c] != e) {
+                printf("rgb24 shrink: pixel %d channel %d is %d, expected %d\n", x, c,
+                    b2_pixel(&dst, x, 0)[c], e);
+                ok = OS_FALSE;
+            }
+        }
+    }
+
+    /* Crop the last three columns, including the pixel next to the padding.
+     */
+    ok &= b2_check(src.crop(&dst, 3, 0, 3, 2) == ESTATUS_SUCCESS, "rgb24 crop");
+    ok &= b2_check_size(&dst, OSAL_RGB24, 3, 2, "rgb24 crop");
+    for (y = 0; y < 2 && ok; y++) {
+        ok &= b2_check(!os_memcmp(b2_pixel(&dst, 0, y), b2_pixel(&src, 3, y), 9),
+            "rgb24 crop content");
+    }
+
+    return ok;
+}
+
+
+/**
+****************************************************************************************************
+  GRAYSCALE16: Full 16 bit values are averaged and interpolated without truncation.
+****************************************************************************************************
+*/
+static os_boolean b2_gray16()
+{
+    eBitmap src, dst;
+    os_boolean ok = OS_TRUE;
+
+    src.allocate(OSAL_GRAYSCALE16, 4, 2);
+    b2_set16(&src, 0, 0, 60000); b2_set16(&src, 1, 0, 40000);
+    b2_set16(&src, 2, 0, 65535); b2_set16(&src, 3, 0, 65535);
+    b2_set16(&src, 0, 1, 60000); b2_set16(&src, 1, 1, 40000);
+    b2_set16(&src, 2, 1, 1);     b2_set16(&src, 3, 1, 0);
+
+    ok &= b2_check(src.scale(&dst, 2, 1) == ESTATUS_SUCCESS, "gray16 shrink");
+    ok &= b2_check_size(&dst, OSAL_GRAYSCALE16, 2, 1, "gray16 shrink");
+    if (ok) {
+        ok &= b2_check(b2_get16(&dst, 0, 0) == 50000, "gray16 average");
+        ok &= b2_check(b2_get16(&dst, 1, 0) == 32768, "gray16 average rounding");
+    }
+
+    src.allocate(OSAL_GRAYSCALE16, 2, 1);
+    b2_set16(&src, 0, 0, 0);
+    b2_set16(&src, 1, 0, 65535);
+    ok &= b2_check(src.scale(&dst, 4, 1, EBITMAP_SCALE_BILINEAR) == ESTATUS_SUCCESS,
+        "gray16 bilinear");
+    if (ok) {
+        ok &= b2_check(b2_get16(&dst, 0, 0) == 0 && b2_get16(&dst, 3, 0) == 65535,
+            "gray16 bilinear end points");
+        ok &= b2_check(b2_get16(&dst, 1, 0) > 255 && b2_get16(&dst, 2, 0) < 65535 - 255 &&
+            b2_get16(&dst, 1, 0) < b2_get16(&dst, 2, 0), "gray16 bilinear range");
+    }
+
+    return ok;
+}
+
+
+/**
+****************************************************************************************************
+  Scale to fit, pyramid levels and crop clipping.
+****************************************************************************************************
+*/
+static os_boolean b2_fit_pyramid_crop()
+{
+    eBitmap src, dst, *level;
+    eContainer levels;
+    eObject *o;
+    os_int x, y, n, w, h;
+    os_boolean ok = OS_TRUE;
+
+    /* Aspect ratio is kept, bitmap which fits is copied as is.
+     */
+    src.allocate(OSAL_GRAYSCALE8, 64, 48);
+    for (y = 0; y < 48; y++) {
+        for (x = 0; x < 64; x++) {
+            *b2_pixel(&src, x, y) = (os_uchar)(4 * x);
+        }
+    }
+    ok &= b2_check(src.scale_to_fit(&dst, 20, 20) == ESTATUS_SUCCESS, "scale to fit");
+    ok &= b2_check_size(&dst, OSAL_GRAYSCALE8, 20, 15, "scale to fit");
+    ok &= b2_check(src.scale_to_fit(&dst, 100, 0) == ESTATUS_SUCCESS, "fit, no limit");
+    ok &= b2_check_size(&dst, OSAL_GRAYSCALE8, 64, 48, "fit, no limit");
+    if (ok) ok &= b2_check(!os_memcmp(dst.ptr(), src.ptr(), 64 * 48), "fit copy content");
+
+    /* 64x48 with minimum size 8: Levels 32x24, 16x12 and 8x6. Each is average of pixel
+       pairs: Pixel x of level l is 4 * 2^l * x + 2 * (2^l - 1).
+     */
+    n = src.pyramid(&levels, 8);
+    ok &= b2_check(n == 3, "pyramid level count");
+    w = 64;
+    h = 48;
+    n = 0;
+    for (o = levels.first(); o && ok; o = o->next())
+    {
+        level = eBitmap::cast(o);
+        w /= 2;
+        h /= 2;
+        n++;
+        ok &= b2_check_size(level, OSAL_GRAYSCALE8, w, h, "pyramid level size");
+        if (!ok) break;
+        for (x = 0; x < w; x++) {
+            if (*b2_pixel(level, x, h - 1) != 4 * (1 << n) * x + 2 * ((1 << n) - 1)) {
+                printf("pyramid level %d: pixel %d is %d\n", n, x, *b2_pixel(level, x, h - 1));
+                ok = OS_FALSE;
+                break;
+            }
+        }
+    }
+
+    /* Region is clipped to bitmap, region outside the bitmap fails.
+     */
+    ok &= b2_check(src.crop(&dst, -2, 46, 6, 6) == ESTATUS_SUCCESS, "crop clipping");
+    ok &= b2_check_size(&dst, OSAL_GRAYSCALE8, 4, 2, "crop clipping");
+    if (ok) ok &= b2_check(*b2_pixel(&dst, 3, 1) == 12, "crop clipping content");
+    ok &= b2_check(src.crop(&dst, 64, 0, 4, 4) != ESTATUS_SUCCESS, "crop outside");
+
+    return ok;
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Bitmap example 2.
+
+  The bitmap_scale_2() function tests scaling, scale to fit, pyramid and cropping.
+
+  @return  None.
+
+****************************************************************************************************
+*/
+void bitmap_scale_2()
+{
+    os_boolean ok = OS_TRUE;
+
+    ok &= b2_box();
+    ok &= b2_bilinear();
+    ok &= b2_rgb24();
+    ok &= b2_gray16();
+    ok &= b2_fit_pyramid_crop();
+
+    printf("bitmap_scale_2 %s\n", ok ? "passed" : "FAILED");
+}
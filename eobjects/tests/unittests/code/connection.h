@@ -17,3 +17,6 @@
 */
 
 void connection_example_1();
+void connection_example_2();
+void connection_example_3();
+void connection_example_4();
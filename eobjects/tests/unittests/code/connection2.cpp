@@ -0,0 +1,182 @@
+/**
+
+  @file    connection2.cpp
+  @brief   Connection setup benchmark.
+  @author  Pekka Lehtikoski
+  @version 1.0
+  @date    18.10.2026
+
+  This example measures time from start of N simultaneous connections to first message
+  received trough each connection. An end point and N connections run in the same process,
+  each connection carries one message, time stamped at sender, to a receiver thread.
+
+  Copyright 2020 Pekka Lehtikoski. This file is part of the eobjects project and shall only be used,
+  modified, and distributed under the terms of the project licensing. By continuing to use, modify,
+  or distribute this file you indicate that you have read the license and understand and accept
+  it fully.
+
+****************************************************************************************************
+*/
+#include "eobjects.h"
+#include "connection.h"
+#include <stdio.h>
+
+/* Number of simultaneous connections.
+ */
+#define C2_NRO_CONNECTIONS 100
+
+/* Class identifier for the receiver thread.
+ */
+#define MY_CLASS_ID_3 (ECLASSID_APP_BASE + 3)
+
+/* Enumeration of c2Receiver properties.
+ */
+#define EMYCLASS3P_T 10
+
+static const os_char emyclass3p_t[] = "T";
+
+/* Number of messages received, set by receiver thread.
+ */
+static volatile os_int c2_nreceived;
+
+
+/**
+****************************************************************************************************
+  Receiver thread, collects time to first message statistics.
+****************************************************************************************************
+*/
+class c2Receiver : public eThread
+{
+public:
+    /* Constructor.
+     */
+    c2Receiver(
+        eObject *parent = OS_NULL,
+        e_oid id = EOID_ITEM,
+        os_int flags = EOBJ_DEFAULT)
+        : eThread(parent, id, flags)
+    {
+        initproperties();
+        m_min_us = m_max_us = m_sum_us = 0;
+    }
+
+    /* Add c2Receiver'es properties to class'es property set.
+    */
+    static void setupclass()
+    {
+        const os_int cls = MY_CLASS_ID_3;
+
+        os_lock();
+        addpropertyl(cls, EMYCLASS3P_T, emyclass3p_t, "send time");
+        os_unlock();
+    }
+
+    /* Get class identifier.
+     */
+    virtual os_int classid()
+    {
+        return MY_CLASS_ID_3;
+    }
+
+    /* Every received time stamp is one connection's first message.
+     */
+    virtual eStatus onpropertychange(
+        os_int propertynr,
+        eVariable *x,
+        os_int flags)
+    {
+        os_long dt_us;
+
+        switch (propertynr)
+        {
+            case EMYCLASS3P_T:
+                if (x->isempty()) break;
+                dt_us = etime() - x->getl();
+                if (c2_nreceived == 0 || dt_us < m_min_us) m_min_us = dt_us;
+                if (dt_us > m_max_us) m_max_us = dt_us;
+                m_sum_us += dt_us;
+                if (++c2_nreceived == C2_NRO_CONNECTIONS)
+                {
+                    printf("%d connections, time to first message: min %.1f ms, "
+                        "avg %.1f ms, max %.1f ms\n", C2_NRO_CONNECTIONS,
+                        0.001 * m_min_us, 0.001 * m_sum_us / C2_NRO_CONNECTIONS,
+                        0.001 * m_max_us);
+                }
+                break;
+
+            default:
+                return ESTATUS_FAILED;
+        }
+
+        return ESTATUS_SUCCESS;
+    }
+
+    os_long m_min_us, m_max_us, m_sum_us;
+};
+
+
+/**
+****************************************************************************************************
+  Connection example 2: Time to first message for N simultaneous connects.
+****************************************************************************************************
+*/
+void connection_example_2()
+{
+    eThread *t;
+    eThreadHandle receiverhandle, endpointhandle, conhandle[C2_NRO_CONNECTIONS];
+    eContainer c;
+    eVariable name, path;
+    os_timer start_t;
+    os_int i;
+
+    c2Receiver::setupclass();
+    c2_nreceived = 0;
+
+    /* Receiver thread and end point to listen for connections.
+     */
+    t = new c2Receiver();
+    t->addname("c2receiver", ENAME_PROCESS_NS);
+    t->start(&receiverhandle);
+
+    t = new eEndPoint();
+    t->start(&endpointhandle);
+    c.setpropertys_msg(endpointhandle.uniquename(),
+         "socket::" IOC_DEFAULT_SOCKET_PORT_STR, eendpp_ipaddr);
+    osal_sleep(500);
+
+    /* Start all connections at once. Each connection buffers the time stamped message
+       until the connection is established.
+     */
+    for (i = 0; i < C2_NRO_CONNECTIONS; i++)
+    {
+        name = "//c2con";
+        name.appendl(i);
+        t = new eConnection();
+        t->addname(name.gets());
+        t->start(&conhandle[i]);
+        c.setpropertys_msg(conhandle[i].uniquename(), "socket:localhost", econnp_ipaddr);
+
+        path = name;
+        path += "/c2receiver";
+        c.setpropertyl_msg(path.gets(), etime(), emyclass3p_t);
+    }
+
+    /* Wait until all messages have been received, or 30 seconds.
+     */
+    os_get_timer(&start_t);
+    while (c2_nreceived < C2_NRO_CONNECTIONS && !os_has_elapsed(&start_t, 30000)) {
+        osal_sleep(10);
+    }
+    if (c2_nreceived < C2_NRO_CONNECTIONS) {
+        printf("timeout, %d of %d messages received\n", c2_nreceived, C2_NRO_CONNECTIONS);
+    }
+
+    for (i = 0; i < C2_NRO_CONNECTIONS; i++) {
+        conhandle[i].terminate();
+        conhandle[i].join();
+    }
+    endpointhandle.terminate();
+    endpointhandle.join();
+    receiverhandle.terminate();
+    receiverhandle.join();
+}
@@ -0,0 +1,249 @@
+/**
+
+  @file    connection3.cpp
+  @brief   Connection pool load test.
+  @author  Pekka Lehtikoski
+  @version 1.0
+  @date    18.10.2026
+
+  This example opens thousands of loopback connections. Server side end point passes accepted
+  connections to a pool of connection worker threads, and client side connections are also run
+  by connection workers, so number of threads stays small. Each connection carries one time
+  stamped message to receiver thread, which reports when all have arrived. The receiver
+  also binds to end point's connection pool statistics, and the test checks that all
+  accepted connections were run by the expected number of workers.
+
+  Copyright 2020 Pekka Lehtikoski. This file is part of the eobjects project and shall only be used,
+  modified, and distributed under the terms of the project licensing. By continuing to use, modify,
+  or distribute this file you indicate that you have read the license and understand and accept
+  it fully.
+
+****************************************************************************************************
+*/
+#include "eobjects.h"
+#include "connection.h"
+#include <stdio.h>
+
+/* Number of loopback connections.
+ */
+#define C3_NRO_CONNECTIONS 2000
+
+/* Number of client side worker threads needed.
+ */
+#define C3_NRO_CLIENT_WORKERS \
+    ((C3_NRO_CONNECTIONS + ECONNECTIONWORKER_MAX_CONNECTIONS - 1) / ECONNECTIONWORKER_MAX_CONNECTIONS)
+
+/* Number of server side worker threads, at least 8 and enough to run all connections.
+ */
+#define C3_SERVER_POOL_SIZE (C3_NRO_CLIENT_WORKERS > 8 ? C3_NRO_CLIENT_WORKERS : 8)
+
+/* Class identifier for the receiver thread.
+ */
+#define MY_CLASS_ID_4 (ECLASSID_APP_BASE + 4)
+
+/* Enumeration of c3Receiver properties.
+ */
+#define EMYCLASS4P_T 10
+#define EMYCLASS4P_WORKERS 11
+#define EMYCLASS4P_MAX_LOAD 12
+#define EMYCLASS4P_OVERFLOW 13
+
+static const os_char emyclass4p_t[] = "T";
+static const os_char emyclass4p_workers[] = "workers";
+static const os_char emyclass4p_max_load[] = "maxload";
+static const os_char emyclass4p_overflow[] = "overflow";
+
+/* Number of messages received and time when last one was received, set by receiver thread.
+ */
+static volatile os_int c3_nreceived;
+static volatile os_long c3_last_us;
+
+/* End point's connection pool statistics, set by receiver thread.
+ */
+static volatile os_int c3_pool_workers;
+static volatile os_int c3_pool_max_load;
+static volatile os_long c3_pool_overflow;
+
+
+/**
+****************************************************************************************************
+  Receiver thread, counts messages.
+****************************************************************************************************
+*/
+class c3Receiver : public eThread
+{
+public:
+    /* Constructor.
+     */
+    c3Receiver(
+        eObject *parent = OS_NULL,
+        e_oid id = EOID_ITEM,
+        os_int flags = EOBJ_DEFAULT)
+        : eThread(parent, id, flags)
+    {
+        initproperties();
+    }
+
+    /* Add c3Receiver'es properties to class'es property set.
+    */
+    static void setupclass()
+    {
+        const os_int cls = MY_CLASS_ID_4;
+
+        os_lock();
+        addpropertyl(cls, EMYCLASS4P_T, emyclass4p_t, "send time");
+        addpropertyl(cls, EMYCLASS4P_WORKERS, emyclass4p_workers, "pool workers");
+        addpropertyl(cls, EMYCLASS4P_MAX_LOAD, emyclass4p_max_load, "connections/worker");
+        addpropertyl(cls, EMYCLASS4P_OVERFLOW, emyclass4p_overflow, "pool overflow");
+        os_unlock();
+    }
+
+    /* Get class identifier.
+     */
+    virtual os_int classid()
+    {
+        return MY_CLASS_ID_4;
+    }
+
+    /* Bind to end point's connection pool statistics.
+     */
+    virtual void initialize(
+        eContainer *params = OS_NULL)
+    {
+        bind(EMYCLASS4P_WORKERS, "//c3endpoint/_p/poolworkers");
+        bind(EMYCLASS4P_MAX_LOAD, "//c3endpoint/_p/poolmaxload");
+        bind(EMYCLASS4P_OVERFLOW, "//c3endpoint/_p/pooloverflow");
+    }
+
+    /* Count received time stamps, collect pool statistics.
+     */
+    virtual eStatus onpropertychange(
+        os_int propertynr,
+        eVariable *x,
+        os_int flags)
+    {
+        switch (propertynr)
+        {
+            case EMYCLASS4P_T:
+                if (x->isempty()) break;
+                c3_last_us = etime();
+                c3_nreceived++;
+                break;
+
+            case EMYCLASS4P_WORKERS:
+                c3_pool_workers = x->geti();
+                break;
+
+            case EMYCLASS4P_MAX_LOAD:
+                c3_pool_max_load = x->geti();
+                break;
+
+            case EMYCLASS4P_OVERFLOW:
+                c3_pool_overflow = x->getl();
+                break;
+
+            default:
+                return ESTATUS_FAILED;
+        }
+
+        return ESTATUS_SUCCESS;
+    }
+};
+
+
+/**
+****************************************************************************************************
+  Connection example 3: Load test with connection pool.
+****************************************************************************************************
+*/
+void connection_example_3()
+{
+    eThread *t;
+    eConnectionWorker *w;
+    eConnection *con;
+    eThreadHandle receiverhandle, endpointhandle, workerhandle[C3_NRO_CLIENT_WORKERS];
+    eContainer c;
+    eVariable name, path;
+    os_timer start_t;
+    os_long start_us;
+    os_int i, j, n;
+
+    c3Receiver::setupclass();
+    c3_nreceived = 0;
+    c3_pool_workers = c3_pool_max_load = 0;
+    c3_pool_overflow = 0;
+
+    /* End point with connection pool and receiver thread.
+     */
+    t = new eEndPoint();
+    t->addname("c3endpoint", ENAME_PROCESS_NS);
+    t->setpropertyl(EENDPP_POOL_SIZE, C3_SERVER_POOL_SIZE);
+    t->start(&endpointhandle);
+    c.setpropertys_msg(endpointhandle.uniquename(),
+         "socket::" IOC_DEFAULT_SOCKET_PORT_STR, eendpp_ipaddr);
+
+    t = new c3Receiver();
+    t->addname("c3receiver", ENAME_PROCESS_NS);
+    t->start(&receiverhandle);
+    osal_sleep(500);
+
+    /* Client connections, created as children of client side workers before starting
+       the workers. Each connection buffers one time stamped message.
+     */
+    start_us = etime();
+    for (i = j = 0; j < C3_NRO_CLIENT_WORKERS; j++)
+    {
+        w = new eConnectionWorker();
+        for (n = 0; n < ECONNECTIONWORKER_MAX_CONNECTIONS && i < C3_NRO_CONNECTIONS; n++, i++)
+        {
+            name = "//c3con";
+            name.appendl(i);
+            con = new eConnection(w);
+            con->addname(name.gets());
+            con->setpropertys(ECONNP_IPADDR, "socket:localhost");
+        }
+        w->start(&workerhandle[j]); /* After this w pointer is useless */
+    }
+    for (i = 0; i < C3_NRO_CONNECTIONS; i++)
+    {
+        path = "//c3con";
+        path.appendl(i);
+        path += "/c3receiver";
+        c.setpropertyl_msg(path.gets(), etime(), emyclass4p_t);
+    }
+
+    /* Wait until all messages have been received, or 60 seconds.
+     */
+    os_get_timer(&start_t);
+    while (c3_nreceived < C3_NRO_CONNECTIONS && !os_has_elapsed(&start_t, 60000)) {
+        osal_sleep(10);
+    }
+    printf("%d of %d connections carried message, %d + %d worker threads, %.1f ms\n",
+        c3_nreceived, C3_NRO_CONNECTIONS, C3_SERVER_POOL_SIZE, C3_NRO_CLIENT_WORKERS,
+        0.001 * (c3_last_us - start_us));
+
+    /* All accepted connections must have been run by server side workers: All workers
+       started, none over the limit and no connection run as own thread. Bound statistics
+       may lag behind the last message a little.
+     */
+    osal_sleep(200);
+    printf("server pool: %d workers, max %d connections/worker, %lld as own thread\n",
+        c3_pool_workers, c3_pool_max_load, (long long)c3_pool_overflow);
+    if (c3_nreceived < C3_NRO_CONNECTIONS ||
+        c3_pool_workers != C3_SERVER_POOL_SIZE ||
+        c3_pool_max_load > ECONNECTIONWORKER_MAX_CONNECTIONS ||
+        c3_pool_max_load * C3_SERVER_POOL_SIZE < C3_NRO_CONNECTIONS ||
+        c3_pool_overflow != 0)
+    {
+        printf("connection_example_3 FAILED\n");
+    }
+
+    for (j = 0; j < C3_NRO_CLIENT_WORKERS; j++) {
+        workerhandle[j].terminate();
+        workerhandle[j].join();
+    }
+    endpointhandle.terminate();
+    endpointhandle.join();
+    receiverhandle.terminate();
+    receiverhandle.join();
+}
@@ -0,0 +1,269 @@
+/**
+
+  @file    connection4.cpp
+  @brief   Message order with connection batching.
+  @author  Pekka Lehtikoski
+  @version 1.0
+  @date    18.10.2026
+
+  This example checks that holding property value updates in connection's batch does not
+  reorder them relative to other messages. A sender thread has two properties bound trough
+  connection to receiver thread. At every timer tick the sender changes A twice and B once,
+  and then sends the same value as plain message to M. When M arrives, the receiver must
+  already have the latest A and B. The test runs first with flush delay set, so that updates
+  are batched and the first A update is coalesced, and then with flush delay 0.
+
+  Copyright 2020 Pekka Lehtikoski. This file is part of the eobjects project and shall only be used,
+  modified, and distributed under the terms of the project licensing. By continuing to use, modify,
+  or distribute this file you indicate that you have read the license and understand and accept
+  it fully.
+
+****************************************************************************************************
+*/
+#include "eobjects.h"
+#include "connection.h"
+#include <stdio.h>
+
+/* Flush delay for the batched part of the test, microseconds.
+ */
+#define C4_FLUSH_DELAY_US 20000
+
+/* Class identifiers for the receiver and sender threads.
+ */
+#define MY_CLASS_ID_9 (ECLASSID_APP_BASE + 9)
+#define MY_CLASS_ID_10 (ECLASSID_APP_BASE + 10)
+
+/* Enumeration of c4Receiver and c4Sender properties.
+ */
+#define EMYCLASS9P_A 10
+#define EMYCLASS9P_B 11
+#define EMYCLASS9P_M 12
+
+static const os_char emyclass9p_a[] = "A";
+static const os_char emyclass9p_b[] = "B";
+static const os_char emyclass9p_m[] = "M";
+
+/* Number of M messages checked and number of those which arrived before A or B update,
+   set by receiver thread.
+ */
+static volatile os_int c4_nchecked;
+static volatile os_int c4_nerrors;
+
+
+/**
+****************************************************************************************************
+  Receiver thread, checks that A and B are up to date when M arrives.
+****************************************************************************************************
+*/
+class c4Receiver : public eThread
+{
+public:
+    /* Constructor.
+     */
+    c4Receiver(
+        eObject *parent = OS_NULL,
+        e_oid id = EOID_ITEM,
+        os_int flags = EOBJ_DEFAULT)
+        : eThread(parent, id, flags)
+    {
+        initproperties();
+        m_in_sync = OS_FALSE;
+    }
+
+    /* Add c4Receiver'es properties to class'es property set.
+    */
+    static void setupclass()
+    {
+        const os_int cls = MY_CLASS_ID_9;
+
+        os_lock();
+        addpropertyl(cls, EMYCLASS9P_A, emyclass9p_a, "A");
+        addpropertyl(cls, EMYCLASS9P_B, emyclass9p_b, "B");
+        addpropertyl(cls, EMYCLASS9P_M, emyclass9p_m, "M");
+        os_unlock();
+    }
+
+    /* Get class identifier.
+     */
+    virtual os_int classid()
+    {
+        return MY_CLASS_ID_9;
+    }
+
+    /* Compare A and B to M. Messages sent before bindings were established are not checked.
+     */
+    virtual eStatus onpropertychange(
+        os_int propertynr,
+        eVariable *x,
+        os_int flags)
+    {
+        os_long m;
+        os_boolean ok;
+
+        switch (propertynr)
+        {
+            case EMYCLASS9P_A:
+            case EMYCLASS9P_B:
+                break;
+
+            case EMYCLASS9P_M:
+                m = x->getl();
+                if (m == 0) break;
+                ok = (os_boolean)(propertyl(EMYCLASS9P_A) == m && propertyl(EMYCLASS9P_B) == m);
+                if (ok) m_in_sync = OS_TRUE;
+                if (!m_in_sync) break;
+                c4_nchecked++;
+                if (!ok)
+                {
+                    if (c4_nerrors++ == 0) {
+                        printf("M=%lld arrived before A=%lld, B=%lld\n", (long long)m,
+                            (long long)propertyl(EMYCLASS9P_A), (long long)propertyl(EMYCLASS9P_B));
+                    }
+                }
+                break;
+
+            default:
+                return ESTATUS_FAILED;
+        }
+
+        return ESTATUS_SUCCESS;
+    }
+
+    os_boolean m_in_sync;
+};
+
+
+/**
+****************************************************************************************************
+  Sender thread, changes bound A and B and sends M at every timer tick.
+****************************************************************************************************
+*/
+class c4Sender : public eThread
+{
+public:
+    /* Constructor.
+     */
+    c4Sender(
+        eObject *parent = OS_NULL,
+        e_oid id = EOID_ITEM,
+        os_int flags = EOBJ_DEFAULT)
+        : eThread(parent, id, flags)
+    {
+        initproperties();
+        m_count = 0;
+    }
+
+    /* Add c4Sender'es properties to class'es property set.
+    */
+    static void setupclass()
+    {
+        const os_int cls = MY_CLASS_ID_10;
+
+        os_lock();
+        addpropertyl(cls, EMYCLASS9P_A, emyclass9p_a, "A");
+        addpropertyl(cls, EMYCLASS9P_B, emyclass9p_b, "B");
+        os_unlock();
+    }
+
+    /* Get class identifier.
+     */
+    virtual os_int classid()
+    {
+        return MY_CLASS_ID_10;
+    }
+
+    /* Bind A and B to receiver. Flow control is disabled so that every change is forwarded
+       immediately, and not held by binding while waiting for acknowledgement.
+     */
+    virtual void initialize(
+        eContainer *params = OS_NULL)
+    {
+        bind(EMYCLASS9P_A, "//c4con/c4receiver/_p/A", EBIND_NOFLOWCLT);
+        bind(EMYCLASS9P_B, "//c4con/c4receiver/_p/B", EBIND_NOFLOWCLT);
+    }
+
+    /* Timer tick: Change A twice, B once and send M.
+     */
+    virtual void onmessage(
+        eEnvelope *envelope)
+    {
+        if (*envelope->target() == '\0' && envelope->command() == ECMD_TIMER)
+        {
+            m_count++;
+            setpropertyl(EMYCLASS9P_A, -m_count);
+            setpropertyl(EMYCLASS9P_A, m_count);
+            setpropertyl(EMYCLASS9P_B, m_count);
+            setpropertyl_msg("//c4con/c4receiver", m_count, emyclass9p_m);
+            return;
+        }
+
+        eThread::onmessage(envelope);
+    }
+
+    os_long m_count;
+};
+
+
+/**
+****************************************************************************************************
+  Connection example 4: Batched property updates keep order relative to other messages.
+****************************************************************************************************
+*/
+void connection_example_4()
+{
+    eThread *t;
+    eThreadHandle receiverhandle, senderhandle, endpointhandle, conhandle;
+    eContainer c;
+    os_int nchecked;
+
+    c4Receiver::setupclass();
+    c4Sender::setupclass();
+    c4_nchecked = c4_nerrors = 0;
+
+    /* Receiver thread, end point and connection with flush delay.
+     */
+    t = new c4Receiver();
+    t->addname("c4receiver", ENAME_PROCESS_NS);
+    t->start(&receiverhandle);
+
+    t = new eEndPoint();
+    t->start(&endpointhandle);
+    c.setpropertys_msg(endpointhandle.uniquename(),
+         "socket::" IOC_DEFAULT_SOCKET_PORT_STR, eendpp_ipaddr);
+    osal_sleep(500);
+
+    t = new eConnection();
+    t->addname("//c4con");
+    t->setpropertyl(ECONNP_FLUSH_DELAY, C4_FLUSH_DELAY_US);
+    t->start(&conhandle);
+    c.setpropertys_msg(conhandle.uniquename(), "socket:localhost", econnp_ipaddr);
+
+    t = new c4Sender();
+    t->timer(5);
+    t->start(&senderhandle);
+
+    /* Run with batching, then switch flush delay to 0 while updates may be held in batch.
+     */
+    osal_sleep(2000);
+    nchecked = c4_nchecked;
+    printf("flush delay %d us: %d messages checked, %d out of order\n",
+        C4_FLUSH_DELAY_US, nchecked, c4_nerrors);
+
+    c.setpropertyl_msg(conhandle.uniquename(), 0, econnp_flush_delay);
+    osal_sleep(2000);
+    printf("flush delay 0 us: %d messages checked, %d out of order total\n",
+        c4_nchecked - nchecked, c4_nerrors);
+
+    if (nchecked == 0 || c4_nchecked == nchecked || c4_nerrors) {
+        printf("connection_example_4 FAILED\n");
+    }
+
+    senderhandle.terminate();
+    senderhandle.join();
+    conhandle.terminate();
+    conhandle.join();
+    endpointhandle.terminate();
+    endpointhandle.join();
+    receiverhandle.terminate();
+    receiverhandle.join();
+}
@@ -15,3 +15,5 @@
 */
 
 void container_example1();
+void container_example2();
+void container_fsys_3();
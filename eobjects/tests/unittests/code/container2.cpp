@@ -0,0 +1,205 @@
+/**
+
+  @file    container2.cpp
+  @brief   Persistent table journal benchmark.
+  @author  Pekka Lehtikoski
+  @version 1.0
+  @date    18.10.2026
+
+  This example saves ePersistent holding 100000 row eMatrix. After initial snapshot, single
+  rows are updated and saved, first by writing journal, then by saving whole object each
+  time. Finally the data is loaded into new persistent object from snapshot and journal. The
+  matrix rows are saved and loaded as memory image snapshot file (ematrix_snapshot.cpp).
+
+  Copyright 2020 Pekka Lehtikoski. This file is part of the eobjects project and shall only be used,
+  modified, and distributed under the terms of the project licensing. By continuing to use, modify,
+  or distribute this file you indicate that you have read the license and understand and accept
+  it fully.
+
+****************************************************************************************************
+*/
+#include "eobjects.h"
+#include "container.h"
+#include <stdio.h>
+
+#define C2_NRO_ROWS 100000
+#define C2_NRO_UPDATES 100
+
+/**
+****************************************************************************************************
+  Persistent object with function to save immediately, instead of waiting for save timer.
+****************************************************************************************************
+*/
+class c2Persistent : public ePersistent
+{
+public:
+    c2Persistent(
+        eObject *parent = OS_NULL)
+        : ePersistent(parent) {}
+
+    /* Save changes now, as snapshot or as journal batch.
+     */
+    void save_now()
+    {
+        if (m_snapshot_needed) {
+            save_as_message();
+        }
+        else {
+            journal_save_as_message();
+        }
+    }
+};
+
+
+/* Create matrix with two columns "ix" and "value" into persistent object.
+ */
+static eMatrix *c2_new_matrix(
+    ePersistent *p)
+{
+    eContainer configuration;
+    eContainer *columns;
+    eVariable *column;
+    eMatrix *m;
+
+    p->ns_create();
+    m = new eMatrix(p);
+    m->addname("rows");
+    m->setflags(EOBJ_PERSISTENT_CALLBACK);
+
+    columns = new eContainer(&configuration, EOID_TABLE_COLUMNS);
+    columns->addname("columns", ENAME_NO_MAP);
+    column = new eVariable(columns);
+    column->addname("ix", ENAME_NO_MAP);
+    column->setpropertyi(EVARP_TYPE, OS_INT);
+    column = new eVariable(columns);
+    column->addname("value", ENAME_NO_MAP);
+    column->setpropertyi(EVARP_TYPE, OS_LONG);
+    m->configure(&configuration);
+    return m;
+}
+
+
+/* Check that two matrices have same content.
+ */
+static os_boolean c2_compare(
+    eMatrix *m1,
+    eMatrix *m2)
+{
+    os_int r, c, nrows, ncols;
+
+    nrows = m1->nrows();
+    ncols = m1->ncolumns();
+    if (m2->nrows() != nrows || m2->ncolumns() != ncols) return OS_FALSE;
+    for (r = 0; r < nrows; r++) {
+        for (c = 0; c < ncols; c++) {
+            if (m1->getl(r, c) != m2->getl(r, c)) return OS_FALSE;
+        }
+    }
+    return OS_TRUE;
+}
+
+
+/* Update value of one row.
+ */
+static void c2_update(
+    eMatrix *m,
+    os_int ix,
+    os_long value)
+{
+    eContainer row;
+    eVariable *element, where;
+
+    element = new eVariable(&row);
+    element->addname("value", ENAME_NO_MAP);
+    element->setl(value);
+
+    where = "[";
+    where.appendl(ix);
+    where.appends("]");
+    m->update(where.gets(), &row);
+}
+
+
+/* Update and save rows, print time per update.
+ */
+static void c2_run(
+    const os_char *what,
+    c2Persistent *p,
+    eMatrix *m,
+    os_long base)
+{
+    os_long start_us;
+    os_int i;
+
+    start_us = etime();
+    for (i = 0; i < C2_NRO_UPDATES; i++)
+    {
+        c2_update(m, (i * 997) % C2_NRO_ROWS + 1, base + i);
+        p->save_now();
+    }
+    printf("%s: %.1f us per update and save\n", what,
+        (os_double)(etime() - start_us) / C2_NRO_UPDATES);
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Container example 2.
+
+  The container_example2() function measures saving changes of large persistent table with
+  and without journal, and verifies that data loads back from snapshot and journal.
+
+  @return  None.
+
+****************************************************************************************************
+*/
+void container_example2()
+{
+    eThreadHandle fsys_handle;
+    eContainer root;
+    c2Persistent *p;
+    ePersistent *p2;
+    eMatrix *m, *m2;
+    eContainer row;
+    eVariable *element;
+    os_long start_us;
+    os_int i;
+
+    efsys_expose_directory("//fsys", eglobal->root_path, &fsys_handle);
+
+    p = new c2Persistent(&root);
+    m = c2_new_matrix(p);
+
+    element = new eVariable(&row);
+    element->addname("value", ENAME_NO_MAP);
+    for (i = 0; i < C2_NRO_ROWS; i++) {
+        element->setl(i);
+        m->insert(&row);
+    }
+
+    start_us = etime();
+    p->setpropertys(EPERP_FILE, "journalbench.eo");
+    p->save_now();
+    printf("snapshot of %d rows: %.1f ms\n", C2_NRO_ROWS, (etime() - start_us) / 1000.0);
+
+    c2_run("journal", p, m, 1000000);
+    osal_sleep(2000);
+
+    /* Load into a new object, content must match including journaled updates.
+     */
+    p2 = new ePersistent(&root);
+    m2 = c2_new_matrix(p2);
+    start_us = etime();
+    p2->load_file("journalbench.eo");
+    printf("load snapshot and journal: %.1f ms, content %s\n",
+        (etime() - start_us) / 1000.0, c2_compare(m, m2) ? "ok" : "DIFFERENT");
+
+    p->setpropertyl(EPERP_JOURNAL_MAX, 0);
+    p->save_now();
+    c2_run("full save", p, m, 2000000);
+
+    osal_sleep(2000);
+    fsys_handle.terminate();
+    fsys_handle.join();
+}
@@ -0,0 +1,208 @@
+/**
+
+  @file    container3.cpp
+  @brief   File system writer pool.
+  @author  Pekka Lehtikoski
+  @version 1.0
+  @date    18.10.2026
+
+  A saver thread sends burst of saves of the same file to file system with one writer thread.
+  The first save is passed to writer immediately, later ones are queued and replaced by the
+  newest. Every save must get a success reply, including the replaced ones, "ncoalesced"
+  property of file system must be forwarded trough binding, the file must hold the content
+  of the last save and the temporary file used for writing must have been renamed away.
+
+  Copyright 2020 Pekka Lehtikoski. This file is part of the eobjects project and shall only be used,
+  modified, and distributed under the terms of the project licensing. By continuing to use, modify,
+  or distribute this file you indicate that you have read the license and understand and accept
+  it fully.
+
+****************************************************************************************************
+*/
+#include "eobjects.h"
+#include "container.h"
+#include <stdio.h>
+
+/* Number of saves sent in burst and name of the file.
+ */
+#define C3_NRO_SAVES 50
+#define C3_FILE_NAME "fsyspool3.eo"
+
+/* Class identifier and properties of saver thread.
+ */
+#define MY_CLASS_ID_11 (ECLASSID_APP_BASE + 11)
+#define EMYCLASS11P_NCOALESCED 10
+
+static const os_char emyclass11p_ncoalesced[] = "ncoalesced";
+
+/* Replies received by saver thread, failed saves and last "ncoalesced" value.
+ */
+static volatile os_int c3_nreplies;
+static volatile os_int c3_nerrors;
+static volatile os_long c3_ncoalesced;
+
+
+/**
+****************************************************************************************************
+  Saver thread, saves the same file repeatedly and counts replies.
+****************************************************************************************************
+*/
+class c3Saver : public eThread
+{
+public:
+    /* Constructor.
+     */
+    c3Saver(
+        eObject *parent = OS_NULL,
+        e_oid id = EOID_ITEM,
+        os_int flags = EOBJ_DEFAULT)
+        : eThread(parent, id, flags)
+    {
+        initproperties();
+    }
+
+    /* Add c3Saver'es properties to class'es property set.
+    */
+    static void setupclass()
+    {
+        const os_int cls = MY_CLASS_ID_11;
+
+        os_lock();
+        addpropertyl(cls, EMYCLASS11P_NCOALESCED, emyclass11p_ncoalesced, "ncoalesced");
+        os_unlock();
+    }
+
+    /* Get class identifier.
+     */
+    virtual os_int classid()
+    {
+        return MY_CLASS_ID_11;
+    }
+
+    /* Bind to file system statistics and send the saves.
+     */
+    virtual void initialize(
+        eContainer *params = OS_NULL)
+    {
+        eContainer *content;
+        eVariable *v;
+        os_int i;
+
+        bind(EMYCLASS11P_NCOALESCED, "//c3fsys/_p/ncoalesced");
+
+        for (i = 0; i < C3_NRO_SAVES; i++)
+        {
+            content = new eContainer(this, EOID_TEMPORARY);
+            v = new eVariable(content, EOID_PATH);
+            v->sets(C3_FILE_NAME);
+            v = new eVariable(content, EOID_CONTENT);
+            v->setl(i);
+            message(ECMD_SAVE_FILE, "//c3fsys/" C3_FILE_NAME, OS_NULL, content,
+                EMSG_DEL_CONTENT);
+        }
+    }
+
+    /* Count replies to saves, empty reply means success.
+     */
+    virtual void onmessage(
+        eEnvelope *envelope)
+    {
+        if (*envelope->target() == '\0' && envelope->command() == ECMD_NO_TARGET)
+        {
+            c3_nreplies++;
+            if (envelope->content()) c3_nerrors++;
+            return;
+        }
+
+        eThread::onmessage(envelope);
+    }
+
+    /* Keep latest "ncoalesced" from file system.
+     */
+    virtual eStatus onpropertychange(
+        os_int propertynr,
+        eVariable *x,
+        os_int flags)
+    {
+        if (propertynr == EMYCLASS11P_NCOALESCED)
+        {
+            c3_ncoalesced = x->getl();
+            return ESTATUS_SUCCESS;
+        }
+        return eThread::onpropertychange(propertynr, x, flags);
+    }
+};
+
+
+/**
+****************************************************************************************************
+
+  @brief Container example 3.
+
+  The container_fsys_3() function checks queueing, coalescing and replies of file system
+  writer pool, and that file is written trough temporary file and rename.
+
+  @return  None.
+
+****************************************************************************************************
+*/
+void container_fsys_3()
+{
+    eThreadHandle fsys_handle, saver_handle;
+    eFileSystem *fsys;
+    eThread *t;
+    eContainer root;
+    eObject *o;
+    eVariable path, tmp_path;
+    os_boolean ok;
+
+    c3Saver::setupclass();
+    c3_nreplies = c3_nerrors = 0;
+    c3_ncoalesced = 0;
+
+    fsys = new eFileSystem();
+    fsys->addname("//c3fsys");
+    fsys->set_os_path(eglobal->root_path);
+    fsys->setpropertyl(EFSYSP_POOL_SIZE, 1);
+    fsys->start(&fsys_handle);
+
+    t = new c3Saver();
+    t->start(&saver_handle);
+    osal_sleep(2000);
+
+    printf("%d saves: %d replies, %d failed, %lld coalesced\n", C3_NRO_SAVES,
+        c3_nreplies, c3_nerrors, (long long)c3_ncoalesced);
+    ok = (os_boolean)(c3_nreplies == C3_NRO_SAVES && c3_nerrors == 0 && c3_ncoalesced > 0);
+
+    /* File holds the last save, temporary file is gone.
+     */
+    path.sets(eglobal->root_path);
+    path.appends("/" C3_FILE_NAME);
+    o = root.load(path.gets());
+    if (o == OS_NULL || o->classid() != ECLASSID_VARIABLE) {
+        ok = OS_FALSE;
+    }
+    else if (eVariable::cast(o)->getl() != C3_NRO_SAVES - 1) {
+        printf("file holds %lld\n", (long long)eVariable::cast(o)->getl());
+        ok = OS_FALSE;
+    }
+    delete o;
+
+    tmp_path.setv(&path);
+    tmp_path.appends(EFSYS_TMP_EXT);
+    o = root.load(tmp_path.gets());
+    if (o) {
+        printf("%s was not renamed\n", tmp_path.gets());
+        ok = OS_FALSE;
+        delete o;
+    }
+
+    if (!ok) {
+        printf("container_fsys_3 FAILED\n");
+    }
+
+    saver_handle.terminate();
+    saver_handle.join();
+    fsys_handle.terminate();
+    fsys_handle.join();
+}
@@ -0,0 +1,311 @@
+/**
+
+  @file    io1.cpp
+  @brief   Device reconnect with cached info.
+  @author  Pekka Lehtikoski
+  @version 1.0
+  @date    18.10.2026
+
+  This example sets up an IO device from parsed info, then "reconnects" it with changed info
+  and with unchanged info. Number of IO signal and IO variable objects is checked after each
+  step: Changed info must add new signals, recreate signals which moved and delete removed
+  ones together with their variables, unchanged info must rebind the existing objects.
+  A second device with identical info must share the same parsed info, and the info must be
+  released from cache when the last device using it is deleted.
+
+  No IOCOM connection is used, info is built directly as eioInfo, like parse_info() would
+  build it from packed JSON.
+
+  Copyright 2020 Pekka Lehtikoski. This file is part of the eobjects project and shall only be used,
+  modified, and distributed under the terms of the project licensing. By continuing to use, modify,
+  or distribute this file you indicate that you have read the license and understand and accept
+  it fully.
+
+****************************************************************************************************
+*/
+#include "eobjects.h"
+#include "extensions/io/eio.h"
+#include "io.h"
+#include <stdio.h>
+
+/* Signal in test info.
+ */
+typedef struct
+{
+    const os_char *mblk_name;
+    const os_char *group_name;
+    const os_char *signal_name;
+    os_int addr;
+}
+i1Signal;
+
+/* Info A: "set_z" and "z" share IO variable "z".
+ */
+static const i1Signal i1_info_a[] = {
+    {"exp", "inputs", "x", 0},
+    {"exp", "inputs", "y", 5},
+    {"exp", "params", "z", 10},
+    {"imp", "params", "set_z", 0}};
+
+/* Info B: "y" and "set_z" removed, "w" added and "z" moved.
+ */
+static const i1Signal i1_info_b[] = {
+    {"exp", "inputs", "x", 0},
+    {"exp", "inputs", "w", 5},
+    {"exp", "params", "z", 15}};
+
+
+/**
+****************************************************************************************************
+  IO root with access to functions used by info callback.
+****************************************************************************************************
+*/
+class i1Root : public eioRoot
+{
+public:
+    /* Constructor.
+     */
+    i1Root(
+        eObject *parent = OS_NULL)
+        : eioRoot(parent)
+    {
+    }
+
+    /* Find or create device object.
+     */
+    eioDevice *device(
+        eioMblkInfo *minfo)
+    {
+        return get_device(minfo);
+    }
+
+    /* Get cached info as parse_info() would, or build and cache it. The caller holds
+       a reference to the returned info.
+     */
+    eioInfo *info(
+        const os_char *text,
+        const i1Signal *sigs,
+        os_int nsigs)
+    {
+        eioInfo *info;
+        eioSignalInfo sinfo;
+        os_memsz nbytes;
+        os_uint hash;
+        os_int i;
+
+        nbytes = os_strlen(text);
+        hash = estrintern_hash(text, nbytes);
+        info = m_info_cache->get(hash, text, nbytes);
+        if (info) return info;
+
+        info = new eioInfo(hash, text, nbytes);
+        os_memclear(&sinfo, sizeof(sinfo));
+        for (i = 0; i < nsigs; i++) {
+            sinfo.signal_name = sigs[i].signal_name;
+            sinfo.group_name = sigs[i].group_name;
+            sinfo.addr = sigs[i].addr;
+            sinfo.n = 1;
+            sinfo.ncolumns = 1;
+            sinfo.flags = OS_INT;
+            info->add_signal(sigs[i].mblk_name, &sinfo);
+        }
+        info->add_mblk("exp", 32);
+        info->add_mblk("imp", 32);
+        m_info_cache->add(info);
+        return info;
+    }
+
+    /* Check if info is in cache, without keeping a reference.
+     */
+    os_boolean is_cached(
+        const os_char *text)
+    {
+        eioInfo *info;
+        os_memsz nbytes;
+
+        nbytes = os_strlen(text);
+        info = m_info_cache->get(estrintern_hash(text, nbytes), text, nbytes);
+        eioInfoCache::release(info);
+        return (os_boolean)(info != OS_NULL);
+    }
+
+    /* Apply new or changed info, device takes over the reference.
+     */
+    void apply(
+        eioDevice *device,
+        eioInfo *info,
+        eioMblkInfo *minfo)
+    {
+        apply_info(device, info, minfo);
+    }
+
+    /* Reconnect with unchanged info.
+     */
+    void rebind(
+        eioDevice *device,
+        eioMblkInfo *minfo)
+    {
+        rebind_by_info(device, device->info(), minfo);
+    }
+};
+
+
+/* Print error message if condition is not true.
+ */
+static os_boolean i1_check(
+    os_boolean condition,
+    const os_char *what)
+{
+    if (!condition) printf("%s failed\n", what);
+    return condition;
+}
+
+/* Count IO signals within device's memory block.
+ */
+static os_int i1_nsignals(
+    eioDevice *device,
+    const os_char *mblk_name)
+{
+    eObject *mblk, *o;
+    os_int n = 0;
+
+    if (device->mblks() == OS_NULL) return 0;
+    mblk = device->mblks()->byname(mblk_name);
+    if (mblk == OS_NULL) return 0;
+    for (o = eioMblk::cast(mblk)->esignals()->first(); o; o = o->next()) {
+        if (o->classid() == ECLASSID_EIO_SIGNAL) n++;
+    }
+    return n;
+}
+
+/* Count IO variables in all groups of device.
+ */
+static os_int i1_nvariables(
+    eioDevice *device)
+{
+    eObject *group, *o;
+    os_int n = 0;
+
+    for (group = device->io()->first(); group; group = group->next()) {
+        if (group->classid() != ECLASSID_EIO_GROUP) continue;
+        for (o = group->first(); o; o = o->next()) {
+            if (o->classid() == ECLASSID_EIO_VARIABLE) n++;
+        }
+    }
+    return n;
+}
+
+/* Get IO signal by memory block and signal name, OS_NULL if none.
+ */
+static eioSignal *i1_signal(
+    eioDevice *device,
+    const os_char *mblk_name,
+    const os_char *signal_name)
+{
+    eObject *mblk, *o;
+
+    if (device->mblks() == OS_NULL) return OS_NULL;
+    mblk = device->mblks()->byname(mblk_name);
+    if (mblk == OS_NULL) return OS_NULL;
+    o = eioMblk::cast(mblk)->esignals()->byname(signal_name);
+    if (o == OS_NULL || o->classid() != ECLASSID_EIO_SIGNAL) return OS_NULL;
+    return (eioSignal*)o;
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief IO example 1.
+
+  The io_reconnect_1() function tests applying changed info, rebinding with unchanged info,
+  sharing parsed info between devices and releasing it.
+
+  @return  None.
+
+****************************************************************************************************
+*/
+void io_reconnect_1()
+{
+    iocRoot iocom_root;
+    i1Root *root;
+    eioDevice *device, *device2;
+    eioSignal *x, *z;
+    eioMblkInfo minfo;
+    eContainer top;
+    os_boolean ok = OS_TRUE;
+
+    eioRoot::setupclass();
+    eioNetwork::setupclass();
+    eioDevice::setupclass();
+    eioMblk::setupclass();
+    eioGroup::setupclass();
+    eioVariable::setupclass();
+    eioSignal::setupclass();
+
+    ioc_initialize_root(&iocom_root, IOC_USE_EOSAL_MUTEX);
+    root = new i1Root(&top);
+
+    os_memclear(&minfo, sizeof(minfo));
+    minfo.device_name = "i1dev";
+    minfo.device_nr = 1;
+    minfo.network_name = "i1net";
+    minfo.root = &iocom_root;
+    minfo.eio_root = root;
+
+    ioc_lock(&iocom_root);
+    os_lock();
+
+    /* First connect: Everything is set up.
+     */
+    device = root->device(&minfo);
+    root->apply(device, root->info("i1 info A", i1_info_a, 4), &minfo);
+    ok &= i1_check(i1_nsignals(device, "exp") == 3, "info A exp signals");
+    ok &= i1_check(i1_nsignals(device, "imp") == 1, "info A imp signals");
+    ok &= i1_check(i1_nvariables(device) == 3, "info A variables");
+    x = i1_signal(device, "exp", "x");
+
+    /* Reconnect with changed info: "x" is kept as is, "z" moves, "y" and its variable are
+       deleted, "set_z" is deleted but variable "z" stays since "z" still maps to it.
+     */
+    root->apply(device, root->info("i1 info B", i1_info_b, 3), &minfo);
+    ok &= i1_check(i1_nsignals(device, "exp") == 3, "info B exp signals");
+    ok &= i1_check(i1_nsignals(device, "imp") == 0, "info B imp signals");
+    ok &= i1_check(i1_nvariables(device) == 3, "info B variables");
+    ok &= i1_check(i1_signal(device, "exp", "x") == x, "unchanged signal kept");
+    ok &= i1_check(i1_signal(device, "exp", "y") == OS_NULL, "removed signal deleted");
+    z = i1_signal(device, "exp", "z");
+    ok &= i1_check(z && z->io_addr() == 15, "moved signal set up");
+    ok &= i1_check(!root->is_cached("i1 info A"), "old info released");
+
+    /* Reconnect with unchanged info: Same objects are rebound.
+     */
+    root->rebind(device, &minfo);
+    ok &= i1_check(i1_nsignals(device, "exp") == 3, "rebind exp signals");
+    ok &= i1_check(i1_nvariables(device) == 3, "rebind variables");
+    ok &= i1_check(i1_signal(device, "exp", "x") == x, "rebind keeps signal");
+    ok &= i1_check(i1_signal(device, "exp", "z") == z, "rebind keeps moved signal");
+
+    /* Second device with identical info shares the parsed info.
+     */
+    minfo.device_nr = 2;
+    device2 = root->device(&minfo);
+    root->apply(device2, root->info("i1 info B", i1_info_b, 3), &minfo);
+    ok &= i1_check(device2->info() == device->info(), "shared info");
+    ok &= i1_check(i1_nsignals(device2, "exp") == 3, "second device signals");
+
+    /* Info is released when the last device using it is deleted.
+     */
+    delete device2;
+    ok &= i1_check(root->is_cached("i1 info B"), "info kept while in use");
+    delete device;
+    ok &= i1_check(!root->is_cached("i1 info B"), "info released on delete");
+
+    os_unlock();
+    ioc_unlock(&iocom_root);
+
+    delete root;
+    ioc_release_root(&iocom_root);
+
+    printf("io_reconnect_1 %s\n", ok ? "passed" : "FAILED");
+}
@@ -26,6 +26,8 @@
 #include "variables.h"
 #include "matrix.h"
 #include "queue.h"
+#include "bitmap.h"
+#include "io.h"
 
 /* If needed for the operating system, EOSAL_C_MAIN macro generates the actual C main() function.
    and macro EMAIN_CONSOLE_ENTRY eobjects specific osal_main() function which calls emain.
@@ -68,7 +70,11 @@ eStatus emain(
     switch (test_nr)
     {
         case 11: container_example1(); break;
+        case 12: container_example2(); break;
+        case 13: container_fsys_3(); break;
         case 21: variables_example1(); break;
+        case 22: variables_format_2(); break;
+        case 23: variables_intern_3(); break;
         case 31: thread_example_1(); break;
         case 32: thread_example_2(); break;
         case 41: names_example1(); break;
@@ -76,12 +82,25 @@ eStatus emain(
         case 52: property_example_2(); break;
         case 53: property_example_3(); break;
         case 54: property_example_4(); break;
+        case 55: property_example_5(); break;
+        case 56: property_example_6(); break;
+        case 57: property_example_7(); break;
         case 61: connection_example_1(); break;
+        case 62: connection_example_2(); break;
+        case 63: connection_example_3(); break;
+        case 64: connection_example_4(); break;
         case 71: endpoint_example_1(); break;
         case 81: matrix_example1(); break;
         case 82: matrix_as_table_2(); break;
         case 83: matrix_as_remote_table_3(); break;
+        case 84: matrix_json_4(); break;
+        case 85: matrix_array_5(); break;
         case 91: queue_example1(); break;
+        case 92: queue_codec_2(); break;
+        case 93: queue_hello_3(); break;
+        case 101: bitmap_codec_1(); break;
+        case 102: bitmap_scale_2(); break;
+        case 111: io_reconnect_1(); break;
     }
 
     return ESTATUS_SUCCESS;
@@ -19,3 +19,5 @@
 void matrix_example1();
 void matrix_as_table_2();
 void matrix_as_remote_table_3();
+void matrix_json_4();
+void matrix_array_5();
@@ -0,0 +1,245 @@
+/**
+
+  @file    matrix4.cpp
+  @brief   Writing and reading large matrix as JSON.
+  @author  Pekka Lehtikoski
+  @version 1.0
+  @date    18.10.2026
+
+  This example writes a few megabytes of table data as JSON into memory buffer and reads it
+  back with streaming JSON reader, and prints time taken. First numeric matrix, where rows
+  are formatted without eVariable conversions, then matrix with mixed data types. Matrix
+  read back must equal the original, element by element. Finally small JSON snippets check
+  that plain JSON object starting with "class" key is read as data, and that unpaired
+  surrogates in "\u" escapes are replaced by U+FFFD.
+
+  Copyright 2020 Pekka Lehtikoski. This file is part of the eobjects project and shall only be used,
+  modified, and distributed under the terms of the project licensing. By continuing to use, modify,
+  or distribute this file you indicate that you have read the license and understand and accept
+  it fully.
+
+****************************************************************************************************
+*/
+#include "eobjects.h"
+#include "matrix.h"
+#include <stdio.h>
+
+/* Matrix size.
+ */
+#define M4_NROWS 50000
+#define M4_NCOLUMNS 8
+
+
+/* Print error message if condition is not true.
+ */
+static os_boolean m4_check(
+    os_boolean condition,
+    const os_char *what)
+{
+    if (!condition) printf("%s failed\n", what);
+    return condition;
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Write matrix to JSON and read it back.
+
+  @param   what Text to print.
+  @param   mtx Matrix to write.
+  @return  OS_TRUE if matrix read back equals the original.
+
+****************************************************************************************************
+*/
+static os_boolean m4_run(
+    const os_char *what,
+    eMatrix *mtx)
+{
+    eBuffer buf;
+    eContainer root;
+    eObject *o;
+    eMatrix *m2;
+    eVariable x, y;
+    os_long write_us, read_us;
+    os_int row, column;
+    os_boolean has_x, has_y;
+
+    write_us = etime();
+    mtx->json_write(&buf, EOBJ_SERIALIZE_DEFAULT);
+    write_us = etime() - write_us;
+
+    read_us = etime();
+    o = root.json_read(&buf);
+    read_us = etime() - read_us;
+
+    printf("%s: %.1f MB JSON, write %.1f ms, read %.1f ms\n", what,
+        buf.used() / 1.0e6, write_us / 1000.0, read_us / 1000.0);
+
+    if (o == OS_NULL || o->classid() != ECLASSID_MATRIX) {
+        printf("%s: reading JSON failed\n", what);
+        return OS_FALSE;
+    }
+
+    m2 = eMatrix::cast(o);
+    if (m2->datatype() != mtx->datatype() || m2->nrows() != mtx->nrows() ||
+        m2->ncolumns() != mtx->ncolumns())
+    {
+        printf("%s: matrix read from JSON has different type or size\n", what);
+        return OS_FALSE;
+    }
+
+    for (row = 0; row < mtx->nrows(); row++) {
+        for (column = 0; column < mtx->ncolumns(); column++)
+        {
+            has_x = mtx->getv(row, column, &x);
+            has_y = m2->getv(row, column, &y);
+            if (has_x != has_y || x.compare(&y))
+            {
+                printf("%s: element %d, %d read from JSON differs\n", what, row, column);
+                return OS_FALSE;
+            }
+        }
+    }
+    return OS_TRUE;
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Read JSON text.
+
+  @param   root Parent for the object read.
+  @param   json JSON text.
+  @return  Pointer to object read, OS_NULL if JSON is not valid.
+
+****************************************************************************************************
+*/
+static eObject *m4_parse(
+    eContainer *root,
+    const os_char *json)
+{
+    eBuffer buf;
+
+    buf.write(json, os_strlen(json) - 1);
+    return root->json_read(&buf);
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Check that JSON string value is decoded as expected UTF-8.
+
+****************************************************************************************************
+*/
+static os_boolean m4_string(
+    const os_char *json,
+    const os_char *expect,
+    const os_char *what)
+{
+    eContainer root;
+    eObject *o;
+
+    o = m4_parse(&root, json);
+    return m4_check(o != OS_NULL && o->classid() == ECLASSID_VARIABLE &&
+        !os_strcmp(eVariable::cast(o)->gets(), expect), what);
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Check JSON objects which are not, or are, written by json_write().
+
+****************************************************************************************************
+*/
+static os_boolean m4_objects()
+{
+    eContainer root;
+    eBuffer buf;
+    eVariable v;
+    eObject *o;
+    os_boolean ok = OS_TRUE;
+
+    o = m4_parse(&root, "{\"class\": \"eVariable\", \"x\": 1}");
+    ok &= m4_check(o != OS_NULL && o->classid() == ECLASSID_CONTAINER &&
+        o->byname("class") && o->byname("x"), "known class with unknown item");
+
+    o = m4_parse(&root, "{\"class\": \"first\", \"names\": [\"a\"]}");
+    ok &= m4_check(o != OS_NULL && o->classid() == ECLASSID_CONTAINER &&
+        o->byname("class") && o->byname("names"), "unknown class");
+
+    o = m4_parse(&root, "{\"class\": \"eVariable\", \"oid\": 3, \"names\": [\"a\"]}");
+    ok &= m4_check(o != OS_NULL && o->classid() == ECLASSID_CONTAINER &&
+        o->byname("oid") && o->byname("names"), "items out of order");
+
+    o = m4_parse(&root, "{\"class\": 5}");
+    ok &= m4_check(o != OS_NULL && o->classid() == ECLASSID_CONTAINER &&
+        o->byname("class"), "class is not string");
+
+    v = "round trip";
+    v.json_write(&buf, EOBJ_SERIALIZE_DEFAULT);
+    o = root.json_read(&buf);
+    ok &= m4_check(o != OS_NULL && o->classid() == ECLASSID_VARIABLE &&
+        !os_strcmp(eVariable::cast(o)->gets(), "round trip"), "serialized variable");
+
+    return ok;
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Matrix example 4.
+
+  The matrix_json_4() function benchmarks JSON writer and streaming JSON reader with large
+  matrices.
+
+  @return  None.
+
+****************************************************************************************************
+*/
+void matrix_json_4()
+{
+    eMatrix mtx;
+    eVariable value;
+    os_int row, column;
+    os_boolean ok = OS_TRUE;
+
+    mtx.allocate(OS_DOUBLE, M4_NROWS, M4_NCOLUMNS);
+    for (row = 0; row < M4_NROWS; row++) {
+        for (column = 0; column < M4_NCOLUMNS; column++) {
+            mtx.setd(row, column, 0.25 * osal_rand(-100000, 100000));
+        }
+    }
+    ok &= m4_run("double matrix", &mtx);
+
+    mtx.allocate(OS_OBJECT, M4_NROWS, M4_NCOLUMNS);
+    for (row = 0; row < M4_NROWS; row++) {
+        for (column = 0; column < M4_NCOLUMNS; column++) {
+            if (column & 1) {
+                value = "name";
+                value.appendl(row);
+            }
+            else {
+                value.setl(osal_rand(0, 1000000));
+            }
+            mtx.setv(row, column, &value);
+        }
+    }
+    ok &= m4_run("mixed matrix", &mtx);
+
+    ok &= m4_objects();
+    ok &= m4_string("\"\\ud83d\\ude00\"", "\xF0\x9F\x98\x80", "surrogate pair");
+    ok &= m4_string("\"a\\ud83dz\"", "a\xEF\xBF\xBDz", "high surrogate before character");
+    ok &= m4_string("\"\\ud83d\"", "\xEF\xBF\xBD", "high surrogate at end");
+    ok &= m4_string("\"\\ud83d\\n\"", "\xEF\xBF\xBD\n", "high surrogate before escape");
+    ok &= m4_string("\"\\ud83d\\ud83d\\ude00\"", "\xEF\xBF\xBD\xF0\x9F\x98\x80",
+        "two high surrogates");
+    ok &= m4_string("\"\\ude00b\"", "\xEF\xBF\xBD" "b", "low surrogate alone");
+    ok &= m4_string("\"\\ud83d\\u0041\"", "\xEF\xBF\xBD" "A", "high surrogate before BMP");
+
+    printf("matrix_json_4 %s\n", ok ? "passed" : "FAILED");
+}
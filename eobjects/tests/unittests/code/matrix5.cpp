@@ -0,0 +1,129 @@
+/**
+
+  @file    matrix5.cpp
+  @brief   Copying arrays to and from matrix.
+  @author  Pekka Lehtikoski
+  @version 1.0
+  @date    18.10.2026
+
+  This example copies 10000 element arrays, like IO array signals, into a matrix element by
+  element with setl()/setd() and in bulk with set_array(), reads them back with get_array(),
+  and prints time taken. Array types are ones used by IO signals: Same type as the matrix is
+  copied with memcpy, other types are converted.
+
+  Copyright 2020 Pekka Lehtikoski. This file is part of the eobjects project and shall only be used,
+  modified, and distributed under the terms of the project licensing. By continuing to use, modify,
+  or distribute this file you indicate that you have read the license and understand and accept
+  it fully.
+
+****************************************************************************************************
+*/
+#include "eobjects.h"
+#include "matrix.h"
+#include <stdio.h>
+
+/* Array size, number of matrix columns and how many times to repeat each test.
+ */
+#define M5_N 10000
+#define M5_NCOLUMNS 100
+#define M5_REPEAT 100
+
+
+/**
+****************************************************************************************************
+
+  @brief Copy array of given type to matrix and back, print time taken.
+
+  @param   what Text to print.
+  @param   src Array of M5_N elements.
+  @param   type_id Array element type.
+
+****************************************************************************************************
+*/
+static void m5_run(
+    const os_char *what,
+    const void *src,
+    osalTypeId type_id)
+{
+    eMatrix mtx;
+    os_char *back;
+    os_memsz sz;
+    os_long t, set_us, array_us, get_us;
+    os_int i, k, nrows;
+
+    sz = M5_N * osal_type_size(type_id);
+    back = os_malloc(sz, OS_NULL);
+    nrows = M5_N / M5_NCOLUMNS;
+
+    /* Element by element, as eioSignal::up() used to do.
+     */
+    t = etime();
+    for (k = 0; k < M5_REPEAT; k++) {
+        mtx.allocate(type_id, nrows, M5_NCOLUMNS);
+        for (i = 0; i < M5_N; i++) {
+            if (OSAL_IS_FLOAT_TYPE(type_id)) {
+                mtx.setd(i / M5_NCOLUMNS, i % M5_NCOLUMNS, ((const os_float*)src)[i]);
+            }
+            else {
+                mtx.setl(i / M5_NCOLUMNS, i % M5_NCOLUMNS, ((const os_short*)src)[i]);
+            }
+        }
+    }
+    set_us = etime() - t;
+
+    t = etime();
+    for (k = 0; k < M5_REPEAT; k++) {
+        mtx.allocate(type_id, nrows, M5_NCOLUMNS);
+        mtx.set_array(0, src, M5_N, type_id);
+    }
+    array_us = etime() - t;
+
+    t = etime();
+    for (k = 0; k < M5_REPEAT; k++) {
+        mtx.get_array(0, back, M5_N, type_id);
+    }
+    get_us = etime() - t;
+
+    printf("%s: setl/setd %.1f us, set_array %.1f us, get_array %.1f us per array\n", what,
+        set_us / (os_double)M5_REPEAT, array_us / (os_double)M5_REPEAT,
+        get_us / (os_double)M5_REPEAT);
+
+    if (os_memcmp(src, back, sz)) {
+        printf("%s: array read back from matrix differs\n", what);
+    }
+    os_free(back, sz);
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Matrix example 5.
+
+  The matrix_array_5() function benchmarks bulk array copy to matrix with array types which
+  are stored as is (short, float) and which are converted (unsigned short to int).
+
+  @return  None.
+
+****************************************************************************************************
+*/
+void matrix_array_5()
+{
+    os_short *s;
+    os_float *f;
+    os_int i;
+
+    s = (os_short*)os_malloc(M5_N * sizeof(os_short), OS_NULL);
+    f = (os_float*)os_malloc(M5_N * sizeof(os_float), OS_NULL);
+    for (i = 0; i < M5_N; i++) {
+        s[i] = (os_short)osal_rand(0, 30000);
+        f[i] = (os_float)(0.5 * osal_rand(-100000, 100000));
+    }
+
+    m5_run("short", s, OS_SHORT);
+    m5_run("ushort", s, OS_USHORT);
+    m5_run("float", f, OS_FLOAT);
+
+    os_free(s, M5_N * sizeof(os_short));
+    os_free(f, M5_N * sizeof(os_float));
+}
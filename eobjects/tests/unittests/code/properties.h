@@ -20,3 +20,6 @@ void property_example_1();
 void property_example_2();
 void property_example_3();
 void property_example_4();
+void property_example_5();
+void property_example_6();
+void property_example_7();
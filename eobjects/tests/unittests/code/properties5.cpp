@@ -0,0 +1,239 @@
+/**
+
+  @file    properties5.cpp
+  @brief   Property set/get benchmark.
+  @author  Pekka Lehtikoski
+  @version 1.0
+  @date    18.10.2026
+
+  This example measures how many property value writes and reads per second can be done,
+  both for simple properties (value kept by class) and for stored properties (value kept
+  in object's eSet). Stored properties are measured both with normal eSet and with dense
+  slot storage (EPSET_DENSE).
+
+  Copyright 2020 Pekka Lehtikoski. This file is part of the eobjects project and shall only be used,
+  modified, and distributed under the terms of the project licensing. By continuing to use, modify,
+  or distribute this file you indicate that you have read the license and understand and accept
+  it fully.
+
+****************************************************************************************************
+*/
+#include "eobjects.h"
+#include "properties.h"
+#include <stdio.h>
+
+/* Class identifiers and number of rounds to run.
+ */
+#define MY_CLASS_ID_5 (ECLASSID_APP_BASE + 5)
+#define MY_CLASS_ID_6 (ECLASSID_APP_BASE + 6)
+#define P5_NRO_ROUNDS 1000000
+
+/* Enumeration of p5MyClass properties.
+ */
+#define EMYCLASS5P_SIMPLE 10
+#define EMYCLASS5P_STORED 12
+
+static const os_char emyclass5p_simple[] = "simple";
+static const os_char emyclass5p_stored[] = "stored";
+
+
+/**
+****************************************************************************************************
+  Example class with one simple and one stored property.
+****************************************************************************************************
+*/
+class p5MyClass : public eObject
+{
+public:
+    /* Constructor.
+     */
+    p5MyClass(
+        eObject *parent = OS_NULL,
+        e_oid id = EOID_ITEM,
+        os_int flags = EOBJ_DEFAULT)
+        : eObject(parent, id, flags)
+    {
+        m_simple = 0.0;
+        initproperties();
+    }
+
+    /* Get class identifier.
+     */
+    virtual os_int classid()
+    {
+        return MY_CLASS_ID_5;
+    }
+
+    /* Add p5MyClass'es properties to class'es property set.
+    */
+    static void setupclass(
+        os_int cls = MY_CLASS_ID_5,
+        os_int psflags = EPSET_DEFAULT)
+    {
+        os_lock();
+        addpropertyd(cls, EMYCLASS5P_SIMPLE, emyclass5p_simple, "simple", 2, EPRO_SIMPLE);
+        addpropertyd(cls, EMYCLASS5P_STORED, emyclass5p_stored, "stored", 2);
+        propertysetdone(cls, psflags);
+        os_unlock();
+    }
+
+    /* Store simple property value.
+     */
+    virtual eStatus onpropertychange(
+        os_int propertynr,
+        eVariable *x,
+        os_int flags)
+    {
+        switch (propertynr)
+        {
+            case EMYCLASS5P_SIMPLE:
+                m_simple = x->getd();
+                break;
+
+            case EMYCLASS5P_STORED:
+                break;
+
+            default:
+                return ESTATUS_FAILED;
+        }
+
+        return ESTATUS_SUCCESS;
+    }
+
+    /* Get simple property value.
+     */
+    virtual eStatus simpleproperty(
+        os_int propertynr,
+        eVariable *x)
+    {
+        switch (propertynr)
+        {
+            case EMYCLASS5P_SIMPLE:
+                x->setd(m_simple);
+                break;
+
+            default:
+                return eObject::simpleproperty(propertynr, x);
+        }
+        return ESTATUS_SUCCESS;
+    }
+
+protected:
+    os_double m_simple;
+};
+
+
+/**
+****************************************************************************************************
+  Same class with stored property values in dense slots.
+****************************************************************************************************
+*/
+class p5DenseClass : public p5MyClass
+{
+public:
+    /* Get class identifier.
+     */
+    virtual os_int classid()
+    {
+        return MY_CLASS_ID_6;
+    }
+
+    /* Add p5DenseClass'es properties to class'es property set.
+    */
+    static void setupclass()
+    {
+        p5MyClass::setupclass(MY_CLASS_ID_6, EPSET_DENSE);
+    }
+};
+
+
+/**
+****************************************************************************************************
+
+  @brief Print rate of operations.
+
+****************************************************************************************************
+*/
+static void p5_report(
+    const os_char *what,
+    os_long start_us)
+{
+    os_long us;
+
+    us = etime() - start_us;
+    if (us <= 0) us = 1;
+    printf("%s: %.0f per second\n", what, 1.0e6 * P5_NRO_ROUNDS / (os_double)us);
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Measure stored property writes and reads.
+
+****************************************************************************************************
+*/
+static void p5_stored(
+    p5MyClass *o,
+    const os_char *what)
+{
+    eVariable v, label;
+    os_long start_us;
+    os_double sum;
+    os_int i;
+
+    start_us = etime();
+    for (i = 0; i < P5_NRO_ROUNDS; i++) {
+        o->setpropertyd(EMYCLASS5P_STORED, (os_double)i);
+    }
+    label = what;
+    label += " property sets";
+    p5_report(label.gets(), start_us);
+
+    sum = 0.0;
+    start_us = etime();
+    for (i = 0; i < P5_NRO_ROUNDS; i++) {
+        o->propertyv(EMYCLASS5P_STORED, &v);
+        sum += v.getd();
+    }
+    label = what;
+    label += " property gets";
+    p5_report(label.gets(), start_us);
+    printf("checksum %f\n", sum);
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Property example 5.
+
+  The property_example_5() function measures property writes and reads per second.
+
+  @return  None.
+
+****************************************************************************************************
+*/
+void property_example_5()
+{
+    p5MyClass *o;
+    os_long start_us;
+    os_int i;
+
+    p5MyClass::setupclass();
+    p5DenseClass::setupclass();
+    o = new p5MyClass();
+
+    start_us = etime();
+    for (i = 0; i < P5_NRO_ROUNDS; i++) {
+        o->setpropertyd(EMYCLASS5P_SIMPLE, (os_double)i);
+    }
+    p5_report("simple property sets", start_us);
+
+    p5_stored(o, "stored");
+    delete o;
+
+    o = new p5DenseClass();
+    p5_stored(o, "dense stored");
+    delete o;
+}
@@ -0,0 +1,221 @@
+/**
+
+  @file    properties6.cpp
+  @brief   Batched property bindings benchmark.
+  @author  Pekka Lehtikoski
+  @version 1.0
+  @date    18.10.2026
+
+  This example binds 300 properties of a client thread to server thread's properties, like
+  a parameter list in GUI bound to IO signals. Server changes all values at once, and the time
+  until client has received all of them is measured. This is done first with normal bindings
+  (one ECMD_FWRD and ECMD_ACK per property) and then with EBIND_BATCH (one message and one
+  acknowledgement per thread cycle).
+
+  Copyright 2020 Pekka Lehtikoski. This file is part of the eobjects project and shall only be used,
+  modified, and distributed under the terms of the project licensing. By continuing to use, modify,
+  or distribute this file you indicate that you have read the license and understand and accept
+  it fully.
+
+****************************************************************************************************
+*/
+#include "eobjects.h"
+#include "properties.h"
+#include <stdio.h>
+
+/* Class identifier, number of bound properties and number of rounds to run.
+ */
+#define MY_CLASS_ID_7 (ECLASSID_APP_BASE + 7)
+#define P6_NRO_VALUES 300
+#define P6_NRO_ROUNDS 200
+
+/* Enumeration of p6Thread properties. Bound values are P6P_X + 0 ... P6P_X + 299.
+ */
+#define P6P_ROUND 10
+#define P6P_X 20
+
+static const os_char p6p_round[] = "round";
+
+/* Round which server is sending, and number of values of that round received by client.
+ */
+static volatile os_long p6_round;
+static volatile os_int p6_nreceived;
+
+
+/**
+****************************************************************************************************
+  Server and client thread. Server changes all values when round is set, client counts
+  received values.
+****************************************************************************************************
+*/
+class p6Thread : public eThread
+{
+public:
+    /* Constructor.
+     */
+    p6Thread(
+        os_int bflags,
+        eObject *parent = OS_NULL,
+        e_oid id = EOID_ITEM,
+        os_int flags = EOBJ_DEFAULT)
+        : eThread(parent, id, flags)
+    {
+        m_bflags = bflags;
+        initproperties();
+    }
+
+    /* Add p6Thread'es properties to class'es property set.
+    */
+    static void setupclass()
+    {
+        const os_int cls = MY_CLASS_ID_7;
+        eVariable name;
+        os_int i;
+
+        os_lock();
+        addpropertyl(cls, P6P_ROUND, p6p_round, "round", EPRO_SIMPLE);
+        for (i = 0; i < P6_NRO_VALUES; i++)
+        {
+            name = "x";
+            name.appendl(i);
+            addpropertyl(cls, P6P_X + i, name.gets(), name.gets());
+        }
+        propertysetdone(cls, EPSET_DENSE);
+        os_unlock();
+    }
+
+    /* Get class identifier.
+     */
+    virtual os_int classid()
+    {
+        return MY_CLASS_ID_7;
+    }
+
+    /* Client binds all values to server.
+     */
+    virtual void initialize(
+        eContainer *params = OS_NULL)
+    {
+        eVariable path;
+        os_int i;
+
+        if (m_bflags < 0) return;
+        for (i = 0; i < P6_NRO_VALUES; i++)
+        {
+            path = "//p6server/_p/x";
+            path.appendl(i);
+            bind(P6P_X + i, path.gets(), m_bflags);
+        }
+    }
+
+    /* Server sets all values for new round, client counts values of current round.
+     */
+    virtual eStatus onpropertychange(
+        os_int propertynr,
+        eVariable *x,
+        os_int flags)
+    {
+        os_int i;
+
+        if (propertynr == P6P_ROUND)
+        {
+            for (i = 0; i < P6_NRO_VALUES; i++) {
+                setpropertyl(P6P_X + i, x->getl());
+            }
+            return ESTATUS_SUCCESS;
+        }
+
+        if (propertynr >= P6P_X && propertynr < P6P_X + P6_NRO_VALUES)
+        {
+            if (m_bflags >= 0 && x->getl() == p6_round) {
+                p6_nreceived++;
+            }
+            return ESTATUS_SUCCESS;
+        }
+
+        return ESTATUS_FAILED;
+    }
+
+protected:
+    /* Binding flags for client, -1 for server.
+     */
+    os_int m_bflags;
+};
+
+
+/**
+****************************************************************************************************
+
+  @brief Run rounds and print time per round.
+
+  @param   what Text to print.
+  @param   bflags Binding flags for client bindings.
+
+****************************************************************************************************
+*/
+static void p6_run(
+    const os_char *what,
+    os_int bflags)
+{
+    eThread *t;
+    eThreadHandle serverhandle, clienthandle;
+    eContainer c;
+    os_timer start_t;
+    os_long start_us;
+    os_int r, nrounds;
+
+    p6_round = 0;
+    t = new p6Thread(-1);
+    t->addname("p6server", ENAME_PROCESS_NS);
+    t->start(&serverhandle);
+
+    t = new p6Thread(bflags);
+    t->start(&clienthandle);
+    osal_sleep(500);
+
+    nrounds = 0;
+    start_us = etime();
+    for (r = 1; r <= P6_NRO_ROUNDS; r++)
+    {
+        p6_nreceived = 0;
+        p6_round = r;
+        c.setpropertyl_msg("//p6server", r, p6p_round);
+
+        os_get_timer(&start_t);
+        while (p6_nreceived < P6_NRO_VALUES && !os_has_elapsed(&start_t, 5000)) {
+            os_timeslice();
+        }
+        if (p6_nreceived < P6_NRO_VALUES) break;
+        nrounds++;
+    }
+
+    printf("%s: %d of %d rounds, %.1f us per round of %d values\n",
+        what, nrounds, P6_NRO_ROUNDS,
+        nrounds ? (os_double)(etime() - start_us) / nrounds : 0.0, P6_NRO_VALUES);
+
+    clienthandle.terminate();
+    clienthandle.join();
+    serverhandle.terminate();
+    serverhandle.join();
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Property example 6.
+
+  The property_example_6() function compares normal and batched property bindings between
+  two threads.
+
+  @return  None.
+
+****************************************************************************************************
+*/
+void property_example_6()
+{
+    p6Thread::setupclass();
+
+    p6_run("per property bindings", EBIND_DEFAULT);
+    p6_run("batched bindings", EBIND_BATCH);
+}
@@ -0,0 +1,226 @@
+/**
+
+  @file    properties7.cpp
+  @brief   Rate limited and deadband filtered property bindings.
+  @author  Pekka Lehtikoski
+  @version 1.0
+  @date    18.10.2026
+
+  Server thread simulates noisy analog signal, which changes every millisecond. Client binds
+  to it first without options, then with deadband and minimum interval, and checks that number
+  of values received is within limits set by the options.
+
+  Copyright 2020 Pekka Lehtikoski. This file is part of the eobjects project and shall only be used,
+  modified, and distributed under the terms of the project licensing. By continuing to use, modify,
+  or distribute this file you indicate that you have read the license and understand and accept
+  it fully.
+
+****************************************************************************************************
+*/
+#include "eobjects.h"
+#include "properties.h"
+#include <stdio.h>
+
+/* Class identifier and property numbers.
+ */
+#define MY_CLASS_ID_8 (ECLASSID_APP_BASE + 8)
+#define P7P_X 10
+
+static const os_char p7p_x[] = "x";
+
+/* Number of signal changes by server and values received by client.
+ */
+static volatile os_int p7_nchanged, p7_nreceived;
+
+
+/**
+****************************************************************************************************
+  Server and client thread. Server simulates the signal, client counts received values.
+****************************************************************************************************
+*/
+class p7Thread : public eThread
+{
+public:
+    /* Constructor, bparams OS_NULL for server.
+     */
+    p7Thread(
+        const eBindParams *bparams,
+        os_boolean server,
+        eObject *parent = OS_NULL,
+        e_oid id = EOID_ITEM,
+        os_int flags = EOBJ_DEFAULT)
+        : eThread(parent, id, flags)
+    {
+        m_server = server;
+        os_memclear(&m_bparams, sizeof(eBindParams));
+        if (bparams) m_bparams = *bparams;
+        initproperties();
+    }
+
+    /* Add p7Thread'es properties to class'es property set.
+    */
+    static void setupclass()
+    {
+        const os_int cls = MY_CLASS_ID_8;
+
+        os_lock();
+        addpropertyd(cls, P7P_X, p7p_x, "x");
+        propertysetdone(cls);
+        os_unlock();
+    }
+
+    /* Get class identifier.
+     */
+    virtual os_int classid()
+    {
+        return MY_CLASS_ID_8;
+    }
+
+    /* Client binds to server.
+     */
+    virtual void initialize(
+        eContainer *params = OS_NULL)
+    {
+        if (!m_server) {
+            bind(P7P_X, "//p7server/_p/x", EBIND_DEFAULT, &m_bparams);
+        }
+    }
+
+    /* Server changes the signal: Slow ramp with +-0.05 noise.
+     */
+    virtual void run()
+    {
+        os_int i;
+
+        if (!m_server)
+        {
+            eThread::run();
+            return;
+        }
+
+        for (i = 0; !exitnow(); i++)
+        {
+            alive(EALIVE_RETURN_IMMEDIATELY);
+            setpropertyd(P7P_X, 0.001 * i + 0.05 * ((i * 7919) % 11 - 5) / 5.0);
+            p7_nchanged++;
+            osal_sleep(1);
+        }
+    }
+
+    /* Client counts received values.
+     */
+    virtual eStatus onpropertychange(
+        os_int propertynr,
+        eVariable *x,
+        os_int flags)
+    {
+        if (propertynr == P7P_X)
+        {
+            if (!m_server) p7_nreceived++;
+            return ESTATUS_SUCCESS;
+        }
+        return ESTATUS_FAILED;
+    }
+
+protected:
+    os_boolean m_server;
+    eBindParams m_bparams;
+};
+
+
+/* Print error message if condition is not true.
+ */
+static os_boolean p7_check(
+    os_boolean condition,
+    const os_char *what)
+{
+    if (!condition) printf("%s failed\n", what);
+    return condition;
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Run server and client for two seconds and print number of received values.
+
+  @param   what Text to print.
+  @param   bparams Binding options for client, OS_NULL for none.
+  @param   nchanged Where to store number of signal changes by server during two seconds.
+  @return  Number of values received by client during two seconds.
+
+****************************************************************************************************
+*/
+static os_int p7_run(
+    const os_char *what,
+    const eBindParams *bparams,
+    os_int *nchanged)
+{
+    eThread *t;
+    eThreadHandle serverhandle, clienthandle;
+    os_int nreceived;
+
+    t = new p7Thread(OS_NULL, OS_TRUE);
+    t->addname("p7server", ENAME_PROCESS_NS);
+    t->start(&serverhandle);
+
+    t = new p7Thread(bparams, OS_FALSE);
+    t->start(&clienthandle);
+
+    osal_sleep(200);
+    p7_nreceived = p7_nchanged = 0;
+    osal_sleep(2000);
+    nreceived = p7_nreceived;
+    *nchanged = p7_nchanged;
+    printf("%s: %d values received in 2 s, signal changed %d times\n",
+        what, nreceived, *nchanged);
+
+    clienthandle.terminate();
+    clienthandle.join();
+    serverhandle.terminate();
+    serverhandle.join();
+    return nreceived;
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Property example 7.
+
+  The property_example_7() function compares bindings with and without rate limit and
+  deadband options. Limits are derived from number of signal changes, since sleep resolution
+  differs between operating systems:
+  - Without options, no more values than changes. Flow control may coalesce some.
+  - Signal ramps 0.001 per change and noise is +-0.05, so with deadband 0.1 a value passes
+    at most once per 0.1 of ramp, plus first value and noise peak. Each of at most five
+    500 ms heartbeats forwards one value and may allow one more noise peak after it.
+  - With 100 ms minimum interval, at most 2000 / 100 values plus first one.
+
+  @return  None.
+
+****************************************************************************************************
+*/
+void property_example_7()
+{
+    eBindParams bparams;
+    os_int n, nchanged;
+    os_boolean ok = OS_TRUE;
+
+    p7Thread::setupclass();
+    n = p7_run("no options", OS_NULL, &nchanged);
+    ok &= p7_check(n > 0 && n <= nchanged, "no options");
+
+    os_memclear(&bparams, sizeof(bparams));
+    bparams.deadband = 0.1;
+    bparams.max_interval_ms = 500;
+    n = p7_run("deadband 0.1, heartbeat 500 ms", &bparams, &nchanged);
+    ok &= p7_check(n > 0 && n <= nchanged / 100 + 12, "deadband");
+
+    os_memclear(&bparams, sizeof(bparams));
+    bparams.min_interval_ms = 100;
+    n = p7_run("min interval 100 ms", &bparams, &nchanged);
+    ok &= p7_check(n > 0 && n <= 2000 / 100 + 1, "min interval");
+
+    printf("property_example_7 %s\n", ok ? "passed" : "FAILED");
+}
@@ -15,3 +15,5 @@
 */
 
 void queue_example1();
+void queue_codec_2();
+void queue_hello_3();
@@ -0,0 +1,259 @@
+/**
+
+  @file    queue2.cpp
+  @brief   Buffered stream compression unit test.
+  @author  Pekka Lehtikoski
+  @version 1.0
+  @date    18.10.2026
+
+  Two buffered streams are connected back to back through memory. The test checks hello and
+  codec switch handling, that hello is recognized only as the first thing received, that
+  compressible data travels as LZ frames and incompressible data as raw frames, and that
+  empty frames and frame headers split between reads are handled. Everything written must
+  be read back unchanged at the other end.
+
+  Copyright 2020 Pekka Lehtikoski. This file is part of the eobjects project and shall only be used,
+  modified, and distributed under the terms of the project licensing. By continuing to use, modify,
+  or distribute this file you indicate that you have read the license and understand and accept
+  it fully.
+
+****************************************************************************************************
+*/
+#include "eobjects.h"
+#include "queue.h"
+#include <stdio.h>
+
+/* Size of memory "wire" between the streams.
+ */
+#define Q2_WIRE_SZ 65536
+
+
+/**
+****************************************************************************************************
+  Buffered stream which writes to the other stream's wire buffer and reads from it's own.
+****************************************************************************************************
+*/
+class q2PipeStream : public eBufferedStream
+{
+public:
+    /* Constructor.
+     */
+    q2PipeStream()
+    {
+        setup_queues(Q2_WIRE_SZ, Q2_WIRE_SZ, 0);
+        m_peer = OS_NULL;
+        m_wire_n = m_wire_pos = 0;
+    }
+
+    /* Set the stream to write to.
+     */
+    void connect(
+        q2PipeStream *peer)
+    {
+        m_peer = peer;
+    }
+
+    /* Write data or control code and flush to the other stream.
+     */
+    eStatus put(
+        const os_char *buf,
+        os_memsz n)
+    {
+        if (m_out->write(buf, n)) return ESTATUS_FAILED;
+        return buffer_to_stream(OS_TRUE);
+    }
+
+    eStatus putchar(
+        os_int c)
+    {
+        if (m_out->writechar(c)) return ESTATUS_FAILED;
+        return buffer_to_stream(OS_TRUE);
+    }
+
+    /* Write everything buffered, codec switch mark after setcodec().
+     */
+    eStatus flush()
+    {
+        return buffer_to_stream(OS_TRUE);
+    }
+
+    /* Place bytes directly on own wire, as if the other end had written them.
+     */
+    void inject(
+        const os_char *buf,
+        os_memsz n)
+    {
+        os_memcpy(m_wire + m_wire_n, buf, n);
+        m_wire_n += n;
+    }
+
+    /* Receive everything on the wire and read decoded data.
+     */
+    os_memsz get(
+        os_char *buf,
+        os_memsz buf_sz)
+    {
+        os_memsz nread;
+
+        if (receive()) return -1;
+        m_in->readx(buf, buf_sz, &nread);
+        return nread;
+    }
+
+protected:
+    virtual eStatus buffered_write(
+        const os_char *buf,
+        os_memsz buf_sz,
+        os_memsz *nwritten)
+    {
+        if (buf_sz > Q2_WIRE_SZ - m_peer->m_wire_n) buf_sz = Q2_WIRE_SZ - m_peer->m_wire_n;
+        m_peer->inject(buf, buf_sz);
+        *nwritten = buf_sz;
+        return ESTATUS_SUCCESS;
+    }
+
+    virtual eStatus buffered_read(
+        os_char *buf,
+        os_memsz buf_sz,
+        os_memsz *nread)
+    {
+        if (buf_sz > m_wire_n - m_wire_pos) buf_sz = m_wire_n - m_wire_pos;
+        os_memcpy(buf, m_wire + m_wire_pos, buf_sz);
+        m_wire_pos += buf_sz;
+        *nread = buf_sz;
+        return ESTATUS_SUCCESS;
+    }
+
+    q2PipeStream *m_peer;
+    os_char m_wire[Q2_WIRE_SZ];
+    os_memsz m_wire_n, m_wire_pos;
+};
+
+
+/**
+****************************************************************************************************
+  Send data from a to b and compare what b reads.
+****************************************************************************************************
+*/
+static os_boolean q2_transfer(
+    q2PipeStream *a,
+    q2PipeStream *b,
+    const os_char *data,
+    os_memsz n,
+    const os_char *what)
+{
+    os_char back[8192];
+    os_memsz nread;
+
+    if (a->put(data, n)) {
+        printf("%s: write failed\n", what);
+        return OS_FALSE;
+    }
+
+    nread = b->get(back, sizeof(back));
+    if (nread != n || os_memcmp(back, data, n)) {
+        printf("%s: %d bytes written, %d read back or content differs\n", what,
+            (int)n, (int)nread);
+        return OS_FALSE;
+    }
+    return OS_TRUE;
+}
+
+
+/**
+****************************************************************************************************
+  Queue example 2: Buffered stream compression.
+****************************************************************************************************
+*/
+void queue_codec_2()
+{
+    q2PipeStream *a, *b, *old;
+    os_char text[6000], noise[3000], back[16], empty[ECOMPRESS_FRAME_HDR_SZ];
+    os_long raw_bytes, coded_bytes, cpu_us;
+    os_int i, caps;
+    os_boolean ok = OS_TRUE;
+
+    /* Compressible text: Envelope like paths repeated, and incompressible noise.
+     */
+    text[0] = '\0';
+    while (os_strlen(text) < (os_memsz)sizeof(text) - 100) {
+        os_strncat(text, "//c4con/c4receiver/_p/A \xE5 value 12345; ", sizeof(text));
+    }
+    for (i = 0; i < (os_int)sizeof(noise); i++) {
+        noise[i] = (os_char)osal_rand(0, 255);
+    }
+
+    a = new q2PipeStream();
+    b = new q2PipeStream();
+    old = new q2PipeStream();
+    a->connect(b);
+    b->connect(a);
+    old->connect(a);
+
+    /* Older version sends no hello: Nothing is scanned, data passes as is.
+     */
+    ok &= q2_transfer(old, a, text, 500, "no hello");
+    if (a->peercaps()) {
+        printf("no hello: capabilities %d received\n", a->peercaps());
+        ok = OS_FALSE;
+    }
+    delete a;
+    a = new q2PipeStream();
+    old->connect(a);
+
+    /* Hello must be the first thing sent: After keep alive it is not taken as hello.
+     */
+    old->putchar(E_STREAM_KEEPALIVE);
+    old->putchar(E_STREAM_KEEPALIVE + (E_STREAM_KEEPALIVE_HELLO | ECOMPRESS_CODEC_LZ));
+    ok &= q2_transfer(old, a, text, 200, "late hello");
+    if (a->peercaps()) {
+        printf("late hello: capabilities %d received\n", a->peercaps());
+        ok = OS_FALSE;
+    }
+    delete a;
+    a = new q2PipeStream();
+    a->connect(b);
+    b->connect(a);
+
+    /* Hello first, then uncompressed data.
+     */
+    caps = E_STREAM_KEEPALIVE_HELLO | ECOMPRESS_CODEC_LZ;
+    a->putchar(E_STREAM_KEEPALIVE + caps);
+    ok &= q2_transfer(a, b, text, 100, "hello");
+    if (b->peercaps() != caps) {
+        printf("hello: capabilities %d received, %d expected\n", b->peercaps(), caps);
+        ok = OS_FALSE;
+    }
+
+    /* Compress from here on: Text as LZ frames, noise as raw frames.
+     */
+    a->setcodec(ECOMPRESS_CODEC_LZ);
+    a->flush();
+    ok &= q2_transfer(a, b, text, os_strlen(text), "lz frames");
+    a->codecstats(&raw_bytes, &coded_bytes, &cpu_us);
+    if (coded_bytes <= 0 || coded_bytes >= raw_bytes) {
+        printf("lz frames: %lld bytes coded as %lld\n", (long long)raw_bytes,
+            (long long)coded_bytes);
+        ok = OS_FALSE;
+    }
+    ok &= q2_transfer(a, b, noise, sizeof(noise), "raw frames");
+
+    /* Empty raw and LZ frames, also header split between reads.
+     */
+    empty[0] = ECOMPRESS_FRAME_RAW;
+    empty[1] = empty[2] = 0;
+    b->inject(empty, ECOMPRESS_FRAME_HDR_SZ);
+    if (b->get(back, sizeof(back)) != 0) ok = OS_FALSE;
+    empty[0] = ECOMPRESS_FRAME_LZ;
+    b->inject(empty, 1);
+    if (b->get(back, sizeof(back)) != 0) ok = OS_FALSE;
+    b->inject(empty + 1, ECOMPRESS_FRAME_HDR_SZ - 1);
+    if (b->get(back, sizeof(back)) != 0) ok = OS_FALSE;
+    ok &= q2_transfer(a, b, text, 2000, "after empty frames");
+
+    printf("queue_codec_2 %s\n", ok ? "passed" : "FAILED");
+
+    delete a;
+    delete b;
+    delete old;
+}
@@ -0,0 +1,245 @@
+/**
+
+  @file    queue3.cpp
+  @brief   Hello echo unit test, with older version peer.
+  @author  Pekka Lehtikoski
+  @version 1.0
+  @date    18.10.2026
+
+  A connection may write dictionary coded paths only after the other end has echoed path
+  dictionary support, which confirms that it received our hello. This test connects buffered
+  streams back to back through memory and checks what the stream reports to connection:
+  - Older version peer sends no hello and no echo, only plain keep alives. Nothing may be
+    reported, so the connection keeps writing paths as strings.
+  - Hello alone, which has the same capability bit set, must not be taken as echo.
+  - Echo is found also when it is split between two reads, and when it arrives inside
+    compressed data.
+  Data around hello and echo must be read back unchanged.
+
+  Copyright 2020 Pekka Lehtikoski. This file is part of the eobjects project and shall only be used,
+  modified, and distributed under the terms of the project licensing. By continuing to use, modify,
+  or distribute this file you indicate that you have read the license and understand and accept
+  it fully.
+
+****************************************************************************************************
+*/
+#include "eobjects.h"
+#include "queue.h"
+#include <stdio.h>
+
+/* Size of memory "wire" between the streams.
+ */
+#define Q3_WIRE_SZ 16384
+
+/* Hello as sent by eConnection: Path dictionary supported, LZ codec selected.
+ */
+#define Q3_HELLO (E_STREAM_KEEPALIVE + (E_STREAM_KEEPALIVE_HELLO | \
+    ECONNECTION_CODEC_PATH_DICT | ECOMPRESS_CODEC_LZ))
+
+/* Echo of path dictionary support.
+ */
+#define Q3_ECHO (E_STREAM_KEEPALIVE + E_STREAM_KEEPALIVE_ECHO)
+
+
+/**
+****************************************************************************************************
+  Buffered stream which writes to the other stream's wire buffer and reads from it's own.
+****************************************************************************************************
+*/
+class q3PipeStream : public eBufferedStream
+{
+public:
+    /* Constructor.
+     */
+    q3PipeStream()
+    {
+        setup_queues(Q3_WIRE_SZ, Q3_WIRE_SZ, 0);
+        m_peer = OS_NULL;
+        m_wire_n = m_wire_pos = 0;
+    }
+
+    /* Set the stream to write to.
+     */
+    void connect(
+        q3PipeStream *peer)
+    {
+        m_peer = peer;
+    }
+
+    /* Write data or control code, flush to the other stream and let it receive.
+     */
+    eStatus put(
+        const os_char *buf,
+        os_memsz n)
+    {
+        if (m_out->write(buf, n)) return ESTATUS_FAILED;
+        return send();
+    }
+
+    eStatus putchar(
+        os_int c)
+    {
+        if (m_out->writechar(c)) return ESTATUS_FAILED;
+        return send();
+    }
+
+    /* Read decoded data received so far.
+     */
+    os_memsz get(
+        os_char *buf,
+        os_memsz buf_sz)
+    {
+        os_memsz nread;
+
+        m_in->readx(buf, buf_sz, &nread);
+        return nread;
+    }
+
+    /* Place bytes directly on own wire, as if the other end had written them.
+     */
+    eStatus inject(
+        const os_char *buf,
+        os_memsz n)
+    {
+        os_memcpy(m_wire + m_wire_n, buf, n);
+        m_wire_n += n;
+        return receive();
+    }
+
+protected:
+    eStatus send()
+    {
+        if (buffer_to_stream(OS_TRUE)) return ESTATUS_FAILED;
+        return m_peer->receive();
+    }
+
+    virtual eStatus buffered_write(
+        const os_char *buf,
+        os_memsz buf_sz,
+        os_memsz *nwritten)
+    {
+        if (buf_sz > Q3_WIRE_SZ - m_peer->m_wire_n) buf_sz = Q3_WIRE_SZ - m_peer->m_wire_n;
+        os_memcpy(m_peer->m_wire + m_peer->m_wire_n, buf, buf_sz);
+        m_peer->m_wire_n += buf_sz;
+        *nwritten = buf_sz;
+        return ESTATUS_SUCCESS;
+    }
+
+    virtual eStatus buffered_read(
+        os_char *buf,
+        os_memsz buf_sz,
+        os_memsz *nread)
+    {
+        if (buf_sz > m_wire_n - m_wire_pos) buf_sz = m_wire_n - m_wire_pos;
+        os_memcpy(buf, m_wire + m_wire_pos, buf_sz);
+        m_wire_pos += buf_sz;
+        *nread = buf_sz;
+        return ESTATUS_SUCCESS;
+    }
+
+    q3PipeStream *m_peer;
+    os_char m_wire[Q3_WIRE_SZ];
+    os_memsz m_wire_n, m_wire_pos;
+};
+
+
+/* Print error message if condition is not true.
+ */
+static os_boolean q3_check(
+    os_boolean condition,
+    const os_char *what)
+{
+    if (!condition) printf("%s failed\n", what);
+    return condition;
+}
+
+/* Check that data sent by put() arrives unchanged.
+ */
+static os_boolean q3_data(
+    q3PipeStream *from,
+    q3PipeStream *to,
+    const os_char *what)
+{
+    static const os_char data[] = "//q3/_p/A \xE5 x";
+    os_char back[64];
+
+    from->put(data, sizeof(data));
+    return q3_check(to->get(back, sizeof(back)) == (os_memsz)sizeof(data) &&
+        !os_memcmp(back, data, sizeof(data)), what);
+}
+
+
+/**
+****************************************************************************************************
+  Queue example 3: Hello echo with older version peer.
+****************************************************************************************************
+*/
+void queue_hello_3()
+{
+    q3PipeStream *a, *b, *old;
+    os_char echo[2];
+    os_boolean ok = OS_TRUE;
+
+    /* Older version peer: Our hello is ignored, and the peer sends only data and plain
+       keep alives. No capabilities and no echo are reported.
+     */
+    a = new q3PipeStream();
+    old = new q3PipeStream();
+    a->connect(old);
+    old->connect(a);
+    a->putchar(Q3_HELLO);
+    ok &= q3_data(a, old, "old peer reads data after hello");
+    ok &= q3_data(old, a, "data from old peer");
+    old->putchar(E_STREAM_KEEPALIVE);
+    ok &= q3_data(old, a, "data after keep alive from old peer");
+    ok &= q3_check(a->peercaps() == 0, "no hello from old peer");
+    ok &= q3_check(a->peerecho() == 0, "no echo from old peer");
+    delete a;
+    delete old;
+
+    /* Two new ends: Hello alone is not echo, echo is found when it arrives.
+     */
+    a = new q3PipeStream();
+    b = new q3PipeStream();
+    a->connect(b);
+    b->connect(a);
+    a->putchar(Q3_HELLO);
+    b->putchar(Q3_HELLO);
+    ok &= q3_data(b, a, "data after hello");
+    ok &= q3_check((a->peercaps() & ECONNECTION_CODEC_PATH_DICT) != 0, "hello received");
+    ok &= q3_check(a->peerecho() == 0, "hello not taken as echo");
+    b->putchar(Q3_ECHO);
+    ok &= q3_data(b, a, "data after echo");
+    ok &= q3_check((a->peerecho() & E_STREAM_KEEPALIVE_ECHO) != 0, "echo received");
+
+    /* Echo split between two reads.
+     */
+    ok &= q3_check((b->peerecho() & E_STREAM_KEEPALIVE_ECHO) == 0, "no echo yet");
+    echo[0] = (os_char)E_STREAM_CTRL_CHAR;
+    echo[1] = (os_char)(E_STREAM_CTRLCH_KEEPALIVE | E_STREAM_KEEPALIVE_ECHO);
+    b->inject(echo, 1);
+    ok &= q3_check(b->peerecho() == 0, "half echo");
+    b->inject(echo + 1, 1);
+    ok &= q3_check((b->peerecho() & E_STREAM_KEEPALIVE_ECHO) != 0, "split echo");
+    delete a;
+    delete b;
+
+    /* Echo inside compressed data.
+     */
+    a = new q3PipeStream();
+    b = new q3PipeStream();
+    a->connect(b);
+    b->connect(a);
+    a->putchar(Q3_HELLO);
+    b->putchar(Q3_HELLO);
+    b->setcodec(ECOMPRESS_CODEC_LZ);
+    ok &= q3_data(b, a, "compressed data");
+    ok &= q3_check(a->peerecho() == 0, "no echo in compressed data");
+    b->putchar(Q3_ECHO);
+    ok &= q3_data(b, a, "compressed data after echo");
+    ok &= q3_check((a->peerecho() & E_STREAM_KEEPALIVE_ECHO) != 0, "compressed echo");
+    delete a;
+    delete b;
+
+    printf("queue_hello_3 %s\n", ok ? "passed" : "FAILED");
+}
@@ -17,3 +17,5 @@
 */
 
 void variables_example1();
+void variables_format_2();
+void variables_intern_3();
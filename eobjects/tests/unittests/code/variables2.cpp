@@ -0,0 +1,161 @@
+/**
+
+  @file    variables2.cpp
+  @brief   Formatting numbers to string.
+  @author  Pekka Lehtikoski
+  @version 1.0
+  @date    18.10.2026
+
+  This example converts a million integer and floating point values to string, first by
+  eVariable::gets() which allocates temporary string buffer, then by eVariable::gets_buf()
+  into stack buffer, and prints time taken. Both must produce the same strings. Then
+  edouble2str() output is compared to expected strings, including rounding of halfway
+  cases, and shortest round trip formatting is compared to osal_double_to_str().
+
+  Copyright 2020 Pekka Lehtikoski. This file is part of the eobjects project and shall only be used,
+  modified, and distributed under the terms of the project licensing. By continuing to use, modify,
+  or distribute this file you indicate that you have read the license and understand and accept
+  it fully.
+
+****************************************************************************************************
+*/
+#include "eobjects.h"
+#include "variables.h"
+#include <stdio.h>
+
+/* Number of values to format.
+ */
+#define V2_NVALUES 1000000
+
+/* Value, number of decimals and expected edouble2str() output.
+ */
+typedef struct
+{
+    os_double x;
+    os_int ddigs;
+    const os_char *expected;
+}
+v2Expected;
+
+static const v2Expected v2_expected[] = {
+    {0.0, EDOUBLE2STR_SHORTEST, "0"},
+    {3.0, EDOUBLE2STR_SHORTEST, "3"},
+    {0.1, EDOUBLE2STR_SHORTEST, "0.1"},
+    {-2.5, EDOUBLE2STR_SHORTEST, "-2.5"},
+    {1e-7, EDOUBLE2STR_SHORTEST, "0.0000001"},
+    {123456.789, EDOUBLE2STR_SHORTEST, "123456.789"},
+    {1.0 / 3.0, EDOUBLE2STR_SHORTEST, "0.333333333333333"},
+    {0.0, 2, "0.00"},
+    {0.1, 2, "0.10"},
+    {1e-7, 3, "0.000"},
+    {-0.0001, 2, "0.00"},
+    {123456.789, 2, "123456.79"},
+    {123456.789, 0, "123457"},
+
+    /* Exact halfway values round away from zero. 1.005 and 2.675 are slightly below
+       halfway as doubles, so they round down.
+     */
+    {0.5, 0, "1"},
+    {-0.5, 0, "-1"},
+    {2.5, 0, "3"},
+    {0.125, 2, "0.13"},
+    {-0.125, 2, "-0.13"},
+    {1.005, 2, "1.00"},
+    {2.675, 2, "2.67"},
+};
+
+
+/**
+****************************************************************************************************
+
+  @brief Variables example 2.
+
+  The variables_format_2() function benchmarks number to string conversions.
+
+  @return  None.
+
+****************************************************************************************************
+*/
+void variables_format_2()
+{
+    eVariable var;
+    os_char buf[EVARIABLE_NBUF_SZ], *e;
+    const os_char *str;
+    os_double d;
+    os_long t;
+    os_int i, nbad;
+    os_boolean ok = OS_TRUE;
+
+    /* Integer and double values with gets(), each new value frees previous temporary string.
+     */
+    t = etime();
+    for (i = 0; i < V2_NVALUES; i++) {
+        if (i & 1) var.setl(i * 7919);
+        else var.setd(i * 0.37);
+        str = var.gets();
+    }
+    printf("gets(): %.1f ms\n", (etime() - t) / 1000.0);
+
+    /* Same with gets_buf(), no memory allocation.
+     */
+    t = etime();
+    for (i = 0; i < V2_NVALUES; i++) {
+        if (i & 1) var.setl(i * 7919);
+        else var.setd(i * 0.37);
+        str = var.gets_buf(buf, sizeof(buf));
+    }
+    printf("gets_buf(): %.1f ms\n", (etime() - t) / 1000.0);
+
+    /* Both must give the same strings. gets_buf() doesn't touch gets() string.
+     */
+    nbad = 0;
+    for (i = 0; i < V2_NVALUES; i++) {
+        if (i & 1) var.setl(i * 7919);
+        else var.setd(i * 0.37);
+        str = var.gets();
+        if (os_strcmp(str, var.gets_buf(buf, sizeof(buf)))) {
+            if (nbad++ == 0) printf("gets() \"%s\", gets_buf() \"%s\"\n", str, buf);
+        }
+    }
+    if (nbad) {
+        printf("gets() and gets_buf() results differ for %d values\n", nbad);
+        ok = OS_FALSE;
+    }
+
+    /* Compare to expected strings.
+     */
+    for (i = 0; i < (os_int)(sizeof(v2_expected) / sizeof(v2Expected)); i++) {
+        e = edouble2str(buf, v2_expected[i].x, sizeof(buf) - 1, v2_expected[i].ddigs);
+        *e = '\0';
+        if (os_strcmp(buf, v2_expected[i].expected)) {
+            printf("edouble2str(%.17g, %d): \"%s\", expected \"%s\"\n", v2_expected[i].x,
+                v2_expected[i].ddigs, buf, v2_expected[i].expected);
+            ok = OS_FALSE;
+        }
+    }
+
+    /* Shortest round trip formatting, check that strings read back as same values.
+     */
+    nbad = 0;
+    t = etime();
+    for (i = 0; i < V2_NVALUES; i++) {
+        d = osal_rand(-1000000, 1000000) / 1024.0;
+        e = edouble2str(buf, d, sizeof(buf) - 1, EDOUBLE2STR_SHORTEST);
+        *e = '\0';
+        if (osal_str_to_double(buf, OS_NULL) != d) nbad++;
+    }
+    printf("edouble2str(), shortest: %.1f ms, %d values did not read back\n",
+        (etime() - t) / 1000.0, nbad);
+    if (nbad) ok = OS_FALSE;
+
+    t = etime();
+    for (i = 0; i < V2_NVALUES; i++) {
+        d = osal_rand(-1000000, 1000000) / 1024.0;
+        osal_double_to_str(buf, sizeof(buf), d, 10, OSAL_FLOAT_DEFAULT);
+    }
+    printf("osal_double_to_str(), 10 digits: %.1f ms\n", (etime() - t) / 1000.0);
+
+    if (!ok) {
+        printf("variables_format_2 FAILED\n");
+    }
+}
@@ -0,0 +1,137 @@
+/**
+
+  @file    variables3.cpp
+  @brief   Interned strings.
+  @author  Pekka Lehtikoski
+  @version 1.0
+  @date    18.10.2026
+
+  This example checks that variables set to the same interned string share it, that copying
+  adds and clearing releases a reference, that modifying the string makes a private copy and
+  that the string is freed when the last reference is released. Finally enough strings are
+  interned to grow the hash table, and all are found and released.
+
+  Copyright 2020 Pekka Lehtikoski. This file is part of the eobjects project and shall only be used,
+  modified, and distributed under the terms of the project licensing. By continuing to use, modify,
+  or distribute this file you indicate that you have read the license and understand and accept
+  it fully.
+
+****************************************************************************************************
+*/
+#include "eobjects.h"
+#include "variables.h"
+#include <stdio.h>
+
+/* Number of different strings interned to grow the hash table.
+ */
+#define V3_NSTRINGS (4 * ESTRINTERN_INITIAL_NBUCKETS)
+
+/* Print error message if condition is not true.
+ */
+static os_boolean v3_check(
+    os_boolean condition,
+    const os_char *what)
+{
+    if (!condition) printf("%s failed\n", what);
+    return condition;
+}
+
+/* Get reference count of interned string, 0 if string is not in table.
+ */
+static os_int v3_refcnt(
+    const os_char *str)
+{
+    eInternedStr *s;
+    os_int refcnt;
+
+    s = estrintern(str, -1, OS_FALSE);
+    if (s == OS_NULL) return 0;
+    refcnt = s->refcnt - 1;
+    estrintern_release(s);
+    return refcnt;
+}
+
+
+/**
+****************************************************************************************************
+
+  @brief Variables example 3.
+
+  The variables_intern_3() function tests interning, reference counting and releasing
+  interned strings.
+
+  @return  None.
+
+****************************************************************************************************
+*/
+void variables_intern_3()
+{
+    eVariable a, b, c, d, *v;
+    eContainer list;
+    os_char buf[32];
+    os_int count0, i, nfound;
+    os_boolean ok = OS_TRUE;
+
+    count0 = eglobal->strintern_count;
+
+    /* Two variables set to the same interned string share it.
+     */
+    a.setis("v3 interned");
+    b.setis("v3 interned");
+    ok &= v3_check(a.isinterned() && b.isinterned(), "isinterned");
+    ok &= v3_check(a.gets() == b.gets(), "shared content");
+    ok &= v3_check(v3_refcnt("v3 interned") == 2, "refcnt after setis");
+    ok &= v3_check(eglobal->strintern_count == count0 + 1, "table count");
+
+    /* Lookup without adding doesn't intern.
+     */
+    c.setis("v3 not interned", OS_FALSE);
+    ok &= v3_check(!c.isinterned(), "setis without add_new");
+    ok &= v3_check(!os_strcmp(c.gets(), "v3 not interned"), "plain string value");
+    ok &= v3_check(v3_refcnt("v3 not interned") == 0, "no table entry");
+
+    /* Copy adds reference, equal plain string compares equal.
+     */
+    c.setv(&a);
+    ok &= v3_check(c.isinterned() && c.gets() == a.gets(), "copy shares content");
+    ok &= v3_check(v3_refcnt("v3 interned") == 3, "refcnt after copy");
+    d.sets("v3 interned");
+    ok &= v3_check(a.compare(&d) == 0 && d.compare(&a) == 0, "compare to plain string");
+
+    /* Modifying makes private copy, others keep the interned value.
+     */
+    c.appends(" changed");
+    ok &= v3_check(!c.isinterned(), "unintern on modify");
+    ok &= v3_check(!os_strcmp(c.gets(), "v3 interned changed"), "modified value");
+    ok &= v3_check(!os_strcmp(a.gets(), "v3 interned"), "shared value unchanged");
+    ok &= v3_check(v3_refcnt("v3 interned") == 2, "refcnt after modify");
+
+    /* String is freed when last reference is released.
+     */
+    b.clear();
+    ok &= v3_check(v3_refcnt("v3 interned") == 1, "refcnt after clear");
+    a.sets("other");
+    ok &= v3_check(v3_refcnt("v3 interned") == 0, "freed after last release");
+    ok &= v3_check(eglobal->strintern_count == count0, "table count after release");
+
+    /* Grow the table, all strings must be found after rehash.
+     */
+    for (i = 0; i < V3_NSTRINGS; i++) {
+        os_strncpy(buf, "v3 ", sizeof(buf));
+        osal_int_to_str(buf + 3, sizeof(buf) - 3, i);
+        v = new eVariable(&list);
+        v->setis(buf);
+    }
+    ok &= v3_check(eglobal->strintern_count == count0 + V3_NSTRINGS, "table count after grow");
+    nfound = 0;
+    for (i = 0; i < V3_NSTRINGS; i++) {
+        os_strncpy(buf, "v3 ", sizeof(buf));
+        osal_int_to_str(buf + 3, sizeof(buf) - 3, i);
+        if (v3_refcnt(buf) == 1) nfound++;
+    }
+    ok &= v3_check(nfound == V3_NSTRINGS, "lookup after grow");
+    list.clear();
+    ok &= v3_check(eglobal->strintern_count == count0, "table count after release all");
+
+    printf("variables_intern_3 %s\n", ok ? "passed" : "FAILED");
+}